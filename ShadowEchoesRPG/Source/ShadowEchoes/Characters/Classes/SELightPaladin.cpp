@@ -3,6 +3,7 @@
 #include "Characters/Classes/SELightPaladin.h"
 #include "Systems/TimelineManager.h"
 #include "Combat/AbilityComponent.h"
+#include "World/SESpatialGrid.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -36,6 +37,7 @@ USELightPaladin::USELightPaladin()
     BarrierDuration = 20.0f;
     BarrierRange = 800.0f;
     BarrierLightCost = 50.0f;
+    BarrierRadius = 400.0f;
 
     // Healing settings
     BaseHealingPower = 50.0f;
@@ -191,6 +193,20 @@ void USELightPaladin::DismissLightBarrier()
     BP_OnBarrierDismissed();
 }
 
+void USELightPaladin::GetActorsInBarrier(TArray<AActor*>& OutActors) const
+{
+    OutActors.Reset();
+    if (!bHasActiveBarrier || !AbilityComponent)
+    {
+        return;
+    }
+
+    if (USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(AbilityComponent))
+    {
+        SpatialGrid->QueryActorsInRadius(BarrierLocation, BarrierRadius, OutActors);
+    }
+}
+
 float USELightPaladin::GetHealingPower() const
 {
     // FromSoftware-style: Complex healing calculations
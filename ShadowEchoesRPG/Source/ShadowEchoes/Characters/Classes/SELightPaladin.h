@@ -83,6 +83,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Light Paladin")
     void DismissLightBarrier();
 
+    /** Combat actors inside the active barrier */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Light Paladin")
+    void GetActorsInBarrier(TArray<AActor*>& OutActors) const;
+
     /** Healing mechanics */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Light Paladin")
     float GetHealingPower() const;
@@ -119,6 +123,9 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Light Paladin")
     float BarrierLightCost;
 
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Light Paladin")
+    float BarrierRadius;
+
     /** Healing settings */
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Light Paladin")
     float BaseHealingPower;
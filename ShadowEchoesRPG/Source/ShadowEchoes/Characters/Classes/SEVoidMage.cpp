@@ -3,6 +3,7 @@
 #include "Characters/Classes/SEVoidMage.h"
 #include "Systems/TimelineManager.h"
 #include "Combat/AbilityComponent.h"
+#include "World/SESpatialGrid.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -36,6 +37,7 @@ USEVoidMage::USEVoidMage()
     PortalDuration = 15.0f;
     PortalRange = 1000.0f;
     PortalVoidCost = 50.0f;
+    PortalRadius = 300.0f;
 
     // Initialize void abilities
     // FromSoftware-style: High risk, high reward abilities
@@ -186,6 +188,20 @@ void USEVoidMage::CloseVoidPortal()
     BP_OnPortalClosed();
 }
 
+void USEVoidMage::GetActorsNearPortal(TArray<AActor*>& OutActors) const
+{
+    OutActors.Reset();
+    if (!bHasActivePortal || !AbilityComponent)
+    {
+        return;
+    }
+
+    if (USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(AbilityComponent))
+    {
+        SpatialGrid->QueryActorsInRadius(PortalLocation, PortalRadius, OutActors);
+    }
+}
+
 void USEVoidMage::OnTimelineStateChanged(ETimelineState NewState)
 {
     Super::OnTimelineStateChanged(NewState);
@@ -83,6 +83,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Void Mage")
     void CloseVoidPortal();
 
+    /** Combat actors close enough to be drawn through the active portal */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Void Mage")
+    void GetActorsNearPortal(TArray<AActor*>& OutActors) const;
+
     /** Overridden base class functions */
     virtual void OnTimelineStateChanged(ETimelineState NewState) override;
     virtual float ModifyDamage(float BaseDamage, ETimelineState DamageTimeline) override;
@@ -112,6 +116,9 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Void Mage")
     float PortalVoidCost;
 
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Void Mage")
+    float PortalRadius;
+
     /** State */
     UPROPERTY()
     bool bIsChannelingVoid;
@@ -2,6 +2,7 @@
 #include "Systems/SETimelineStateManager.h"
 #include "Combat/CombatComponent.h"
 #include "Combat/AbilityComponent.h"
+#include "Systems/SESignificanceManager.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Particles/ParticleSystemComponent.h"
@@ -44,6 +45,57 @@ void ASECharacterBase::BeginPlay()
 
     // Set initial health
     CurrentHealth = MaxHealth;
+
+    // Tick rate follows significance from here on
+    if (USESignificanceManager* Significance = USESignificanceManager::Get(this))
+    {
+        Significance->Register(this);
+    }
+}
+
+void ASECharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USESignificanceManager* Significance = USESignificanceManager::Get(this))
+    {
+        Significance->Unregister(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASECharacterBase::ApplySignificanceTickRate(float TickInterval, bool bTickEnabled)
+{
+    SetActorTickInterval(TickInterval);
+    SetActorTickEnabled(bTickEnabled);
+
+    UActorComponent* const ThrottledComponents[] = { TimelineManager, CombatComponent, AbilityComponent };
+    for (UActorComponent* Component : ThrottledComponents)
+    {
+        if (Component)
+        {
+            Component->SetComponentTickInterval(TickInterval);
+            Component->SetComponentTickEnabled(bTickEnabled);
+        }
+    }
+}
+
+void ASECharacterBase::CatchUpSkippedTime(float SkippedSeconds)
+{
+    if (SkippedSeconds <= 0.0f)
+    {
+        return;
+    }
+
+    // One large step; effect timers and energy regen are linear in time
+    UActorComponent* const ThrottledComponents[] = { TimelineManager, CombatComponent, AbilityComponent };
+    for (UActorComponent* Component : ThrottledComponents)
+    {
+        if (Component)
+        {
+            Component->TickComponent(SkippedSeconds, LEVELTICK_All, &Component->PrimaryComponentTick);
+        }
+    }
+    Tick(SkippedSeconds);
 }
 
 void ASECharacterBase::Tick(float DeltaTime)
@@ -23,6 +23,7 @@ public:
     ASECharacterBase();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
     virtual float TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
@@ -63,6 +64,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Timeline")
     void RemoveTimelineEffect(const FString& EffectName);
 
+    UCombatComponent* GetCombatComponent() const { return CombatComponent; }
+
+    // Significance
+    /** Tick interval for the actor and its timeline, combat and ability components */
+    void ApplySignificanceTickRate(float TickInterval, bool bTickEnabled);
+
+    /** Advance everything that ticks by time spent dormant */
+    void CatchUpSkippedTime(float SkippedSeconds);
+
     // Delegates
     UPROPERTY(BlueprintAssignable, Category = "Timeline")
     FOnCharacterStateChanged OnTimelineStateChanged;
@@ -2,6 +2,7 @@
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
 #include "Combat/CombatComponent.h"
+#include "TimerManager.h"
 
 const float UAbilityComponent::ComboWindowDuration = 2.0f;
 
@@ -23,7 +24,6 @@ void UAbilityComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    UpdateCooldowns(DeltaTime);
     CleanupExpiredEffects();
 }
 
@@ -76,6 +76,12 @@ void UAbilityComponent::ForgetAbility(const FName& AbilityName)
 {
     LearnedAbilities.Remove(AbilityName);
     AbilityCooldowns.Remove(AbilityName);
+
+    FTimerHandle TimerHandle;
+    if (CooldownTimers.RemoveAndCopyValue(AbilityName, TimerHandle) && GetWorld())
+    {
+        GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+    }
 }
 
 bool UAbilityComponent::HasAbility(const FName& AbilityName) const
@@ -121,8 +127,13 @@ TArray<FName> UAbilityComponent::GetAvailableAbilities(ETimelineState State) con
 
 float UAbilityComponent::GetRemainingCooldown(const FName& AbilityName) const
 {
-    const float* Cooldown = AbilityCooldowns.Find(AbilityName);
-    return Cooldown ? *Cooldown : 0.0f;
+    const float* ReadyTime = AbilityCooldowns.Find(AbilityName);
+    if (!ReadyTime || !GetWorld())
+    {
+        return 0.0f;
+    }
+
+    return FMath::Max(0.0f, *ReadyTime - GetWorld()->GetTimeSeconds());
 }
 
 bool UAbilityComponent::IsAbilityReady(const FName& AbilityName) const
@@ -293,7 +304,26 @@ void UAbilityComponent::ApplyAbilityEffects(const FAbilityData& AbilityData)
 
 void UAbilityComponent::StartCooldown(const FName& AbilityName, float Duration)
 {
-    AbilityCooldowns.Add(AbilityName, Duration);
+    UWorld* World = GetWorld();
+    if (!World || Duration <= 0.0f)
+    {
+        return;
+    }
+
+    // Store the ready time and arm a single expiry timer; nothing runs per frame
+    // while the ability cools down, listeners derive progress from start/duration
+    const float StartTime = World->GetTimeSeconds();
+    AbilityCooldowns.Add(AbilityName, StartTime + Duration);
+
+    FTimerHandle& TimerHandle = CooldownTimers.FindOrAdd(AbilityName);
+    World->GetTimerManager().SetTimer(
+        TimerHandle,
+        FTimerDelegate::CreateUObject(this, &UAbilityComponent::ClearCooldown, AbilityName),
+        Duration,
+        false
+    );
+
+    OnCooldownStarted.Broadcast(AbilityName, StartTime, Duration);
 }
 
 void UAbilityComponent::ApplyTimelineModifiers(FAbilityData& AbilityData) const
@@ -375,34 +405,10 @@ void UAbilityComponent::HandleAbilityFailure(const FName& AbilityName, const FSt
     OnAbilityActivated.Broadcast(AbilityName, false);
 }
 
-void UAbilityComponent::UpdateCooldowns(float DeltaTime)
-{
-    TArray<FName> CompletedCooldowns;
-
-    for (auto& Pair : AbilityCooldowns)
-    {
-        Pair.Value -= DeltaTime;
-        
-        if (Pair.Value <= 0.0f)
-        {
-            CompletedCooldowns.Add(Pair.Key);
-        }
-        else
-        {
-            OnCooldownUpdated.Broadcast(Pair.Key, Pair.Value);
-        }
-    }
-
-    // Remove completed cooldowns
-    for (const FName& AbilityName : CompletedCooldowns)
-    {
-        ClearCooldown(AbilityName);
-    }
-}
-
-void UAbilityComponent::ClearCooldown(const FName& AbilityName)
+void UAbilityComponent::ClearCooldown(FName AbilityName)
 {
     AbilityCooldowns.Remove(AbilityName);
+    CooldownTimers.Remove(AbilityName);
     OnCooldownUpdated.Broadcast(AbilityName, 0.0f);
 }
 
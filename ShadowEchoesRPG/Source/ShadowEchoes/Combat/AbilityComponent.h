@@ -9,6 +9,7 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAbilityActivated, const FName&, AbilityName, bool, bSuccess);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAbilityLearned, const FAbilityData&, AbilityData);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCooldownUpdated, const FName&, AbilityName, float, RemainingTime);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnCooldownStarted, const FName&, AbilityName, float, StartTime, float, Duration);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class SHADOWECHOES_API UAbilityComponent : public UActorComponent
@@ -72,17 +73,26 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Abilities")
     FOnAbilityLearned OnAbilityLearned;
 
+    /** Fired once when a cooldown expires (RemainingTime is always 0) */
     UPROPERTY(BlueprintAssignable, Category = "Abilities")
     FOnCooldownUpdated OnCooldownUpdated;
 
+    /** Fired once when a cooldown begins; StartTime is in world seconds */
+    UPROPERTY(BlueprintAssignable, Category = "Abilities")
+    FOnCooldownStarted OnCooldownStarted;
+
 protected:
     // Ability Storage
     UPROPERTY()
     TMap<FName, FAbilityData> LearnedAbilities;
 
+    /** World time at which each cooling ability becomes ready */
     UPROPERTY()
     TMap<FName, float> AbilityCooldowns;
 
+    /** One expiry timer per cooling ability */
+    TMap<FName, FTimerHandle> CooldownTimers;
+
     // Timeline State
     UPROPERTY()
     ETimelineState CurrentTimelineState;
@@ -107,8 +117,7 @@ protected:
 
 private:
     // Cooldown Management
-    void UpdateCooldowns(float DeltaTime);
-    void ClearCooldown(const FName& AbilityName);
+    void ClearCooldown(FName AbilityName);
 
     // Combo System
     TArray<FName> CurrentComboChain;
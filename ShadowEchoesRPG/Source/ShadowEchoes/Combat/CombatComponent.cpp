@@ -1,7 +1,9 @@
 #include "CombatComponent.h"
+#include "Components/SceneComponent.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "World/SESpatialGrid.h"
 
 UCombatComponent::UCombatComponent()
 {
@@ -21,6 +23,33 @@ void UCombatComponent::BeginPlay()
 {
     Super::BeginPlay();
     CurrentStats = BaseStats;
+
+    if (USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(this))
+    {
+        SpatialGrid->Register(this);
+
+        // Follow movement rather than ticks, which significance may throttle or stop
+        if (USceneComponent* Root = GetOwner()->GetRootComponent())
+        {
+            OwnerMovedHandle = Root->TransformUpdated.AddUObject(this, &UCombatComponent::HandleOwnerMoved);
+        }
+    }
+}
+
+void UCombatComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USceneComponent* Root = GetOwner()->GetRootComponent())
+    {
+        Root->TransformUpdated.Remove(OwnerMovedHandle);
+    }
+    OwnerMovedHandle.Reset();
+
+    if (USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(this))
+    {
+        SpatialGrid->Unregister(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void UCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -31,6 +60,15 @@ void UCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
     ProcessComboTimeout(DeltaTime);
 }
 
+void UCombatComponent::HandleOwnerMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    // Only touches the grid cells when the owner crosses a cell boundary
+    if (USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(this))
+    {
+        SpatialGrid->UpdateLocation(this);
+    }
+}
+
 void UCombatComponent::EnterCombat(AActor* Target)
 {
     if (!Target || CurrentCombatState == ECombatState::InCombat)
@@ -132,6 +170,42 @@ void UCombatComponent::ExecuteAttack(const FAttackData& AttackData, AActor* Targ
     }
 }
 
+int32 UCombatComponent::ExecuteAreaAttack(const FAttackData& AttackData, const FVector& Center, float Radius)
+{
+    USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(this);
+    if (!SpatialGrid || !IsInCombat())
+    {
+        return 0;
+    }
+
+    TArray<AActor*> Targets;
+    SpatialGrid->QueryActorsInRadius(Center, Radius, Targets, GetOwner());
+
+    for (AActor* Target : Targets)
+    {
+        float FinalDamage = CalculateDamage(AttackData, Target);
+        bool bWasCritical = ShouldTriggerCritical();
+
+        UGameplayStatics::ApplyDamage(
+            Target,
+            FinalDamage,
+            GetOwner()->GetInstigatorController(),
+            GetOwner(),
+            nullptr
+        );
+
+        OnDamageDealt.Broadcast(FinalDamage, Target, bWasCritical);
+    }
+
+    // One combo step per cast, not per target
+    if (Targets.Num() > 0 && AttackData.bCanCombo)
+    {
+        ContinueCombo(AttackData.AbilityName);
+    }
+
+    return Targets.Num();
+}
+
 void UCombatComponent::ApplyStatusEffect(const FStatusEffect& Effect, AActor* Target)
 {
     if (!Target)
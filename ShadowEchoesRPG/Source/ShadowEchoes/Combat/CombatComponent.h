@@ -6,6 +6,8 @@
 #include "Combat/SECombatTypes.h"
 #include "CombatComponent.generated.h"
 
+class USceneComponent;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnDamageDealt, float, Damage, AActor*, Target, bool, bWasCritical);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCombatStateChanged, ECombatState, NewState, ECombatState, OldState);
 
@@ -18,6 +20,7 @@ public:
     UCombatComponent();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     // Combat State Management
@@ -44,6 +47,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void ExecuteAttack(const FAttackData& AttackData, AActor* Target);
 
+    /** Attack every other combat actor within Radius of Center; returns the number hit */
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    int32 ExecuteAreaAttack(const FAttackData& AttackData, const FVector& Center, float Radius);
+
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void ApplyStatusEffect(const FStatusEffect& Effect, AActor* Target);
 
@@ -159,4 +166,8 @@ private:
     // Cache
     TMap<FName, float> AbilityDamageCache;
     void UpdateDamageCache();
+
+    // Spatial grid
+    void HandleOwnerMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+    FDelegateHandle OwnerMovedHandle;
 };
@@ -33,7 +33,7 @@ void USEBossManager::Initialize(USEGameInstance* InGameInstance)
         {
             if (Boss)
             {
-                BossDatabase.Add(Boss->BossID, *Boss);
+                RegisterBoss(*Boss);
             }
         }
     }
@@ -88,6 +88,11 @@ void USEBossManager::EndBossFight(bool bWasVictorious)
     CurrentHealthPercent = 1.0f;
 }
 
+void USEBossManager::RegisterBoss(const FBossInfo& Boss)
+{
+    BossDatabase.Add(Boss.BossID, Boss);
+}
+
 const FBossInfo* USEBossManager::GetBossInfo(const FName& BossID) const
 {
     return BossDatabase.Find(BossID);
@@ -78,6 +78,9 @@ public:
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Bosses")
     bool IsBossFightActive() const { return bIsBossFightActive; }
 
+    /** Add or replace a boss outside DT_BossFights, e.g. for simulation */
+    void RegisterBoss(const FBossInfo& Boss);
+
     /** Boss info */
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Bosses")
     const FBossInfo* GetBossInfo(const FName& BossID) const;
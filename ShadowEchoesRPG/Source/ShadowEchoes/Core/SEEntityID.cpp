@@ -0,0 +1,209 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Core/SEEntityID.h"
+#include "Algo/AnyOf.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace SEEntityIDText
+{
+    /** Characters that end an unquoted ID in text, as in struct and array literals */
+    static bool IsDelimiter(TCHAR Char)
+    {
+        return FChar::IsWhitespace(Char) || Char == TEXT(',') || Char == TEXT(')') || Char == TEXT('=');
+    }
+}
+
+FSEEntityID FSEEntityID::Intern(const FString& Name)
+{
+    return FSEEntityID(FSEEntityRegistry::Get().Intern(Name));
+}
+
+FSEEntityID FSEEntityID::Find(const FString& Name)
+{
+    return FSEEntityID(FSEEntityRegistry::Get().Find(Name));
+}
+
+FSEEntityID FSEEntityID::NewID()
+{
+    return Intern(FGuid::NewGuid().ToString());
+}
+
+void FSEEntityID::Release(const FSEEntityID& ID)
+{
+    FSEEntityRegistry::Get().Release(ID.Value);
+}
+
+FString FSEEntityID::ToString() const
+{
+    return FSEEntityRegistry::Get().GetName(Value);
+}
+
+bool FSEEntityID::Serialize(FArchive& Ar)
+{
+    if (Ar.IsLoading())
+    {
+        FString Name;
+        Ar << Name;
+        *this = Intern(Name);
+    }
+    else
+    {
+        FString Name = ToString();
+        Ar << Name;
+    }
+    return true;
+}
+
+bool FSEEntityID::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // The handle differs between processes, so the wire carries the name like any archive
+    Serialize(Ar);
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
+
+bool FSEEntityID::ExportTextItem(FString& ValueStr, const FSEEntityID& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
+{
+    // Names that would end an unquoted import early are written quoted
+    const FString Name = ToString();
+    if (Name.Contains(TEXT("\"")) || Name.Contains(TEXT("\\")) || Algo::AnyOf(Name, &SEEntityIDText::IsDelimiter))
+    {
+        ValueStr += FString::Printf(TEXT("\"%s\""), *Name.ReplaceCharWithEscapedChar());
+    }
+    else
+    {
+        ValueStr += Name;
+    }
+    return true;
+}
+
+bool FSEEntityID::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+{
+    if (*Buffer == TEXT('"'))
+    {
+        FString Name;
+        int32 NumCharsRead = 0;
+        if (!FParse::QuotedString(Buffer, Name, &NumCharsRead))
+        {
+            return false;
+        }
+        Buffer += NumCharsRead;
+        *this = Intern(Name);
+        return true;
+    }
+
+    // Unquoted names run to the first delimiter of the enclosing text
+    const TCHAR* Start = Buffer;
+    while (*Buffer && !SEEntityIDText::IsDelimiter(*Buffer))
+    {
+        ++Buffer;
+    }
+
+    *this = Intern(FString::ConstructFromPtrSize(Start, UE_PTRDIFF_TO_INT32(Buffer - Start)));
+    return true;
+}
+
+FSEEntityRegistry& FSEEntityRegistry::Get()
+{
+    static FSEEntityRegistry Registry;
+    return Registry;
+}
+
+uint64 FSEEntityRegistry::Intern(const FString& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return 0;
+    }
+
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const uint64* Existing = Values.Find(Name))
+        {
+            return *Existing;
+        }
+    }
+
+    // Another thread may have interned it between the two locks
+    FWriteScopeLock WriteLock(Lock);
+    if (const uint64* Existing = Values.Find(Name))
+    {
+        return *Existing;
+    }
+
+    uint32 Slot = 0;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(false);
+        Entries[Slot].Name = Name;
+    }
+    else
+    {
+        Slot = static_cast<uint32>(Entries.AddElement(FEntry{ Name, 0 }));
+    }
+
+    const uint64 Value = MakeValue(Slot, Entries[Slot].Generation);
+    Values.Add(Name, Value);
+    return Value;
+}
+
+uint64 FSEEntityRegistry::Find(const FString& Name) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const uint64* Existing = Values.Find(Name);
+    return Existing ? *Existing : 0;
+}
+
+FString FSEEntityRegistry::GetName(uint64 Value) const
+{
+    if (Value == 0)
+    {
+        return FString();
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    const FEntry& Entry = Entries[static_cast<int32>(GetSlot(Value))];
+    return Entry.Generation == GetGeneration(Value) ? Entry.Name : FString();
+}
+
+void FSEEntityRegistry::Release(uint64 Value)
+{
+    if (Value == 0)
+    {
+        return;
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    const uint32 Slot = GetSlot(Value);
+    FEntry& Entry = Entries[static_cast<int32>(Slot)];
+    if (Entry.Generation != GetGeneration(Value))
+    {
+        // Already released
+        return;
+    }
+
+    Values.Remove(Entry.Name);
+    Entry.Name.Empty();
+    ++Entry.Generation;
+    FreeSlots.Add(Slot);
+}
+
+int32 FSEEntityRegistry::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Entries.Num() - FreeSlots.Num();
+}
+
+SIZE_T FSEEntityRegistry::GetAllocatedSize() const
+{
+    FReadScopeLock ReadLock(Lock);
+
+    SIZE_T Size = Values.GetAllocatedSize() + Entries.GetAllocatedSize() + FreeSlots.GetAllocatedSize();
+    for (const auto& Pair : Values)
+    {
+        // Key and chunked copy of every name
+        Size += Pair.Key.GetAllocatedSize() * 2;
+    }
+    return Size;
+}
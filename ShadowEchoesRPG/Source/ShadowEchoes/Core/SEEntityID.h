@@ -0,0 +1,145 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "SEEntityID.generated.h"
+
+/**
+ * Compact handle for a player, guild, listing or match
+ *
+ * A 64-bit slot index and generation in a process-wide intern table that holds the external
+ * string form, so hashing, comparison and copies are integer operations. Handles are only
+ * meaningful within one process: archives, replication and text export write the string form
+ * and intern it again on load. Short-lived IDs are released when their object goes away; a
+ * stale copy then compares unequal to whatever reuses the slot and reads as empty.
+ */
+USTRUCT(BlueprintType)
+struct SHADOWECHOES_API FSEEntityID
+{
+    GENERATED_BODY()
+
+    FSEEntityID()
+        : Value(0)
+    {
+    }
+
+    /** Handle for Name, adding it to the table if needed; empty names give the invalid ID */
+    static FSEEntityID Intern(const FString& Name);
+
+    /** Handle for Name if it was interned, otherwise the invalid ID */
+    static FSEEntityID Find(const FString& Name);
+
+    /** Fresh ID with a GUID string form; Release it when the object it names is gone */
+    static FSEEntityID NewID();
+
+    /** Return ID's slot for reuse; only once nothing needs its string form any more */
+    static void Release(const FSEEntityID& ID);
+
+    bool IsValid() const { return Value != 0; }
+    uint64 GetValue() const { return Value; }
+
+    /** External form, copied out so a concurrent Release cannot change it; empty for the invalid ID */
+    FString ToString() const;
+
+    bool operator==(const FSEEntityID& Other) const { return Value == Other.Value; }
+    bool operator!=(const FSEEntityID& Other) const { return Value != Other.Value; }
+
+    friend uint32 GetTypeHash(const FSEEntityID& ID) { return ::GetTypeHash(ID.Value); }
+
+    /** Persistence writes the string form */
+    bool Serialize(FArchive& Ar);
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+    bool ExportTextItem(FString& ValueStr, const FSEEntityID& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
+    bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
+
+    friend FArchive& operator<<(FArchive& Ar, FSEEntityID& ID)
+    {
+        ID.Serialize(Ar);
+        return Ar;
+    }
+
+private:
+    explicit FSEEntityID(uint64 InValue)
+        : Value(InValue)
+    {
+    }
+
+    /** Slot generation in the high 32 bits, 1-based slot in the low; deliberately not a UPROPERTY */
+    uint64 Value;
+};
+
+template<>
+struct TStructOpsTypeTraits<FSEEntityID> : public TStructOpsTypeTraitsBase2<FSEEntityID>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithNetSerializer = true,
+        WithExportTextItem = true,
+        WithImportTextItem = true,
+        WithIdenticalViaEquality = true
+    };
+};
+
+/**
+ * Process-wide intern table behind FSEEntityID
+ *
+ * Names live in chunked storage so their addresses never move while other threads intern.
+ * GetName copies the name under the lock, since a released slot is emptied and refilled by the
+ * next Intern. Released slots come back with the next generation, so handles to the old name
+ * never match the new one.
+ */
+class SHADOWECHOES_API FSEEntityRegistry
+{
+public:
+    static FSEEntityRegistry& Get();
+
+    uint64 Intern(const FString& Name);
+    uint64 Find(const FString& Name) const;
+    FString GetName(uint64 Value) const;
+    void Release(uint64 Value);
+
+    /** Names currently interned */
+    int32 Num() const;
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    static constexpr int32 NamesPerChunk = 16384;
+
+    struct FEntry
+    {
+        FString Name;
+        uint32 Generation = 0;
+    };
+
+    static uint64 MakeValue(uint32 Slot, uint32 Generation) { return (static_cast<uint64>(Generation) << 32) | (Slot + 1); }
+    static uint32 GetSlot(uint64 Value) { return static_cast<uint32>(Value) - 1; }
+    static uint32 GetGeneration(uint64 Value) { return static_cast<uint32>(Value >> 32); }
+
+    mutable FRWLock Lock;
+    TMap<FString, uint64> Values;
+    TChunkedArray<FEntry, NamesPerChunk * sizeof(FEntry)> Entries;
+    TArray<uint32> FreeSlots;
+};
+
+/** Blueprint conversions at the UI boundary */
+UCLASS()
+class SHADOWECHOES_API USEEntityIDLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Entity", meta = (DisplayName = "To Entity ID"))
+    static FSEEntityID MakeEntityID(const FString& Name) { return FSEEntityID::Intern(Name); }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Entity", meta = (DisplayName = "To String (Entity ID)", CompactNodeTitle = "->", BlueprintAutocast))
+    static FString Conv_EntityIDToString(const FSEEntityID& ID) { return ID.ToString(); }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Entity", meta = (DisplayName = "Equal (Entity ID)", CompactNodeTitle = "=="))
+    static bool EqualEqual_EntityID(const FSEEntityID& A, const FSEEntityID& B) { return A == B; }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Entity", meta = (DisplayName = "Is Valid (Entity ID)"))
+    static bool IsValidEntityID(const FSEEntityID& ID) { return ID.IsValid(); }
+};
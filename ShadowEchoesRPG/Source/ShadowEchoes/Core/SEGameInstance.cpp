@@ -1,10 +1,22 @@
 // Copyright Shadow Echoes RPG. All Rights Reserved.
 
 #include "Core/SEGameInstance.h"
+#include "ShadowEchoes.h"
 #include "Systems/TimelineManager.h"
 #include "Systems/QuestManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "SaveGame/SESaveGame.h"
+#include "SaveGame/SESaveFormat.h"
+#include "SaveGame/SESaveGamePipeline.h"
+#include "SaveGame/SESaveJournal.h"
+#include "SaveGame/SEWorldDatabase.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+
+namespace
+{
+    const TCHAR* MainSaveSlot = TEXT("MainSave");
+}
 
 USEGameInstance::USEGameInstance()
     : DefaultTimelineState(ETimelineState::BrightWorld)
@@ -12,6 +24,12 @@ USEGameInstance::USEGameInstance()
     , PlayerLevel(1)
     , PlayerExperience(0)
     , PlayerCurrency(0)
+    , AutoSaveInterval(300.0f)
+    , AutoSavesPerCompaction(10)
+    , JournalCompactionBytes(256 * 1024)
+    , WorldDatabaseFlushInterval(0.1f)
+    , AutoSavesSinceCompaction(0)
+    , SlotJournalGeneration(0)
 {
 }
 
@@ -19,23 +37,91 @@ void USEGameInstance::Init()
 {
     Super::Init();
 
+    // Async save writer
+    SavePipeline = MakeShared<FSESaveGamePipeline, ESPMode::ThreadSafe>();
+    SavePipeline->OnSaveFinished.BindUObject(this, &USEGameInstance::HandleSaveFinished);
+    SaveJournal = MakeUnique<FSESaveJournal>(MainSaveSlot);
+
+    // World database is local to the server and must be open before managers load from it;
+    // client builds never have one, and LoadComplete closes it once we join a remote server
+    if (!IsRunningClientOnly())
+    {
+        WorldDatabase = MakeUnique<FSEWorldDatabase>(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Server"), TEXT("World.db")));
+        if (!WorldDatabase->Open())
+        {
+            WorldDatabase.Reset();
+        }
+    }
+
     // Initialize systems
     InitializeManagers();
     InitializePlayerData();
     LoadQuestData();
 
+    // Progression indices must exist before saved bitsets are read
+    FSEProgressionRegistry::Get().LoadFromData();
+
     // Load saved game if exists
     LoadGame();
+
+    // Autosave runs off the game thread, so a fixed interval is cheap
+    if (AutoSaveInterval > 0.0f)
+    {
+        GetTimerManager().SetTimer(AutoSaveTimerHandle, this, &USEGameInstance::RequestAutoSave, AutoSaveInterval, true);
+    }
+
+    if (WorldDatabase && WorldDatabaseFlushInterval > 0.0f)
+    {
+        GetTimerManager().SetTimer(WorldDatabaseTimerHandle, this, &USEGameInstance::FlushWorldDatabase, WorldDatabaseFlushInterval, true);
+    }
 }
 
 void USEGameInstance::Shutdown()
 {
-    // Save game on shutdown
+    GetTimerManager().ClearTimer(AutoSaveTimerHandle);
+    GetTimerManager().ClearTimer(WorldDatabaseTimerHandle);
+
+    // Save game on shutdown and wait for it to reach the disk
     SaveGame();
+    if (SavePipeline)
+    {
+        // Flush reports the final save, so its journal cleanup still runs
+        SavePipeline->Flush();
+        SavePipeline->OnSaveFinished.Unbind();
+        SavePipeline.Reset();
+    }
+    SaveJournal.Reset();
+    SaveSlotReader.Reset();
+
+    // Every queued guild and rank write is committed before exit
+    CloseWorldDatabase();
 
     Super::Shutdown();
 }
 
+void USEGameInstance::LoadComplete(const float LoadTime, const FString& MapName)
+{
+    Super::LoadComplete(LoadTime, MapName);
+
+    // The shared world belongs to the server we joined, not to this process
+    const UWorld* World = GetWorld();
+    if (WorldDatabase && World && World->GetNetMode() == NM_Client)
+    {
+        SE_LOG(Log, TEXT("Connected as a client; closing the local world database"));
+        CloseWorldDatabase();
+    }
+}
+
+void USEGameInstance::CloseWorldDatabase()
+{
+    GetTimerManager().ClearTimer(WorldDatabaseTimerHandle);
+    if (WorldDatabase)
+    {
+        WorldDatabase->Close();
+        WorldDatabase.Reset();
+    }
+}
+
 void USEGameInstance::SetTimelineState(ETimelineState NewState)
 {
     if (CurrentTimelineState != NewState)
@@ -51,6 +137,11 @@ void USEGameInstance::SetTimelineState(ETimelineState NewState)
         // Broadcast events
         OnTimelineStateChanged.Broadcast(NewState);
         BP_OnTimelineStateChanged(NewState);
+
+        if (SaveJournal)
+        {
+            SaveJournal->RecordTimelineState(NewState);
+        }
     }
 }
 
@@ -65,6 +156,8 @@ void USEGameInstance::RegisterTimelineManager(UTimelineManager* Manager)
 
 void USEGameInstance::StartQuest(const FName& QuestID)
 {
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Quests));
+
     if (QuestManager)
     {
         const FQuestInfo* Quest = QuestManager->GetQuestInfo(QuestID);
@@ -87,6 +180,10 @@ void USEGameInstance::StartQuest(const FName& QuestID)
 
             // Start quest
             QuestStates.Add(QuestID, EQuestState::InProgress);
+            if (SaveJournal)
+            {
+                SaveJournal->RecordQuestState(QuestID, EQuestState::InProgress);
+            }
             OnQuestStateChanged.Broadcast(*Quest, EQuestState::InProgress);
             BP_OnQuestStateChanged(*Quest, EQuestState::InProgress);
         }
@@ -95,6 +192,8 @@ void USEGameInstance::StartQuest(const FName& QuestID)
 
 void USEGameInstance::CompleteQuest(const FName& QuestID)
 {
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Quests));
+
     if (QuestManager)
     {
         const FQuestInfo* Quest = QuestManager->GetQuestInfo(QuestID);
@@ -106,6 +205,10 @@ void USEGameInstance::CompleteQuest(const FName& QuestID)
 
             // Update state
             QuestStates[QuestID] = EQuestState::Completed;
+            if (SaveJournal)
+            {
+                SaveJournal->RecordQuestState(QuestID, EQuestState::Completed);
+            }
             OnQuestStateChanged.Broadcast(*Quest, EQuestState::Completed);
             BP_OnQuestStateChanged(*Quest, EQuestState::Completed);
         }
@@ -114,12 +217,18 @@ void USEGameInstance::CompleteQuest(const FName& QuestID)
 
 void USEGameInstance::FailQuest(const FName& QuestID)
 {
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Quests));
+
     if (QuestManager)
     {
         const FQuestInfo* Quest = QuestManager->GetQuestInfo(QuestID);
         if (Quest && QuestStates.Contains(QuestID))
         {
             QuestStates[QuestID] = EQuestState::Failed;
+            if (SaveJournal)
+            {
+                SaveJournal->RecordQuestState(QuestID, EQuestState::Failed);
+            }
             OnQuestStateChanged.Broadcast(*Quest, EQuestState::Failed);
             BP_OnQuestStateChanged(*Quest, EQuestState::Failed);
         }
@@ -128,11 +237,14 @@ void USEGameInstance::FailQuest(const FName& QuestID)
 
 EQuestState USEGameInstance::GetQuestState(const FName& QuestID) const
 {
+    const_cast<USEGameInstance*>(this)->EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Quests));
     return QuestStates.Contains(QuestID) ? QuestStates[QuestID] : EQuestState::NotStarted;
 }
 
 TArray<FQuestInfo> USEGameInstance::GetActiveQuests() const
 {
+    const_cast<USEGameInstance*>(this)->EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Quests));
+
     TArray<FQuestInfo> ActiveQuests;
     if (QuestManager)
     {
@@ -155,47 +267,335 @@ void USEGameInstance::AddExperience(int32 XP)
 {
     PlayerExperience += XP;
     CheckLevelUp();
+
+    if (SaveJournal)
+    {
+        SaveJournal->RecordPlayerProgress(PlayerLevel, PlayerExperience, PlayerCurrency);
+    }
 }
 
 void USEGameInstance::AddCurrency(int32 Amount)
 {
     PlayerCurrency += Amount;
+
+    if (SaveJournal)
+    {
+        SaveJournal->RecordPlayerProgress(PlayerLevel, PlayerExperience, PlayerCurrency);
+    }
+}
+
+void USEGameInstance::AddInventoryItem(const FName& ItemID)
+{
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Inventory));
+    PersistentSnapshot.InventoryItems.Add(ItemID);
+    if (SaveJournal)
+    {
+        SaveJournal->RecordItemGained(ItemID);
+    }
+}
+
+void USEGameInstance::RemoveInventoryItem(const FName& ItemID)
+{
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Inventory));
+    if (PersistentSnapshot.InventoryItems.RemoveSingle(ItemID) > 0 && SaveJournal)
+    {
+        SaveJournal->RecordItemRemoved(ItemID);
+    }
+}
+
+void USEGameInstance::DiscoverLocation(const FName& LocationID)
+{
+    SetProgressionFlag(ESEProgressionDomain::Location, FSEProgressionRegistry::Get().FindOrAdd(ESEProgressionDomain::Location, LocationID));
+}
+
+void USEGameInstance::AddTimelineMastery(ETimelineState Timeline, float Delta)
+{
+    float& Mastery = Timeline == ETimelineState::DarkWorld
+        ? PersistentSnapshot.DarkTimelineMastery
+        : PersistentSnapshot.BrightTimelineMastery;
+    Mastery = FMath::Clamp(Mastery + Delta, 0.0f, 1.0f);
+
+    if (SaveJournal)
+    {
+        SaveJournal->RecordMasteryDelta(Timeline, Delta);
+    }
+}
+
+void USEGameInstance::SetAchievementProgress(const FName& AchievementID, float Progress)
+{
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Achievements));
+    PersistentSnapshot.AchievementProgress.Add(AchievementID, Progress);
+    if (SaveJournal)
+    {
+        SaveJournal->RecordAchievementProgress(AchievementID, Progress);
+    }
+}
+
+void USEGameInstance::UnlockAchievement(const FName& AchievementID)
+{
+    SetProgressionFlag(ESEProgressionDomain::Achievement, FSEProgressionRegistry::Get().FindOrAdd(ESEProgressionDomain::Achievement, AchievementID));
+}
+
+bool USEGameInstance::IsLocationDiscovered(const FName& LocationID) const
+{
+    return GetProgression().TestID(ESEProgressionDomain::Location, LocationID);
+}
+
+bool USEGameInstance::IsAchievementUnlocked(const FName& AchievementID) const
+{
+    return GetProgression().TestID(ESEProgressionDomain::Achievement, AchievementID);
+}
+
+const FSEProgressionState& USEGameInstance::GetProgression() const
+{
+    const_cast<USEGameInstance*>(this)->EnsureSaveSectionsLoaded(
+        SESaveSections::Bit(ESESaveSection::World) | SESaveSections::Bit(ESESaveSection::Achievements));
+    return PersistentSnapshot.Progression;
+}
+
+bool USEGameInstance::SetProgressionFlag(ESEProgressionDomain Domain, int32 Index)
+{
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(Domain == ESEProgressionDomain::Achievement
+        ? ESESaveSection::Achievements
+        : ESESaveSection::World));
+
+    if (!PersistentSnapshot.Progression.Set(Domain, Index))
+    {
+        return false;
+    }
+
+    if (SaveJournal)
+    {
+        SaveJournal->RecordProgressionFlag(Domain, FSEProgressionRegistry::Get().GetID(Domain, Index));
+    }
+    return true;
+}
+
+FSELockoutStore& USEGameInstance::GetLockouts()
+{
+    EnsureSaveSectionsLoaded(SESaveSections::Bit(ESESaveSection::Lockouts));
+    Lockouts.Purge(FSELockoutStore::Now());
+    return Lockouts;
 }
 
 bool USEGameInstance::SaveGame()
 {
-    USESaveGame* SaveGameInstance = Cast<USESaveGame>(UGameplayStatics::CreateSaveGameObject(USESaveGame::StaticClass()));
-    if (SaveGameInstance)
+    if (!SavePipeline)
     {
-        // Save player data
-        SaveGameInstance->PlayerLevel = PlayerLevel;
-        SaveGameInstance->PlayerExperience = PlayerExperience;
-        SaveGameInstance->PlayerCurrency = PlayerCurrency;
-        SaveGameInstance->CurrentTimelineState = CurrentTimelineState;
-        SaveGameInstance->QuestStates = QuestStates;
+        return false;
+    }
+
+    // Capture on the game thread; everything else happens on a worker
+    const double SnapshotStart = FPlatformTime::Seconds();
+    EnsureSaveSectionsLoaded(SESaveSections::All);
+    FSESaveSnapshot Snapshot;
+    CaptureSnapshot(Snapshot);
 
-        // Save to slot
-        return UGameplayStatics::SaveGameToSlot(SaveGameInstance, TEXT("MainSave"), 0);
+    // Live state already includes every journaled change; later records go to a new generation
+    if (SaveJournal)
+    {
+        Snapshot.JournalGeneration = SaveJournal->Rotate();
+    }
+    AutoSavesSinceCompaction = 0;
+    const float SnapshotMs = static_cast<float>((FPlatformTime::Seconds() - SnapshotStart) * 1000.0);
+
+    SavePipeline->RequestSave(MoveTemp(Snapshot), MainSaveSlot, SnapshotMs);
+    return true;
+}
+
+void USEGameInstance::RequestAutoSave()
+{
+    const float* AutoSave = PersistentSnapshot.GameSettings.Find(TEXT("AutoSave"));
+    if (!AutoSave || *AutoSave <= 0.0f)
+    {
+        return;
+    }
+
+    // Cheap path: append the journal; compact into a new base every few autosaves
+    const bool bCompactionDue = !SaveJournal
+        || ++AutoSavesSinceCompaction >= AutoSavesPerCompaction
+        || SaveJournal->GetJournalBytes() >= JournalCompactionBytes;
+
+    if (bCompactionDue)
+    {
+        SaveGame();
+    }
+    else
+    {
+        SaveJournal->Flush();
     }
-    return false;
+}
+
+bool USEGameInstance::IsSaveInProgress() const
+{
+    return SavePipeline && SavePipeline->IsSaving();
 }
 
 bool USEGameInstance::LoadGame()
 {
-    USESaveGame* SaveGameInstance = Cast<USESaveGame>(UGameplayStatics::LoadGameFromSlot(TEXT("MainSave"), 0));
+    FSESaveSnapshot Snapshot;
+
+    // Only player core stats are needed to start playing; other sections decode on first use
+    SaveSlotReader = SavePipeline ? SavePipeline->OpenSlot(MainSaveSlot) : nullptr;
+    if (SaveSlotReader)
+    {
+        const uint32 CoreMask = SESaveSections::Bit(ESESaveSection::Core);
+        SaveSlotReader->LoadSections(CoreMask, Snapshot);
+        if (!Snapshot.Validate())
+        {
+            Snapshot.Repair();
+        }
+        if (SaveJournal)
+        {
+            SaveJournal->Replay(Snapshot, CoreMask);
+        }
+        ApplySnapshot(Snapshot);
+        return true;
+    }
+
+    // Sectioned files that failed to open end up here too and fall back to their backup
+    if (SavePipeline && SavePipeline->LoadSlot(MainSaveSlot, Snapshot))
+    {
+        // Base plus every change recorded since it was written
+        if (SaveJournal)
+        {
+            SaveJournal->Replay(Snapshot);
+        }
+        ApplySnapshot(Snapshot);
+        return true;
+    }
+
+    // Legacy USaveGame slot written before the async pipeline existed
+    USESaveGame* SaveGameInstance = Cast<USESaveGame>(UGameplayStatics::LoadGameFromSlot(MainSaveSlot, 0));
     if (SaveGameInstance)
     {
-        // Load player data
-        PlayerLevel = SaveGameInstance->PlayerLevel;
-        PlayerExperience = SaveGameInstance->PlayerExperience;
-        PlayerCurrency = SaveGameInstance->PlayerCurrency;
-        SetTimelineState(SaveGameInstance->CurrentTimelineState);
-        QuestStates = SaveGameInstance->QuestStates;
+        SaveGameInstance->ToSnapshot(Snapshot);
+        if (!Snapshot.Validate())
+        {
+            Snapshot.Repair();
+        }
+        ApplySnapshot(Snapshot);
+        return true;
+    }
+
+    // Fresh game: start from the save defaults
+    GetDefault<USESaveGame>()->ToSnapshot(Snapshot);
+    if (SaveJournal && SaveJournal->Replay(Snapshot) > 0)
+    {
+        // Journal written before the first base save
+        ApplySnapshot(Snapshot);
         return true;
     }
+    PersistentSnapshot = Snapshot;
     return false;
 }
 
+void USEGameInstance::EnsureSaveSectionsLoaded(uint32 SectionMask)
+{
+    if (!SaveSlotReader)
+    {
+        return;
+    }
+
+    const uint32 MissingMask = SectionMask & ~SaveSlotReader->GetLoadedMask();
+    if (MissingMask == 0)
+    {
+        return;
+    }
+
+    // Base section, then the journaled changes that were deferred for it
+    SaveSlotReader->LoadSections(MissingMask, PersistentSnapshot);
+    if (SaveJournal)
+    {
+        SaveJournal->ApplyDeferred(MissingMask, PersistentSnapshot);
+    }
+    if (!PersistentSnapshot.Validate())
+    {
+        PersistentSnapshot.Repair();
+    }
+
+    if (MissingMask & SESaveSections::Bit(ESESaveSection::Quests))
+    {
+        QuestStates = PersistentSnapshot.QuestStates;
+    }
+
+    // The store owns lockouts from here on; the save captures them back out of it
+    if (MissingMask & SESaveSections::Bit(ESESaveSection::Lockouts))
+    {
+        Lockouts.Import(PersistentSnapshot.Lockouts, FSELockoutStore::Now());
+        PersistentSnapshot.Lockouts.Empty();
+    }
+
+    if (SaveSlotReader->IsFullyLoaded())
+    {
+        SaveSlotReader.Reset();
+    }
+}
+
+void USEGameInstance::CaptureSnapshot(FSESaveSnapshot& OutSnapshot) const
+{
+    OutSnapshot = PersistentSnapshot;
+
+    // Save player data
+    OutSnapshot.PlayerLevel = PlayerLevel;
+    OutSnapshot.PlayerExperience = PlayerExperience;
+    OutSnapshot.PlayerCurrency = PlayerCurrency;
+    OutSnapshot.CurrentTimelineState = CurrentTimelineState;
+    OutSnapshot.QuestStates = QuestStates;
+    Lockouts.Export(OutSnapshot.Lockouts, FSELockoutStore::Now());
+
+    // Registry IDs the bitsets refer to, for the save worker
+    OutSnapshot.Progression.CaptureIDs();
+
+    // Save metadata
+    OutSnapshot.LastSaveTime = FDateTime::Now();
+    OutSnapshot.SaveSlotName = MainSaveSlot;
+}
+
+void USEGameInstance::ApplySnapshot(const FSESaveSnapshot& Snapshot)
+{
+    PersistentSnapshot = Snapshot;
+    SlotJournalGeneration = Snapshot.JournalGeneration;
+
+    // Load player data
+    PlayerLevel = Snapshot.PlayerLevel;
+    PlayerExperience = Snapshot.PlayerExperience;
+    PlayerCurrency = Snapshot.PlayerCurrency;
+    SetTimelineState(Snapshot.CurrentTimelineState);
+    QuestStates = Snapshot.QuestStates;
+
+    // Empty when the Lockouts section is still waiting in the slot reader
+    Lockouts.Import(Snapshot.Lockouts, FSELockoutStore::Now());
+    PersistentSnapshot.Lockouts.Empty();
+}
+
+void USEGameInstance::HandleSaveFinished(bool bSuccess, const FSESaveStats& Stats)
+{
+    SE_LOG(Log, TEXT("Save %s: snapshot %.3f ms, serialize %.2f ms, compress %.2f ms, write %.2f ms, %d -> %d bytes"),
+        bSuccess ? TEXT("succeeded") : TEXT("failed"),
+        Stats.SnapshotMs, Stats.SerializeMs, Stats.CompressMs, Stats.WriteMs,
+        Stats.UncompressedBytes, Stats.WrittenBytes);
+
+    // The verified new base folds in all older generations, but the previous base is now the
+    // backup; a corrupt main file falls back to it, so its journals stay until the next save
+    if (bSuccess && SaveJournal)
+    {
+        SaveJournal->DeleteGenerationsBelow(SlotJournalGeneration);
+        SlotJournalGeneration = static_cast<uint32>(Stats.JournalGeneration);
+    }
+
+    OnSaveGameCompleted.Broadcast(bSuccess, Stats);
+    BP_OnSaveGameCompleted(bSuccess, Stats);
+}
+
+void USEGameInstance::FlushWorldDatabase()
+{
+    if (WorldDatabase)
+    {
+        WorldDatabase->FlushIfDue();
+    }
+}
+
 void USEGameInstance::InitializeManagers()
 {
     // Create timeline manager if needed
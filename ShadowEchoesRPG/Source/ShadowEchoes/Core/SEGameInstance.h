@@ -5,14 +5,21 @@
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
 #include "Core/SETypes.h"
+#include "Core/SELockoutStore.h"
+#include "SaveGame/SESaveTypes.h"
 #include "SEGameInstance.generated.h"
 
 class UTimelineManager;
 class UQuestManager;
+class FSESaveGamePipeline;
+class FSESaveJournal;
+class FSESaveSlotReader;
+class FSEWorldDatabase;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimelineStateChanged, ETimelineState, NewState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnQuestStateChanged, const FQuestInfo&, Quest, EQuestState, NewState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerLevelUp, int32, NewLevel);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSaveGameCompleted, bool, bSuccess, const FSESaveStats&, Stats);
 
 /**
  * Game Instance class for Shadow Echoes RPG
@@ -28,6 +35,7 @@ public:
 
     virtual void Init() override;
     virtual void Shutdown() override;
+    virtual void LoadComplete(const float LoadTime, const FString& MapName) override;
 
     /** Timeline management */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Timeline")
@@ -68,13 +76,58 @@ public:
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Player")
     int32 GetPlayerCurrency() const { return PlayerCurrency; }
 
+    /** Persistent progression, recorded incrementally in the save journal */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Player")
+    void AddInventoryItem(const FName& ItemID);
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Player")
+    void RemoveInventoryItem(const FName& ItemID);
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Player")
+    void DiscoverLocation(const FName& LocationID);
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Player")
+    void AddTimelineMastery(ETimelineState Timeline, float Delta);
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Player")
+    void SetAchievementProgress(const FName& AchievementID, float Progress);
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Player")
+    void UnlockAchievement(const FName& AchievementID);
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Player")
+    bool IsLocationDiscovered(const FName& LocationID) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Player")
+    bool IsAchievementUnlocked(const FName& AchievementID) const;
+
+    /** Progression bitsets indexed by FSEProgressionRegistry */
+    const FSEProgressionState& GetProgression() const;
+
+    /** Set a progression bit and journal it; returns true if it was not set before */
+    bool SetProgressionFlag(ESEProgressionDomain Domain, int32 Index);
+
     /** Save/Load system */
+    /** Snapshot state and write it asynchronously as a new base, compacting the journal */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|SaveGame")
     bool SaveGame();
 
+    /** If the AutoSave setting is enabled, flush the journal or compact when due */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|SaveGame")
+    void RequestAutoSave();
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|SaveGame")
+    bool IsSaveInProgress() const;
+
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|SaveGame")
     bool LoadGame();
 
+    /** Raid, invasion and dungeon lockouts; saved with the slot, purged lazily on access */
+    FSELockoutStore& GetLockouts();
+
+    /** Shared world state store (guilds, PvP ranks); null if it failed to open */
+    FSEWorldDatabase* GetWorldDatabase() const { return WorldDatabase.Get(); }
+
     /** Events */
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Timeline|Events")
     FOnTimelineStateChanged OnTimelineStateChanged;
@@ -85,6 +138,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Player|Events")
     FOnPlayerLevelUp OnPlayerLevelUp;
 
+    UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|SaveGame|Events")
+    FOnSaveGameCompleted OnSaveGameCompleted;
+
 protected:
     /** Timeline settings */
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Timeline")
@@ -94,6 +150,22 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Player")
     UCurveFloat* ExperienceCurve;
 
+    /** Save settings */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|SaveGame")
+    float AutoSaveInterval;
+
+    /** Journal flushes between full base saves */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|SaveGame")
+    int32 AutoSavesPerCompaction;
+
+    /** Journal size that forces a compaction */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|SaveGame")
+    int32 JournalCompactionBytes;
+
+    /** How often queued world database writes are handed to the writer */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|SaveGame")
+    float WorldDatabaseFlushInterval;
+
     /** Manager references */
     UPROPERTY()
     UTimelineManager* TimelineManager;
@@ -133,6 +205,40 @@ private:
     void SavePlayerData();
     void SaveQuestData();
     void LoadPlayerData();
+    void CaptureSnapshot(FSESaveSnapshot& OutSnapshot) const;
+    void ApplySnapshot(const FSESaveSnapshot& Snapshot);
+    void HandleSaveFinished(bool bSuccess, const FSESaveStats& Stats);
+    void FlushWorldDatabase();
+    void CloseWorldDatabase();
+
+    /** Decode save sections (ESESaveSection bits) that have not been needed yet */
+    void EnsureSaveSectionsLoaded(uint32 SectionMask);
+
+    /** Async save writer */
+    TSharedPtr<FSESaveGamePipeline, ESPMode::ThreadSafe> SavePipeline;
+
+    /** Incremental change journal for the main slot */
+    TUniquePtr<FSESaveJournal> SaveJournal;
+
+    /** Guild and PvP persistence, opened before the managers that read it */
+    TUniquePtr<FSEWorldDatabase> WorldDatabase;
+
+    /** Live lockouts; the Lockouts save section is imported here when first needed */
+    FSELockoutStore Lockouts;
+
+    /** Last loaded save; carries fields this class does not own between saves */
+    FSESaveSnapshot PersistentSnapshot;
+
+    /** Open save file whose remaining sections load on first use */
+    TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SaveSlotReader;
+
+    int32 AutoSavesSinceCompaction;
+
+    /** Journal generation of the base in the main slot file; it becomes the backup on the next save */
+    uint32 SlotJournalGeneration;
+
+    FTimerHandle AutoSaveTimerHandle;
+    FTimerHandle WorldDatabaseTimerHandle;
 
 protected:
     /** Blueprint events */
@@ -144,4 +250,7 @@ protected:
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Player|Events")
     void BP_OnPlayerLevelUp(int32 NewLevel);
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|SaveGame|Events")
+    void BP_OnSaveGameCompleted(bool bSuccess, const FSESaveStats& Stats);
 };
@@ -0,0 +1,195 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Core/SELockoutStore.h"
+
+FSELockoutStore::FSELockoutStore()
+    : SweptSlotTime(0)
+{
+}
+
+int64 FSELockoutStore::Now()
+{
+    return FDateTime::UtcNow().ToUnixTimestamp();
+}
+
+int64 FSELockoutStore::GetNextWeeklyReset(int64 Time, EDayOfWeek Day, int32 Hour)
+{
+    const FDateTime Date = FDateTime::FromUnixTimestamp(Time);
+    const int32 DaysAhead = (static_cast<int32>(Day) - static_cast<int32>(Date.GetDayOfWeek()) + 7) % 7;
+
+    FDateTime Reset = Date.GetDate() + FTimespan::FromDays(DaysAhead) + FTimespan::FromHours(FMath::Clamp(Hour, 0, 23));
+    if (Reset <= Date)
+    {
+        Reset += FTimespan::FromDays(7);
+    }
+    return Reset.ToUnixTimestamp();
+}
+
+void FSELockoutStore::Add(const FSEEntityID& PlayerID, FName Content, int64 ExpiresAt)
+{
+    if (PlayerID.IsValid())
+    {
+        Insert({ PlayerID, Content }, ExpiresAt);
+    }
+}
+
+void FSELockoutStore::Add(TArrayView<const FSEEntityID> PlayerIDs, FName Content, int64 ExpiresAt)
+{
+    Entries.Reserve(Entries.Num() + PlayerIDs.Num());
+    for (const FSEEntityID& PlayerID : PlayerIDs)
+    {
+        Add(PlayerID, Content, ExpiresAt);
+    }
+}
+
+bool FSELockoutStore::Remove(const FSEEntityID& PlayerID, FName Content)
+{
+    // The wheel reference goes stale and is dropped when its slot is swept
+    return Entries.Remove({ PlayerID, Content }) > 0;
+}
+
+bool FSELockoutStore::IsLockedOut(const FSEEntityID& PlayerID, FName Content, int64 Time) const
+{
+    return GetExpiry(PlayerID, Content, Time) != 0;
+}
+
+int64 FSELockoutStore::GetExpiry(const FSEEntityID& PlayerID, FName Content, int64 Time) const
+{
+    const int64* ExpiresAt = Entries.Find({ PlayerID, Content });
+    return ExpiresAt && *ExpiresAt > Time ? *ExpiresAt : 0;
+}
+
+bool FSELockoutStore::IsAnyLockedOut(TArrayView<const FSEEntityID> PlayerIDs, FName Content, int64 Time) const
+{
+    for (const FSEEntityID& PlayerID : PlayerIDs)
+    {
+        if (IsLockedOut(PlayerID, Content, Time))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int32 FSELockoutStore::FindLockedOut(TArrayView<const FSEEntityID> PlayerIDs, FName Content, int64 Time, TArray<FSEEntityID>& OutPlayerIDs) const
+{
+    int32 NumFound = 0;
+    for (const FSEEntityID& PlayerID : PlayerIDs)
+    {
+        if (IsLockedOut(PlayerID, Content, Time))
+        {
+            OutPlayerIDs.Add(PlayerID);
+            ++NumFound;
+        }
+    }
+    return NumFound;
+}
+
+int32 FSELockoutStore::Purge(int64 Time)
+{
+    const int64 TargetSlotTime = GetSlotTime(Time);
+    if (TargetSlotTime <= SweptSlotTime)
+    {
+        return 0;
+    }
+
+    // Only slots the clock has fully passed; after a long gap one turn covers every slot
+    int32 NumRemoved = 0;
+    for (int64 SlotTime = FMath::Max(SweptSlotTime, TargetSlotTime - NumSlots); SlotTime < TargetSlotTime; ++SlotTime)
+    {
+        const int32 SlotIndex = static_cast<int32>(SlotTime & (NumSlots - 1));
+        TArray<FKey>& Slot = Slots[SlotIndex];
+        for (int32 Index = Slot.Num() - 1; Index >= 0; --Index)
+        {
+            const int64* ExpiresAt = Entries.Find(Slot[Index]);
+            if (ExpiresAt && GetSlot(*ExpiresAt) == SlotIndex && *ExpiresAt > Time)
+            {
+                // Due on a later turn of the wheel
+                continue;
+            }
+
+            if (ExpiresAt && GetSlot(*ExpiresAt) == SlotIndex)
+            {
+                Entries.Remove(Slot[Index]);
+                ++NumRemoved;
+            }
+            Slot.RemoveAtSwap(Index, 1, false);
+        }
+    }
+
+    SweptSlotTime = TargetSlotTime;
+    return NumRemoved;
+}
+
+void FSELockoutStore::Export(TArray<FSELockoutRecord>& OutRecords, int64 Time) const
+{
+    OutRecords.Reset(Entries.Num());
+    for (const auto& Pair : Entries)
+    {
+        if (Pair.Value > Time)
+        {
+            OutRecords.Add({ Pair.Key.PlayerID, Pair.Key.Content, Pair.Value });
+        }
+    }
+}
+
+void FSELockoutStore::Import(const TArray<FSELockoutRecord>& Records, int64 Time)
+{
+    Reset();
+    SweptSlotTime = GetSlotTime(Time);
+
+    Entries.Reserve(Records.Num());
+    for (const FSELockoutRecord& Record : Records)
+    {
+        if (Record.ExpiresAt > Time)
+        {
+            Add(Record.PlayerID, Record.Content, Record.ExpiresAt);
+        }
+    }
+}
+
+void FSELockoutStore::Reset()
+{
+    Entries.Reset();
+    for (TArray<FKey>& Slot : Slots)
+    {
+        Slot.Reset();
+    }
+    SweptSlotTime = 0;
+}
+
+SIZE_T FSELockoutStore::GetAllocatedSize() const
+{
+    SIZE_T Size = Entries.GetAllocatedSize();
+    for (const TArray<FKey>& Slot : Slots)
+    {
+        Size += Slot.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FSELockoutStore::Insert(const FKey& Key, int64 ExpiresAt)
+{
+    // A slot the wheel has already passed would not be swept until the next turn
+    if (GetSlotTime(ExpiresAt) < SweptSlotTime)
+    {
+        Entries.Remove(Key);
+        return;
+    }
+
+    if (int64* Existing = Entries.Find(Key))
+    {
+        const bool bSameSlot = GetSlot(*Existing) == GetSlot(ExpiresAt);
+        *Existing = ExpiresAt;
+        if (bSameSlot)
+        {
+            return;
+        }
+    }
+    else
+    {
+        Entries.Add(Key, ExpiresAt);
+    }
+
+    Slots[GetSlot(ExpiresAt)].Add(Key);
+}
@@ -0,0 +1,103 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SEEntityID.h"
+
+/** One player locked out of one piece of content until an absolute time */
+struct FSELockoutRecord
+{
+    FSEEntityID PlayerID;
+
+    /** e.g. Raid.<RaidID>, Invasion, Dungeon.<DungeonID> */
+    FName Content;
+
+    /** Unix seconds, UTC */
+    int64 ExpiresAt = 0;
+};
+
+/**
+ * Expiring (player, content) membership shared by raid lockouts, invasion cooldowns and
+ * dungeon weekly lockouts
+ *
+ * Entries live in one hash map keyed by player and content, holding an absolute UTC expiry,
+ * so a lookup is a single probe and an expired entry reads as absent whether or not it has
+ * been purged yet. Purging is lazy: every entry is also filed in a timing wheel slot by its
+ * expiry, and writes sweep the slots the clock has passed since the last sweep. Entries
+ * further out than one turn of the wheel stay in their slot until the turn they expire.
+ */
+class SHADOWECHOES_API FSELockoutStore
+{
+public:
+    /** Wheel of 256 one-minute slots; one turn is a little over four hours */
+    static constexpr int32 NumSlots = 256;
+    static constexpr int64 SlotSeconds = 60;
+
+    FSELockoutStore();
+
+    /** Current time in the store's clock: Unix seconds, UTC */
+    static int64 Now();
+
+    /** Next time the weekly reset comes round after Time */
+    static int64 GetNextWeeklyReset(int64 Time, EDayOfWeek Day, int32 Hour);
+
+    /** Lock a player out until ExpiresAt, replacing any earlier expiry */
+    void Add(const FSEEntityID& PlayerID, FName Content, int64 ExpiresAt);
+
+    /** Lock a whole party out until ExpiresAt */
+    void Add(TArrayView<const FSEEntityID> PlayerIDs, FName Content, int64 ExpiresAt);
+
+    bool Remove(const FSEEntityID& PlayerID, FName Content);
+
+    bool IsLockedOut(const FSEEntityID& PlayerID, FName Content, int64 Time) const;
+
+    /** Expiry of a live lockout, or 0 if there is none */
+    int64 GetExpiry(const FSEEntityID& PlayerID, FName Content, int64 Time) const;
+
+    /** True if any of the players is locked out */
+    bool IsAnyLockedOut(TArrayView<const FSEEntityID> PlayerIDs, FName Content, int64 Time) const;
+
+    /** Append the locked out players to OutPlayerIDs; returns how many were found */
+    int32 FindLockedOut(TArrayView<const FSEEntityID> PlayerIDs, FName Content, int64 Time, TArray<FSEEntityID>& OutPlayerIDs) const;
+
+    /** Sweep the wheel slots passed since the last sweep; returns entries removed */
+    int32 Purge(int64 Time);
+
+    /** Live entries, for the save */
+    void Export(TArray<FSELockoutRecord>& OutRecords, int64 Time) const;
+
+    /** Replace the contents with saved entries, dropping any that have expired */
+    void Import(const TArray<FSELockoutRecord>& Records, int64 Time);
+
+    void Reset();
+
+    /** Entries held, including expired ones not yet purged */
+    int32 Num() const { return Entries.Num(); }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FKey
+    {
+        FSEEntityID PlayerID;
+        FName Content;
+
+        bool operator==(const FKey& Other) const { return PlayerID == Other.PlayerID && Content == Other.Content; }
+
+        friend uint32 GetTypeHash(const FKey& Key) { return HashCombineFast(GetTypeHash(Key.PlayerID), GetTypeHash(Key.Content)); }
+    };
+
+    static int64 GetSlotTime(int64 Time) { return Time >= 0 ? Time / SlotSeconds : (Time - SlotSeconds + 1) / SlotSeconds; }
+    static int32 GetSlot(int64 Time) { return static_cast<int32>(GetSlotTime(Time) & (NumSlots - 1)); }
+
+    void Insert(const FKey& Key, int64 ExpiresAt);
+
+    TMap<FKey, int64> Entries;
+
+    /** Keys filed by expiry slot; a key whose expiry moved is left behind and dropped on sweep */
+    TArray<FKey> Slots[NumSlots];
+
+    /** Slot time the wheel has been swept up to, exclusive */
+    int64 SweptSlotTime;
+};
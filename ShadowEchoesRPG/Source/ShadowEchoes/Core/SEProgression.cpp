@@ -0,0 +1,154 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Core/SEProgression.h"
+#include "World/SEWorldManager.h"
+#include "Engine/DataTable.h"
+
+FSEProgressionRegistry::FSEProgressionRegistry()
+    : bDataLoaded(false)
+{
+}
+
+void FSEProgressionRegistry::LoadFromData()
+{
+    check(IsInGameThread());
+
+    if (bDataLoaded)
+    {
+        return;
+    }
+    bDataLoaded = true;
+
+    // Areas and their secrets
+    UDataTable* AreaTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_WorldAreas")));
+    if (AreaTable)
+    {
+        TArray<FWorldArea*> AreaRows;
+        AreaTable->GetAllRows<FWorldArea>("", AreaRows);
+        for (const FWorldArea* Area : AreaRows)
+        {
+            if (Area)
+            {
+                FindOrAdd(ESEProgressionDomain::Area, Area->AreaID);
+                for (const FName& SecretID : Area->HiddenSecrets)
+                {
+                    FindOrAddSecret(Area->AreaID, SecretID);
+                }
+            }
+        }
+    }
+
+    // Achievements only need their row names. Locations have no table of their own; they
+    // are appended as they are discovered or loaded from a save.
+    UDataTable* AchievementTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_Achievements")));
+    if (AchievementTable)
+    {
+        for (const FName& RowName : AchievementTable->GetRowNames())
+        {
+            FindOrAdd(ESEProgressionDomain::Achievement, RowName);
+        }
+    }
+}
+
+int32 FSEProgressionRegistry::FindOrAdd(ESEProgressionDomain Domain, FName ID)
+{
+    if (ID.IsNone())
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Existing = Find(Domain, ID);
+    return Existing != INDEX_NONE ? Existing : Append(Domain, ID);
+}
+
+int32 FSEProgressionRegistry::FindOrAddSecret(FName AreaID, FName SecretID)
+{
+    const int32 Existing = FindSecret(AreaID, SecretID);
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    // The combined name is only built here, for save files
+    const FName CombinedID = *FString::Printf(TEXT("%s_%s"), *AreaID.ToString(), *SecretID.ToString());
+    const int32 Index = FindOrAdd(ESEProgressionDomain::Secret, CombinedID);
+    SecretIndices.Add(TPair<FName, FName>(AreaID, SecretID), Index);
+    return Index;
+}
+
+int32 FSEProgressionRegistry::Append(ESEProgressionDomain Domain, FName ID)
+{
+    check(IsInGameThread());
+
+    FDomain& Entry = GetDomain(Domain);
+
+    // Lists already handed to save snapshots stay untouched
+    if (!Entry.IDs.IsUnique())
+    {
+        Entry.IDs = MakeShared<TArray<FName>, ESPMode::ThreadSafe>(*Entry.IDs);
+    }
+
+    const int32 Index = Entry.IDs->Add(ID);
+    Entry.Indices.Add(ID, Index);
+    return Index;
+}
+
+void FSEProgressionRegistry::Reset()
+{
+    for (FDomain& Entry : Domains)
+    {
+        Entry = FDomain();
+    }
+    SecretIndices.Reset();
+    bDataLoaded = false;
+}
+
+bool FSEProgressionState::Set(ESEProgressionDomain Domain, int32 Index)
+{
+    if (Index < 0)
+    {
+        return false;
+    }
+
+    TBitArray<>& DomainBits = GetBits(Domain);
+    if (Index >= DomainBits.Num())
+    {
+        DomainBits.Add(false, Index + 1 - DomainBits.Num());
+    }
+
+    if (DomainBits[Index])
+    {
+        return false;
+    }
+    DomainBits[Index] = true;
+    return true;
+}
+
+void FSEProgressionState::GetSetIDs(ESEProgressionDomain Domain, TArray<FName>& OutIDs) const
+{
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+
+    OutIDs.Reset();
+    for (TConstSetBitIterator<> It(GetBits(Domain)); It; ++It)
+    {
+        OutIDs.Add(Registry.GetID(Domain, It.GetIndex()));
+    }
+}
+
+void FSEProgressionState::SetIDs(ESEProgressionDomain Domain, const TArray<FName>& InIDs)
+{
+    GetBits(Domain).Reset();
+    for (const FName& ID : InIDs)
+    {
+        SetID(Domain, ID);
+    }
+}
+
+void FSEProgressionState::CaptureIDs()
+{
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+    for (int32 Domain = 0; Domain < static_cast<int32>(ESEProgressionDomain::Num); ++Domain)
+    {
+        IDs[Domain] = Registry.GetIDs(static_cast<ESEProgressionDomain>(Domain));
+    }
+}
@@ -0,0 +1,134 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Kinds of persistent one-shot progression
+ */
+enum class ESEProgressionDomain : uint8
+{
+    Area        = 0,
+    Secret      = 1,
+    Location    = 2,
+    Achievement = 3,
+
+    Num
+};
+
+/**
+ * Dense index for every area, secret, location and achievement
+ *
+ * Entries from the world data tables are registered once at data load, in table order, so
+ * progression can be kept in bitsets instead of FName containers. IDs that are not in any
+ * table (locations, older saves, debug content) are appended on first use. Secrets are keyed by area
+ * and secret ID; their combined name is built once at registration and only used for saves.
+ * Game thread only, except for the immutable ID lists handed out by GetIDs().
+ */
+class SHADOWECHOES_API FSEProgressionRegistry
+{
+public:
+    static FSEProgressionRegistry& Get()
+    {
+        static FSEProgressionRegistry Instance;
+        return Instance;
+    }
+
+    /** Register every entry from the world data tables; later calls do nothing */
+    void LoadFromData();
+
+    /** Index of an ID, or INDEX_NONE */
+    int32 Find(ESEProgressionDomain Domain, FName ID) const
+    {
+        const int32* Index = GetDomain(Domain).Indices.Find(ID);
+        return Index ? *Index : INDEX_NONE;
+    }
+
+    /** Index of a secret, or INDEX_NONE */
+    int32 FindSecret(FName AreaID, FName SecretID) const
+    {
+        const int32* Index = SecretIndices.Find(TPair<FName, FName>(AreaID, SecretID));
+        return Index ? *Index : INDEX_NONE;
+    }
+
+    /** Index of an ID, registering it if needed */
+    int32 FindOrAdd(ESEProgressionDomain Domain, FName ID);
+    int32 FindOrAddSecret(FName AreaID, FName SecretID);
+
+    FName GetID(ESEProgressionDomain Domain, int32 Index) const
+    {
+        const TArray<FName>& IDs = *GetDomain(Domain).IDs;
+        return IDs.IsValidIndex(Index) ? IDs[Index] : NAME_None;
+    }
+
+    int32 Num(ESEProgressionDomain Domain) const { return GetDomain(Domain).IDs->Num(); }
+
+    /** Current ID list; never modified after it is handed out, safe to read on any thread */
+    TSharedRef<const TArray<FName>, ESPMode::ThreadSafe> GetIDs(ESEProgressionDomain Domain) const { return GetDomain(Domain).IDs; }
+
+    /** Drop every entry */
+    void Reset();
+
+private:
+    FSEProgressionRegistry();
+
+    struct FDomain
+    {
+        TMap<FName, int32> Indices;
+        TSharedRef<TArray<FName>, ESPMode::ThreadSafe> IDs = MakeShared<TArray<FName>, ESPMode::ThreadSafe>();
+    };
+
+    FDomain& GetDomain(ESEProgressionDomain Domain) { return Domains[static_cast<int32>(Domain)]; }
+    const FDomain& GetDomain(ESEProgressionDomain Domain) const { return Domains[static_cast<int32>(Domain)]; }
+
+    int32 Append(ESEProgressionDomain Domain, FName ID);
+
+    FDomain Domains[static_cast<int32>(ESEProgressionDomain::Num)];
+    TMap<TPair<FName, FName>, int32> SecretIndices;
+    bool bDataLoaded;
+};
+
+/**
+ * One bit per registered entry for each progression domain
+ */
+struct SHADOWECHOES_API FSEProgressionState
+{
+    bool Test(ESEProgressionDomain Domain, int32 Index) const
+    {
+        const TBitArray<>& DomainBits = Bits[static_cast<int32>(Domain)];
+        return Index >= 0 && Index < DomainBits.Num() && DomainBits[Index];
+    }
+
+    /** Returns true if the bit was not set before */
+    bool Set(ESEProgressionDomain Domain, int32 Index);
+
+    /** Set the bit of an ID, registering it if needed. Game thread only. */
+    bool SetID(ESEProgressionDomain Domain, FName ID)
+    {
+        return Set(Domain, FSEProgressionRegistry::Get().FindOrAdd(Domain, ID));
+    }
+
+    bool TestID(ESEProgressionDomain Domain, FName ID) const
+    {
+        return Test(Domain, FSEProgressionRegistry::Get().Find(Domain, ID));
+    }
+
+    const TBitArray<>& GetBits(ESEProgressionDomain Domain) const { return Bits[static_cast<int32>(Domain)]; }
+    TBitArray<>& GetBits(ESEProgressionDomain Domain) { return Bits[static_cast<int32>(Domain)]; }
+
+    int32 CountSet(ESEProgressionDomain Domain) const { return GetBits(Domain).CountSetBits(); }
+
+    /** Set IDs as names, for the legacy save formats. Game thread only. */
+    void GetSetIDs(ESEProgressionDomain Domain, TArray<FName>& OutIDs) const;
+    void SetIDs(ESEProgressionDomain Domain, const TArray<FName>& IDs);
+
+    /** Pin the registry ID lists so the state can be written on another thread */
+    void CaptureIDs();
+
+    /** Registry ID lists pinned by CaptureIDs */
+    TSharedPtr<const TArray<FName>, ESPMode::ThreadSafe> IDs[static_cast<int32>(ESEProgressionDomain::Num)];
+
+private:
+    TBitArray<> Bits[static_cast<int32>(ESEProgressionDomain::Num)];
+};
@@ -0,0 +1,81 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Economy/SEMarketSimulation.h"
+#include "Core/SETypes.h"
+#include "Economy/SETradeManager.h"
+
+FSEMarketStepResult FSEMarketSimulation::Step(const FSEMarketSnapshot& Snapshot)
+{
+    FRandomStream Random(Snapshot.Seed);
+    FSEMarketStepResult Result;
+
+    // Update each item's price
+    Result.ListingModifiers.SetNumUninitialized(Snapshot.Listings.Num());
+    for (int32 Index = 0; Index < Snapshot.Listings.Num(); ++Index)
+    {
+        Result.ListingModifiers[Index] = CalculatePriceModifier(Snapshot, Snapshot.Listings[Index], Random);
+    }
+
+    // Update supply and demand
+    Result.PriceModifiers = Snapshot.PriceModifiers;
+    for (int32 Index = 0; Index < Snapshot.Supply.Num(); ++Index)
+    {
+        const float SupplyRatio = Snapshot.Supply[Index] / 100.0f;  // Base value of 100 items
+        const float DemandRatio = Snapshot.Demand[Index] / 100.0f;
+
+        // Sold-out items count as maximum scarcity, unless nobody wants them either
+        float& Modifier = Result.PriceModifiers.FindOrAdd(ETradeItemType::Resource, 1.0f);
+        if (SupplyRatio > 0.0f)
+        {
+            Modifier = FMath::Clamp(DemandRatio / SupplyRatio, 0.5f, 2.0f);
+        }
+        else
+        {
+            Modifier = DemandRatio > 0.0f ? 2.0f : 1.0f;
+        }
+    }
+
+    // Calculate market trends from how much traded prices actually move
+    Result.MarketVolatility = Snapshot.MarketVolatility;
+    if (Snapshot.bHasTrades)
+    {
+        Result.MarketVolatility = FMath::Lerp(
+            Snapshot.MarketVolatility,
+            FMath::Clamp(Snapshot.TradeVolatility, 0.0f, 1.0f),
+            0.1f  // Smooth changes
+        );
+    }
+
+    return Result;
+}
+
+float FSEMarketSimulation::CalculatePriceModifier(const FSEMarketSnapshot& Snapshot, const FSEMarketListingInput& Listing, FRandomStream& Random)
+{
+    float Modifier = 1.0f;
+
+    // Apply supply/demand modifier
+    if (const float* TypeModifier = Snapshot.PriceModifiers.Find(Listing.Type))
+    {
+        Modifier *= *TypeModifier;
+    }
+
+    // Apply timeline influence
+    if (Snapshot.bHasTimeline && Listing.PreferredTimeline != ETimelineState::Any)
+    {
+        if (Snapshot.CurrentTimeline == Listing.PreferredTimeline)
+        {
+            Modifier *= 0.8f;  // 20% discount in preferred timeline
+        }
+        else
+        {
+            Modifier *= 1.2f;  // 20% markup in other timeline
+        }
+    }
+
+    // Apply market volatility
+    const float VolatilityEffect = Random.FRandRange(-Snapshot.MarketVolatility, Snapshot.MarketVolatility);
+    Modifier *= (1.0f + VolatilityEffect);
+
+    // Clamp final modifier
+    return FMath::Clamp(Modifier, 1.0f - Snapshot.MaxPriceFluctuation, 1.0f + Snapshot.MaxPriceFluctuation);
+}
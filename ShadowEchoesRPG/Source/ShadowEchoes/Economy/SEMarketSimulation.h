@@ -0,0 +1,73 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SEEntityID.h"
+
+enum class ETradeItemType : uint8;
+enum class ETimelineState : uint8;
+
+/** Stage of a market pass in progress */
+enum class ESEMarketPhase : uint8
+{
+    Idle,
+    Simulate,
+    Apply
+};
+
+/** What the price step needs from a listing */
+struct FSEMarketListingInput
+{
+    FSEEntityID ListingID;
+    ETradeItemType Type{};
+    ETimelineState PreferredTimeline{};
+};
+
+/** Game-thread copy of everything one market step reads */
+struct FSEMarketSnapshot
+{
+    TArray<FSEMarketListingInput> Listings;
+
+    /** Supply and demand per traded item, in the same order */
+    TArray<int32> Supply;
+    TArray<int32> Demand;
+
+    /** Market-wide EWMA volatility of trade prices, when anything has traded */
+    float TradeVolatility = 0.0f;
+    bool bHasTrades = false;
+
+    TMap<ETradeItemType, float> PriceModifiers;
+    float MarketVolatility = 0.0f;
+    float MaxPriceFluctuation = 0.5f;
+
+    ETimelineState CurrentTimeline{};
+    bool bHasTimeline = false;
+
+    /** Seeds the volatility noise so a snapshot always steps to the same result */
+    int32 Seed = 0;
+};
+
+/** New market values, applied back on the game thread */
+struct FSEMarketStepResult
+{
+    /** Price modifier per snapshot listing, in snapshot order */
+    TArray<float> ListingModifiers;
+
+    TMap<ETradeItemType, float> PriceModifiers;
+    float MarketVolatility = 0.0f;
+};
+
+/**
+ * Pure market step
+ *
+ * Reads only the snapshot, so it can run on a worker while the game thread keeps trading.
+ * All randomness comes from the snapshot seed.
+ */
+class SHADOWECHOES_API FSEMarketSimulation
+{
+public:
+    static FSEMarketStepResult Step(const FSEMarketSnapshot& Snapshot);
+
+    static float CalculatePriceModifier(const FSEMarketSnapshot& Snapshot, const FSEMarketListingInput& Listing, FRandomStream& Random);
+};
@@ -0,0 +1,257 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Economy/SEPriceHistory.h"
+#include "Economy/SETradeManager.h"
+
+void FSEPriceCandle::AddTrade(float Price, int32 Quantity)
+{
+    if (Volume == 0)
+    {
+        Open = High = Low = Price;
+    }
+    else
+    {
+        High = FMath::Max(High, Price);
+        Low = FMath::Min(Low, Price);
+    }
+    Close = Price;
+    Volume += Quantity;
+}
+
+FSECandleRing::FSECandleRing(int32 InCapacity)
+    : Newest(INDEX_NONE)
+    , Count(0)
+{
+    Candles.SetNum(InCapacity);
+}
+
+void FSECandleRing::AddTrade(int64 BucketStart, float Price, int32 Quantity)
+{
+    if (Count == 0 || Candles[Newest].StartTime != BucketStart)
+    {
+        // Overwrites the oldest candle once the ring is full
+        Newest = (Newest + 1) % Candles.Num();
+        Count = FMath::Min(Count + 1, Candles.Num());
+        Candles[Newest] = FSEPriceCandle();
+        Candles[Newest].StartTime = BucketStart;
+    }
+
+    Candles[Newest].AddTrade(Price, FMath::Max(Quantity, 0));
+}
+
+const FSEPriceCandle& FSECandleRing::GetFromNewest(int32 Age) const
+{
+    check(Age >= 0 && Age < Count);
+    return Candles[(Newest - Age + Candles.Num()) % Candles.Num()];
+}
+
+void FSECandleRing::Serialize(FArchive& Ar)
+{
+    int32 NumCandles = Count;
+    Ar << NumCandles;
+
+    if (Ar.IsLoading())
+    {
+        const int32 Capacity = Candles.Num();
+        Candles.Reset();
+        Candles.SetNum(Capacity);
+        Newest = INDEX_NONE;
+        Count = 0;
+
+        for (int32 Index = 0; Index < NumCandles && !Ar.IsError(); ++Index)
+        {
+            FSEPriceCandle Candle;
+            Ar << Candle;
+            Newest = (Newest + 1) % Capacity;
+            Count = FMath::Min(Count + 1, Capacity);
+            Candles[Newest] = Candle;
+        }
+        return;
+    }
+
+    for (int32 Age = Count - 1; Age >= 0; --Age)
+    {
+        FSEPriceCandle Candle = GetFromNewest(Age);
+        Ar << Candle;
+    }
+}
+
+void FSEEwmaVolatility::AddReturn(float LogReturn, float Lambda)
+{
+    // The first return seeds the variance instead of being damped toward zero
+    const float Squared = LogReturn * LogReturn;
+    Variance = Samples == 0 ? Squared : Lambda * Variance + (1.0f - Lambda) * Squared;
+    ++Samples;
+}
+
+FSEPriceHistory::FItemSeries::FItemSeries()
+    : Rings{ FSECandleRing(MinuteCandles), FSECandleRing(HourCandles), FSECandleRing(DayCandles) }
+{
+}
+
+int64 FSEPriceHistory::GetBucketSeconds(ESEPriceResolution Resolution)
+{
+    switch (Resolution)
+    {
+        case ESEPriceResolution::Minute:
+            return 60;
+
+        case ESEPriceResolution::Hour:
+            return 3600;
+
+        default:
+            return 86400;
+    }
+}
+
+void FSEPriceHistory::RecordTrade(const FString& ItemID, ETradeItemType Type, float Price, int32 Quantity, int64 UnixTime)
+{
+    if (Price <= 0.0f)
+    {
+        return;
+    }
+
+    FItemSeries& Series = Items.FindOrAdd(ItemID);
+
+    for (int32 Index = 0; Index < static_cast<int32>(ESEPriceResolution::Num); ++Index)
+    {
+        const int64 BucketSeconds = GetBucketSeconds(static_cast<ESEPriceResolution>(Index));
+        Series.Rings[Index].AddTrade(UnixTime - UnixTime % BucketSeconds, Price, Quantity);
+    }
+
+    if (Series.LastPrice > 0.0f)
+    {
+        const float LogReturn = FMath::Loge(Price / Series.LastPrice);
+        Series.Volatility.AddReturn(LogReturn, VolatilityLambda);
+        TypeVolatility.FindOrAdd(Type).AddReturn(LogReturn, VolatilityLambda);
+        MarketVolatility.AddReturn(LogReturn, VolatilityLambda);
+    }
+    Series.LastPrice = Price;
+}
+
+void FSEPriceHistory::GetCandles(const FString& ItemID, ESEPriceResolution Resolution, int32 MaxCount, TArray<FSEPriceCandle>& OutCandles) const
+{
+    OutCandles.Reset();
+
+    const FItemSeries* Series = Items.Find(ItemID);
+    if (!Series)
+    {
+        return;
+    }
+
+    const FSECandleRing& Ring = Series->Rings[static_cast<int32>(Resolution)];
+    const int32 Count = FMath::Clamp(MaxCount, 0, Ring.Num());
+    OutCandles.Reserve(Count);
+    for (int32 Age = Count - 1; Age >= 0; --Age)
+    {
+        OutCandles.Add(Ring.GetFromNewest(Age));
+    }
+}
+
+const FSEPriceCandle* FSEPriceHistory::GetLatestCandle(const FString& ItemID, ESEPriceResolution Resolution) const
+{
+    const FItemSeries* Series = Items.Find(ItemID);
+    if (!Series)
+    {
+        return nullptr;
+    }
+
+    const FSECandleRing& Ring = Series->Rings[static_cast<int32>(Resolution)];
+    return Ring.Num() > 0 ? &Ring.GetFromNewest(0) : nullptr;
+}
+
+float FSEPriceHistory::GetTrend(const FString& ItemID, ESEPriceResolution Resolution, int32 Periods) const
+{
+    const FItemSeries* Series = Items.Find(ItemID);
+    if (!Series || Periods <= 0)
+    {
+        return 0.0f;
+    }
+
+    const FSECandleRing& Ring = Series->Rings[static_cast<int32>(Resolution)];
+    if (Ring.Num() <= Periods)
+    {
+        return 0.0f;
+    }
+
+    const float Then = Ring.GetFromNewest(Periods).Close;
+    return Then > 0.0f ? Ring.GetFromNewest(0).Close / Then - 1.0f : 0.0f;
+}
+
+float FSEPriceHistory::GetItemVolatility(const FString& ItemID) const
+{
+    const FItemSeries* Series = Items.Find(ItemID);
+    return Series ? Series->Volatility.Get() : 0.0f;
+}
+
+float FSEPriceHistory::GetTypeVolatility(ETradeItemType Type) const
+{
+    const FSEEwmaVolatility* Volatility = TypeVolatility.Find(Type);
+    return Volatility ? Volatility->Get() : 0.0f;
+}
+
+void FSEPriceHistory::Reset()
+{
+    Items.Reset();
+    TypeVolatility.Reset();
+    MarketVolatility = FSEEwmaVolatility();
+}
+
+void FSEPriceHistory::Serialize(FArchive& Ar)
+{
+    int32 NumSeries = Items.Num();
+    Ar << NumSeries;
+
+    if (Ar.IsLoading())
+    {
+        Reset();
+        for (int32 Index = 0; Index < NumSeries && !Ar.IsError(); ++Index)
+        {
+            FString ItemID;
+            Ar << ItemID;
+            FItemSeries& Series = Items.FindOrAdd(ItemID);
+            for (FSECandleRing& Ring : Series.Rings)
+            {
+                Ring.Serialize(Ar);
+            }
+            Ar << Series.Volatility << Series.LastPrice;
+        }
+    }
+    else
+    {
+        for (auto& Pair : Items)
+        {
+            FString ItemID = Pair.Key;
+            Ar << ItemID;
+            for (FSECandleRing& Ring : Pair.Value.Rings)
+            {
+                Ring.Serialize(Ar);
+            }
+            Ar << Pair.Value.Volatility << Pair.Value.LastPrice;
+        }
+    }
+
+    // Item types are stored as bytes
+    int32 NumTypes = TypeVolatility.Num();
+    Ar << NumTypes;
+    if (Ar.IsLoading())
+    {
+        for (int32 Index = 0; Index < NumTypes && !Ar.IsError(); ++Index)
+        {
+            uint8 Type = 0;
+            FSEEwmaVolatility Volatility;
+            Ar << Type << Volatility;
+            TypeVolatility.Add(static_cast<ETradeItemType>(Type), Volatility);
+        }
+    }
+    else
+    {
+        for (auto& Pair : TypeVolatility)
+        {
+            uint8 Type = static_cast<uint8>(Pair.Key);
+            Ar << Type << Pair.Value;
+        }
+    }
+
+    Ar << MarketVolatility;
+}
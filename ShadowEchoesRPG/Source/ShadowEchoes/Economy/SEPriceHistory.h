@@ -0,0 +1,160 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SEPriceHistory.generated.h"
+
+enum class ETradeItemType : uint8;
+
+/** Candle width of a price series */
+UENUM(BlueprintType)
+enum class ESEPriceResolution : uint8
+{
+    Minute      UMETA(DisplayName = "1 Minute"),
+    Hour        UMETA(DisplayName = "1 Hour"),
+    Day         UMETA(DisplayName = "1 Day"),
+    Num         UMETA(Hidden)
+};
+
+/** Open, high, low, close and volume of the trades in one time bucket */
+USTRUCT(BlueprintType)
+struct FSEPriceCandle
+{
+    GENERATED_BODY()
+
+    /** Unix seconds at the start of the bucket */
+    UPROPERTY(BlueprintReadOnly, Category = "Trade")
+    int64 StartTime;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Trade")
+    float Open;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Trade")
+    float High;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Trade")
+    float Low;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Trade")
+    float Close;
+
+    /** Units traded */
+    UPROPERTY(BlueprintReadOnly, Category = "Trade")
+    int32 Volume;
+
+    FSEPriceCandle()
+        : StartTime(0)
+        , Open(0.0f)
+        , High(0.0f)
+        , Low(0.0f)
+        , Close(0.0f)
+        , Volume(0)
+    {
+    }
+
+    void AddTrade(float Price, int32 Quantity);
+
+    friend FArchive& operator<<(FArchive& Ar, FSEPriceCandle& Candle)
+    {
+        Ar << Candle.StartTime << Candle.Open << Candle.High << Candle.Low << Candle.Close << Candle.Volume;
+        return Ar;
+    }
+};
+
+/** Fixed-capacity ring of candles, newest last; buckets without trades are skipped */
+class SHADOWECHOES_API FSECandleRing
+{
+public:
+    explicit FSECandleRing(int32 InCapacity = 0);
+
+    /** Fold a trade into the open candle, starting a new one when the bucket changes */
+    void AddTrade(int64 BucketStart, float Price, int32 Quantity);
+
+    int32 Num() const { return Count; }
+    int32 GetCapacity() const { return Candles.Num(); }
+
+    /** 0 is the newest candle */
+    const FSEPriceCandle& GetFromNewest(int32 Age) const;
+
+    /** Candles are stored oldest first, so loading into a smaller ring keeps the newest */
+    void Serialize(FArchive& Ar);
+
+private:
+    TArray<FSEPriceCandle> Candles;
+    int32 Newest;
+    int32 Count;
+};
+
+/** Incremental exponentially weighted volatility of log returns */
+struct FSEEwmaVolatility
+{
+    float Variance = 0.0f;
+    int32 Samples = 0;
+
+    void AddReturn(float LogReturn, float Lambda);
+    float Get() const { return FMath::Sqrt(Variance); }
+
+    friend FArchive& operator<<(FArchive& Ar, FSEEwmaVolatility& Volatility)
+    {
+        Ar << Volatility.Variance << Volatility.Samples;
+        return Ar;
+    }
+};
+
+/**
+ * Fixed-memory price history per traded item
+ *
+ * Every trade folds into the open candle at each resolution, so the hourly and daily rings
+ * are downsampled as they are written and never need a rebuild. Rings have a fixed capacity
+ * per resolution, and volatility is an EWMA of trade-to-trade log returns kept per item, per
+ * item type and across the market. Recording a trade, the latest candle and volatility are
+ * constant time; a chart costs the candles returned.
+ */
+class SHADOWECHOES_API FSEPriceHistory
+{
+public:
+    /** Candles kept per resolution: two hours of minutes, two days of hours, a month of days */
+    static constexpr int32 MinuteCandles = 120;
+    static constexpr int32 HourCandles = 48;
+    static constexpr int32 DayCandles = 30;
+
+    /** RiskMetrics decay; higher reacts more slowly */
+    static constexpr float VolatilityLambda = 0.94f;
+
+    void RecordTrade(const FString& ItemID, ETradeItemType Type, float Price, int32 Quantity, int64 UnixTime);
+
+    /** Up to MaxCount candles, oldest first */
+    void GetCandles(const FString& ItemID, ESEPriceResolution Resolution, int32 MaxCount, TArray<FSEPriceCandle>& OutCandles) const;
+    const FSEPriceCandle* GetLatestCandle(const FString& ItemID, ESEPriceResolution Resolution) const;
+
+    /** Relative close-to-close change over the last Periods candles; 0 without enough history */
+    float GetTrend(const FString& ItemID, ESEPriceResolution Resolution, int32 Periods) const;
+
+    float GetItemVolatility(const FString& ItemID) const;
+    float GetTypeVolatility(ETradeItemType Type) const;
+    float GetMarketVolatility() const { return MarketVolatility.Get(); }
+    bool HasTrades() const { return MarketVolatility.Samples > 0; }
+
+    int32 NumItems() const { return Items.Num(); }
+    void Reset();
+
+    /** Every series and volatility, for checkpoints; loading replaces the current history */
+    void Serialize(FArchive& Ar);
+
+    static int64 GetBucketSeconds(ESEPriceResolution Resolution);
+
+private:
+    struct FItemSeries
+    {
+        FSECandleRing Rings[static_cast<int32>(ESEPriceResolution::Num)];
+        FSEEwmaVolatility Volatility;
+        float LastPrice = 0.0f;
+
+        FItemSeries();
+    };
+
+    TMap<FString, FItemSeries> Items;
+    TMap<ETradeItemType, FSEEwmaVolatility> TypeVolatility;
+    FSEEwmaVolatility MarketVolatility;
+};
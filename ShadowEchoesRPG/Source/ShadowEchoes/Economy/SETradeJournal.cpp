@@ -0,0 +1,452 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Economy/SETradeJournal.h"
+#include "Core/SETypes.h"
+#include "SaveGame/SESaveGamePipeline.h"
+#include "ShadowEchoes.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SETradeJournalFile
+{
+    /** Each group: uint32 payload size, uint32 payload CRC, payload */
+    static const int32 BatchHeaderSize = 8;
+    static const TCHAR* Extension = TEXT(".journal");
+
+    /** A lone retry waits longer than the commit window */
+    static constexpr double RetryWindowSeconds = 1.0;
+
+    /** Checkpoint header: magic, version, first journal generation, last included sequence */
+    static const uint32 CheckpointMagic = 0x53455443; // 'SETC'
+    static const uint32 CheckpointVersion = 3;
+
+    /** Reads a checkpoint file; outputs are untouched if it is missing or unreadable */
+    static bool LoadCheckpoint(const FString& Path, TArray<uint8>& OutPayload, uint32& OutFirstGeneration, uint64& OutSequence)
+    {
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+        {
+            return false;
+        }
+
+        FMemoryReader Reader(Bytes);
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        uint32 FirstGeneration = 0;
+        uint64 Sequence = 0;
+        Reader << Magic << Version << FirstGeneration << Sequence;
+        if (Reader.IsError() || Magic != CheckpointMagic || Version != CheckpointVersion)
+        {
+            return false;
+        }
+
+        OutPayload.Reset();
+        OutPayload.Append(Bytes.GetData() + Reader.Tell(), Bytes.Num() - Reader.Tell());
+        OutFirstGeneration = FirstGeneration;
+        OutSequence = Sequence;
+        return true;
+    }
+}
+
+FSETradeJournal::FSETradeJournal(const FString& InName, float InGroupCommitMs)
+    : Name(InName)
+    , Generation(0)
+    , NextSequence(1)
+    , GroupCommitSeconds(InGroupCommitMs * 0.001)
+    , LastCommitTime(0.0)
+    , NumPendingRecords(0)
+    , WriterState(MakeShared<FWriterState, ESPMode::ThreadSafe>())
+{
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(GetCheckpointPath()), true);
+}
+
+FSETradeJournal::~FSETradeJournal()
+{
+    CommitBlocking();
+
+    if (HasFailedWrites())
+    {
+        SE_LOG_ERROR(TEXT("Trade journal %s closed with %d bytes that could not be written"), *Name, WriterState->RetryFrames.Num());
+    }
+}
+
+FString FSETradeJournal::GetJournalPrefix() const
+{
+    return Name + SETradeJournalFile::Extension;
+}
+
+FString FSETradeJournal::GetJournalPath(uint32 InGeneration) const
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Trade"), GetJournalPrefix() + LexToString(InGeneration));
+}
+
+FString FSETradeJournal::GetCheckpointPath() const
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Trade"), Name + TEXT(".checkpoint"));
+}
+
+void FSETradeJournal::SerializeListing(FArchive& Ar, FMarketItem& Item)
+{
+    uint8 Type = static_cast<uint8>(Item.Type);
+    uint8 PreferredTimeline = static_cast<uint8>(Item.PreferredTimeline);
+    Ar << Item.ItemID << Item.ListingID << Item.SellerID << Type << Item.Quantity << Item.BasePrice << Item.CurrentPriceModifier;
+    Ar << PreferredTimeline << Item.bIsAuction << Item.EndTime << Item.Bids;
+
+    if (Ar.IsLoading())
+    {
+        Item.Type = static_cast<ETradeItemType>(Type);
+        Item.PreferredTimeline = static_cast<ETimelineState>(PreferredTimeline);
+    }
+}
+
+uint64 FSETradeJournal::BeginRecord(ESETradeJournalRecord Type, const FSEEntityID& ListingID)
+{
+    check(IsInGameThread());
+
+    uint64 Sequence = NextSequence++;
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    uint8 TypeByte = static_cast<uint8>(Type);
+    FSEEntityID ID = ListingID;
+    Writer << TypeByte << Sequence << ID;
+
+    ++NumPendingRecords;
+    return Sequence;
+}
+
+uint64 FSETradeJournal::AppendList(const FSEEntityID& ListingID, const FMarketItem& Item)
+{
+    const uint64 Sequence = BeginRecord(ESETradeJournalRecord::List, ListingID);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    FMarketItem Listing = Item;
+    SerializeListing(Writer, Listing);
+    return Sequence;
+}
+
+uint64 FSETradeJournal::AppendBid(const FSEEntityID& ListingID, const FSEEntityID& BidderID, int32 Amount)
+{
+    const uint64 Sequence = BeginRecord(ESETradeJournalRecord::Bid, ListingID);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    FSEEntityID Bidder = BidderID;
+    Writer << Bidder << Amount;
+    return Sequence;
+}
+
+uint64 FSETradeJournal::AppendBuy(const FSEEntityID& ListingID, const FSEEntityID& BuyerID, float Price, int64 Time)
+{
+    const uint64 Sequence = BeginRecord(ESETradeJournalRecord::Buy, ListingID);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    FSEEntityID Buyer = BuyerID;
+    Writer << Buyer << Price << Time;
+    return Sequence;
+}
+
+uint64 FSETradeJournal::AppendExpire(const FSEEntityID& ListingID, const FSEEntityID& WinnerID)
+{
+    const uint64 Sequence = BeginRecord(ESETradeJournalRecord::Expire, ListingID);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    FSEEntityID Winner = WinnerID;
+    Writer << Winner;
+    return Sequence;
+}
+
+bool FSETradeJournal::CommitIfDue()
+{
+    const bool bRetryOnly = PendingBatch.Num() == 0;
+    if (bRetryOnly && !HasFailedWrites())
+    {
+        return false;
+    }
+
+    // While an fsync is in flight the group keeps growing, which is what makes commits cheap
+    const double Window = bRetryOnly ? SETradeJournalFile::RetryWindowSeconds : GroupCommitSeconds;
+    if (FPlatformTime::Seconds() - LastCommitTime < Window || !LastTask.IsCompleted())
+    {
+        return false;
+    }
+
+    Commit();
+    return true;
+}
+
+void FSETradeJournal::Commit()
+{
+    check(IsInGameThread());
+
+    if (PendingBatch.Num() == 0 && !HasFailedWrites())
+    {
+        return;
+    }
+
+    // Frame the group so a partially written tail is detected on replay
+    TArray<uint8> Framed;
+    if (PendingBatch.Num() > 0)
+    {
+        Framed.Reserve(SETradeJournalFile::BatchHeaderSize + PendingBatch.Num());
+        FMemoryWriter Writer(Framed);
+        uint32 PayloadSize = PendingBatch.Num();
+        uint32 PayloadCrc = FCrc::MemCrc32(PendingBatch.GetData(), PendingBatch.Num());
+        Writer << PayloadSize << PayloadCrc;
+        Writer.Serialize(PendingBatch.GetData(), PendingBatch.Num());
+    }
+
+    PendingBatch.Reset();
+    NumPendingRecords = 0;
+    LastCommitTime = FPlatformTime::Seconds();
+
+    const FString Path = GetJournalPath(Generation);
+    const uint32 FileGeneration = Generation;
+    const uint64 GroupSequence = GetLastSequence();
+    LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [State = WriterState, Path, FileGeneration, GroupSequence, Framed = MoveTemp(Framed)]() mutable
+    {
+        // A failed group goes first so records stay in sequence order; until it is written
+        // DurableSequence stays put
+        TArray<uint8> Frames = MoveTemp(State->RetryFrames);
+        Frames.Append(MoveTemp(Framed));
+
+        if (!State->File || State->FileGeneration != FileGeneration)
+        {
+            State->File.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true, false));
+            State->FileGeneration = FileGeneration;
+        }
+
+        // One fsync covers every record in the group
+        const int64 Start = State->File ? State->File->Tell() : 0;
+        if (!State->File || !State->File->Write(Frames.GetData(), Frames.Num()) || !State->File->Flush(true))
+        {
+            SE_LOG_ERROR(TEXT("Failed to append trade journal %s; retrying with the next group"), *Path);
+
+            // Cut off a partial append, or replay would stop at it and lose the retried groups
+            if (State->File && !State->File->Truncate(Start))
+            {
+                SE_LOG_ERROR(TEXT("Failed to truncate trade journal %s"), *Path);
+            }
+            State->File.Reset();
+            State->RetryFrames = MoveTemp(Frames);
+            State->bRetryPending.store(true, std::memory_order_release);
+            return;
+        }
+
+        State->bRetryPending.store(false, std::memory_order_release);
+        State->DurableSequence.store(GroupSequence, std::memory_order_release);
+    }, UE::Tasks::Prerequisites(LastTask));
+}
+
+void FSETradeJournal::CommitBlocking()
+{
+    Commit();
+    LastTask.Wait();
+}
+
+void FSETradeJournal::Checkpoint(TArray<uint8>&& Payload)
+{
+    // Records up to here are in the payload; later ones go to the next generation
+    Commit();
+    const uint64 CheckpointSequence = GetLastSequence();
+    ++Generation;
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    uint32 Magic = SETradeJournalFile::CheckpointMagic;
+    uint32 Version = SETradeJournalFile::CheckpointVersion;
+    uint32 FirstGeneration = Generation;
+    uint64 Sequence = CheckpointSequence;
+    Writer << Magic << Version << FirstGeneration << Sequence;
+    Writer.Serialize(Payload.GetData(), Payload.Num());
+
+    const FString CheckpointPath = GetCheckpointPath();
+    const FString Directory = FPaths::GetPath(CheckpointPath);
+    const FString Prefix = GetJournalPrefix();
+
+    // Ordered after pending appends so a journal is never deleted before its checkpoint is written
+    LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [State = WriterState, CheckpointPath, Directory, Prefix, FirstGeneration, CheckpointSequence, Bytes = MoveTemp(Bytes)]()
+    {
+        // Returns once the checkpoint and the directory entry publishing it are both fsynced
+        if (!FSESaveGamePipeline::WriteFileAtomic(CheckpointPath, Bytes))
+        {
+            SE_LOG_ERROR(TEXT("Failed to write trade checkpoint %s"), *CheckpointPath);
+            return;
+        }
+
+        State->File.Reset();
+
+        // The checkpoint holds every record up to it, including any group that failed to write
+        State->RetryFrames.Reset();
+        State->bRetryPending.store(false, std::memory_order_release);
+        State->DurableSequence.store(CheckpointSequence, std::memory_order_release);
+
+        // The replaced checkpoint is now the backup, so only journals below its generation can go
+        const uint32 BackupGeneration = State->CheckpointGeneration;
+        State->CheckpointGeneration = FirstGeneration;
+
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, Prefix + TEXT("*")), true, false);
+        for (const FString& File : Files)
+        {
+            uint32 FileGeneration = 0;
+            LexFromString(FileGeneration, *File.RightChop(Prefix.Len()));
+            if (FileGeneration < BackupGeneration)
+            {
+                IFileManager::Get().Delete(*FPaths::Combine(Directory, File), false, false, true);
+            }
+        }
+    }, UE::Tasks::Prerequisites(LastTask));
+}
+
+bool FSETradeJournal::DecodeEntry(FArchive& Reader, FSETradeJournalEntry& OutEntry)
+{
+    uint8 Type = 0;
+    Reader << Type << OutEntry.Sequence << OutEntry.ListingID;
+    OutEntry.Type = static_cast<ESETradeJournalRecord>(Type);
+
+    switch (OutEntry.Type)
+    {
+        case ESETradeJournalRecord::List:
+            SerializeListing(Reader, OutEntry.Item);
+            break;
+
+        case ESETradeJournalRecord::Bid:
+            Reader << OutEntry.ActorID << OutEntry.Amount;
+            break;
+
+        case ESETradeJournalRecord::Buy:
+            Reader << OutEntry.ActorID << OutEntry.Price << OutEntry.Time;
+            break;
+
+        case ESETradeJournalRecord::Expire:
+            Reader << OutEntry.ActorID;
+            break;
+
+        default:
+            SE_LOG_WARNING(TEXT("Unknown trade journal record type %d"), Type);
+            return false;
+    }
+
+    return !Reader.IsError();
+}
+
+int32 FSETradeJournal::Recover(TArray<uint8>& OutCheckpoint, TFunctionRef<void(const FSETradeJournalEntry&)> Apply)
+{
+    LastTask.Wait();
+    WriterState->File.Reset();
+    OutCheckpoint.Reset();
+
+    uint32 FirstGeneration = 0;
+    uint64 CheckpointSequence = 0;
+
+    const FString CheckpointPath = GetCheckpointPath();
+    const FString BackupPath = CheckpointPath + TEXT(".bak");
+    if (!SETradeJournalFile::LoadCheckpoint(CheckpointPath, OutCheckpoint, FirstGeneration, CheckpointSequence))
+    {
+        // A checkpoint lost mid-write falls back to the backup, whose journals are still on disk
+        if (SETradeJournalFile::LoadCheckpoint(BackupPath, OutCheckpoint, FirstGeneration, CheckpointSequence))
+        {
+            SE_LOG_WARNING(TEXT("Trade checkpoint %s is unreadable; recovered from its backup"), *CheckpointPath);
+        }
+        else if (IFileManager::Get().FileExists(*CheckpointPath) || IFileManager::Get().FileExists(*BackupPath))
+        {
+            SE_LOG_ERROR(TEXT("Trade checkpoint %s is unreadable; replaying journals only"), *CheckpointPath);
+        }
+    }
+    WriterState->CheckpointGeneration = FirstGeneration;
+
+    const FString Directory = FPaths::GetPath(GetCheckpointPath());
+    const FString Prefix = GetJournalPrefix();
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, Prefix + TEXT("*")), true, false);
+
+    TArray<uint32> Generations;
+    for (const FString& File : Files)
+    {
+        uint32 FileGeneration = 0;
+        LexFromString(FileGeneration, *File.RightChop(Prefix.Len()));
+        if (FileGeneration >= FirstGeneration)
+        {
+            Generations.Add(FileGeneration);
+        }
+    }
+    Generations.Sort();
+
+    uint64 LastSequence = CheckpointSequence;
+    int32 NumReplayed = 0;
+    for (const uint32 FileGeneration : Generations)
+    {
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *GetJournalPath(FileGeneration), FILEREAD_Silent))
+        {
+            continue;
+        }
+
+        int32 Offset = 0;
+        while (Offset + SETradeJournalFile::BatchHeaderSize <= Bytes.Num())
+        {
+            uint32 PayloadSize = 0;
+            uint32 PayloadCrc = 0;
+            FMemoryReader Reader(Bytes);
+            Reader.Seek(Offset);
+            Reader << PayloadSize << PayloadCrc;
+
+            const int32 PayloadOffset = Offset + SETradeJournalFile::BatchHeaderSize;
+            if (PayloadOffset + static_cast<int64>(PayloadSize) > Bytes.Num() ||
+                FCrc::MemCrc32(Bytes.GetData() + PayloadOffset, PayloadSize) != PayloadCrc)
+            {
+                // Torn tail from a crash mid-append; those trades were never acknowledged
+                SE_LOG_WARNING(TEXT("Trade journal generation %u truncated at byte %d"), FileGeneration, Offset);
+                break;
+            }
+
+            Reader.Seek(PayloadOffset);
+            while (Reader.Tell() < PayloadOffset + static_cast<int64>(PayloadSize))
+            {
+                FSETradeJournalEntry Entry;
+                if (!DecodeEntry(Reader, Entry))
+                {
+                    break;
+                }
+
+                // Records already folded into the checkpoint
+                if (Entry.Sequence > CheckpointSequence)
+                {
+                    Apply(Entry);
+                    LastSequence = FMath::Max(LastSequence, Entry.Sequence);
+                    ++NumReplayed;
+                }
+            }
+            Offset = PayloadOffset + PayloadSize;
+        }
+    }
+
+    // Continue in a fresh generation above anything on disk
+    Generation = FirstGeneration;
+    if (Generations.Num() > 0)
+    {
+        Generation = FMath::Max(Generation, Generations.Last() + 1);
+    }
+    NextSequence = LastSequence + 1;
+    WriterState->DurableSequence.store(LastSequence, std::memory_order_release);
+
+    return NumReplayed;
+}
+
+void FSETradeJournal::DeleteFiles()
+{
+    LastTask.Wait();
+    WriterState->File.Reset();
+
+    const FString Directory = FPaths::GetPath(GetCheckpointPath());
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, Name + TEXT(".*")), true, false);
+    for (const FString& File : Files)
+    {
+        IFileManager::Get().Delete(*FPaths::Combine(Directory, File), false, false, true);
+    }
+}
@@ -0,0 +1,139 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Tasks/Task.h"
+#include "Economy/SETradeManager.h"
+#include <atomic>
+
+/** Record types stored in the trade journal */
+enum class ESETradeJournalRecord : uint8
+{
+    List    = 1,
+    Bid     = 2,
+    Buy     = 3,
+    Expire  = 4
+};
+
+/** One decoded trade record */
+struct FSETradeJournalEntry
+{
+    ESETradeJournalRecord Type = ESETradeJournalRecord::List;
+    uint64 Sequence = 0;
+    FSEEntityID ListingID;
+
+    /** Seller, bidder, buyer or auction winner; empty when an auction ends without bids */
+    FSEEntityID ActorID;
+
+    /** Bid amount */
+    int32 Amount = 0;
+
+    /** Exact sale price, so replayed trades chart as they were recorded */
+    float Price = 0.0f;
+
+    /** Unix seconds of a sale */
+    int64 Time = 0;
+
+    /** The new listing of a List record */
+    FMarketItem Item;
+};
+
+/**
+ * Write-ahead log of trade transactions with group commit
+ *
+ * Trades append compact binary records to an in-memory group on the game thread, each with
+ * a sequence number. A group is committed once the commit window has passed and the previous
+ * commit has finished: it is framed with size and CRC, appended by a serial background task
+ * and made durable with a single fsync, after which GetDurableSequence covers every record in
+ * it. A group that fails to write is truncated off the file and retried ahead of the next one,
+ * so the durable sequence never covers a record that is not on disk. Checkpoints store the order book together with the last sequence they include and rotate
+ * to a new journal generation. Once the checkpoint and its directory are fsynced, the previous
+ * checkpoint is the backup and only generations below the backup's are deleted. Recovery loads
+ * the checkpoint, or the backup if it is unreadable, and replays every later record, ignoring
+ * a torn tail.
+ */
+class SHADOWECHOES_API FSETradeJournal
+{
+public:
+    explicit FSETradeJournal(const FString& InName, float InGroupCommitMs = 5.0f);
+    ~FSETradeJournal();
+
+    /** Appending, game thread only; each returns the record's sequence number */
+    uint64 AppendList(const FSEEntityID& ListingID, const FMarketItem& Item);
+    uint64 AppendBid(const FSEEntityID& ListingID, const FSEEntityID& BidderID, int32 Amount);
+    uint64 AppendBuy(const FSEEntityID& ListingID, const FSEEntityID& BuyerID, float Price, int64 Time);
+    uint64 AppendExpire(const FSEEntityID& ListingID, const FSEEntityID& WinnerID);
+
+    /** Commit the pending group if the window has passed and no commit is in flight */
+    bool CommitIfDue();
+
+    /** Commit the pending group now */
+    void Commit();
+
+    /** Commit and wait until everything appended is durable */
+    void CommitBlocking();
+
+    /** Highest sequence number that is on disk and fsynced */
+    uint64 GetDurableSequence() const { return WriterState->DurableSequence.load(std::memory_order_acquire); }
+    uint64 GetLastSequence() const { return NextSequence - 1; }
+
+    /** True while a group that failed to write waits to be written again */
+    bool HasFailedWrites() const { return WriterState->bRetryPending.load(std::memory_order_acquire); }
+
+    int32 GetNumPendingRecords() const { return NumPendingRecords; }
+    uint32 GetGeneration() const { return Generation; }
+
+    /** Store Payload as a checkpoint that covers every record appended so far */
+    void Checkpoint(TArray<uint8>&& Payload);
+
+    /**
+     * Load the latest checkpoint into OutCheckpoint (empty if none) and pass every later record
+     * to Apply in order; returns the number of records replayed
+     */
+    int32 Recover(TArray<uint8>& OutCheckpoint, TFunctionRef<void(const FSETradeJournalEntry&)> Apply);
+
+    /** Delete the journal and checkpoint files */
+    void DeleteFiles();
+
+    /** Listing fields shared by List records and order book checkpoints */
+    static void SerializeListing(FArchive& Ar, FMarketItem& Item);
+
+private:
+    struct FWriterState
+    {
+        TUniquePtr<IFileHandle> File;
+        uint32 FileGeneration = 0;
+        std::atomic<uint64> DurableSequence{ 0 };
+
+        /** Framed groups that failed to write, oldest first */
+        TArray<uint8> RetryFrames;
+        std::atomic<bool> bRetryPending{ false };
+
+        /** First generation of the checkpoint on disk */
+        uint32 CheckpointGeneration = 0;
+    };
+
+    FString GetJournalPath(uint32 InGeneration) const;
+    FString GetCheckpointPath() const;
+    FString GetJournalPrefix() const;
+    uint64 BeginRecord(ESETradeJournalRecord Type, const FSEEntityID& ListingID);
+    static bool DecodeEntry(FArchive& Reader, FSETradeJournalEntry& OutEntry);
+
+    FString Name;
+    uint32 Generation;
+    uint64 NextSequence;
+    double GroupCommitSeconds;
+    double LastCommitTime;
+
+    /** Pending group */
+    TArray<uint8> PendingBatch;
+    int32 NumPendingRecords;
+
+    /** Owned by the serial commit tasks */
+    TSharedRef<FWriterState, ESPMode::ThreadSafe> WriterState;
+
+    /** Last background task; every journal task depends on the previous one */
+    UE::Tasks::FTask LastTask;
+};
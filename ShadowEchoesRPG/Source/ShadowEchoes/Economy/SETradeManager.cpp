@@ -2,14 +2,29 @@
 
 #include "Economy/SETradeManager.h"
 #include "Core/SEGameInstance.h"
+#include "Economy/SETradeJournal.h"
 #include "Systems/TimelineManager.h"
 #include "Engine/DataTable.h"
-#include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Systems/SEJobScheduler.h"
+#include "UI/Core/SENotificationPipeline.h"
 
 USETradeManager::USETradeManager()
     : MarketUpdateInterval(300.0f)  // 5 minutes
+    , AuctionCheckInterval(60.0f)   // 1 minute
     , AuctionDuration(86400.0f)     // 24 hours
     , MaxPriceFluctuation(0.5f)     // 50% max price change
+    , GroupCommitMs(5.0f)
+    , CheckpointInterval(600.0f)    // 10 minutes
+    , MarketRepriceDelay(5.0f)
+    , MarketPhase(ESEMarketPhase::Idle)
+    , MarketPassCursor(0)
+    , bMarketDirty(false)
+    , NextMarketPassTime(0.0)
+    , AuctionPassCursor(INDEX_NONE)
+    , bDeterministicMarket(false)
+    , MarketSeed(0)
 {
 }
 
@@ -25,28 +40,30 @@ void USETradeManager::Initialize(USEGameInstance* InGameInstance)
     CurrentMarketData.MarketVolatility = 0.1f;
     CurrentMarketData.TimelineInfluence = 1.0f;
 
-    // Start market update loop
-    FTimerHandle UpdateTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        UpdateTimer,
-        this,
-        &USETradeManager::UpdateMarketPrices,
-        MarketUpdateInterval,
-        true
-    );
-
-    // Start auction processing
-    FTimerHandle AuctionTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        AuctionTimer,
-        this,
-        &USETradeManager::ProcessAuctions,
-        60.0f,  // Check auctions every minute
-        true
-    );
+    // Rebuild the order book from the last checkpoint and journal
+    TradeJournal = MakeUnique<FSETradeJournal>(TEXT("TradingPost"), GroupCommitMs);
+    RecoverOrderBook();
+
+    // Market and auction scans are sliced across frames by the shared scheduler
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        Scheduler->AddJob(TEXT("Trade.JournalCommit"), GroupCommitMs * 0.001f, ESEJobPriority::High,
+            [this](const FSEJobBudget&) { CommitTradeJournal(); return true; }, this);
+
+        Scheduler->AddJob(TEXT("Trade.Checkpoint"), CheckpointInterval, ESEJobPriority::Low,
+            [this](const FSEJobBudget&) { WriteCheckpoint(); return true; }, this);
+
+        // Checked every reprice delay so trades are picked up soon, but a full pass only runs when due
+        NextMarketPassTime = GetWorld()->GetTimeSeconds() + MarketUpdateInterval;
+        Scheduler->AddJob(TEXT("Trade.MarketPrices"), MarketRepriceDelay, ESEJobPriority::Low,
+            [this](const FSEJobBudget& Budget) { return !IsMarketPassDue() || StepMarketUpdate(Budget); }, this);
+
+        Scheduler->AddJob(TEXT("Trade.Auctions"), AuctionCheckInterval, ESEJobPriority::Normal,
+            [this](const FSEJobBudget& Budget) { return StepAuctions(Budget); }, this);
+    }
 }
 
-bool USETradeManager::ListItem(const FString& SellerID, const FMarketItem& Item)
+bool USETradeManager::ListItem(const FSEEntityID& SellerID, const FMarketItem& Item)
 {
     // Validate item data
     if (Item.Quantity <= 0 || Item.BasePrice <= 0)
@@ -55,21 +72,23 @@ bool USETradeManager::ListItem(const FString& SellerID, const FMarketItem& Item)
     }
 
     // Generate unique item listing ID
-    FString ItemID = FGuid::NewGuid().ToString();
+    FSEEntityID ListingID = FSEEntityID::NewID();
     
     // Apply initial price modifier based on market conditions
     FMarketItem NewListing = Item;
-    NewListing.ItemID = ItemID;
+    NewListing.ListingID = ListingID;
     NewListing.SellerID = SellerID;
     NewListing.CurrentPriceModifier = CalculatePriceModifier(Item);
     
-    if (Item.bIsAuction)
-    {
-        NewListing.TimeRemaining = AuctionDuration;
-    }
+    // The end time is journaled with the listing, so auctions close on schedule across restarts
+    NewListing.EndTime = Item.bIsAuction ? FDateTime::UtcNow().ToUnixTimestamp() + FMath::CeilToInt64(AuctionDuration) : 0;
 
     // Add to market
-    ListedItems.Add(ItemID, NewListing);
+    ListedItems.Add(ListingID, NewListing);
+    if (TradeJournal)
+    {
+        TradeJournal->AppendList(ListingID, NewListing);
+    }
 
     // Update supply metrics
     if (!CurrentMarketData.ItemSupply.Contains(Item.ItemID))
@@ -78,20 +97,20 @@ bool USETradeManager::ListItem(const FString& SellerID, const FMarketItem& Item)
     }
     CurrentMarketData.ItemSupply[Item.ItemID] += Item.Quantity;
 
-    // Update market data
-    UpdateMarketPrices();
+    // The listing is priced above; everything else reprices on the next market pass
+    MarkMarketDirty();
 
     return true;
 }
 
-bool USETradeManager::BuyItem(const FString& BuyerID, const FString& ItemID)
+bool USETradeManager::BuyItem(const FSEEntityID& BuyerID, const FSEEntityID& ListingID)
 {
-    if (!ListedItems.Contains(ItemID))
+    if (!ListedItems.Contains(ListingID))
     {
         return false;
     }
 
-    FMarketItem& Item = ListedItems[ItemID];
+    FMarketItem& Item = ListedItems[ListingID];
     
     // Validate trade
     if (!ValidateTrade(BuyerID, Item))
@@ -100,7 +119,7 @@ bool USETradeManager::BuyItem(const FString& BuyerID, const FString& ItemID)
     }
 
     // Process transaction
-    float CurrentPrice = GetCurrentPrice(ItemID);
+    float CurrentPrice = GetCurrentPrice(ListingID);
     
     // Update market data
     if (!CurrentMarketData.ItemDemand.Contains(Item.ItemID))
@@ -111,33 +130,40 @@ bool USETradeManager::BuyItem(const FString& BuyerID, const FString& ItemID)
     CurrentMarketData.ItemSupply[Item.ItemID] -= Item.Quantity;
 
     // Record transaction
-    if (!ItemHistory.Contains(Item.ItemID))
-    {
-        ItemHistory.Add(Item.ItemID, TArray<FString>());
-    }
-    ItemHistory[Item.ItemID].Add(BuyerID);
+    const int64 TradeTime = FDateTime::UtcNow().ToUnixTimestamp();
+    PriceHistory.RecordTrade(Item.ItemID, Item.Type, CurrentPrice, Item.Quantity, TradeTime);
 
     // Remove listing
-    ListedItems.Remove(ItemID);
+    const FString ItemID = Item.ItemID;
+    const int32 Quantity = Item.Quantity;
+    ListedItems.Remove(ListingID);
 
-    // Notify completion
-    OnTradeCompleted.Broadcast(ItemID, BuyerID);
-    BP_OnTradeCompleted(ItemID, BuyerID);
+    // Notify completion once the trade survives a crash
+    if (TradeJournal)
+    {
+        const uint64 Sequence = TradeJournal->AppendBuy(ListingID, BuyerID, CurrentPrice, TradeTime);
+        PendingTradeNotices.Add({ Sequence, ListingID, BuyerID, ItemID, Quantity });
+    }
+    else
+    {
+        NotifyTradeCompleted(ListingID, BuyerID, ItemID, Quantity);
+        FSEEntityID::Release(ListingID);
+    }
 
-    // Update market
-    UpdateMarketPrices();
+    // Supply and demand moved, so the next market pass reprices
+    MarkMarketDirty();
 
     return true;
 }
 
-bool USETradeManager::PlaceBid(const FString& BidderID, const FString& ItemID, int32 BidAmount)
+bool USETradeManager::PlaceBid(const FSEEntityID& BidderID, const FSEEntityID& ListingID, int32 BidAmount)
 {
-    if (!ListedItems.Contains(ItemID))
+    if (!ListedItems.Contains(ListingID))
     {
         return false;
     }
 
-    FMarketItem& Item = ListedItems[ItemID];
+    FMarketItem& Item = ListedItems[ListingID];
     
     if (!Item.bIsAuction)
     {
@@ -145,7 +171,7 @@ bool USETradeManager::PlaceBid(const FString& BidderID, const FString& ItemID, i
     }
 
     // Validate bid amount
-    float CurrentPrice = GetCurrentPrice(ItemID);
+    float CurrentPrice = GetCurrentPrice(ListingID);
     if (BidAmount <= CurrentPrice)
     {
         return false;
@@ -154,6 +180,10 @@ bool USETradeManager::PlaceBid(const FString& BidderID, const FString& ItemID, i
     // Add bid
     Item.Bids.Add(BidderID);
     Item.BasePrice = BidAmount;  // Update base price to current bid
+    if (TradeJournal)
+    {
+        TradeJournal->AppendBid(ListingID, BidderID, BidAmount);
+    }
 
     // Update market volatility
     CurrentMarketData.MarketVolatility += 0.01f;
@@ -162,189 +192,291 @@ bool USETradeManager::PlaceBid(const FString& BidderID, const FString& ItemID, i
     return true;
 }
 
-float USETradeManager::GetCurrentPrice(const FString& ItemID) const
+float USETradeManager::GetCurrentPrice(const FSEEntityID& ListingID) const
 {
-    if (!ListedItems.Contains(ItemID))
+    if (!ListedItems.Contains(ListingID))
     {
         return 0.0f;
     }
 
-    const FMarketItem& Item = ListedItems[ItemID];
+    const FMarketItem& Item = ListedItems[ListingID];
     return Item.BasePrice * Item.CurrentPriceModifier;
 }
 
 void USETradeManager::UpdateMarketPrices()
 {
-    // Update market volatility
-    UpdateMarketVolatility();
-
-    // Process market events
-    ProcessMarketEvents();
-
-    // Update each item's price
-    for (auto& Pair : ListedItems)
+    // Finish the pass in flight instead of throwing its work away, then reprice what changed since
+    const bool bWasRunning = MarketPhase != ESEMarketPhase::Idle;
+    if (bWasRunning)
     {
-        FMarketItem& Item = Pair.Value;
-        Item.CurrentPriceModifier = CalculatePriceModifier(Item);
+        StepMarketUpdate(FSEJobBudget::Unbounded());
     }
+    if (!bWasRunning || bMarketDirty)
+    {
+        StepMarketUpdate(FSEJobBudget::Unbounded());
+    }
+}
 
-    // Update supply and demand
-    UpdateSupplyAndDemand();
-
-    // Calculate market trends
-    CalculateMarketTrends();
+bool USETradeManager::IsMarketPassDue() const
+{
+    if (MarketPhase != ESEMarketPhase::Idle || bMarketDirty)
+    {
+        return true;
+    }
 
-    // Clean up old listings
-    CleanupExpiredListings();
+    const UWorld* World = GetWorld();
+    return !World || World->GetTimeSeconds() >= NextMarketPassTime;
+}
 
-    // Notify market update
-    OnMarketUpdate.Broadcast(CurrentMarketData);
-    BP_OnMarketUpdate(CurrentMarketData);
+void USETradeManager::SetDeterministicMarket(int32 Seed)
+{
+    ResetMarketPass();
+    bDeterministicMarket = true;
+    MarketSeed = Seed;
 }
 
-void USETradeManager::OnTimelineStateChanged(ETimelineState NewState)
+int32 USETradeManager::NextMarketSeed()
 {
-    // Apply timeline-specific effects
-    ApplyTimelineEffects(NewState);
+    return bDeterministicMarket ? MarketSeed++ : FMath::Rand();
+}
 
-    // Update market prices
-    UpdateMarketPrices();
+void USETradeManager::ResetMarketPass()
+{
+    // A step still running on a worker finishes into a result nobody reads
+    MarketPhase = ESEMarketPhase::Idle;
+    MarketSnapshot.Reset();
+    MarketStep = UE::Tasks::TTask<FSEMarketStepResult>();
+    MarketResult = FSEMarketStepResult();
+    MarketPassCursor = 0;
+}
 
-    BP_OnTimelineStateChanged(NewState);
+void USETradeManager::CopyMarketState(FSEMarketSnapshot& Snapshot) const
+{
+    Snapshot.PriceModifiers = CurrentMarketData.PriceModifiers;
+    Snapshot.MarketVolatility = CurrentMarketData.MarketVolatility;
+    Snapshot.MaxPriceFluctuation = MaxPriceFluctuation;
+    Snapshot.bHasTimeline = TimelineManager != nullptr;
+    if (TimelineManager)
+    {
+        Snapshot.CurrentTimeline = TimelineManager->GetCurrentState();
+    }
 }
 
-TArray<FMarketItem> USETradeManager::GetListedItems(ETradeItemType Type) const
+void USETradeManager::TakeMarketSnapshot(FSEMarketSnapshot& Snapshot) const
 {
-    TArray<FMarketItem> Items;
-    
+    CopyMarketState(Snapshot);
+
+    Snapshot.Listings.Reserve(ListedItems.Num());
     for (const auto& Pair : ListedItems)
     {
-        if (Pair.Value.Type == Type)
-        {
-            Items.Add(Pair.Value);
-        }
+        FSEMarketListingInput& Listing = Snapshot.Listings.AddDefaulted_GetRef();
+        Listing.ListingID = Pair.Key;
+        Listing.Type = Pair.Value.Type;
+        Listing.PreferredTimeline = Pair.Value.PreferredTimeline;
     }
 
-    return Items;
+    Snapshot.Supply.Reserve(CurrentMarketData.ItemSupply.Num());
+    Snapshot.Demand.Reserve(CurrentMarketData.ItemSupply.Num());
+    for (const auto& Pair : CurrentMarketData.ItemSupply)
+    {
+        const int32* Demand = CurrentMarketData.ItemDemand.Find(Pair.Key);
+        Snapshot.Supply.Add(Pair.Value);
+        Snapshot.Demand.Add(Demand ? *Demand : 0);
+    }
+
+    Snapshot.TradeVolatility = PriceHistory.GetMarketVolatility();
+    Snapshot.bHasTrades = PriceHistory.HasTrades();
 }
 
-void USETradeManager::ProcessAuctions()
+bool USETradeManager::StepMarketUpdate(const FSEJobBudget& Budget)
 {
-    float CurrentTime = UGameplayStatics::GetRealTimeSeconds(GetWorld());
-    TArray<FString> CompletedAuctions;
-
-    // Check each auction
-    for (auto& Pair : ListedItems)
+    if (MarketPhase == ESEMarketPhase::Idle)
     {
-        FMarketItem& Item = Pair.Value;
-        
-        if (!Item.bIsAuction)
+        // Update market volatility
+        UpdateMarketVolatility();
+
+        // Process market events
+        ProcessMarketEvents();
+
+        MarketSnapshot = MakeShared<FSEMarketSnapshot, ESPMode::ThreadSafe>();
+        TakeMarketSnapshot(*MarketSnapshot);
+        MarketSnapshot->Seed = NextMarketSeed();
+
+        // Changes from here on are not in the snapshot and wait for the next pass
+        bMarketDirty = false;
+        if (const UWorld* World = GetWorld())
         {
-            continue;
+            NextMarketPassTime = World->GetTimeSeconds() + MarketUpdateInterval;
         }
 
-        Item.TimeRemaining -= 60.0f;  // Reduce time by one minute
-
-        if (Item.TimeRemaining <= 0)
+        if (bDeterministicMarket || Budget.IsUnbounded())
         {
-            CompletedAuctions.Add(Pair.Key);
-            
-            // Find winner
-            if (Item.Bids.Num() > 0)
+            MarketResult = FSEMarketSimulation::Step(*MarketSnapshot);
+            MarketPhase = ESEMarketPhase::Apply;
+        }
+        else
+        {
+            // The snapshot is immutable until the pass ends, so the worker can read it in place
+            MarketStep = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot = MarketSnapshot.ToSharedRef()]()
             {
-                FString WinnerID = Item.Bids.Last();
-                OnAuctionEnded.Broadcast(Item.ItemID, WinnerID);
-                BP_OnAuctionEnded(Item.ItemID, WinnerID);
-            }
+                return FSEMarketSimulation::Step(*Snapshot);
+            });
+            MarketPhase = ESEMarketPhase::Simulate;
         }
+        MarketPassCursor = 0;
     }
 
-    // Remove completed auctions
-    for (const FString& AuctionID : CompletedAuctions)
+    if (MarketPhase == ESEMarketPhase::Simulate)
     {
-        ListedItems.Remove(AuctionID);
+        // Yield the frame to other jobs while the worker runs; an unbounded caller waits for it
+        if (!MarketStep.IsCompleted() && !Budget.IsUnbounded())
+        {
+            return false;
+        }
+        MarketResult = MoveTemp(MarketStep.GetResult());
+        MarketStep = UE::Tasks::TTask<FSEMarketStepResult>();
+        MarketPhase = ESEMarketPhase::Apply;
     }
-}
 
-void USETradeManager::UpdateSupplyAndDemand()
-{
-    for (auto& Pair : CurrentMarketData.ItemSupply)
-    {
-        const FString& ItemID = Pair.Key;
-        
-        // Calculate supply ratio
-        float SupplyRatio = Pair.Value / 100.0f;  // Base value of 100 items
-        
-        // Get demand
-        int32 Demand = CurrentMarketData.ItemDemand.Contains(ItemID) ? 
-            CurrentMarketData.ItemDemand[ItemID] : 0;
-        
-        // Calculate demand ratio
-        float DemandRatio = Demand / 100.0f;
-
-        // Update price modifiers
-        if (!CurrentMarketData.PriceModifiers.Contains(ETradeItemType::Resource))
+    // Apply new prices to listings still on the market
+    const TArray<FSEMarketListingInput>& Listings = MarketSnapshot->Listings;
+    while (MarketPassCursor < Listings.Num())
+    {
+        if (FMarketItem* Item = ListedItems.Find(Listings[MarketPassCursor].ListingID))
+        {
+            Item->CurrentPriceModifier = MarketResult.ListingModifiers[MarketPassCursor];
+        }
+        ++MarketPassCursor;
+
+        if (MarketPassCursor < Listings.Num() && !Budget.HasTimeLeft())
         {
-            CurrentMarketData.PriceModifiers.Add(ETradeItemType::Resource, 1.0f);
+            return false;
         }
+    }
 
-        float& Modifier = CurrentMarketData.PriceModifiers[ETradeItemType::Resource];
-        Modifier = FMath::Clamp(DemandRatio / SupplyRatio, 0.5f, 2.0f);
+    // Supply, demand and trends; only the step's own changes land, so timeline scaling and bids
+    // applied while it ran survive
+    for (const auto& Pair : MarketResult.PriceModifiers)
+    {
+        const float* Before = MarketSnapshot->PriceModifiers.Find(Pair.Key);
+        if (!Before || *Before != Pair.Value)
+        {
+            CurrentMarketData.PriceModifiers.Add(Pair.Key, Pair.Value);
+        }
     }
+    CurrentMarketData.MarketVolatility = FMath::Clamp(
+        CurrentMarketData.MarketVolatility + MarketResult.MarketVolatility - MarketSnapshot->MarketVolatility, 0.0f, 1.0f);
+    ResetMarketPass();
+
+    // Notify market update
+    OnMarketUpdate.Broadcast(CurrentMarketData);
+    BP_OnMarketUpdate(CurrentMarketData);
+    return true;
 }
 
-void USETradeManager::CalculateMarketTrends()
+void USETradeManager::OnTimelineStateChanged(ETimelineState NewState)
 {
-    // Analyze recent transactions
-    for (const auto& Pair : ItemHistory)
-    {
-        const FString& ItemID = Pair.Key;
-        const TArray<FString>& Transactions = Pair.Value;
+    // Apply timeline-specific effects
+    ApplyTimelineEffects(NewState);
+
+    // Listings reprice under the new timeline on the next market pass
+    MarkMarketDirty();
 
-        // Calculate transaction frequency
-        float TransactionsPerHour = Transactions.Num() / (MarketUpdateInterval / 3600.0f);
+    BP_OnTimelineStateChanged(NewState);
+}
 
-        // Update market volatility based on transaction frequency
-        CurrentMarketData.MarketVolatility = FMath::Lerp(
-            CurrentMarketData.MarketVolatility,
-            TransactionsPerHour / 100.0f,  // Normalize to 0-1 range
-            0.1f  // Smooth changes
-        );
+TArray<FMarketItem> USETradeManager::GetListedItems(ETradeItemType Type) const
+{
+    TArray<FMarketItem> Items;
+    
+    for (const auto& Pair : ListedItems)
+    {
+        if (Pair.Value.Type == Type)
+        {
+            Items.Add(Pair.Value);
+        }
     }
+
+    return Items;
+}
+
+TArray<FSEPriceCandle> USETradeManager::GetPriceCandles(const FString& ItemID, ESEPriceResolution Resolution, int32 MaxCount) const
+{
+    TArray<FSEPriceCandle> Candles;
+    PriceHistory.GetCandles(ItemID, Resolution, MaxCount, Candles);
+    return Candles;
 }
 
-float USETradeManager::CalculatePriceModifier(const FMarketItem& Item) const
+float USETradeManager::GetPriceTrend(const FString& ItemID, ESEPriceResolution Resolution, int32 Periods) const
 {
-    float Modifier = 1.0f;
+    return PriceHistory.GetTrend(ItemID, Resolution, Periods);
+}
 
-    // Apply supply/demand modifier
-    if (CurrentMarketData.PriceModifiers.Contains(Item.Type))
+bool USETradeManager::StepAuctions(const FSEJobBudget& Budget)
+{
+    if (AuctionPassCursor == INDEX_NONE)
     {
-        Modifier *= CurrentMarketData.PriceModifiers[Item.Type];
+        ListedItems.GetKeys(AuctionPassItems);
+        AuctionPassCursor = 0;
     }
 
-    // Apply timeline influence
-    if (TimelineManager && Item.PreferredTimeline != ETimelineState::Any)
+    const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+
+    // Check each auction
+    while (AuctionPassCursor < AuctionPassItems.Num())
     {
-        if (TimelineManager->GetCurrentState() == Item.PreferredTimeline)
+        const FSEEntityID AuctionID = AuctionPassItems[AuctionPassCursor++];
+        FMarketItem* Item = ListedItems.Find(AuctionID);
+
+        if (Item && Item->bIsAuction)
         {
-            Modifier *= 0.8f;  // 20% discount in preferred timeline
+            if (Now >= Item->EndTime)
+            {
+                // Find winner
+                FSEEntityID WinnerID;
+                if (Item->Bids.Num() > 0)
+                {
+                    WinnerID = Item->Bids.Last();
+                    OnAuctionEnded.Broadcast(AuctionID, WinnerID);
+                    BP_OnAuctionEnded(AuctionID, WinnerID);
+                    FSENotificationPipeline::PostItem(TEXT("Auction ended"), Item->ItemID, Item->Quantity);
+                }
+
+                if (TradeJournal)
+                {
+                    TradeJournal->AppendExpire(AuctionID, WinnerID);
+                }
+                ListedItems.Remove(AuctionID);
+                FSEEntityID::Release(AuctionID);
+            }
         }
-        else
+
+        if (AuctionPassCursor < AuctionPassItems.Num() && !Budget.HasTimeLeft())
         {
-            Modifier *= 1.2f;  // 20% markup in other timeline
+            return false;
         }
     }
 
-    // Apply market volatility
-    float VolatilityEffect = FMath::RandRange(-CurrentMarketData.MarketVolatility, CurrentMarketData.MarketVolatility);
-    Modifier *= (1.0f + VolatilityEffect);
+    AuctionPassItems.Reset();
+    AuctionPassCursor = INDEX_NONE;
+    return true;
+}
+
+float USETradeManager::CalculatePriceModifier(const FMarketItem& Item)
+{
+    // Same rules as the market step, for a single listing on the game thread
+    FSEMarketSnapshot Snapshot;
+    CopyMarketState(Snapshot);
+
+    FSEMarketListingInput Listing;
+    Listing.Type = Item.Type;
+    Listing.PreferredTimeline = Item.PreferredTimeline;
 
-    // Clamp final modifier
-    return FMath::Clamp(Modifier, 1.0f - MaxPriceFluctuation, 1.0f + MaxPriceFluctuation);
+    FRandomStream Random(NextMarketSeed());
+    return FSEMarketSimulation::CalculatePriceModifier(Snapshot, Listing, Random);
 }
 
-bool USETradeManager::ValidateTrade(const FString& BuyerID, const FMarketItem& Item) const
+bool USETradeManager::ValidateTrade(const FSEEntityID& BuyerID, const FMarketItem& Item) const
 {
     // Check if item is in auction
     if (Item.bIsAuction)
@@ -407,22 +539,166 @@ void USETradeManager::ProcessMarketEvents()
     }
 }
 
-void USETradeManager::CleanupExpiredListings()
+void USETradeManager::BeginDestroy()
 {
-    TArray<FString> ExpiredListings;
+    // Everything acknowledged so far must be on disk before the journal goes away
+    if (TradeJournal)
+    {
+        TradeJournal->CommitBlocking();
+        TradeJournal.Reset();
+    }
 
-    float CurrentTime = UGameplayStatics::GetRealTimeSeconds(GetWorld());
-    
-    for (const auto& Pair : ListedItems)
+    Super::BeginDestroy();
+}
+
+void USETradeManager::NotifyTradeCompleted(const FSEEntityID& ListingID, const FSEEntityID& BuyerID, const FString& ItemID, int32 Quantity)
+{
+    OnTradeCompleted.Broadcast(ListingID, BuyerID);
+    FSENotificationPipeline::PostItem(TEXT("Trade completed"), ItemID, Quantity);
+    BP_OnTradeCompleted(ListingID, BuyerID);
+}
+
+void USETradeManager::CommitTradeJournal()
+{
+    if (!TradeJournal)
+    {
+        return;
+    }
+
+    TradeJournal->CommitIfDue();
+
+    // Notices are in sequence order, so stop at the first one still waiting for its fsync
+    const uint64 DurableSequence = TradeJournal->GetDurableSequence();
+    int32 NumDurable = 0;
+    while (NumDurable < PendingTradeNotices.Num() && PendingTradeNotices[NumDurable].Sequence <= DurableSequence)
+    {
+        ++NumDurable;
+    }
+
+    if (NumDurable > 0)
     {
-        if (!Pair.Value.bIsAuction && CurrentTime > Pair.Value.TimeRemaining)
+        TArray<FPendingTradeNotice> Durable(PendingTradeNotices.GetData(), NumDurable);
+        PendingTradeNotices.RemoveAt(0, NumDurable);
+        for (const FPendingTradeNotice& Notice : Durable)
         {
-            ExpiredListings.Add(Pair.Key);
+            NotifyTradeCompleted(Notice.ListingID, Notice.BuyerID, Notice.ItemID, Notice.Quantity);
+            FSEEntityID::Release(Notice.ListingID);
         }
     }
+}
 
-    for (const FString& ListingID : ExpiredListings)
+void USETradeManager::WriteCheckpoint()
+{
+    if (!TradeJournal)
     {
-        ListedItems.Remove(ListingID);
+        return;
+    }
+
+    // Order book plus the supply, demand and price history the journal records keep in step with it
+    TArray<uint8> Payload;
+    FMemoryWriter Writer(Payload);
+
+    int32 NumListings = ListedItems.Num();
+    Writer << NumListings;
+    for (auto& Pair : ListedItems)
+    {
+        FSEEntityID ListingID = Pair.Key;
+        Writer << ListingID;
+        FSETradeJournal::SerializeListing(Writer, Pair.Value);
+    }
+    Writer << CurrentMarketData.ItemSupply << CurrentMarketData.ItemDemand;
+    PriceHistory.Serialize(Writer);
+
+    TradeJournal->Checkpoint(MoveTemp(Payload));
+}
+
+void USETradeManager::RecoverOrderBook()
+{
+    // Records are buffered so the checkpoint they follow is loaded first
+    TArray<uint8> Checkpoint;
+    TArray<FSETradeJournalEntry> Entries;
+    TradeJournal->Recover(Checkpoint, [&Entries](const FSETradeJournalEntry& Entry)
+    {
+        Entries.Add(Entry);
+    });
+
+    if (Checkpoint.Num() > 0)
+    {
+        FMemoryReader Reader(Checkpoint);
+
+        int32 NumListings = 0;
+        Reader << NumListings;
+        for (int32 Index = 0; Index < NumListings && !Reader.IsError(); ++Index)
+        {
+            FSEEntityID ListingID;
+            FMarketItem Item;
+            Reader << ListingID;
+            FSETradeJournal::SerializeListing(Reader, Item);
+            ListedItems.Add(ListingID, Item);
+        }
+        Reader << CurrentMarketData.ItemSupply << CurrentMarketData.ItemDemand;
+        PriceHistory.Serialize(Reader);
+
+        if (Reader.IsError())
+        {
+            SE_LOG_ERROR(TEXT("Trade checkpoint is corrupt, starting from an empty order book"));
+            ListedItems.Reset();
+            CurrentMarketData.ItemSupply.Reset();
+            CurrentMarketData.ItemDemand.Reset();
+            PriceHistory.Reset();
+        }
+    }
+
+    for (const FSETradeJournalEntry& Entry : Entries)
+    {
+        ApplyJournalEntry(Entry);
+    }
+
+    if (Checkpoint.Num() > 0 || Entries.Num() > 0)
+    {
+        SE_LOG(Log, TEXT("Recovered trading post: %d listings, %d journal records"), ListedItems.Num(), Entries.Num());
+    }
+}
+
+void USETradeManager::ApplyJournalEntry(const FSETradeJournalEntry& Entry)
+{
+    switch (Entry.Type)
+    {
+        case ESETradeJournalRecord::List:
+        {
+            ListedItems.Add(Entry.ListingID, Entry.Item);
+            CurrentMarketData.ItemSupply.FindOrAdd(Entry.Item.ItemID) += Entry.Item.Quantity;
+            break;
+        }
+
+        case ESETradeJournalRecord::Bid:
+        {
+            if (FMarketItem* Item = ListedItems.Find(Entry.ListingID))
+            {
+                Item->Bids.Add(Entry.ActorID);
+                Item->BasePrice = Entry.Amount;
+            }
+            break;
+        }
+
+        case ESETradeJournalRecord::Buy:
+        {
+            if (const FMarketItem* Item = ListedItems.Find(Entry.ListingID))
+            {
+                CurrentMarketData.ItemDemand.FindOrAdd(Item->ItemID)++;
+                CurrentMarketData.ItemSupply.FindOrAdd(Item->ItemID) -= Item->Quantity;
+                PriceHistory.RecordTrade(Item->ItemID, Item->Type, Entry.Price, Item->Quantity, Entry.Time);
+                ListedItems.Remove(Entry.ListingID);
+            }
+            FSEEntityID::Release(Entry.ListingID);
+            break;
+        }
+
+        case ESETradeJournalRecord::Expire:
+        {
+            ListedItems.Remove(Entry.ListingID);
+            FSEEntityID::Release(Entry.ListingID);
+            break;
+        }
     }
 }
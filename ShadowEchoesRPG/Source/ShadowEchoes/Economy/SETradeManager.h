@@ -4,10 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Core/SEEntityID.h"
+#include "Economy/SEMarketSimulation.h"
+#include "Economy/SEPriceHistory.h"
+#include "Tasks/Task.h"
 #include "SETradeManager.generated.h"
 
 class USEGameInstance;
 class UTimelineManager;
+class FSETradeJournal;
+struct FSEJobBudget;
+struct FSETradeJournalEntry;
 
 UENUM(BlueprintType)
 enum class ETradeItemType : uint8
@@ -27,8 +34,12 @@ struct FMarketItem
     UPROPERTY()
     FString ItemID;
 
+    /** Assigned when listed */
     UPROPERTY()
-    FString SellerID;
+    FSEEntityID ListingID;
+
+    UPROPERTY()
+    FSEEntityID SellerID;
 
     UPROPERTY()
     ETradeItemType Type;
@@ -48,11 +59,12 @@ struct FMarketItem
     UPROPERTY()
     bool bIsAuction;
 
+    /** Unix seconds an auction closes, set once when listed; 0 for fixed-price listings */
     UPROPERTY()
-    float TimeRemaining;
+    int64 EndTime;
 
     UPROPERTY()
-    TArray<FString> Bids;
+    TArray<FSEEntityID> Bids;
 };
 
 USTRUCT(BlueprintType)
@@ -77,8 +89,8 @@ struct FMarketData
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMarketUpdate, const FMarketData&, MarketData);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTradeCompleted, const FString&, ItemID, const FString&, BuyerID);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAuctionEnded, const FString&, ItemID, const FString&, WinnerID);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTradeCompleted, const FSEEntityID&, ListingID, const FSEEntityID&, BuyerID);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAuctionEnded, const FSEEntityID&, ListingID, const FSEEntityID&, WinnerID);
 
 /**
  * Manages the trading post system with timeline-based market dynamics
@@ -94,23 +106,32 @@ public:
     /** Initialize the trade system */
     void Initialize(USEGameInstance* InGameInstance);
 
+    virtual void BeginDestroy() override;
+
     /** Market operations */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
-    bool ListItem(const FString& SellerID, const FMarketItem& Item);
+    bool ListItem(const FSEEntityID& SellerID, const FMarketItem& Item);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
-    bool BuyItem(const FString& BuyerID, const FString& ItemID);
+    bool BuyItem(const FSEEntityID& BuyerID, const FSEEntityID& ListingID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
-    bool PlaceBid(const FString& BidderID, const FString& ItemID, int32 BidAmount);
+    bool PlaceBid(const FSEEntityID& BidderID, const FSEEntityID& ListingID, int32 BidAmount);
 
     /** Market analysis */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
-    float GetCurrentPrice(const FString& ItemID) const;
+    float GetCurrentPrice(const FSEEntityID& ListingID) const;
 
+    /**
+     * Reprice the market now: finishes the pass in flight, then runs one more if anything changed.
+     * Trades only mark the market dirty and leave this to the Trade.MarketPrices job.
+     */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
     void UpdateMarketPrices();
 
+    /** Seed market noise from Seed and step inline, so tests get repeatable prices */
+    void SetDeterministicMarket(int32 Seed);
+
     /** Timeline integration */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
     void OnTimelineStateChanged(ETimelineState NewState);
@@ -122,6 +143,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
     TArray<FMarketItem> GetListedItems(ETradeItemType Type) const;
 
+    /** Price history */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Trade")
+    TArray<FSEPriceCandle> GetPriceCandles(const FString& ItemID, ESEPriceResolution Resolution, int32 MaxCount) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Trade")
+    float GetPriceTrend(const FString& ItemID, ESEPriceResolution Resolution, int32 Periods) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Trade")
+    float GetItemVolatility(const FString& ItemID) const { return PriceHistory.GetItemVolatility(ItemID); }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Trade")
+    float GetTypeVolatility(ETradeItemType Type) const { return PriceHistory.GetTypeVolatility(Type); }
+
+    const FSEPriceHistory& GetPriceHistory() const { return PriceHistory; }
+
     /** Events */
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Trade|Events")
     FOnMarketUpdate OnMarketUpdate;
@@ -137,22 +173,37 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade")
     float MarketUpdateInterval;
 
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade")
+    float AuctionCheckInterval;
+
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade")
     float AuctionDuration;
 
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade")
     float MaxPriceFluctuation;
 
+    /** Longest a trade or timeline change waits for the market job to reprice, in seconds */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade")
+    float MarketRepriceDelay;
+
+    /** Longest a completed trade waits for its journal fsync, in milliseconds */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade|Persistence")
+    float GroupCommitMs;
+
+    /** Seconds between order book checkpoints */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Trade|Persistence")
+    float CheckpointInterval;
+
 private:
     /** Current state */
     UPROPERTY()
-    TMap<FString, FMarketItem> ListedItems;
+    TMap<FSEEntityID, FMarketItem> ListedItems;
 
     UPROPERTY()
     FMarketData CurrentMarketData;
 
-    UPROPERTY()
-    TMap<FString, TArray<FString>> ItemHistory;
+    /** Bounded OHLC candles and volatility of completed trades */
+    FSEPriceHistory PriceHistory;
 
     /** Game instance reference */
     UPROPERTY()
@@ -161,16 +212,62 @@ private:
     UPROPERTY()
     UTimelineManager* TimelineManager;
 
+    /** Scheduler slices; each pass walks a snapshot of listing IDs so it can resume next frame */
+    bool StepMarketUpdate(const FSEJobBudget& Budget);
+    bool StepAuctions(const FSEJobBudget& Budget);
+
+    /** Market pass: snapshot, step on a worker, then apply the new modifiers in budgeted slices */
+    void CopyMarketState(FSEMarketSnapshot& Snapshot) const;
+    void TakeMarketSnapshot(FSEMarketSnapshot& Snapshot) const;
+    void ResetMarketPass();
+    int32 NextMarketSeed();
+
+    /** A pass is due when one is in flight, the market changed, or the update interval elapsed */
+    bool IsMarketPassDue() const;
+    void MarkMarketDirty() { bMarketDirty = true; }
+
+    ESEMarketPhase MarketPhase;
+    TSharedPtr<FSEMarketSnapshot, ESPMode::ThreadSafe> MarketSnapshot;
+    UE::Tasks::TTask<FSEMarketStepResult> MarketStep;
+    FSEMarketStepResult MarketResult;
+    int32 MarketPassCursor;
+
+    /** Set by trades and timeline changes made since the last snapshot */
+    bool bMarketDirty;
+    double NextMarketPassTime;
+
+    bool bDeterministicMarket;
+    int32 MarketSeed;
+
+    TArray<FSEEntityID> AuctionPassItems;
+    int32 AuctionPassCursor;
+
+    /** Write-ahead log of every order book change */
+    TUniquePtr<FSETradeJournal> TradeJournal;
+
+    /** Completed trades announced once their journal record is durable */
+    struct FPendingTradeNotice
+    {
+        uint64 Sequence;
+        FSEEntityID ListingID;
+        FSEEntityID BuyerID;
+        FString ItemID;
+        int32 Quantity;
+    };
+    TArray<FPendingTradeNotice> PendingTradeNotices;
+
+    void RecoverOrderBook();
+    void ApplyJournalEntry(const FSETradeJournalEntry& Entry);
+    void WriteCheckpoint();
+    void CommitTradeJournal();
+    void NotifyTradeCompleted(const FSEEntityID& ListingID, const FSEEntityID& BuyerID, const FString& ItemID, int32 Quantity);
+
     /** Internal functionality */
-    void ProcessAuctions();
-    void UpdateSupplyAndDemand();
-    void CalculateMarketTrends();
-    float CalculatePriceModifier(const FMarketItem& Item) const;
-    bool ValidateTrade(const FString& BuyerID, const FMarketItem& Item) const;
+    float CalculatePriceModifier(const FMarketItem& Item);
+    bool ValidateTrade(const FSEEntityID& BuyerID, const FMarketItem& Item) const;
     void ApplyTimelineEffects(ETimelineState State);
     void UpdateMarketVolatility();
     void ProcessMarketEvents();
-    void CleanupExpiredListings();
 
 protected:
     /** Blueprint events */
@@ -178,10 +275,10 @@ protected:
     void BP_OnMarketUpdate(const FMarketData& MarketData);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Trade|Events")
-    void BP_OnTradeCompleted(const FString& ItemID, const FString& BuyerID);
+    void BP_OnTradeCompleted(const FSEEntityID& ListingID, const FSEEntityID& BuyerID);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Trade|Events")
-    void BP_OnAuctionEnded(const FString& ItemID, const FString& WinnerID);
+    void BP_OnAuctionEnded(const FSEEntityID& ListingID, const FSEEntityID& WinnerID);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Trade|Events")
     void BP_OnTimelineStateChanged(ETimelineState NewState);
@@ -2,10 +2,31 @@
 
 #include "Guild/SEGuildManager.h"
 #include "Core/SEGameInstance.h"
+#include "ShadowEchoes.h"
+#include "SaveGame/SEWorldDatabase.h"
+#include "Systems/SEJobScheduler.h"
 #include "Systems/TimelineManager.h"
 #include "Engine/DataTable.h"
 #include "Kismet/GameplayStatics.h"
 
+FArchive& operator<<(FArchive& Ar, FGuildData& Guild)
+{
+    uint8 PreferredTimeline = static_cast<uint8>(Guild.PreferredTimeline);
+    Ar << Guild.GuildID << Guild.GuildName << Guild.Description << PreferredTimeline << Guild.Level << Guild.MaxMembers;
+    Ar << Guild.UnlockedFeatures << Guild.TimelinePower << Guild.GuildHallID;
+    Guild.PreferredTimeline = static_cast<ETimelineState>(PreferredTimeline);
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FGuildHall& Hall)
+{
+    // Bonuses are derived and rebuilt on load
+    uint8 Timeline = static_cast<uint8>(Hall.Timeline);
+    Ar << Hall.HallID << Hall.Name << Timeline << Hall.Features << Hall.Upgrades;
+    Hall.Timeline = static_cast<ETimelineState>(Timeline);
+    return Ar;
+}
+
 USEGuildManager::USEGuildManager()
     : MaxGuildLevel(50)
     , BaseMaxMembers(50)
@@ -21,15 +42,14 @@ void USEGuildManager::Initialize(USEGameInstance* InGameInstance)
         TimelineManager = GameInstance->GetTimelineManager();
     }
 
+    LoadGuilds();
+
     // Start mission check loop
-    FTimerHandle MissionTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        MissionTimer,
-        this,
-        &USEGuildManager::ProcessGuildMissions,
-        MissionCheckInterval,
-        true
-    );
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        Scheduler->AddJob(TEXT("Guild.Missions"), MissionCheckInterval, ESEJobPriority::Low,
+            [this](const FSEJobBudget&) { ProcessGuildMissions(); return true; }, this);
+    }
 
     // Load guild data
     UDataTable* GuildTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_GuildContent")));
@@ -39,7 +59,7 @@ void USEGuildManager::Initialize(USEGameInstance* InGameInstance)
     }
 }
 
-bool USEGuildManager::CreateGuild(const FString& GuildName, const FString& FounderID, ETimelineState PreferredTimeline)
+bool USEGuildManager::CreateGuild(const FString& GuildName, const FSEEntityID& FounderID, ETimelineState PreferredTimeline)
 {
     if (!ValidateGuildCreation(GuildName, FounderID))
     {
@@ -48,24 +68,26 @@ bool USEGuildManager::CreateGuild(const FString& GuildName, const FString& Found
 
     // Create guild data
     FGuildData NewGuild;
-    NewGuild.GuildID = FGuid::NewGuid().ToString();
+    NewGuild.GuildID = FSEEntityID::NewID();
     NewGuild.GuildName = GuildName;
     NewGuild.PreferredTimeline = PreferredTimeline;
     NewGuild.Level = 1;
     NewGuild.MaxMembers = BaseMaxMembers;
-    NewGuild.Members.Add(FounderID);
-    NewGuild.MemberRanks.Add(FounderID, EGuildRank::GuildMaster);
     NewGuild.TimelinePower = 0;
 
     // Create guild hall
     FGuildHall NewHall;
-    NewHall.HallID = FGuid::NewGuid().ToString();
+    NewHall.HallID = FSEEntityID::NewID();
     NewHall.Timeline = PreferredTimeline;
     NewGuild.GuildHallID = NewHall.HallID;
 
     // Store guild data
     Guilds.Add(NewGuild.GuildID, NewGuild);
     GuildHalls.Add(NewHall.HallID, NewHall);
+    Membership.AddMember(NewGuild.GuildID, FounderID, EGuildRank::GuildMaster);
+    UpdateGuildBonuses(NewGuild.GuildID);
+    PersistGuild(NewGuild.GuildID);
+    PersistMembers(NewGuild.GuildID);
 
     // Notify creation
     OnGuildCreated.Broadcast(NewGuild);
@@ -74,7 +96,7 @@ bool USEGuildManager::CreateGuild(const FString& GuildName, const FString& Found
     return true;
 }
 
-bool USEGuildManager::JoinGuild(const FString& PlayerID, const FString& GuildID)
+bool USEGuildManager::JoinGuild(const FSEEntityID& PlayerID, const FSEEntityID& GuildID)
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -84,14 +106,18 @@ bool USEGuildManager::JoinGuild(const FString& PlayerID, const FString& GuildID)
     FGuildData& Guild = Guilds[GuildID];
 
     // Check member limit
-    if (Guild.Members.Num() >= Guild.MaxMembers)
+    if (Membership.NumMembers(GuildID) >= Guild.MaxMembers)
     {
         return false;
     }
 
-    // Add member
-    Guild.Members.AddUnique(PlayerID);
-    Guild.MemberRanks.Add(PlayerID, EGuildRank::Member);
+    // Add member; players belong to one guild at a time
+    if (!Membership.AddMember(GuildID, PlayerID, EGuildRank::Member))
+    {
+        return false;
+    }
+    UpdateMemberBonus(GuildID);
+    PersistMembers(GuildID);
 
     // Apply timeline effects
     if (TimelineManager)
@@ -106,40 +132,67 @@ bool USEGuildManager::JoinGuild(const FString& PlayerID, const FString& GuildID)
     return true;
 }
 
-void USEGuildManager::LeaveGuild(const FString& PlayerID, const FString& GuildID)
+void USEGuildManager::LeaveGuild(const FSEEntityID& PlayerID, const FSEEntityID& GuildID)
 {
-    if (!Guilds.Contains(GuildID))
+    EGuildRank Rank;
+    if (!Membership.IsMember(GuildID, PlayerID) || !Membership.GetRank(PlayerID, Rank))
     {
         return;
     }
 
-    FGuildData& Guild = Guilds[GuildID];
-
     // Remove member
-    Guild.Members.Remove(PlayerID);
-    Guild.MemberRanks.Remove(PlayerID);
+    Membership.RemoveMember(PlayerID);
 
     // Check if guild should be disbanded
-    if (Guild.Members.Num() == 0)
+    if (Membership.NumMembers(GuildID) == 0)
     {
+        const FSEEntityID HallID = Guilds[GuildID].GuildHallID;
         Guilds.Remove(GuildID);
-        if (!Guild.GuildHallID.IsEmpty())
-        {
-            GuildHalls.Remove(Guild.GuildHallID);
-        }
+        GuildHalls.Remove(HallID);
+        Membership.RemoveGuild(GuildID);
+        DeleteGuildRows(GuildID, HallID);
+
+        // Rows are gone, so nothing needs the string forms any more
+        FSEEntityID::Release(HallID);
+        FSEEntityID::Release(GuildID);
+        return;
     }
-    else if (Guild.MemberRanks[PlayerID] == EGuildRank::GuildMaster)
+
+    if (Rank == EGuildRank::GuildMaster)
     {
-        // Promote new guild master
-        if (Guild.Members.Num() > 0)
-        {
-            FString NewMaster = Guild.Members[0];
-            Guild.MemberRanks[NewMaster] = EGuildRank::GuildMaster;
-        }
+        // Promote the highest-ranked remaining member
+        Membership.SetRank(Membership.FindHighestRanked(GuildID), EGuildRank::GuildMaster);
     }
+
+    UpdateMemberBonus(GuildID);
+    PersistMembers(GuildID);
 }
 
-bool USEGuildManager::StartGuildMission(const FString& GuildID, const FString& MissionID)
+bool USEGuildManager::SetMemberRank(const FSEEntityID& GuildID, const FSEEntityID& PlayerID, EGuildRank Rank)
+{
+    if (!Membership.IsMember(GuildID, PlayerID) || !Membership.SetRank(PlayerID, Rank))
+    {
+        return false;
+    }
+
+    UpdateMemberBonus(GuildID);
+    PersistMembers(GuildID);
+    return true;
+}
+
+TArray<FSEEntityID> USEGuildManager::GetGuildMembers(const FSEEntityID& GuildID) const
+{
+    TArray<FSEEntityID> Members;
+    const TArrayView<const FSEGuildMember> Table = Membership.GetMembers(GuildID);
+    Members.Reserve(Table.Num());
+    for (const FSEGuildMember& Member : Table)
+    {
+        Members.Add(Member.PlayerID);
+    }
+    return Members;
+}
+
+bool USEGuildManager::StartGuildMission(const FSEEntityID& GuildID, const FString& MissionID)
 {
     if (!ValidateGuildMission(GuildID, MissionID))
     {
@@ -187,7 +240,7 @@ bool USEGuildManager::StartGuildMission(const FString& GuildID, const FString& M
     return true;
 }
 
-void USEGuildManager::CompleteGuildMission(const FString& GuildID, const FString& MissionID)
+void USEGuildManager::CompleteGuildMission(const FSEEntityID& GuildID, const FString& MissionID)
 {
     if (!ActiveMissions.Contains(MissionID))
     {
@@ -222,7 +275,7 @@ void USEGuildManager::CompleteGuildMission(const FString& GuildID, const FString
     ActiveMissions.Remove(MissionID);
 }
 
-bool USEGuildManager::UpgradeGuildHall(const FString& GuildID, const FName& UpgradeID)
+bool USEGuildManager::UpgradeGuildHall(const FSEEntityID& GuildID, const FName& UpgradeID)
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -243,6 +296,7 @@ bool USEGuildManager::UpgradeGuildHall(const FString& GuildID, const FName& Upgr
     // Apply upgrade
     Hall.Upgrades.AddUnique(UpgradeID);
     UpdateGuildBonuses(GuildID);
+    PersistGuild(GuildID);
 
     // Notify upgrade
     OnGuildHallUpgraded.Broadcast(GuildID, UpgradeID);
@@ -251,7 +305,7 @@ bool USEGuildManager::UpgradeGuildHall(const FString& GuildID, const FName& Upgr
     return true;
 }
 
-void USEGuildManager::UnlockGuildFeature(const FString& GuildID, const FName& FeatureID)
+void USEGuildManager::UnlockGuildFeature(const FSEEntityID& GuildID, const FName& FeatureID)
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -263,6 +317,7 @@ void USEGuildManager::UnlockGuildFeature(const FString& GuildID, const FName& Fe
 
     // Apply feature effects
     UpdateGuildBonuses(GuildID);
+    PersistGuild(GuildID);
 }
 
 void USEGuildManager::OnTimelineStateChanged(ETimelineState NewState)
@@ -272,7 +327,7 @@ void USEGuildManager::OnTimelineStateChanged(ETimelineState NewState)
     BP_OnTimelineStateChanged(NewState);
 }
 
-void USEGuildManager::AddGuildExperience(const FString& GuildID, int32 Experience)
+void USEGuildManager::AddGuildExperience(const FSEEntityID& GuildID, int32 Experience)
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -291,6 +346,7 @@ void USEGuildManager::AddGuildExperience(const FString& GuildID, int32 Experienc
     }
 
     // Update guild level
+    const int32 StartLevel = Guild.Level;
     while (Experience >= RequiredExp && Guild.Level < MaxGuildLevel)
     {
         Experience -= RequiredExp;
@@ -303,9 +359,16 @@ void USEGuildManager::AddGuildExperience(const FString& GuildID, int32 Experienc
             UnlockGuildFeature(GuildID, *FString::Printf(TEXT("Level_%d_Feature"), Guild.Level));
         }
     }
+
+    // Level feeds the hall bonuses
+    if (Guild.Level != StartLevel)
+    {
+        UpdateGuildBonuses(GuildID);
+        PersistGuild(GuildID);
+    }
 }
 
-void USEGuildManager::UpdateGuildTimelinePower(const FString& GuildID, int32 PowerChange)
+void USEGuildManager::UpdateGuildTimelinePower(const FSEEntityID& GuildID, int32 PowerChange)
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -314,6 +377,7 @@ void USEGuildManager::UpdateGuildTimelinePower(const FString& GuildID, int32 Pow
 
     FGuildData& Guild = Guilds[GuildID];
     Guild.TimelinePower += PowerChange;
+    PersistGuild(GuildID);
 
     // Apply power effects
     int32 PowerBonus = CalculateGuildPowerBonus(Guild);
@@ -325,7 +389,7 @@ void USEGuildManager::UpdateGuildTimelinePower(const FString& GuildID, int32 Pow
     }
 }
 
-bool USEGuildManager::ValidateGuildCreation(const FString& GuildName, const FString& FounderID) const
+bool USEGuildManager::ValidateGuildCreation(const FString& GuildName, const FSEEntityID& FounderID) const
 {
     // Check name availability
     for (const auto& Pair : Guilds)
@@ -337,6 +401,11 @@ bool USEGuildManager::ValidateGuildCreation(const FString& GuildName, const FStr
     }
 
     // Check founder requirements
+    if (Membership.GetGuild(FounderID).IsValid())
+    {
+        return false;
+    }
+
     if (!GameInstance)
     {
         return false;
@@ -355,7 +424,7 @@ bool USEGuildManager::ValidateGuildCreation(const FString& GuildName, const FStr
     return true;
 }
 
-bool USEGuildManager::ValidateGuildMission(const FString& GuildID, const FString& MissionID) const
+bool USEGuildManager::ValidateGuildMission(const FSEEntityID& GuildID, const FString& MissionID) const
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -399,7 +468,7 @@ void USEGuildManager::ProcessGuildMissions()
     }
 }
 
-void USEGuildManager::UpdateGuildBonuses(const FString& GuildID)
+void USEGuildManager::UpdateGuildBonuses(const FSEEntityID& GuildID)
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -433,15 +502,33 @@ void USEGuildManager::UpdateGuildBonuses(const FString& GuildID)
     }
 
     // Timeline alignment bonus
-    if (TimelineManager && TimelineManager->GetCurrentState() == Guild.PreferredTimeline)
+    const float Alignment = GetAlignmentMultiplier(Guild);
+    for (auto& Bonus : NewBonuses)
     {
-        for (auto& Bonus : NewBonuses)
-        {
-            Bonus.Value *= 1.5f;
-        }
+        Bonus.Value *= Alignment;
     }
 
     Hall.Bonuses = NewBonuses;
+    UpdateMemberBonus(GuildID);
+}
+
+void USEGuildManager::UpdateMemberBonus(const FSEEntityID& GuildID)
+{
+    // Membership changes only touch this entry, from the store's running totals
+    const FGuildData* Guild = Guilds.Find(GuildID);
+    const FSEGuildMemberAggregate* Aggregate = Membership.GetAggregate(GuildID);
+    FGuildHall* Hall = Guild ? GuildHalls.Find(Guild->GuildHallID) : nullptr;
+    if (!Hall || !Aggregate)
+    {
+        return;
+    }
+
+    Hall->Bonuses.Add("MemberStrength", Aggregate->RankWeight * 0.1f * GetAlignmentMultiplier(*Guild));
+}
+
+float USEGuildManager::GetAlignmentMultiplier(const FGuildData& Guild) const
+{
+    return TimelineManager && TimelineManager->GetCurrentState() == Guild.PreferredTimeline ? 1.5f : 1.0f;
 }
 
 void USEGuildManager::CheckTimelineEffects(ETimelineState NewState)
@@ -469,7 +556,7 @@ void USEGuildManager::CheckTimelineEffects(ETimelineState NewState)
     }
 }
 
-bool USEGuildManager::CanAccessGuildHall(const FString& GuildID, const FString& PlayerID) const
+bool USEGuildManager::CanAccessGuildHall(const FSEEntityID& GuildID, const FSEEntityID& PlayerID) const
 {
     if (!Guilds.Contains(GuildID))
     {
@@ -479,7 +566,7 @@ bool USEGuildManager::CanAccessGuildHall(const FString& GuildID, const FString&
     const FGuildData& Guild = Guilds[GuildID];
     
     // Check membership
-    if (!Guild.Members.Contains(PlayerID))
+    if (!Membership.IsMember(GuildID, PlayerID))
     {
         return false;
     }
@@ -522,3 +609,105 @@ int32 USEGuildManager::CalculateGuildPowerBonus(const FGuildData& Guild) const
 
     return Bonus;
 }
+
+FSEWorldDatabase* USEGuildManager::GetWorldDatabase() const
+{
+    return GameInstance ? GameInstance->GetWorldDatabase() : nullptr;
+}
+
+void USEGuildManager::LoadGuilds()
+{
+    FSEWorldDatabase* Database = GetWorldDatabase();
+    if (!Database)
+    {
+        return;
+    }
+
+    // Step 1: Guild and hall rows
+    Database->LoadAll(ESEWorldTable::Guilds, [this](const FString& Key, const TArray<uint8>& Value)
+    {
+        FGuildData Guild;
+        FMemoryReader Reader(Value);
+        Reader << Guild;
+        if (!Reader.IsError() && Guild.GuildID.IsValid())
+        {
+            Guilds.Add(Guild.GuildID, MoveTemp(Guild));
+        }
+    });
+
+    Database->LoadAll(ESEWorldTable::GuildHalls, [this](const FString& Key, const TArray<uint8>& Value)
+    {
+        FGuildHall Hall;
+        FMemoryReader Reader(Value);
+        Reader << Hall;
+        if (!Reader.IsError() && Hall.HallID.IsValid())
+        {
+            GuildHalls.Add(Hall.HallID, MoveTemp(Hall));
+        }
+    });
+
+    // Step 2: Member tables rebuild the store and its reverse index
+    Membership.Reset();
+    Database->LoadAll(ESEWorldTable::GuildMembers, [this](const FString& Key, const TArray<uint8>& Value)
+    {
+        const FSEEntityID GuildID = FSEEntityID::Intern(Key);
+        if (!Guilds.Contains(GuildID))
+        {
+            return;
+        }
+
+        TArray<FSEGuildMember> Members;
+        FMemoryReader Reader(Value);
+        Reader << Members;
+        for (const FSEGuildMember& Member : Members)
+        {
+            Membership.AddMember(GuildID, Member.PlayerID, Member.Rank);
+        }
+    });
+
+    // Step 3: Derived bonuses are not stored
+    for (const auto& Pair : Guilds)
+    {
+        UpdateGuildBonuses(Pair.Key);
+    }
+
+    SE_LOG(Log, TEXT("Loaded %d guilds with %d members"), Guilds.Num(), Membership.NumPlayers());
+}
+
+void USEGuildManager::PersistGuild(const FSEEntityID& GuildID)
+{
+    FSEWorldDatabase* Database = GetWorldDatabase();
+    const FGuildData* Guild = Guilds.Find(GuildID);
+    if (!Database || !Guild)
+    {
+        return;
+    }
+
+    Database->PutRow(ESEWorldTable::Guilds, GuildID.ToString(), *Guild);
+    if (const FGuildHall* Hall = GuildHalls.Find(Guild->GuildHallID))
+    {
+        Database->PutRow(ESEWorldTable::GuildHalls, Hall->HallID.ToString(), *Hall);
+    }
+}
+
+void USEGuildManager::PersistMembers(const FSEEntityID& GuildID)
+{
+    FSEWorldDatabase* Database = GetWorldDatabase();
+    if (!Database)
+    {
+        return;
+    }
+
+    TArray<FSEGuildMember> Members(Membership.GetMembers(GuildID));
+    Database->PutRow(ESEWorldTable::GuildMembers, GuildID.ToString(), Members);
+}
+
+void USEGuildManager::DeleteGuildRows(const FSEEntityID& GuildID, const FSEEntityID& HallID)
+{
+    if (FSEWorldDatabase* Database = GetWorldDatabase())
+    {
+        Database->Delete(ESEWorldTable::Guilds, GuildID.ToString());
+        Database->Delete(ESEWorldTable::GuildHalls, HallID.ToString());
+        Database->Delete(ESEWorldTable::GuildMembers, GuildID.ToString());
+    }
+}
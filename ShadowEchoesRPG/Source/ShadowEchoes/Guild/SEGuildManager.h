@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Core/SEEntityID.h"
+#include "Guild/SEGuildMembership.h"
 #include "SEGuildManager.generated.h"
 
 class USEGameInstance;
 class UTimelineManager;
+class FSEWorldDatabase;
 
 UENUM(BlueprintType)
 enum class EGuildRank : uint8
@@ -24,7 +27,7 @@ struct FGuildData
     GENERATED_BODY()
 
     UPROPERTY()
-    FString GuildID;
+    FSEEntityID GuildID;
 
     UPROPERTY()
     FString GuildName;
@@ -41,12 +44,6 @@ struct FGuildData
     UPROPERTY()
     int32 MaxMembers;
 
-    UPROPERTY()
-    TArray<FString> Members;
-
-    UPROPERTY()
-    TMap<FString, EGuildRank> MemberRanks;
-
     UPROPERTY()
     TArray<FName> UnlockedFeatures;
 
@@ -54,7 +51,7 @@ struct FGuildData
     int32 TimelinePower;
 
     UPROPERTY()
-    FString GuildHallID;
+    FSEEntityID GuildHallID;
 };
 
 USTRUCT(BlueprintType)
@@ -93,7 +90,7 @@ struct FGuildHall
     GENERATED_BODY()
 
     UPROPERTY()
-    FString HallID;
+    FSEEntityID HallID;
 
     UPROPERTY()
     FString Name;
@@ -111,9 +108,13 @@ struct FGuildHall
     TMap<FName, float> Bonuses;
 };
 
+/** World database rows; enums are stored as their underlying byte */
+SHADOWECHOES_API FArchive& operator<<(FArchive& Ar, FGuildData& Guild);
+SHADOWECHOES_API FArchive& operator<<(FArchive& Ar, FGuildHall& Hall);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGuildCreated, const FGuildData&, GuildData);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGuildMissionCompleted, const FString&, GuildID, const FGuildMission&, Mission);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGuildHallUpgraded, const FString&, GuildID, const FName&, UpgradeID);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGuildMissionCompleted, const FSEEntityID&, GuildID, const FGuildMission&, Mission);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGuildHallUpgraded, const FSEEntityID&, GuildID, const FName&, UpgradeID);
 
 /**
  * Manages guild systems including timeline-specific halls and missions
@@ -131,27 +132,42 @@ public:
 
     /** Guild management */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    bool CreateGuild(const FString& GuildName, const FString& FounderID, ETimelineState PreferredTimeline);
+    bool CreateGuild(const FString& GuildName, const FSEEntityID& FounderID, ETimelineState PreferredTimeline);
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
+    bool JoinGuild(const FSEEntityID& PlayerID, const FSEEntityID& GuildID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    bool JoinGuild(const FString& PlayerID, const FString& GuildID);
+    void LeaveGuild(const FSEEntityID& PlayerID, const FSEEntityID& GuildID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    void LeaveGuild(const FString& PlayerID, const FString& GuildID);
+    bool SetMemberRank(const FSEEntityID& GuildID, const FSEEntityID& PlayerID, EGuildRank Rank);
+
+    /** Membership queries */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Guild")
+    FSEEntityID GetPlayerGuild(const FSEEntityID& PlayerID) const { return Membership.GetGuild(PlayerID); }
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
+    TArray<FSEEntityID> GetGuildMembers(const FSEEntityID& GuildID) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Guild")
+    int32 GetGuildMemberCount(const FSEEntityID& GuildID) const { return Membership.NumMembers(GuildID); }
+
+    const FSEGuildMembershipStore& GetMembership() const { return Membership; }
 
     /** Guild missions */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    bool StartGuildMission(const FString& GuildID, const FString& MissionID);
+    bool StartGuildMission(const FSEEntityID& GuildID, const FString& MissionID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    void CompleteGuildMission(const FString& GuildID, const FString& MissionID);
+    void CompleteGuildMission(const FSEEntityID& GuildID, const FString& MissionID);
 
     /** Guild hall */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    bool UpgradeGuildHall(const FString& GuildID, const FName& UpgradeID);
+    bool UpgradeGuildHall(const FSEEntityID& GuildID, const FName& UpgradeID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    void UnlockGuildFeature(const FString& GuildID, const FName& FeatureID);
+    void UnlockGuildFeature(const FSEEntityID& GuildID, const FName& FeatureID);
 
     /** Timeline integration */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
@@ -159,10 +175,10 @@ public:
 
     /** Guild progression */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    void AddGuildExperience(const FString& GuildID, int32 Experience);
+    void AddGuildExperience(const FSEEntityID& GuildID, int32 Experience);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Guild")
-    void UpdateGuildTimelinePower(const FString& GuildID, int32 PowerChange);
+    void UpdateGuildTimelinePower(const FSEEntityID& GuildID, int32 PowerChange);
 
     /** Events */
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Guild|Events")
@@ -188,13 +204,16 @@ protected:
 private:
     /** Current state */
     UPROPERTY()
-    TMap<FString, FGuildData> Guilds;
+    TMap<FSEEntityID, FGuildData> Guilds;
 
     UPROPERTY()
     TMap<FString, FGuildMission> ActiveMissions;
 
     UPROPERTY()
-    TMap<FString, FGuildHall> GuildHalls;
+    TMap<FSEEntityID, FGuildHall> GuildHalls;
+
+    /** Member tables, ranks and the player-to-guild index */
+    FSEGuildMembershipStore Membership;
 
     /** Game instance reference */
     UPROPERTY()
@@ -204,25 +223,34 @@ private:
     UTimelineManager* TimelineManager;
 
     /** Internal functionality */
-    bool ValidateGuildCreation(const FString& GuildName, const FString& FounderID) const;
-    bool ValidateGuildMission(const FString& GuildID, const FString& MissionID) const;
+    bool ValidateGuildCreation(const FString& GuildName, const FSEEntityID& FounderID) const;
+    bool ValidateGuildMission(const FSEEntityID& GuildID, const FString& MissionID) const;
     void ProcessGuildMissions();
-    void UpdateGuildBonuses(const FString& GuildID);
+    void UpdateGuildBonuses(const FSEEntityID& GuildID);
+    void UpdateMemberBonus(const FSEEntityID& GuildID);
+    float GetAlignmentMultiplier(const FGuildData& Guild) const;
     void CheckTimelineEffects(ETimelineState NewState);
-    bool CanAccessGuildHall(const FString& GuildID, const FString& PlayerID) const;
+    bool CanAccessGuildHall(const FSEEntityID& GuildID, const FSEEntityID& PlayerID) const;
     void ApplyGuildHallEffects(const FGuildHall& Hall);
     int32 CalculateGuildPowerBonus(const FGuildData& Guild) const;
 
+    /** World database persistence; every change writes the guild's rows through */
+    FSEWorldDatabase* GetWorldDatabase() const;
+    void LoadGuilds();
+    void PersistGuild(const FSEEntityID& GuildID);
+    void PersistMembers(const FSEEntityID& GuildID);
+    void DeleteGuildRows(const FSEEntityID& GuildID, const FSEEntityID& HallID);
+
 protected:
     /** Blueprint events */
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Guild|Events")
     void BP_OnGuildCreated(const FGuildData& GuildData);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Guild|Events")
-    void BP_OnGuildMissionCompleted(const FString& GuildID, const FGuildMission& Mission);
+    void BP_OnGuildMissionCompleted(const FSEEntityID& GuildID, const FGuildMission& Mission);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Guild|Events")
-    void BP_OnGuildHallUpgraded(const FString& GuildID, const FName& UpgradeID);
+    void BP_OnGuildHallUpgraded(const FSEEntityID& GuildID, const FName& UpgradeID);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Guild|Events")
     void BP_OnTimelineStateChanged(ETimelineState NewState);
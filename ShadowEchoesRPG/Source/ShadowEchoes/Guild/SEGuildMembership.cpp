@@ -0,0 +1,143 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Guild/SEGuildMembership.h"
+#include "Guild/SEGuildManager.h"
+
+void FSEGuildMembershipStore::AddToAggregate(FSEGuildMemberAggregate& Aggregate, EGuildRank Rank, int32 Sign)
+{
+    const int32 RankIndex = static_cast<int32>(Rank);
+    check(RankIndex >= 0 && RankIndex < UE_ARRAY_COUNT(Aggregate.NumByRank));
+
+    Aggregate.NumMembers += Sign;
+    Aggregate.RankWeight += Sign * (RankIndex + 1);
+    Aggregate.NumByRank[RankIndex] += Sign;
+}
+
+bool FSEGuildMembershipStore::AddMember(const FSEEntityID& GuildID, const FSEEntityID& PlayerID, EGuildRank Rank)
+{
+    if (!GuildID.IsValid() || !PlayerID.IsValid() || PlayerIndex.Contains(PlayerID))
+    {
+        return false;
+    }
+
+    FMemberTable& Table = Tables.FindOrAdd(GuildID);
+    const int32 Row = Table.Members.Add({ PlayerID, Rank });
+    AddToAggregate(Table.Aggregate, Rank, 1);
+
+    PlayerIndex.Add(PlayerID, { GuildID, Row });
+    return true;
+}
+
+FSEEntityID FSEGuildMembershipStore::RemoveMember(const FSEEntityID& PlayerID)
+{
+    FPlayerSlot Slot;
+    if (!PlayerIndex.RemoveAndCopyValue(PlayerID, Slot))
+    {
+        return FSEEntityID();
+    }
+
+    FMemberTable& Table = Tables.FindChecked(Slot.GuildID);
+    AddToAggregate(Table.Aggregate, Table.Members[Slot.Row].Rank, -1);
+
+    // The last row moves into the gap, so point its player at the new row
+    Table.Members.RemoveAtSwap(Slot.Row, 1, false);
+    if (Slot.Row < Table.Members.Num())
+    {
+        PlayerIndex.FindChecked(Table.Members[Slot.Row].PlayerID).Row = Slot.Row;
+    }
+
+    return Slot.GuildID;
+}
+
+bool FSEGuildMembershipStore::SetRank(const FSEEntityID& PlayerID, EGuildRank Rank)
+{
+    const FPlayerSlot* Slot = PlayerIndex.Find(PlayerID);
+    if (!Slot)
+    {
+        return false;
+    }
+
+    FMemberTable& Table = Tables.FindChecked(Slot->GuildID);
+    FSEGuildMember& Member = Table.Members[Slot->Row];
+    AddToAggregate(Table.Aggregate, Member.Rank, -1);
+    Member.Rank = Rank;
+    AddToAggregate(Table.Aggregate, Rank, 1);
+    return true;
+}
+
+void FSEGuildMembershipStore::RemoveGuild(const FSEEntityID& GuildID)
+{
+    FMemberTable Table;
+    if (Tables.RemoveAndCopyValue(GuildID, Table))
+    {
+        for (const FSEGuildMember& Member : Table.Members)
+        {
+            PlayerIndex.Remove(Member.PlayerID);
+        }
+    }
+}
+
+FSEEntityID FSEGuildMembershipStore::GetGuild(const FSEEntityID& PlayerID) const
+{
+    const FPlayerSlot* Slot = PlayerIndex.Find(PlayerID);
+    return Slot ? Slot->GuildID : FSEEntityID();
+}
+
+bool FSEGuildMembershipStore::GetRank(const FSEEntityID& PlayerID, EGuildRank& OutRank) const
+{
+    const FPlayerSlot* Slot = PlayerIndex.Find(PlayerID);
+    if (!Slot)
+    {
+        return false;
+    }
+
+    OutRank = Tables.FindChecked(Slot->GuildID).Members[Slot->Row].Rank;
+    return true;
+}
+
+TArrayView<const FSEGuildMember> FSEGuildMembershipStore::GetMembers(const FSEEntityID& GuildID) const
+{
+    const FMemberTable* Table = Tables.Find(GuildID);
+    return Table ? TArrayView<const FSEGuildMember>(Table->Members) : TArrayView<const FSEGuildMember>();
+}
+
+int32 FSEGuildMembershipStore::NumMembers(const FSEEntityID& GuildID) const
+{
+    const FMemberTable* Table = Tables.Find(GuildID);
+    return Table ? Table->Members.Num() : 0;
+}
+
+FSEEntityID FSEGuildMembershipStore::FindHighestRanked(const FSEEntityID& GuildID) const
+{
+    const FSEGuildMember* Best = nullptr;
+    for (const FSEGuildMember& Member : GetMembers(GuildID))
+    {
+        if (!Best || Member.Rank > Best->Rank)
+        {
+            Best = &Member;
+        }
+    }
+    return Best ? Best->PlayerID : FSEEntityID();
+}
+
+const FSEGuildMemberAggregate* FSEGuildMembershipStore::GetAggregate(const FSEEntityID& GuildID) const
+{
+    const FMemberTable* Table = Tables.Find(GuildID);
+    return Table ? &Table->Aggregate : nullptr;
+}
+
+SIZE_T FSEGuildMembershipStore::GetAllocatedSize() const
+{
+    SIZE_T Size = Tables.GetAllocatedSize() + PlayerIndex.GetAllocatedSize();
+    for (const auto& Pair : Tables)
+    {
+        Size += Pair.Value.Members.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FSEGuildMembershipStore::Reset()
+{
+    Tables.Reset();
+    PlayerIndex.Reset();
+}
@@ -0,0 +1,99 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SEEntityID.h"
+
+enum class EGuildRank : uint8;
+
+/** One row of a guild's member table */
+struct FSEGuildMember
+{
+    FSEEntityID PlayerID;
+    EGuildRank Rank{};
+
+    friend FArchive& operator<<(FArchive& Ar, FSEGuildMember& Member)
+    {
+        uint8 Rank = static_cast<uint8>(Member.Rank);
+        Ar << Member.PlayerID << Rank;
+        Member.Rank = static_cast<EGuildRank>(Rank);
+        return Ar;
+    }
+};
+
+/** Running totals over a guild's members, kept current on every change */
+struct FSEGuildMemberAggregate
+{
+    int32 NumMembers = 0;
+
+    /** Sum of (rank + 1) over members, so leaders count for more */
+    int32 RankWeight = 0;
+
+    /** Members per EGuildRank value */
+    int32 NumByRank[4] = {};
+};
+
+/**
+ * Guild membership store
+ *
+ * Each guild has a dense member table with rank stored alongside, and a player-to-guild
+ * index records which guild and row every player is in. Rows swap-remove and the moved
+ * player's index entry is patched, so finding a player's guild, adding, removing and
+ * changing rank are all O(1) regardless of guild count or size. Per-guild aggregates are
+ * adjusted by the same operations rather than recomputed from the table.
+ */
+class SHADOWECHOES_API FSEGuildMembershipStore
+{
+public:
+    /** Add a player who is not in any guild; false if they already are */
+    bool AddMember(const FSEEntityID& GuildID, const FSEEntityID& PlayerID, EGuildRank Rank);
+
+    /** Remove a player from their guild; returns the guild they left, or the invalid ID */
+    FSEEntityID RemoveMember(const FSEEntityID& PlayerID);
+
+    bool SetRank(const FSEEntityID& PlayerID, EGuildRank Rank);
+
+    /** Drop a guild and clear the index entries of everyone in it */
+    void RemoveGuild(const FSEEntityID& GuildID);
+
+    /** Guild the player is in, or the invalid ID */
+    FSEEntityID GetGuild(const FSEEntityID& PlayerID) const;
+    bool IsMember(const FSEEntityID& GuildID, const FSEEntityID& PlayerID) const { return PlayerID.IsValid() && GetGuild(PlayerID) == GuildID; }
+
+    /** False if the player is not in a guild */
+    bool GetRank(const FSEEntityID& PlayerID, EGuildRank& OutRank) const;
+
+    /** Member table in no particular order; empty for unknown guilds */
+    TArrayView<const FSEGuildMember> GetMembers(const FSEEntityID& GuildID) const;
+    int32 NumMembers(const FSEEntityID& GuildID) const;
+
+    /** Highest-ranked member, or the invalid ID for an empty guild */
+    FSEEntityID FindHighestRanked(const FSEEntityID& GuildID) const;
+
+    const FSEGuildMemberAggregate* GetAggregate(const FSEEntityID& GuildID) const;
+
+    int32 NumGuilds() const { return Tables.Num(); }
+    int32 NumPlayers() const { return PlayerIndex.Num(); }
+    SIZE_T GetAllocatedSize() const;
+
+    void Reset();
+
+private:
+    struct FMemberTable
+    {
+        TArray<FSEGuildMember> Members;
+        FSEGuildMemberAggregate Aggregate;
+    };
+
+    struct FPlayerSlot
+    {
+        FSEEntityID GuildID;
+        int32 Row = INDEX_NONE;
+    };
+
+    static void AddToAggregate(FSEGuildMemberAggregate& Aggregate, EGuildRank Rank, int32 Sign);
+
+    TMap<FSEEntityID, FMemberTable> Tables;
+    TMap<FSEEntityID, FPlayerSlot> PlayerIndex;
+};
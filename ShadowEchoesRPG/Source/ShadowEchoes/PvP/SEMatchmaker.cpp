@@ -0,0 +1,212 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "PvP/SEMatchmaker.h"
+#include "Core/SETypes.h"
+#include "Algo/BinarySearch.h"
+
+FSEMatchmaker::FSEMatchmaker(const FSEMatchmakingSettings& InSettings)
+    : Settings(InSettings)
+    , NextSerial(1)
+{
+    Settings.BucketWidth = FMath::Max(Settings.BucketWidth, 1);
+    Settings.MaxRating = FMath::Max(Settings.MaxRating, 0);
+
+    for (FQueue& Queue : Queues)
+    {
+        Queue.Buckets.SetNum(GetBucket(Settings.MaxRating) + 1);
+    }
+}
+
+int32 FSEMatchmaker::GetQueueIndex(bool bRanked, ETimelineState Timeline)
+{
+    const int32 TimelineIndex = static_cast<int32>(Timeline);
+    check(TimelineIndex >= 0 && TimelineIndex < NumTimelines);
+    return (bRanked ? NumTimelines : 0) + TimelineIndex;
+}
+
+float FSEMatchmaker::GetSearchWindow(double WaitSeconds) const
+{
+    return FMath::Min(Settings.MaxWindow, Settings.BaseWindow + Settings.WindowGrowthPerSecond * static_cast<float>(FMath::Max(WaitSeconds, 0.0)));
+}
+
+bool FSEMatchmaker::Enqueue(const FSEEntityID& PlayerID, int32 Rating, bool bRanked, ETimelineState Timeline, double Now)
+{
+    if (!PlayerID.IsValid() || PlayerIndex.Contains(PlayerID))
+    {
+        return false;
+    }
+
+    FEntry Entry;
+    Entry.PlayerID = PlayerID;
+    Entry.Rating = FMath::Clamp(Rating, 0, Settings.MaxRating);
+    Entry.Serial = NextSerial++;
+    Entry.Queue = static_cast<uint8>(GetQueueIndex(bRanked, Timeline));
+    Entry.EnqueueTime = Now;
+
+    const int32 Index = Entries.Add(Entry);
+    PlayerIndex.Add(PlayerID, Index);
+
+    // Keep the bucket sorted so the nearest rating is a binary search away
+    FQueue& Queue = Queues[Entry.Queue];
+    TArray<FSlot>& Bucket = Queue.Buckets[GetBucket(Entry.Rating)];
+    const int32 Position = Algo::UpperBoundBy(Bucket, Entry.Rating, &FSlot::Rating);
+    Bucket.Insert({ Entry.Rating, Index }, Position);
+    Queue.Order.Add({ Index, Entry.Serial });
+    ++Queue.Num;
+    return true;
+}
+
+bool FSEMatchmaker::Remove(const FSEEntityID& PlayerID)
+{
+    const int32* Index = PlayerIndex.Find(PlayerID);
+    if (!Index)
+    {
+        return false;
+    }
+
+    // The ticket in the order list goes stale and is dropped on the next pass
+    RemoveEntry(*Index);
+    return true;
+}
+
+void FSEMatchmaker::RemoveEntry(int32 Index)
+{
+    const FEntry& Entry = Entries[Index];
+    FQueue& Queue = Queues[Entry.Queue];
+    TArray<FSlot>& Bucket = Queue.Buckets[GetBucket(Entry.Rating)];
+
+    for (int32 Position = Algo::LowerBoundBy(Bucket, Entry.Rating, &FSlot::Rating); Position < Bucket.Num(); ++Position)
+    {
+        if (Bucket[Position].Entry == Index)
+        {
+            Bucket.RemoveAt(Position, 1, false);
+            break;
+        }
+    }
+
+    --Queue.Num;
+    PlayerIndex.Remove(Entry.PlayerID);
+    Entries.RemoveAt(Index);
+}
+
+int32 FSEMatchmaker::FindNearest(const FQueue& Queue, int32 Rating, int32 Window, int32 Exclude) const
+{
+    int32 Best = INDEX_NONE;
+    int32 BestDistance = Window + 1;
+
+    auto Consider = [&Best, &BestDistance, Rating](const FSlot& Slot)
+    {
+        const int32 Distance = FMath::Abs(Slot.Rating - Rating);
+        if (Distance < BestDistance)
+        {
+            Best = Slot.Entry;
+            BestDistance = Distance;
+        }
+    };
+
+    // Step 1: Own bucket, either side of the rating; only the excluded entry is skipped
+    const int32 Home = GetBucket(Rating);
+    const TArray<FSlot>& HomeBucket = Queue.Buckets[Home];
+    const int32 Position = Algo::LowerBoundBy(HomeBucket, Rating, &FSlot::Rating);
+    for (int32 Up = Position; Up < HomeBucket.Num(); ++Up)
+    {
+        if (HomeBucket[Up].Entry != Exclude)
+        {
+            Consider(HomeBucket[Up]);
+            break;
+        }
+    }
+    for (int32 Down = Position - 1; Down >= 0; --Down)
+    {
+        if (HomeBucket[Down].Entry != Exclude)
+        {
+            Consider(HomeBucket[Down]);
+            break;
+        }
+    }
+
+    // Step 2: Neighbouring buckets outward, while they can still hold something closer
+    const int32 Width = Settings.BucketWidth;
+    for (int32 Step = 1; ; ++Step)
+    {
+        const int32 Below = Home - Step;
+        const int32 Above = Home + Step;
+        const int32 BelowDistance = Below >= 0 ? Rating - ((Below + 1) * Width - 1) : MAX_int32;
+        const int32 AboveDistance = Above < Queue.Buckets.Num() ? Above * Width - Rating : MAX_int32;
+        if (BelowDistance >= BestDistance && AboveDistance >= BestDistance)
+        {
+            break;
+        }
+
+        if (BelowDistance < BestDistance && Queue.Buckets[Below].Num() > 0)
+        {
+            Consider(Queue.Buckets[Below].Last());
+        }
+        if (AboveDistance < BestDistance && Queue.Buckets[Above].Num() > 0)
+        {
+            Consider(Queue.Buckets[Above][0]);
+        }
+    }
+
+    return Best;
+}
+
+int32 FSEMatchmaker::FormMatches(double Now, TArray<FSEArenaPairing>& OutPairings)
+{
+    const int32 NumBefore = OutPairings.Num();
+
+    for (int32 QueueIndex = 0; QueueIndex < NumQueues; ++QueueIndex)
+    {
+        FQueue& Queue = Queues[QueueIndex];
+        if (Queue.Num < 2)
+        {
+            continue;
+        }
+
+        // Longest wait first; their windows are the widest
+        for (const FTicket& Ticket : Queue.Order)
+        {
+            if (Queue.Num < 2)
+            {
+                break;
+            }
+            if (!IsLive(Ticket))
+            {
+                continue;
+            }
+
+            const FEntry& Seeker = Entries[Ticket.Entry];
+            const double Wait = Now - Seeker.EnqueueTime;
+            const int32 Window = FMath::FloorToInt(GetSearchWindow(Wait));
+            const int32 Opponent = FindNearest(Queue, Seeker.Rating, Window, Ticket.Entry);
+            if (Opponent == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const FEntry& Other = Entries[Opponent];
+            FSEArenaPairing& Pairing = OutPairings.AddDefaulted_GetRef();
+            Pairing.Players[0] = Seeker.PlayerID;
+            Pairing.Players[1] = Other.PlayerID;
+            Pairing.Ratings[0] = Seeker.Rating;
+            Pairing.Ratings[1] = Other.Rating;
+            Pairing.WaitSeconds[0] = static_cast<float>(Wait);
+            Pairing.WaitSeconds[1] = static_cast<float>(Now - Other.EnqueueTime);
+            Pairing.bRanked = QueueIndex >= NumTimelines;
+            Pairing.Timeline = static_cast<ETimelineState>(QueueIndex % NumTimelines);
+
+            RemoveEntry(Ticket.Entry);
+            RemoveEntry(Opponent);
+        }
+
+        // Drop matched and departed tickets; survivors keep their order
+        Queue.Order.RemoveAll([this](const FTicket& Ticket) { return !IsLive(Ticket); });
+    }
+
+    return OutPairings.Num() - NumBefore;
+}
+
+int32 FSEMatchmaker::NumInQueue(bool bRanked, ETimelineState Timeline) const
+{
+    return Queues[GetQueueIndex(bRanked, Timeline)].Num;
+}
@@ -0,0 +1,120 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SEEntityID.h"
+
+enum class ETimelineState : uint8;
+
+struct FSEMatchmakingSettings
+{
+    /** Rating difference accepted the moment a player queues */
+    float BaseWindow = 50.0f;
+
+    /** Window growth per second of waiting */
+    float WindowGrowthPerSecond = 10.0f;
+
+    /** Window never grows past this */
+    float MaxWindow = 600.0f;
+
+    /** Width of one rating bucket; ratings are clamped to [0, MaxRating] */
+    int32 BucketWidth = 25;
+    int32 MaxRating = 5000;
+};
+
+/** Two players paired by FormMatches */
+struct FSEArenaPairing
+{
+    FSEEntityID Players[2];
+    int32 Ratings[2] = {};
+    float WaitSeconds[2] = {};
+    bool bRanked = false;
+    ETimelineState Timeline{};
+};
+
+/**
+ * Arena matchmaking queues
+ *
+ * Players queue into one of six partitions, ranked or unranked by preferred timeline. Each
+ * partition keeps its players in fixed-width rating buckets, each sorted by rating, so the
+ * nearest opponent is a binary search in the player's own bucket and a look at the ends of
+ * the buckets inside the search window. FormMatches runs on a fixed cadence and pairs the
+ * longest-waiting players first, each with a window that widens with time in queue.
+ */
+class SHADOWECHOES_API FSEMatchmaker
+{
+public:
+    explicit FSEMatchmaker(const FSEMatchmakingSettings& InSettings = FSEMatchmakingSettings());
+
+    /** Queue a player; false if they are already queued */
+    bool Enqueue(const FSEEntityID& PlayerID, int32 Rating, bool bRanked, ETimelineState Timeline, double Now);
+
+    /** Leave the queue; false if the player was not in it */
+    bool Remove(const FSEEntityID& PlayerID);
+
+    bool IsQueued(const FSEEntityID& PlayerID) const { return PlayerIndex.Contains(PlayerID); }
+
+    /** Pair everyone who has an opponent inside their window; returns the number of pairings added */
+    int32 FormMatches(double Now, TArray<FSEArenaPairing>& OutPairings);
+
+    /** Rating difference accepted after waiting this long */
+    float GetSearchWindow(double WaitSeconds) const;
+
+    int32 Num() const { return PlayerIndex.Num(); }
+    int32 NumInQueue(bool bRanked, ETimelineState Timeline) const;
+
+    const FSEMatchmakingSettings& GetSettings() const { return Settings; }
+
+private:
+    /** Timelines a partition can prefer: Bright, Dark and Any */
+    static constexpr int32 NumTimelines = 3;
+    static constexpr int32 NumQueues = 2 * NumTimelines;
+
+    struct FEntry
+    {
+        FSEEntityID PlayerID;
+        int32 Rating = 0;
+        uint32 Serial = 0;
+        uint8 Queue = 0;
+        double EnqueueTime = 0.0;
+    };
+
+    /** Bucket slot; sorted by rating, then entry */
+    struct FSlot
+    {
+        int32 Rating;
+        int32 Entry;
+    };
+
+    /** Queue position; the serial detects entries freed and reused since */
+    struct FTicket
+    {
+        int32 Entry;
+        uint32 Serial;
+    };
+
+    struct FQueue
+    {
+        TArray<TArray<FSlot>> Buckets;
+
+        /** Oldest first */
+        TArray<FTicket> Order;
+
+        int32 Num = 0;
+    };
+
+    static int32 GetQueueIndex(bool bRanked, ETimelineState Timeline);
+    int32 GetBucket(int32 Rating) const { return Rating / Settings.BucketWidth; }
+    bool IsLive(const FTicket& Ticket) const { return Entries.IsAllocated(Ticket.Entry) && Entries[Ticket.Entry].Serial == Ticket.Serial; }
+
+    /** Nearest entry within Window of Rating, other than Exclude; INDEX_NONE if none */
+    int32 FindNearest(const FQueue& Queue, int32 Rating, int32 Window, int32 Exclude) const;
+    void RemoveEntry(int32 Entry);
+
+    FSEMatchmakingSettings Settings;
+    TSparseArray<FEntry> Entries;
+    TMap<FSEEntityID, int32> PlayerIndex;
+    FQueue Queues[NumQueues];
+    uint32 NextSerial;
+};
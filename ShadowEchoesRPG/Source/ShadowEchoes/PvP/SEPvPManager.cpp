@@ -2,14 +2,25 @@
 
 #include "PvP/SEPvPManager.h"
 #include "Core/SEGameInstance.h"
+#include "ShadowEchoes.h"
+#include "SaveGame/SEWorldDatabase.h"
+#include "Systems/SEJobScheduler.h"
 #include "Systems/TimelineManager.h"
 #include "Engine/DataTable.h"
-#include "Kismet/GameplayStatics.h"
+
+namespace SEPvPManager
+{
+    /** Lockout store content key of the invasion cooldown */
+    static const FName InvasionLockout(TEXT("Invasion"));
+}
 
 USEPvPManager::USEPvPManager()
     : InvasionCooldown(300.0f)  // 5 minutes between invasions
     , MaxSimultaneousInvasions(3)
     , ArenaMatchDuration(600.0f)  // 10 minute matches
+    , MatchmakingInterval(5.0f)
+    , RatingPeriodLength(86400.0f)  // Daily rating periods
+    , WarScorePublishInterval(1.0f)
 {
 }
 
@@ -21,28 +32,27 @@ void USEPvPManager::Initialize(USEGameInstance* InGameInstance)
         TimelineManager = GameInstance->GetTimelineManager();
     }
 
-    // Start matchmaking loop
-    FTimerHandle MatchmakingTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        MatchmakingTimer,
-        this,
-        &USEPvPManager::ProcessMatchmaking,
-        5.0f,  // Check every 5 seconds
-        true
-    );
+    LoadWarScores();
+    SyncRatingPeriod();
+    LoadRatings();
 
-    // Start timeline war update loop
-    FTimerHandle WarTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        WarTimer,
-        this,
-        &USEPvPManager::UpdateTimelineWar,
-        60.0f,  // Update every minute
-        true
-    );
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        // Matches form in batches; players are waiting on it
+        Scheduler->AddJob(TEXT("PvP.Matchmaking"), MatchmakingInterval, ESEJobPriority::High,
+            [this](const FSEJobBudget&) { ProcessMatchmaking(); return true; }, this);
+
+        // Scores land in shards from any thread; the UI and dominance read the published totals
+        Scheduler->AddJob(TEXT("PvP.WarScores"), WarScorePublishInterval, ESEJobPriority::Normal,
+            [this](const FSEJobBudget&) { PublishWarScores(); return true; }, this);
+
+        // Timeline war update every minute
+        Scheduler->AddJob(TEXT("PvP.TimelineWar"), 60.0f, ESEJobPriority::Low,
+            [this](const FSEJobBudget&) { UpdateTimelineWar(); return true; }, this);
+    }
 }
 
-bool USEPvPManager::StartInvasion(const FString& InvaderID, const FString& TargetID)
+bool USEPvPManager::StartInvasion(const FSEEntityID& InvaderID, const FSEEntityID& TargetID)
 {
     // FromSoftware-style: Invasions are high-stakes encounters
     if (!ValidateInvasion(InvaderID, TargetID))
@@ -73,7 +83,10 @@ bool USEPvPManager::StartInvasion(const FString& InvaderID, const FString& Targe
     ActiveInvasions.Add(InvaderID, Invasion);
 
     // Set cooldown
-    InvasionCooldowns.Add(InvaderID, UGameplayStatics::GetRealTimeSeconds(GetWorld()));
+    if (GameInstance)
+    {
+        GameInstance->GetLockouts().Add(InvaderID, SEPvPManager::InvasionLockout, FSELockoutStore::Now() + static_cast<int64>(InvasionCooldown));
+    }
 
     // Notify invasion start
     OnInvasionStarted.Broadcast(Invasion);
@@ -82,7 +95,7 @@ bool USEPvPManager::StartInvasion(const FString& InvaderID, const FString& Targe
     return true;
 }
 
-void USEPvPManager::EndInvasion(const FString& InvasionID, const FString& WinnerID)
+void USEPvPManager::EndInvasion(const FSEEntityID& InvasionID, const FSEEntityID& WinnerID)
 {
     if (!ActiveInvasions.Contains(InvasionID))
     {
@@ -94,17 +107,21 @@ void USEPvPManager::EndInvasion(const FString& InvasionID, const FString& Winner
     // Calculate and grant rewards
     CalculateRewards(WinnerID, EPvPMode::TimelineInvasion);
 
-    // Update rankings
-    int32 WinnerRank = GetPlayerRank(WinnerID);
-    int32 LoserRank = GetPlayerRank(WinnerID == Invasion.InvaderID ? Invasion.TargetID : Invasion.InvaderID);
-    int32 RankChange = CalculateRankChange(WinnerRank, LoserRank);
-    UpdatePlayerRank(WinnerID, RankChange);
+    // Update rankings; an invasion that times out is a draw
+    if (WinnerID.IsValid())
+    {
+        RecordRatedResult(WinnerID, WinnerID == Invasion.InvaderID ? Invasion.TargetID : Invasion.InvaderID, 1.0);
+    }
+    else
+    {
+        RecordRatedResult(Invasion.InvaderID, Invasion.TargetID, 0.5);
+    }
 
     // Cleanup invasion
     ActiveInvasions.Remove(InvasionID);
 }
 
-bool USEPvPManager::CanInvade(const FString& PlayerID) const
+bool USEPvPManager::CanInvade(const FSEEntityID& PlayerID) const
 {
     // FromSoftware-style: Invasion requirements are strict
     if (ActiveInvasions.Num() >= MaxSimultaneousInvasions)
@@ -113,14 +130,9 @@ bool USEPvPManager::CanInvade(const FString& PlayerID) const
     }
 
     // Check cooldown
-    if (InvasionCooldowns.Contains(PlayerID))
+    if (GameInstance && GameInstance->GetLockouts().IsLockedOut(PlayerID, SEPvPManager::InvasionLockout, FSELockoutStore::Now()))
     {
-        float LastInvasionTime = InvasionCooldowns[PlayerID];
-        float CurrentTime = UGameplayStatics::GetRealTimeSeconds(GetWorld());
-        if (CurrentTime - LastInvasionTime < InvasionCooldown)
-        {
-            return false;
-        }
+        return false;
     }
 
     // Check player requirements (level, items, etc.)
@@ -129,7 +141,7 @@ bool USEPvPManager::CanInvade(const FString& PlayerID) const
     return true;
 }
 
-bool USEPvPManager::QueueForArena(const FString& PlayerID, bool bRanked)
+bool USEPvPManager::QueueForArena(const FSEEntityID& PlayerID, bool bRanked)
 {
     // FromSoftware-style: Arena matches are skill-based
     if (!GameInstance)
@@ -137,24 +149,25 @@ bool USEPvPManager::QueueForArena(const FString& PlayerID, bool bRanked)
         return false;
     }
 
-    // Validate player requirements
-    int32 PlayerRank = GetPlayerRank(PlayerID);
-    if (bRanked && PlayerRank < 1000)  // Minimum rank requirement
-    {
-        return false;
-    }
+    // Ranked is open to everyone: new players start at 1500 with full deviation, so their
+    // first matches place them quickly
+    const int32 PlayerRank = GetPlayerRank(PlayerID);
 
-    // Add to matchmaking queue
-    // This would be handled by the matchmaking system
+    // Queue by preferred timeline; players in no timeline wait in the Any partition
+    const ETimelineState Timeline = TimelineManager ? TimelineManager->GetPlayerTimeline(PlayerID) : ETimelineState::Any;
+    return Matchmaker.Enqueue(PlayerID, PlayerRank, bRanked, Timeline, FPlatformTime::Seconds());
+}
 
-    return true;
+bool USEPvPManager::LeaveArenaQueue(const FSEEntityID& PlayerID)
+{
+    return Matchmaker.Remove(PlayerID);
 }
 
-void USEPvPManager::StartArenaMatch(const FPvPMatchData& MatchData)
+bool USEPvPManager::StartArenaMatch(const FPvPMatchData& MatchData)
 {
     if (!ValidateArenaMatch(MatchData))
     {
-        return;
+        return false;
     }
 
     // Set up match
@@ -166,7 +179,7 @@ void USEPvPManager::StartArenaMatch(const FPvPMatchData& MatchData)
         MatchTimer,
         [this, MatchData]()
         {
-            EndArenaMatch(MatchData.MatchID, "");  // Time limit reached
+            EndArenaMatch(MatchData.MatchID, FSEEntityID());  // Time limit reached
         },
         ArenaMatchDuration,
         false
@@ -175,9 +188,10 @@ void USEPvPManager::StartArenaMatch(const FPvPMatchData& MatchData)
     // Notify match start
     OnMatchStarted.Broadcast(MatchData);
     BP_OnMatchStarted(MatchData);
+    return true;
 }
 
-void USEPvPManager::EndArenaMatch(const FString& MatchID, const FString& WinnerID)
+void USEPvPManager::EndArenaMatch(const FSEEntityID& MatchID, const FSEEntityID& WinnerID)
 {
     if (!ActiveMatches.Contains(MatchID))
     {
@@ -189,27 +203,31 @@ void USEPvPManager::EndArenaMatch(const FString& MatchID, const FString& WinnerI
     // Calculate rewards
     CalculateRewards(WinnerID, EPvPMode::ArenaMatch);
 
-    // Update rankings for ranked matches
+    // Update rankings for ranked matches; the winner beat everyone else, a timeout is a draw
     if (MatchData.bIsRanked)
     {
-        for (const FString& PlayerID : MatchData.PlayerIDs)
+        if (WinnerID.IsValid())
         {
-            if (PlayerID == WinnerID)
-            {
-                UpdatePlayerRank(PlayerID, 25);  // Base rank gain
-            }
-            else
+            for (const FSEEntityID& PlayerID : MatchData.PlayerIDs)
             {
-                UpdatePlayerRank(PlayerID, -20);  // Base rank loss
+                if (PlayerID != WinnerID)
+                {
+                    RecordRatedResult(WinnerID, PlayerID, 1.0);
+                }
             }
         }
+        else if (MatchData.PlayerIDs.Num() == 2)
+        {
+            RecordRatedResult(MatchData.PlayerIDs[0], MatchData.PlayerIDs[1], 0.5);
+        }
     }
 
-    // Cleanup match
+    // Cleanup match; match IDs only live as long as the match
     ActiveMatches.Remove(MatchID);
+    FSEEntityID::Release(MatchData.MatchID);
 }
 
-bool USEPvPManager::JoinTimelineWar(const FString& PlayerID, ETimelineState Timeline)
+bool USEPvPManager::JoinTimelineWar(const FSEEntityID& PlayerID, ETimelineState Timeline)
 {
     // FromSoftware-style: Timeline Wars are epic-scale conflicts
     if (!TimelineManager)
@@ -230,18 +248,20 @@ bool USEPvPManager::JoinTimelineWar(const FString& PlayerID, ETimelineState Time
     return true;
 }
 
-void USEPvPManager::UpdateWarProgress(ETimelineState Timeline, int32 Points)
+void USEPvPManager::UpdateWarProgress(ETimelineState Timeline, int32 Points, FName Region)
 {
-    if (!TimelineWarScores.Contains(Timeline))
-    {
-        TimelineWarScores.Add(Timeline, 0);
-    }
+    WarScores.AddPoints(Timeline, WarScores.FindOrAddRegion(Region), Points);
+}
 
-    TimelineWarScores[Timeline] += Points;
+void USEPvPManager::PublishWarScores()
+{
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Previous = WarScores.GetSnapshot();
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Current = WarScores.Publish();
+    PersistWarScores(*Previous, *Current);
 
-    // Check for timeline dominance
-    int32 DarkScore = TimelineWarScores[ETimelineState::DarkWorld];
-    int32 LightScore = TimelineWarScores[ETimelineState::BrightWorld];
+    // Check for timeline dominance against one consistent set of totals
+    const int32 DarkScore = Current->GetScore(ETimelineState::DarkWorld);
+    const int32 LightScore = Current->GetScore(ETimelineState::BrightWorld);
 
     // Apply timeline war effects based on scores
     if (FMath::Abs(DarkScore - LightScore) > 1000)
@@ -249,21 +269,64 @@ void USEPvPManager::UpdateWarProgress(ETimelineState Timeline, int32 Points)
         // Timeline dominance effects
     }
 
-    BP_OnTimelineWarUpdate(Timeline, TimelineWarScores[Timeline]);
+    for (int32 TimelineIndex = 0; TimelineIndex < FSEWarScoreSnapshot::NumTimelines; ++TimelineIndex)
+    {
+        if (Current->TimelineScores[TimelineIndex] != Previous->TimelineScores[TimelineIndex])
+        {
+            BP_OnTimelineWarUpdate(static_cast<ETimelineState>(TimelineIndex), Current->TimelineScores[TimelineIndex]);
+        }
+    }
+}
+
+int32 USEPvPManager::GetPlayerRank(const FSEEntityID& PlayerID) const
+{
+    return FMath::RoundToInt(Ratings.GetRating(PlayerID).Rating);
+}
+
+void USEPvPManager::UpdatePlayerRank(const FSEEntityID& PlayerID, int32 RankChange)
+{
+    if (!PlayerID.IsValid())
+    {
+        return;
+    }
+
+    SyncRatingPeriod();
+    FSEGlickoRating Rating = Ratings.GetRating(PlayerID);
+    Rating.Rating = FMath::Max(0.0, Rating.Rating + RankChange);
+    Ratings.SetRating(PlayerID, Rating);
+    PersistRating(PlayerID);
 }
 
-int32 USEPvPManager::GetPlayerRank(const FString& PlayerID) const
+TArray<FSEEntityID> USEPvPManager::GetLeaderboardTop(int32 Count) const
 {
-    // This would be handled by the ranking system
-    return 1000;  // Default rank
+    TArray<FSEEntityID> Players;
+    Ratings.GetTopPlayers(Count, Players);
+    return Players;
 }
 
-void USEPvPManager::UpdatePlayerRank(const FString& PlayerID, int32 RankChange)
+TArray<FSEEntityID> USEPvPManager::GetLeaderboardAround(const FSEEntityID& PlayerID, int32 Radius) const
 {
-    // This would be handled by the ranking system
+    TArray<FSEEntityID> Players;
+    Ratings.GetPlayersAround(PlayerID, Radius, Players);
+    return Players;
 }
 
-bool USEPvPManager::ValidateInvasion(const FString& InvaderID, const FString& TargetID) const
+void USEPvPManager::RecordRatedResult(const FSEEntityID& PlayerA, const FSEEntityID& PlayerB, double ScoreA)
+{
+    SyncRatingPeriod();
+    Ratings.RecordResult(PlayerA, PlayerB, ScoreA);
+    PersistRating(PlayerA);
+    PersistRating(PlayerB);
+}
+
+void USEPvPManager::SyncRatingPeriod()
+{
+    // Periods follow the wall clock so they line up across restarts; idle players age on read
+    const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+    Ratings.SetCurrentPeriod(static_cast<int32>(Now / FMath::Max(FMath::RoundToInt64(RatingPeriodLength), 1LL)));
+}
+
+bool USEPvPManager::ValidateInvasion(const FSEEntityID& InvaderID, const FSEEntityID& TargetID) const
 {
     if (!TimelineManager)
     {
@@ -296,7 +359,7 @@ bool USEPvPManager::ValidateArenaMatch(const FPvPMatchData& MatchData) const
     // Check rank requirements for ranked matches
     if (MatchData.bIsRanked)
     {
-        for (const FString& PlayerID : MatchData.PlayerIDs)
+        for (const FSEEntityID& PlayerID : MatchData.PlayerIDs)
         {
             if (GetPlayerRank(PlayerID) < MatchData.RankThreshold)
             {
@@ -311,17 +374,41 @@ bool USEPvPManager::ValidateArenaMatch(const FPvPMatchData& MatchData) const
 void USEPvPManager::ProcessMatchmaking()
 {
     // FromSoftware-style: Matchmaking considers timeline alignment
-    // This would handle arena match creation
+    TArray<FSEArenaPairing> Pairings;
+    const double Now = FPlatformTime::Seconds();
+    if (Matchmaker.FormMatches(Now, Pairings) == 0)
+    {
+        return;
+    }
+
+    for (const FSEArenaPairing& Pairing : Pairings)
+    {
+        FPvPMatchData MatchData;
+        MatchData.MatchID = FSEEntityID::NewID();
+        MatchData.Mode = EPvPMode::ArenaMatch;
+        MatchData.PlayerIDs = { Pairing.Players[0], Pairing.Players[1] };
+        MatchData.Timeline = Pairing.Timeline;
+        MatchData.bIsRanked = Pairing.bRanked;
+        MatchData.RankThreshold = 0;  // Checked when they queued
+        if (StartArenaMatch(MatchData))
+        {
+            continue;
+        }
+
+        // FormMatches already took both players off the queue; put them back where they were
+        FSEEntityID::Release(MatchData.MatchID);
+        for (int32 Index = 0; Index < 2; ++Index)
+        {
+            Matchmaker.Enqueue(Pairing.Players[Index], Pairing.Ratings[Index], Pairing.bRanked, Pairing.Timeline, Now - Pairing.WaitSeconds[Index]);
+        }
+    }
 }
 
 void USEPvPManager::UpdateTimelineWar()
 {
-    // Update war progress
-    for (const auto& Pair : TimelineWarScores)
-    {
-        // Natural timeline power decay
-        TimelineWarScores[Pair.Key] = FMath::Max(0, Pair.Value - 10);
-    }
+    // Natural timeline power decay
+    WarScores.Decay(10);
+    PublishWarScores();
 
     // Check for timeline events
     if (FMath::FRand() < 0.1f)  // 10% chance each update
@@ -330,7 +417,7 @@ void USEPvPManager::UpdateTimelineWar()
     }
 }
 
-void USEPvPManager::CalculateRewards(const FString& WinnerID, EPvPMode Mode)
+void USEPvPManager::CalculateRewards(const FSEEntityID& WinnerID, EPvPMode Mode)
 {
     TArray<FName> Rewards;
 
@@ -368,8 +455,9 @@ bool USEPvPManager::CheckTimelineCompatibility(ETimelineState Source, ETimelineS
     }
 
     // Check timeline power balance
-    float SourcePower = TimelineWarScores.Contains(Source) ? TimelineWarScores[Source] : 0.0f;
-    float TargetPower = TimelineWarScores.Contains(Target) ? TimelineWarScores[Target] : 0.0f;
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Scores = WarScores.GetSnapshot();
+    float SourcePower = Scores->GetScore(Source);
+    float TargetPower = Scores->GetScore(Target);
 
     return FMath::Abs(SourcePower - TargetPower) < 1000;  // Prevent invasions during extreme timeline imbalance
 }
@@ -386,20 +474,99 @@ void USEPvPManager::ApplyInvasionEffects(const FInvasionData& Invasion)
     // This would affect both invader and target's worlds
 }
 
-int32 USEPvPManager::CalculateRankChange(int32 WinnerRank, int32 LoserRank) const
+FSEWorldDatabase* USEPvPManager::GetWorldDatabase() const
 {
-    // FromSoftware-style: Ranking system rewards skill
-    float RankDiff = LoserRank - WinnerRank;
-    float BaseChange = 25.0f;
+    return GameInstance ? GameInstance->GetWorldDatabase() : nullptr;
+}
 
-    if (RankDiff > 0)
+void USEPvPManager::LoadWarScores()
+{
+    FSEWorldDatabase* Database = GetWorldDatabase();
+    if (!Database)
     {
-        // Bonus for beating higher ranked players
-        return FMath::RoundToInt(BaseChange * (1.0f + RankDiff / 500.0f));
+        return;
     }
-    else
+
+    // Keyed by the timeline's enum value, with "/Region" appended for region totals
+    Database->LoadAll(ESEWorldTable::WarScores, [this](const FString& Key, const TArray<uint8>& Value)
+    {
+        int32 Score = 0;
+        FMemoryReader Reader(Value);
+        Reader << Score;
+        if (Reader.IsError())
+        {
+            return;
+        }
+
+        FString TimelineKey = Key;
+        FString RegionKey;
+        Key.Split(TEXT("/"), &TimelineKey, &RegionKey);
+        const int32 TimelineIndex = FCString::Atoi(*TimelineKey);
+        if (TimelineIndex >= 0 && TimelineIndex < FSEWarScoreSnapshot::NumTimelines)
+        {
+            WarScores.Restore(static_cast<ETimelineState>(TimelineIndex), RegionKey.IsEmpty() ? NAME_None : FName(*RegionKey), Score);
+        }
+    });
+
+    WarScores.Publish();
+}
+
+void USEPvPManager::PersistWarScores(const FSEWarScoreSnapshot& Previous, const FSEWarScoreSnapshot& Current)
+{
+    FSEWorldDatabase* Database = GetWorldDatabase();
+    if (!Database)
+    {
+        return;
+    }
+
+    // Only totals that moved since the last publish
+    for (int32 TimelineIndex = 0; TimelineIndex < FSEWarScoreSnapshot::NumTimelines; ++TimelineIndex)
+    {
+        if (Current.TimelineScores[TimelineIndex] != Previous.TimelineScores[TimelineIndex])
+        {
+            Database->PutRow(ESEWorldTable::WarScores, FString::FromInt(TimelineIndex), Current.TimelineScores[TimelineIndex]);
+        }
+    }
+
+    // Region 0 is the unassigned breakdown and is not kept
+    for (int32 Cell = FSEWarScoreSnapshot::NumTimelines; Cell < Current.RegionScores.Num(); ++Cell)
+    {
+        const int32 Before = Previous.RegionScores.IsValidIndex(Cell) ? Previous.RegionScores[Cell] : 0;
+        if (Current.RegionScores[Cell] != Before)
+        {
+            const int32 TimelineIndex = Cell % FSEWarScoreSnapshot::NumTimelines;
+            const FName Region = Current.Regions[Cell / FSEWarScoreSnapshot::NumTimelines];
+            Database->PutRow(ESEWorldTable::WarScores, FString::Printf(TEXT("%d/%s"), TimelineIndex, *Region.ToString()), Current.RegionScores[Cell]);
+        }
+    }
+}
+
+void USEPvPManager::LoadRatings()
+{
+    FSEWorldDatabase* Database = GetWorldDatabase();
+    if (!Database)
+    {
+        return;
+    }
+
+    // Every rating is resident; the leaderboard needs all of them
+    Database->LoadAll(ESEWorldTable::PvPRatings, [this](const FString& Key, const TArray<uint8>& Value)
+    {
+        FSEGlickoRating Rating;
+        Rating.Period = Ratings.GetCurrentPeriod();
+        FMemoryReader Reader(Value);
+        Reader << Rating;
+        if (!Reader.IsError())
+        {
+            Ratings.SetRating(FSEEntityID::Intern(Key), Rating);
+        }
+    });
+}
+
+void USEPvPManager::PersistRating(const FSEEntityID& PlayerID)
+{
+    if (FSEWorldDatabase* Database = GetWorldDatabase())
     {
-        // Reduced gain for beating lower ranked players
-        return FMath::RoundToInt(BaseChange * (1.0f + RankDiff / 1000.0f));
+        Database->PutRow(ESEWorldTable::PvPRatings, PlayerID.ToString(), Ratings.GetRating(PlayerID));
     }
 }
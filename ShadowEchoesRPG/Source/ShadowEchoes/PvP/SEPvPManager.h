@@ -4,9 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Core/SEEntityID.h"
+#include "PvP/SEMatchmaker.h"
+#include "PvP/SERatingService.h"
+#include "PvP/SEWarScoreboard.h"
 #include "SEPvPManager.generated.h"
 
 class USEGameInstance;
+class FSEWorldDatabase;
 class UTimelineManager;
 
 UENUM(BlueprintType)
@@ -24,13 +29,13 @@ struct FPvPMatchData
     GENERATED_BODY()
 
     UPROPERTY()
-    FString MatchID;
+    FSEEntityID MatchID;
 
     UPROPERTY()
     EPvPMode Mode;
 
     UPROPERTY()
-    TArray<FString> PlayerIDs;
+    TArray<FSEEntityID> PlayerIDs;
 
     UPROPERTY()
     ETimelineState Timeline;
@@ -51,10 +56,10 @@ struct FInvasionData
     GENERATED_BODY()
 
     UPROPERTY()
-    FString InvaderID;
+    FSEEntityID InvaderID;
 
     UPROPERTY()
-    FString TargetID;
+    FSEEntityID TargetID;
 
     UPROPERTY()
     ETimelineState SourceTimeline;
@@ -74,7 +79,7 @@ struct FInvasionData
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInvasionStarted, const FInvasionData&, InvasionData);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMatchStarted, const FPvPMatchData&, MatchData);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPvPReward, const FString&, WinnerID, const TArray<FName>&, Rewards);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPvPReward, const FSEEntityID&, WinnerID, const TArray<FName>&, Rewards);
 
 /**
  * Manages PvP systems including timeline invasions, arena matches, and timeline wars
@@ -92,37 +97,69 @@ public:
 
     /** Invasion system */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    bool StartInvasion(const FString& InvaderID, const FString& TargetID);
+    bool StartInvasion(const FSEEntityID& InvaderID, const FSEEntityID& TargetID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    void EndInvasion(const FString& InvasionID, const FString& WinnerID);
+    void EndInvasion(const FSEEntityID& InvasionID, const FSEEntityID& WinnerID);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    bool CanInvade(const FString& PlayerID) const;
+    bool CanInvade(const FSEEntityID& PlayerID) const;
 
     /** Arena system */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    bool QueueForArena(const FString& PlayerID, bool bRanked = false);
+    bool QueueForArena(const FSEEntityID& PlayerID, bool bRanked = false);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    void StartArenaMatch(const FPvPMatchData& MatchData);
+    bool LeaveArenaQueue(const FSEEntityID& PlayerID);
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|PvP")
+    bool IsInArenaQueue(const FSEEntityID& PlayerID) const { return Matchmaker.IsQueued(PlayerID); }
+
+    const FSEMatchmaker& GetMatchmaker() const { return Matchmaker; }
+
+    /** False if the match fails validation; the caller still owns its MatchID */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
+    bool StartArenaMatch(const FPvPMatchData& MatchData);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    void EndArenaMatch(const FString& MatchID, const FString& WinnerID);
+    void EndArenaMatch(const FSEEntityID& MatchID, const FSEEntityID& WinnerID);
 
     /** Timeline War system */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    bool JoinTimelineWar(const FString& PlayerID, ETimelineState Timeline);
+    bool JoinTimelineWar(const FSEEntityID& PlayerID, ETimelineState Timeline);
+
+    /** Safe from any thread; scores appear once the next snapshot is published */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
+    void UpdateWarProgress(ETimelineState Timeline, int32 Points, FName Region = NAME_None);
 
+    /** Timeline score as of the last published snapshot */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|PvP")
+    int32 GetWarScore(ETimelineState Timeline) const { return WarScores.GetSnapshot()->GetScore(Timeline); }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|PvP")
+    int32 GetRegionWarScore(ETimelineState Timeline, FName Region) const { return WarScores.GetSnapshot()->GetRegionScore(Timeline, Region); }
+
+    FSEWarScoreboard& GetWarScoreboard() { return WarScores; }
+
+    /** Ranking system; rank is the player's Glicko-2 rating, rounded */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    void UpdateWarProgress(ETimelineState Timeline, int32 Points);
+    int32 GetPlayerRank(const FSEEntityID& PlayerID) const;
+
+    /** Manual adjustment of a player's rating, e.g. by a GM */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
+    void UpdatePlayerRank(const FSEEntityID& PlayerID, int32 RankChange);
+
+    /** One-based leaderboard position, or 0 if unrated */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|PvP")
+    int32 GetLeaderboardPosition(const FSEEntityID& PlayerID) const { return Ratings.GetGlobalRank(PlayerID); }
 
-    /** Ranking system */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    int32 GetPlayerRank(const FString& PlayerID) const;
+    TArray<FSEEntityID> GetLeaderboardTop(int32 Count) const;
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|PvP")
-    void UpdatePlayerRank(const FString& PlayerID, int32 RankChange);
+    TArray<FSEEntityID> GetLeaderboardAround(const FSEEntityID& PlayerID, int32 Radius) const;
+
+    const FSERatingService& GetRatings() const { return Ratings; }
 
     /** Events */
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|PvP|Events")
@@ -145,19 +182,34 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|PvP")
     float ArenaMatchDuration;
 
+    /** Seconds between matchmaking passes */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|PvP")
+    float MatchmakingInterval;
+
+    /** Length of a Glicko-2 rating period in wall-clock seconds; idle players grow less certain at each end */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|PvP")
+    float RatingPeriodLength;
+
+    /** Seconds between war score snapshots */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|PvP")
+    float WarScorePublishInterval;
+
 private:
     /** Current state */
     UPROPERTY()
-    TMap<FString, FInvasionData> ActiveInvasions;
+    TMap<FSEEntityID, FInvasionData> ActiveInvasions;
 
     UPROPERTY()
-    TMap<FString, FPvPMatchData> ActiveMatches;
+    TMap<FSEEntityID, FPvPMatchData> ActiveMatches;
 
-    UPROPERTY()
-    TMap<ETimelineState, int32> TimelineWarScores;
+    /** Arena queues, partitioned by ranked and preferred timeline */
+    FSEMatchmaker Matchmaker;
 
-    UPROPERTY()
-    TMap<FString, float> InvasionCooldowns;
+    /** Glicko-2 ratings and the leaderboard */
+    FSERatingService Ratings;
+
+    /** Sharded Timeline War scoring, published on a fixed cadence */
+    FSEWarScoreboard WarScores;
 
     /** Game instance reference */
     UPROPERTY()
@@ -167,14 +219,23 @@ private:
     UTimelineManager* TimelineManager;
 
     /** Internal functionality */
-    bool ValidateInvasion(const FString& InvaderID, const FString& TargetID) const;
+    bool ValidateInvasion(const FSEEntityID& InvaderID, const FSEEntityID& TargetID) const;
     bool ValidateArenaMatch(const FPvPMatchData& MatchData) const;
     void ProcessMatchmaking();
     void UpdateTimelineWar();
-    void CalculateRewards(const FString& WinnerID, EPvPMode Mode);
+    void PublishWarScores();
+    void CalculateRewards(const FSEEntityID& WinnerID, EPvPMode Mode);
     bool CheckTimelineCompatibility(ETimelineState Source, ETimelineState Target) const;
     void ApplyInvasionEffects(const FInvasionData& Invasion);
-    int32 CalculateRankChange(int32 WinnerRank, int32 LoserRank) const;
+    void RecordRatedResult(const FSEEntityID& PlayerA, const FSEEntityID& PlayerB, double ScoreA);
+    void SyncRatingPeriod();
+
+    /** World database persistence for ranks and war scores */
+    FSEWorldDatabase* GetWorldDatabase() const;
+    void LoadWarScores();
+    void PersistWarScores(const FSEWarScoreSnapshot& Previous, const FSEWarScoreSnapshot& Current);
+    void LoadRatings();
+    void PersistRating(const FSEEntityID& PlayerID);
 
 protected:
     /** Blueprint events */
@@ -185,7 +246,7 @@ protected:
     void BP_OnMatchStarted(const FPvPMatchData& MatchData);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|PvP|Events")
-    void BP_OnPvPReward(const FString& WinnerID, const TArray<FName>& Rewards);
+    void BP_OnPvPReward(const FSEEntityID& WinnerID, const TArray<FName>& Rewards);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|PvP|Events")
     void BP_OnTimelineWarUpdate(ETimelineState Timeline, int32 Points);
@@ -0,0 +1,425 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "PvP/SERatingService.h"
+
+namespace SEGlicko
+{
+    /** Public scale to Glicko-2 scale */
+    static constexpr double Scale = 173.7178;
+
+    /** Convergence tolerance for the volatility iteration */
+    static constexpr double Epsilon = 0.000001;
+
+    static double G(double Phi)
+    {
+        return 1.0 / FMath::Sqrt(1.0 + 3.0 * Phi * Phi / (PI * PI));
+    }
+}
+
+FSERatingLeaderboard::FSERatingLeaderboard()
+    : Root(INDEX_NONE)
+    , Seed(0x9E3779B9u)
+{
+}
+
+void FSERatingLeaderboard::Reset()
+{
+    Nodes.Reset();
+    FreeNodes.Reset();
+    Root = INDEX_NONE;
+}
+
+void FSERatingLeaderboard::Split(int32 Node, double Rating, uint64 Key, int32& OutLeft, int32& OutRight)
+{
+    if (Node == INDEX_NONE)
+    {
+        OutLeft = OutRight = INDEX_NONE;
+        return;
+    }
+
+    FNode& Current = Nodes[Node];
+    if (Precedes(Current.Rating, Current.Player.GetValue(), Rating, Key))
+    {
+        Split(Current.Right, Rating, Key, Current.Right, OutRight);
+        OutLeft = Node;
+    }
+    else
+    {
+        Split(Current.Left, Rating, Key, OutLeft, Current.Left);
+        OutRight = Node;
+    }
+    Update(Node);
+}
+
+void FSERatingLeaderboard::SplitAt(int32 Node, int32 Count, int32& OutLeft, int32& OutRight)
+{
+    if (Node == INDEX_NONE)
+    {
+        OutLeft = OutRight = INDEX_NONE;
+        return;
+    }
+
+    FNode& Current = Nodes[Node];
+    const int32 LeftSize = SizeOf(Current.Left);
+    if (LeftSize < Count)
+    {
+        SplitAt(Current.Right, Count - LeftSize - 1, Current.Right, OutRight);
+        OutLeft = Node;
+    }
+    else
+    {
+        SplitAt(Current.Left, Count, OutLeft, Current.Left);
+        OutRight = Node;
+    }
+    Update(Node);
+}
+
+int32 FSERatingLeaderboard::Merge(int32 Left, int32 Right)
+{
+    if (Left == INDEX_NONE || Right == INDEX_NONE)
+    {
+        return Left == INDEX_NONE ? Right : Left;
+    }
+
+    // Higher priority stays on top, which keeps the expected depth logarithmic
+    if (Nodes[Left].Priority > Nodes[Right].Priority)
+    {
+        const int32 Merged = Merge(Nodes[Left].Right, Right);
+        Nodes[Left].Right = Merged;
+        Update(Left);
+        return Left;
+    }
+
+    const int32 Merged = Merge(Left, Nodes[Right].Left);
+    Nodes[Right].Left = Merged;
+    Update(Right);
+    return Right;
+}
+
+void FSERatingLeaderboard::Insert(const FSEEntityID& PlayerID, double Rating)
+{
+    // xorshift32 priorities; the sequence only needs to look random to the tree
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+
+    const FNode NewNode{ Rating, PlayerID, Seed, 1, INDEX_NONE, INDEX_NONE };
+    int32 Index;
+    if (FreeNodes.Num() > 0)
+    {
+        Index = FreeNodes.Pop(false);
+        Nodes[Index] = NewNode;
+    }
+    else
+    {
+        Index = Nodes.Add(NewNode);
+    }
+
+    int32 Left, Right;
+    Split(Root, Rating, PlayerID.GetValue(), Left, Right);
+    Root = Merge(Merge(Left, Index), Right);
+}
+
+bool FSERatingLeaderboard::Remove(const FSEEntityID& PlayerID, double Rating)
+{
+    // Everything from the key onward, then its first node
+    int32 Left, Rest, Middle, Right;
+    Split(Root, Rating, PlayerID.GetValue(), Left, Rest);
+    SplitAt(Rest, 1, Middle, Right);
+
+    if (Middle == INDEX_NONE || Nodes[Middle].Player != PlayerID)
+    {
+        Root = Merge(Left, Merge(Middle, Right));
+        return false;
+    }
+
+    FreeNodes.Add(Middle);
+    Root = Merge(Left, Right);
+    return true;
+}
+
+int32 FSERatingLeaderboard::GetPosition(const FSEEntityID& PlayerID, double Rating) const
+{
+    const uint64 Key = PlayerID.GetValue();
+    int32 Position = 0;
+    int32 Node = Root;
+    while (Node != INDEX_NONE)
+    {
+        const FNode& Current = Nodes[Node];
+        if (Current.Player == PlayerID)
+        {
+            return Position + SizeOf(Current.Left);
+        }
+
+        if (Precedes(Rating, Key, Current.Rating, Current.Player.GetValue()))
+        {
+            Node = Current.Left;
+        }
+        else
+        {
+            Position += SizeOf(Current.Left) + 1;
+            Node = Current.Right;
+        }
+    }
+    return INDEX_NONE;
+}
+
+FSEEntityID FSERatingLeaderboard::GetAt(int32 Position) const
+{
+    int32 Node = Root;
+    while (Node != INDEX_NONE)
+    {
+        const FNode& Current = Nodes[Node];
+        const int32 LeftSize = SizeOf(Current.Left);
+        if (Position < LeftSize)
+        {
+            Node = Current.Left;
+        }
+        else if (Position == LeftSize)
+        {
+            return Current.Player;
+        }
+        else
+        {
+            Position -= LeftSize + 1;
+            Node = Current.Right;
+        }
+    }
+    return FSEEntityID();
+}
+
+void FSERatingLeaderboard::Collect(int32 Node, int32 Skip, int32& Remaining, TArray<FSEEntityID>& OutPlayers) const
+{
+    if (Node == INDEX_NONE || Remaining <= 0)
+    {
+        return;
+    }
+
+    // Subtrees entirely before the range are skipped by size, not visited
+    const FNode& Current = Nodes[Node];
+    const int32 LeftSize = SizeOf(Current.Left);
+    if (Skip < LeftSize)
+    {
+        Collect(Current.Left, Skip, Remaining, OutPlayers);
+    }
+    if (Remaining > 0 && Skip <= LeftSize)
+    {
+        OutPlayers.Add(Current.Player);
+        --Remaining;
+    }
+    Collect(Current.Right, FMath::Max(0, Skip - LeftSize - 1), Remaining, OutPlayers);
+}
+
+void FSERatingLeaderboard::GetRange(int32 Start, int32 Count, TArray<FSEEntityID>& OutPlayers) const
+{
+    int32 Remaining = FMath::Min(Count, Num() - Start);
+    if (Start < 0 || Remaining <= 0)
+    {
+        return;
+    }
+
+    OutPlayers.Reserve(OutPlayers.Num() + Remaining);
+    Collect(Root, Start, Remaining, OutPlayers);
+}
+
+FSEGlickoRating FSERatingService::Update(const FSEGlickoRating& Player, const FSEGlickoRating& Opponent, double Score)
+{
+    // Step 1: Convert to the Glicko-2 scale
+    const double Mu = (Player.Rating - 1500.0) / SEGlicko::Scale;
+    const double Phi = Player.Deviation / SEGlicko::Scale;
+    const double Sigma = Player.Volatility;
+    const double OpponentMu = (Opponent.Rating - 1500.0) / SEGlicko::Scale;
+    const double OpponentPhi = Opponent.Deviation / SEGlicko::Scale;
+
+    // Step 2: Estimated variance and improvement from this one game
+    const double G = SEGlicko::G(OpponentPhi);
+    const double Expected = 1.0 / (1.0 + FMath::Exp(-G * (Mu - OpponentMu)));
+    const double Variance = 1.0 / (G * G * Expected * (1.0 - Expected));
+    const double Delta = Variance * G * (Score - Expected);
+
+    // Step 3: New volatility by the Illinois method
+    const double PhiSquared = Phi * Phi;
+    const double DeltaSquared = Delta * Delta;
+    const double A = FMath::Loge(Sigma * Sigma);
+    const double TauSquared = Tau * Tau;
+    auto F = [=](double X)
+    {
+        const double ExpX = FMath::Exp(X);
+        const double Denominator = PhiSquared + Variance + ExpX;
+        return ExpX * (DeltaSquared - PhiSquared - Variance - ExpX) / (2.0 * Denominator * Denominator) - (X - A) / TauSquared;
+    };
+
+    double Lower = A;
+    double Upper;
+    if (DeltaSquared > PhiSquared + Variance)
+    {
+        Upper = FMath::Loge(DeltaSquared - PhiSquared - Variance);
+    }
+    else
+    {
+        int32 K = 1;
+        while (F(A - K * Tau) < 0.0)
+        {
+            ++K;
+        }
+        Upper = A - K * Tau;
+    }
+
+    double FLower = F(Lower);
+    double FUpper = F(Upper);
+    for (int32 Iteration = 0; Iteration < 100 && FMath::Abs(Upper - Lower) > SEGlicko::Epsilon; ++Iteration)
+    {
+        const double C = Lower + (Lower - Upper) * FLower / (FUpper - FLower);
+        const double FC = F(C);
+        if (FC * FUpper <= 0.0)
+        {
+            Lower = Upper;
+            FLower = FUpper;
+        }
+        else
+        {
+            FLower *= 0.5;
+        }
+        Upper = C;
+        FUpper = FC;
+    }
+    const double NewSigma = FMath::Exp(Lower * 0.5);
+
+    // Step 4: New deviation and rating, back on the public scale
+    const double PhiStar = FMath::Sqrt(PhiSquared + NewSigma * NewSigma);
+    const double NewPhi = 1.0 / FMath::Sqrt(1.0 / (PhiStar * PhiStar) + 1.0 / Variance);
+    const double NewMu = Mu + NewPhi * NewPhi * G * (Score - Expected);
+
+    FSEGlickoRating Result;
+    Result.Rating = NewMu * SEGlicko::Scale + 1500.0;
+    Result.Deviation = FMath::Clamp(NewPhi * SEGlicko::Scale, MinDeviation, MaxDeviation);
+    Result.Volatility = NewSigma;
+    return Result;
+}
+
+FSEGlickoRating FSERatingService::Age(const FSEGlickoRating& Rating, int32 Period)
+{
+    // The period of the last match ends without growth, and each idle one after adds the
+    // volatility in quadrature; the current period has not ended yet
+    const int32 IdlePeriods = Period - Rating.Period - 1;
+    if (IdlePeriods <= 0)
+    {
+        return Rating;
+    }
+
+    FSEGlickoRating Aged = Rating;
+    const double Phi = Rating.Deviation / SEGlicko::Scale;
+    const double Inflated = FMath::Sqrt(Phi * Phi + IdlePeriods * Rating.Volatility * Rating.Volatility) * SEGlicko::Scale;
+    Aged.Deviation = FMath::Min(Inflated, MaxDeviation);
+    Aged.Period = Period - 1;
+    return Aged;
+}
+
+FSEGlickoRating FSERatingService::GetRating(const FSEEntityID& PlayerID) const
+{
+    const int32* Index = PlayerIndex.Find(PlayerID);
+    if (!Index)
+    {
+        FSEGlickoRating Default;
+        Default.Period = CurrentPeriod;
+        return Default;
+    }
+    return Age(Ratings[*Index], CurrentPeriod);
+}
+
+int32 FSERatingService::FindOrAdd(const FSEEntityID& PlayerID)
+{
+    if (const int32* Index = PlayerIndex.Find(PlayerID))
+    {
+        return *Index;
+    }
+
+    const int32 Index = Players.Add(PlayerID);
+    Ratings.AddDefaulted().Period = CurrentPeriod;
+    PlayerIndex.Add(PlayerID, Index);
+    Leaderboard.Insert(PlayerID, Ratings[Index].Rating);
+    return Index;
+}
+
+void FSERatingService::SetRating(const FSEEntityID& PlayerID, const FSEGlickoRating& Rating)
+{
+    if (!PlayerID.IsValid())
+    {
+        return;
+    }
+
+    if (const int32* Index = PlayerIndex.Find(PlayerID))
+    {
+        Leaderboard.Remove(PlayerID, Ratings[*Index].Rating);
+        Ratings[*Index] = Rating;
+    }
+    else
+    {
+        PlayerIndex.Add(PlayerID, Players.Add(PlayerID));
+        Ratings.Add(Rating);
+    }
+    Leaderboard.Insert(PlayerID, Rating.Rating);
+}
+
+void FSERatingService::RecordResult(const FSEEntityID& PlayerA, const FSEEntityID& PlayerB, double ScoreA)
+{
+    if (!PlayerA.IsValid() || !PlayerB.IsValid() || PlayerA == PlayerB)
+    {
+        return;
+    }
+
+    const int32 IndexA = FindOrAdd(PlayerA);
+    const int32 IndexB = FindOrAdd(PlayerB);
+
+    // Both sides update from the pre-match ratings, with any idle periods applied first
+    const FSEGlickoRating OldA = Age(Ratings[IndexA], CurrentPeriod);
+    const FSEGlickoRating OldB = Age(Ratings[IndexB], CurrentPeriod);
+
+    FSEGlickoRating NewA = Update(OldA, OldB, ScoreA);
+    FSEGlickoRating NewB = Update(OldB, OldA, 1.0 - ScoreA);
+    NewA.Period = CurrentPeriod;
+    NewB.Period = CurrentPeriod;
+    SetRating(PlayerA, NewA);
+    SetRating(PlayerB, NewB);
+}
+
+int32 FSERatingService::GetGlobalRank(const FSEEntityID& PlayerID) const
+{
+    const int32* Index = PlayerIndex.Find(PlayerID);
+    if (!Index)
+    {
+        return 0;
+    }
+
+    return Leaderboard.GetPosition(PlayerID, Ratings[*Index].Rating) + 1;
+}
+
+void FSERatingService::GetTopPlayers(int32 Count, TArray<FSEEntityID>& OutPlayers) const
+{
+    Leaderboard.GetRange(0, Count, OutPlayers);
+}
+
+void FSERatingService::GetPlayersAround(const FSEEntityID& PlayerID, int32 Radius, TArray<FSEEntityID>& OutPlayers) const
+{
+    const int32 Rank = GetGlobalRank(PlayerID);
+    if (Rank == 0)
+    {
+        return;
+    }
+
+    const int32 Start = FMath::Max(0, Rank - 1 - Radius);
+    Leaderboard.GetRange(Start, Rank - 1 - Start + Radius + 1, OutPlayers);
+}
+
+void FSERatingService::Reserve(int32 Number)
+{
+    Players.Reserve(Number);
+    Ratings.Reserve(Number);
+    PlayerIndex.Reserve(Number);
+    Leaderboard.Reserve(Number);
+}
+
+SIZE_T FSERatingService::GetAllocatedSize() const
+{
+    return Players.GetAllocatedSize() + Ratings.GetAllocatedSize() + PlayerIndex.GetAllocatedSize() + Leaderboard.GetAllocatedSize();
+}
@@ -0,0 +1,169 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SEEntityID.h"
+
+/** Glicko-2 rating on the public (Glicko-1) scale */
+struct FSEGlickoRating
+{
+    double Rating = 1500.0;
+    double Deviation = 350.0;
+    double Volatility = 0.06;
+
+    /** Rating period the deviation is current for; later idle periods are applied on read */
+    int32 Period = 0;
+
+    /** Row format: 0 has no period, 1 adds it */
+    static constexpr uint8 LatestVersion = 1;
+
+    friend FArchive& operator<<(FArchive& Ar, FSEGlickoRating& Value)
+    {
+        uint8 Version = LatestVersion;
+        Ar << Version;
+        if (Version > LatestVersion)
+        {
+            // Written by a newer build; refuse it rather than guess
+            Ar.SetError();
+            return Ar;
+        }
+
+        Ar << Value.Rating << Value.Deviation << Value.Volatility;
+
+        // Rows from before periods were stored keep the caller's default
+        if (Version >= 1)
+        {
+            Ar << Value.Period;
+        }
+        return Ar;
+    }
+};
+
+/**
+ * Order-statistic leaderboard
+ *
+ * A treap ordered by rating, highest first, with ties broken by player ID. Every node
+ * stores its subtree size, so a player's position, the player at a position and any
+ * contiguous slice of the board are found in O(log n). Nodes live in one array and are
+ * linked by index.
+ */
+class SHADOWECHOES_API FSERatingLeaderboard
+{
+public:
+    FSERatingLeaderboard();
+
+    void Insert(const FSEEntityID& PlayerID, double Rating);
+
+    /** Rating must be the one the player was inserted with */
+    bool Remove(const FSEEntityID& PlayerID, double Rating);
+
+    /** Zero-based position, or INDEX_NONE if not on the board */
+    int32 GetPosition(const FSEEntityID& PlayerID, double Rating) const;
+
+    /** Player at a zero-based position, or the invalid ID */
+    FSEEntityID GetAt(int32 Position) const;
+
+    /** Up to Count players starting at a position, best first */
+    void GetRange(int32 Start, int32 Count, TArray<FSEEntityID>& OutPlayers) const;
+
+    int32 Num() const { return Root == INDEX_NONE ? 0 : Nodes[Root].Size; }
+    void Reserve(int32 Number) { Nodes.Reserve(Number); }
+    void Reset();
+    SIZE_T GetAllocatedSize() const { return Nodes.GetAllocatedSize() + FreeNodes.GetAllocatedSize(); }
+
+private:
+    struct FNode
+    {
+        double Rating;
+        FSEEntityID Player;
+        uint32 Priority;
+        int32 Size;
+        int32 Left;
+        int32 Right;
+    };
+
+    /** Board order: higher rating first, then lower key */
+    static bool Precedes(double RatingA, uint64 KeyA, double RatingB, uint64 KeyB)
+    {
+        return RatingA > RatingB || (RatingA == RatingB && KeyA < KeyB);
+    }
+
+    int32 SizeOf(int32 Node) const { return Node == INDEX_NONE ? 0 : Nodes[Node].Size; }
+    void Update(int32 Node) { Nodes[Node].Size = 1 + SizeOf(Nodes[Node].Left) + SizeOf(Nodes[Node].Right); }
+
+    /** Split into nodes before (Rating, Key) and the rest */
+    void Split(int32 Node, double Rating, uint64 Key, int32& OutLeft, int32& OutRight);
+
+    /** Split off the first Count nodes */
+    void SplitAt(int32 Node, int32 Count, int32& OutLeft, int32& OutRight);
+
+    int32 Merge(int32 Left, int32 Right);
+    void Collect(int32 Node, int32 Skip, int32& Remaining, TArray<FSEEntityID>& OutPlayers) const;
+
+    TArray<FNode> Nodes;
+    TArray<int32> FreeNodes;
+    int32 Root;
+    uint32 Seed;
+};
+
+/**
+ * Glicko-2 rating service
+ *
+ * Each match updates both players at once, treating it as a one-game rating period, and
+ * moves them on the leaderboard. Every rating remembers the period it was last updated in;
+ * the deviation growth for each period a player sat out since is applied when the rating is
+ * read, so ending a period is O(1) and idle players are never touched or rewritten.
+ */
+class SHADOWECHOES_API FSERatingService
+{
+public:
+    /** Glicko-2 system constant; constrains volatility change */
+    static constexpr double Tau = 0.5;
+    static constexpr double MaxDeviation = 350.0;
+    static constexpr double MinDeviation = 30.0;
+
+    /** Rating of a player as of the current period, or the default for players never rated */
+    FSEGlickoRating GetRating(const FSEEntityID& PlayerID) const;
+    bool IsRated(const FSEEntityID& PlayerID) const { return PlayerIndex.Contains(PlayerID); }
+
+    /** Set a rating outright, e.g. when loading */
+    void SetRating(const FSEEntityID& PlayerID, const FSEGlickoRating& Rating);
+
+    /** Score is 1 for a win by A, 0.5 for a draw, 0 for a loss */
+    void RecordResult(const FSEEntityID& PlayerA, const FSEEntityID& PlayerB, double ScoreA);
+
+    /** Move to the next period, or to an absolute one such as a day number */
+    void EndRatingPeriod() { ++CurrentPeriod; }
+    void SetCurrentPeriod(int32 Period) { CurrentPeriod = FMath::Max(CurrentPeriod, Period); }
+    int32 GetCurrentPeriod() const { return CurrentPeriod; }
+
+    /** Rating brought forward to Period: deviation grows once per period ended without a match */
+    static FSEGlickoRating Age(const FSEGlickoRating& Rating, int32 Period);
+
+    /** One-based global position, or 0 if unrated */
+    int32 GetGlobalRank(const FSEEntityID& PlayerID) const;
+
+    void GetTopPlayers(int32 Count, TArray<FSEEntityID>& OutPlayers) const;
+
+    /** Radius players either side of a player, best first, including the player */
+    void GetPlayersAround(const FSEEntityID& PlayerID, int32 Radius, TArray<FSEEntityID>& OutPlayers) const;
+
+    int32 Num() const { return Players.Num(); }
+    void Reserve(int32 Number);
+    SIZE_T GetAllocatedSize() const;
+
+    /** Pure Glicko-2 update of one player against one opponent */
+    static FSEGlickoRating Update(const FSEGlickoRating& Player, const FSEGlickoRating& Opponent, double Score);
+
+private:
+    int32 FindOrAdd(const FSEEntityID& PlayerID);
+
+    /** Dense per-player state, indexed through PlayerIndex */
+    TArray<FSEEntityID> Players;
+    TArray<FSEGlickoRating> Ratings;
+    TMap<FSEEntityID, int32> PlayerIndex;
+    int32 CurrentPeriod = 0;
+
+    FSERatingLeaderboard Leaderboard;
+};
@@ -0,0 +1,180 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "PvP/SEWarScoreboard.h"
+#include "Core/SETypes.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace SEWarScoreboard
+{
+    static constexpr int32 CellsPerCacheLine = PLATFORM_CACHE_LINE_SIZE / sizeof(int64);
+
+    static std::atomic<int32> NextThreadSlot{ 0 };
+    static thread_local int32 ThreadSlot = INDEX_NONE;
+
+    static int32 Saturate(int64 Value)
+    {
+        return static_cast<int32>(FMath::Clamp<int64>(Value, MIN_int32, MAX_int32));
+    }
+}
+
+int32 FSEWarScoreSnapshot::GetScore(ETimelineState Timeline) const
+{
+    const int32 TimelineIndex = static_cast<int32>(Timeline);
+    return TimelineIndex < NumTimelines ? TimelineScores[TimelineIndex] : 0;
+}
+
+int32 FSEWarScoreSnapshot::GetRegionScore(ETimelineState Timeline, FName Region) const
+{
+    const int32 TimelineIndex = static_cast<int32>(Timeline);
+    const int32 RegionIndex = Regions.IndexOfByKey(Region);
+    if (TimelineIndex >= NumTimelines || RegionIndex == INDEX_NONE)
+    {
+        return 0;
+    }
+    return RegionScores[RegionIndex * NumTimelines + TimelineIndex];
+}
+
+FSEWarScoreboard::FSEWarScoreboard(int32 InMaxRegions, int32 InNumShards)
+    : MaxRegions(FMath::Max(InMaxRegions, 1))
+    , NumShards(InNumShards > 0 ? InNumShards : FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1))
+    , ShardStride(Align(MaxRegions * NumTimelines, SEWarScoreboard::CellsPerCacheLine))
+    , Cells(MakeUnique<std::atomic<int64>[]>(NumShards * ShardStride))
+    , NumRegions(1)
+    , Snapshot(MakeShared<FSEWarScoreSnapshot, ESPMode::ThreadSafe>())
+{
+    // Region 0 collects points scored outside any named region
+    RegionNames.Add(NAME_None);
+    RegionIndices.Add(NAME_None, 0);
+    RegionTotals.SetNumZeroed(MaxRegions * NumTimelines);
+}
+
+int32 FSEWarScoreboard::GetTimelineIndex(ETimelineState Timeline)
+{
+    const int32 TimelineIndex = static_cast<int32>(Timeline);
+    check(TimelineIndex >= 0 && TimelineIndex < NumTimelines);
+    return TimelineIndex;
+}
+
+int32 FSEWarScoreboard::GetShardIndex() const
+{
+    if (SEWarScoreboard::ThreadSlot == INDEX_NONE)
+    {
+        SEWarScoreboard::ThreadSlot = SEWarScoreboard::NextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+    }
+    return SEWarScoreboard::ThreadSlot % NumShards;
+}
+
+int32 FSEWarScoreboard::FindOrAddRegion(FName Name)
+{
+    {
+        FReadScopeLock ReadLock(RegionLock);
+        if (const int32* Index = RegionIndices.Find(Name))
+        {
+            return *Index;
+        }
+    }
+
+    FWriteScopeLock WriteLock(RegionLock);
+    if (const int32* Index = RegionIndices.Find(Name))
+    {
+        return *Index;
+    }
+    if (RegionNames.Num() >= MaxRegions)
+    {
+        return 0;
+    }
+
+    // Publish the count after the name so the aggregator never drains an unnamed region
+    const int32 Index = RegionNames.Add(Name);
+    RegionIndices.Add(Name, Index);
+    NumRegions.store(RegionNames.Num(), std::memory_order_release);
+    return Index;
+}
+
+void FSEWarScoreboard::AddPoints(ETimelineState Timeline, int32 RegionIndex, int32 Points)
+{
+    check(RegionIndex >= 0 && RegionIndex < MaxRegions);
+    GetCell(GetShardIndex(), RegionIndex, GetTimelineIndex(Timeline)).fetch_add(Points, std::memory_order_relaxed);
+}
+
+TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> FSEWarScoreboard::Publish()
+{
+    // Step 1: Drain every shard; points added mid-drain stay in their cell for next time
+    const int32 RegionCount = NumRegions.load(std::memory_order_acquire);
+    const int32 NumCells = RegionCount * NumTimelines;
+
+    TArray<int64, TInlineAllocator<256>> Deltas;
+    Deltas.SetNumZeroed(NumCells);
+    for (int32 Shard = 0; Shard < NumShards; ++Shard)
+    {
+        std::atomic<int64>* ShardCells = &Cells[Shard * ShardStride];
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            // Skip the write for idle cells so untouched shards stay shared in every cache
+            if (ShardCells[Cell].load(std::memory_order_relaxed) != 0)
+            {
+                Deltas[Cell] += ShardCells[Cell].exchange(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Step 2: Fold into the totals; every region counts toward its timeline
+    for (int32 Cell = 0; Cell < NumCells; ++Cell)
+    {
+        if (Deltas[Cell] != 0)
+        {
+            RegionTotals[Cell] = SEWarScoreboard::Saturate(RegionTotals[Cell] + Deltas[Cell]);
+            const int32 TimelineIndex = Cell % NumTimelines;
+            TimelineTotals[TimelineIndex] = SEWarScoreboard::Saturate(TimelineTotals[TimelineIndex] + Deltas[Cell]);
+        }
+    }
+
+    // Step 3: Build the snapshot off to the side, then swap it in
+    TSharedRef<FSEWarScoreSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSEWarScoreSnapshot, ESPMode::ThreadSafe>();
+    NewSnapshot->Sequence = ++Sequence;
+    FMemory::Memcpy(NewSnapshot->TimelineScores, TimelineTotals, sizeof(TimelineTotals));
+    {
+        FReadScopeLock ReadLock(RegionLock);
+        NewSnapshot->Regions.Append(RegionNames.GetData(), RegionCount);
+    }
+    NewSnapshot->RegionScores.Append(RegionTotals.GetData(), NumCells);
+
+    FScopeLock Lock(&SnapshotLock);
+    Snapshot = NewSnapshot;
+    return Snapshot;
+}
+
+void FSEWarScoreboard::Decay(int32 Amount)
+{
+    for (int32& Total : TimelineTotals)
+    {
+        Total = FMath::Max(0, Total - Amount);
+    }
+    for (int32& Total : RegionTotals)
+    {
+        Total = FMath::Max(0, Total - Amount);
+    }
+}
+
+void FSEWarScoreboard::Restore(ETimelineState Timeline, FName Region, int32 Score)
+{
+    const int32 TimelineIndex = GetTimelineIndex(Timeline);
+    if (Region.IsNone())
+    {
+        TimelineTotals[TimelineIndex] = Score;
+        return;
+    }
+
+    const int32 RegionIndex = FindOrAddRegion(Region);
+    if (RegionIndex != 0)
+    {
+        RegionTotals[RegionIndex * NumTimelines + TimelineIndex] = Score;
+    }
+}
+
+TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> FSEWarScoreboard::GetSnapshot() const
+{
+    FScopeLock Lock(&SnapshotLock);
+    return Snapshot;
+}
@@ -0,0 +1,107 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+enum class ETimelineState : uint8;
+
+/** Immutable Timeline War totals as of one publish */
+struct SHADOWECHOES_API FSEWarScoreSnapshot
+{
+    /** Timelines scored: Bright, Dark and Any */
+    static constexpr int32 NumTimelines = 3;
+
+    /** Increments with every publish */
+    uint64 Sequence = 0;
+
+    int32 TimelineScores[NumTimelines] = {};
+
+    /** Region names by region index; index 0 is unassigned and always NAME_None */
+    TArray<FName> Regions;
+
+    /** Per-region scores, NumTimelines per region */
+    TArray<int32> RegionScores;
+
+    int32 GetScore(ETimelineState Timeline) const;
+    int32 GetRegionScore(ETimelineState Timeline, FName Region) const;
+};
+
+/**
+ * Concurrent Timeline War scoring
+ *
+ * Matches and invasions score from any thread with one relaxed atomic add into the calling
+ * thread's shard, so concurrent scorers never share a counter unless there are more threads
+ * than shards. Each shard holds a cell per timeline per region and is padded to whole cache
+ * lines. Publish drains every shard into the running totals and swaps in a new immutable
+ * snapshot; UI and dominance checks read that snapshot and never see a half-applied update.
+ *
+ * Regions are registered on first use and never removed. Publish, Decay and Restore are
+ * aggregator calls and must come from a single thread.
+ */
+class SHADOWECHOES_API FSEWarScoreboard
+{
+public:
+    static constexpr int32 NumTimelines = FSEWarScoreSnapshot::NumTimelines;
+
+    /** NumShards of 0 uses one shard per hardware thread */
+    explicit FSEWarScoreboard(int32 InMaxRegions = 64, int32 InNumShards = 0);
+
+    FSEWarScoreboard(const FSEWarScoreboard&) = delete;
+    FSEWarScoreboard& operator=(const FSEWarScoreboard&) = delete;
+
+    /** Region index for Name; NAME_None and regions past capacity share the unassigned index */
+    int32 FindOrAddRegion(FName Name);
+
+    /** Thread-safe; counted in the next publish */
+    void AddPoints(ETimelineState Timeline, int32 RegionIndex, int32 Points);
+
+    /** Drain the shards into the totals and publish a new snapshot */
+    TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Publish();
+
+    /** Lower every total by Amount, not below zero; takes effect at the next publish */
+    void Decay(int32 Amount);
+
+    /** Set a total outright, e.g. when loading; takes effect at the next publish */
+    void Restore(ETimelineState Timeline, FName Region, int32 Score);
+
+    /** Latest published snapshot; thread-safe */
+    TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> GetSnapshot() const;
+
+    int32 GetNumShards() const { return NumShards; }
+    int32 GetMaxRegions() const { return MaxRegions; }
+
+private:
+    static int32 GetTimelineIndex(ETimelineState Timeline);
+
+    /** Shard for the calling thread, assigned round-robin on first use */
+    int32 GetShardIndex() const;
+
+    std::atomic<int64>& GetCell(int32 Shard, int32 RegionIndex, int32 TimelineIndex)
+    {
+        return Cells[Shard * ShardStride + RegionIndex * NumTimelines + TimelineIndex];
+    }
+
+    const int32 MaxRegions;
+    const int32 NumShards;
+
+    /** Cells per shard, rounded up to whole cache lines */
+    const int32 ShardStride;
+
+    TUniquePtr<std::atomic<int64>[]> Cells;
+
+    /** Region registry; reads vastly outnumber the rare first-use writes */
+    mutable FRWLock RegionLock;
+    TMap<FName, int32> RegionIndices;
+    TArray<FName> RegionNames;
+    std::atomic<int32> NumRegions;
+
+    /** Aggregator-owned running totals */
+    int32 TimelineTotals[NumTimelines] = {};
+    TArray<int32> RegionTotals;
+    uint64 Sequence = 0;
+
+    mutable FCriticalSection SnapshotLock;
+    TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Snapshot;
+};
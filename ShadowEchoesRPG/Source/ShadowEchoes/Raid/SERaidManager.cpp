@@ -2,14 +2,26 @@
 
 #include "Raid/SERaidManager.h"
 #include "Core/SEGameInstance.h"
+#include "Characters/SECharacterBase.h"
+#include "ShadowEchoes.h"
+#include "Systems/SEJobScheduler.h"
 #include "Systems/TimelineManager.h"
 #include "Engine/DataTable.h"
-#include "Kismet/GameplayStatics.h"
+
+namespace SERaidManager
+{
+    /** Lockout store content key of a raid */
+    static FName GetLockoutContent(const FString& RaidID)
+    {
+        return FName(*FString::Printf(TEXT("Raid.%s"), *RaidID));
+    }
+}
 
 USERaidManager::USERaidManager()
-    : MechanicCheckInterval(1.0f)
+    : MechanicCheckInterval(0.1f)  // One pass per executor step
     , MaxSimultaneousRaids(5)
     , RaidLockoutDuration(604800.0f)  // 7 days in seconds
+    , LastMechanicTime(0.0)
 {
 }
 
@@ -21,34 +33,73 @@ void USERaidManager::Initialize(USEGameInstance* InGameInstance)
         TimelineManager = GameInstance->GetTimelineManager();
     }
 
-    // Start mechanic check loop
-    FTimerHandle MechanicTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        MechanicTimer,
-        this,
-        &USERaidManager::ProcessRaidMechanics,
-        MechanicCheckInterval,
-        true
-    );
+    CompileEncounters();
+
+    // Start mechanic check loop; raids run on game time, so pauses and dilation carry through
+    MechanicWorld = GetWorld();
+    LastMechanicTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        Scheduler->AddJob(TEXT("Raid.Mechanics"), MechanicCheckInterval, ESEJobPriority::High,
+            [this](const FSEJobBudget&) { ProcessRaidMechanics(); return true; }, this);
+    }
 }
 
-bool USERaidManager::StartRaid(const FString& RaidID, const TArray<FString>& ParticipantIDs)
+void USERaidManager::CompileEncounters()
 {
-    // FromSoftware-style: Strict entry requirements
-    if (!ValidateRaidRequirements(RaidID, ParticipantIDs))
+    Encounters.Reset();
+    Schedules.Reset();
+
+    // Loaded once; a data table holds one row struct, so mechanics have their own table, DT_RaidMechanics
+    UDataTable* RaidTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
+    UDataTable* MechanicTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidMechanics")));
+    if (!RaidTable)
+    {
+        return;
+    }
+
+    TMap<FName, FRaidMechanic> Mechanics;
+    if (MechanicTable)
+    {
+        MechanicTable->ForeachRow<FRaidMechanic>(TEXT("CompileEncounters"), [&Mechanics](const FName& RowName, const FRaidMechanic& Mechanic)
+        {
+            Mechanics.Add(Mechanic.MechanicID.IsNone() ? RowName : Mechanic.MechanicID, Mechanic);
+        });
+    }
+
+    RaidTable->ForeachRow<FRaidEncounter>(TEXT("CompileEncounters"), [this, &Mechanics](const FName& RowName, const FRaidEncounter& Encounter)
     {
+        RegisterEncounter(RowName.ToString(), Encounter, Mechanics);
+    });
+
+    SE_LOG(Log, TEXT("Compiled %d raid encounters"), Schedules.Num());
+}
+
+bool USERaidManager::RegisterEncounter(const FString& RaidID, const FRaidEncounter& Encounter, const TMap<FName, FRaidMechanic>& Mechanics)
+{
+    FSERaidSchedule Schedule;
+    if (!Schedule.Compile(Encounter, Mechanics))
+    {
+        SE_LOG_WARNING(TEXT("Raid %s has no phases and was not compiled"), *RaidID);
         return false;
     }
 
-    // Load raid data
-    UDataTable* RaidTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
-    if (!RaidTable)
+    Encounters.Add(RaidID, Encounter);
+    Schedules.Add(RaidID, MakeShared<FSERaidSchedule>(MoveTemp(Schedule)));
+    return true;
+}
+
+bool USERaidManager::StartRaid(const FString& RaidID, const TArray<FSEEntityID>& ParticipantIDs)
+{
+    // FromSoftware-style: Strict entry requirements
+    if (!ValidateRaidRequirements(RaidID, ParticipantIDs))
     {
         return false;
     }
 
-    FRaidEncounter* Encounter = RaidTable->FindRow<FRaidEncounter>(*RaidID, "");
-    if (!Encounter)
+    const FRaidEncounter* Encounter = Encounters.Find(RaidID);
+    const TSharedRef<const FSERaidSchedule>* Schedule = Schedules.Find(RaidID);
+    if (!Encounter || !Schedule)
     {
         return false;
     }
@@ -56,23 +107,24 @@ bool USERaidManager::StartRaid(const FString& RaidID, const TArray<FString>& Par
     // Initialize raid progress
     FRaidProgress Progress;
     Progress.RaidID = RaidID;
-    Progress.CurrentPhase = ERaidPhase::Preparation;
+    Progress.CurrentPhase = (*Schedule)->GetPhase(0).Phase;
     Progress.TimeElapsed = 0.0f;
     Progress.ParticipantIDs = ParticipantIDs;
     Progress.DeathCounter = 0;
 
-    // Store active raid
+    // Store active raid and start its executor
     ActiveRaids.Add(RaidID, Progress);
+    FSERaidInstance& Instance = RaidInstances.Add(RaidID, FSERaidInstance(*Schedule));
+    if (TimelineManager)
+    {
+        Instance.GetConditions().Timeline = TimelineManager->GetCurrentState();
+    }
 
     // Apply raid lockout
-    float CurrentTime = UGameplayStatics::GetRealTimeSeconds(GetWorld());
-    for (const FString& PlayerID : ParticipantIDs)
+    if (GameInstance)
     {
-        if (!RaidLockouts.Contains(RaidID))
-        {
-            RaidLockouts.Add(RaidID, TArray<FString>());
-        }
-        RaidLockouts[RaidID].Add(PlayerID);
+        const int64 ExpiresAt = FSELockoutStore::Now() + static_cast<int64>(RaidLockoutDuration);
+        GameInstance->GetLockouts().Add(ParticipantIDs, SERaidManager::GetLockoutContent(RaidID), ExpiresAt);
     }
 
     // Notify raid start
@@ -96,6 +148,8 @@ void USERaidManager::EndRaid(const FString& RaidID, bool bSuccess)
 
     // Cleanup raid
     ActiveRaids.Remove(RaidID);
+    RaidInstances.Remove(RaidID);
+    SetRaidBoss(RaidID, nullptr);
 
     // Notify completion
     OnRaidCompleted.Broadcast(RaidID, bSuccess);
@@ -110,13 +164,13 @@ void USERaidManager::UpdateRaidProgress(const FRaidProgress& Progress)
     }
 
     // FromSoftware-style: Death counter affects difficulty
-    if (Progress.DeathCounter > ActiveRaids[Progress.RaidID].DeathCounter)
+    const bool bDeathsChanged = Progress.DeathCounter > ActiveRaids[Progress.RaidID].DeathCounter;
+    ActiveRaids[Progress.RaidID] = Progress;
+    if (bDeathsChanged)
     {
         // Increase mechanic difficulty
         UpdateRaidState(Progress.RaidID);
     }
-
-    ActiveRaids[Progress.RaidID] = Progress;
 }
 
 void USERaidManager::TransitionToPhase(const FString& RaidID, ERaidPhase NewPhase)
@@ -126,21 +180,11 @@ void USERaidManager::TransitionToPhase(const FString& RaidID, ERaidPhase NewPhas
         return;
     }
 
-    FRaidProgress& Progress = ActiveRaids[RaidID];
-    Progress.CurrentPhase = NewPhase;
-
-    // Load phase mechanics
-    UDataTable* MechanicTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
-    if (MechanicTable)
-    {
-        TArray<FName> PhaseMechanics;
-        // Get mechanics for this phase
-        // Similar to Dark Souls boss phase transitions
-
-        // Notify phase change
-        OnRaidPhaseChanged.Broadcast(NewPhase, PhaseMechanics);
-        BP_OnRaidPhaseChanged(NewPhase, PhaseMechanics);
-    }
+    // The executor reports the change back through the usual outputs
+    FSERaidInstance& Instance = RaidInstances[RaidID];
+    TArray<FSERaidOutput> Outputs;
+    Instance.EnterPhase(Instance.GetSchedule()->FindPhase(NewPhase), Outputs);
+    HandleRaidOutputs(RaidID, Outputs);
 }
 
 void USERaidManager::TriggerMechanic(const FString& RaidID, const FName& MechanicID)
@@ -150,21 +194,17 @@ void USERaidManager::TriggerMechanic(const FString& RaidID, const FName& Mechani
         return;
     }
 
-    // Load mechanic data
-    UDataTable* MechanicTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
-    if (!MechanicTable)
-    {
-        return;
-    }
-
-    FRaidMechanic* Mechanic = MechanicTable->FindRow<FRaidMechanic>(MechanicID, "");
-    if (!Mechanic)
+    FSERaidInstance& Instance = RaidInstances[RaidID];
+    const int32 MechanicIndex = Instance.GetSchedule()->FindMechanic(MechanicID);
+    if (MechanicIndex == INDEX_NONE)
     {
         return;
     }
 
     // Apply mechanic effects
-    ApplyMechanicEffects(*Mechanic);
+    TArray<FSERaidOutput> Outputs;
+    Instance.TriggerMechanic(MechanicIndex, Outputs);
+    HandleRaidOutputs(RaidID, Outputs);
 
     // Update progress
     FRaidProgress& Progress = ActiveRaids[RaidID];
@@ -200,38 +240,72 @@ void USERaidManager::GrantRaidRewards(const FString& RaidID)
     // Similar to Dark Souls boss soul rewards
 }
 
-bool USERaidManager::HasCompletedRaid(const FString& PlayerID, const FString& RaidID) const
+bool USERaidManager::HasCompletedRaid(const FSEEntityID& PlayerID, const FString& RaidID) const
 {
-    return RaidLockouts.Contains(RaidID) && RaidLockouts[RaidID].Contains(PlayerID);
+    return GameInstance && GameInstance->GetLockouts().IsLockedOut(PlayerID, SERaidManager::GetLockoutContent(RaidID), FSELockoutStore::Now());
 }
 
-bool USERaidManager::ValidateRaidRequirements(const FString& RaidID, const TArray<FString>& ParticipantIDs) const
+void USERaidManager::ReportBossHealth(const FString& RaidID, float HealthFraction)
 {
-    if (ActiveRaids.Num() >= MaxSimultaneousRaids)
+    if (FSERaidInstance* Instance = RaidInstances.Find(RaidID))
     {
-        return false;
+        Instance->GetConditions().BossHealth = FMath::Clamp(HealthFraction, 0.0f, 1.0f);
     }
+}
 
-    // Check raid lockouts
-    if (RaidLockouts.Contains(RaidID))
+void USERaidManager::SetRaidBoss(const FString& RaidID, ASECharacterBase* Boss)
+{
+    TWeakObjectPtr<ASECharacterBase> Previous;
+    if (RaidBosses.RemoveAndCopyValue(RaidID, Previous) && Previous.IsValid())
     {
-        for (const FString& PlayerID : ParticipantIDs)
+        // The same boss may still stand in for another raid
+        bool bStillBound = false;
+        for (const auto& Pair : RaidBosses)
         {
-            if (RaidLockouts[RaidID].Contains(PlayerID))
-            {
-                return false;
-            }
+            bStillBound |= Pair.Value == Previous;
+        }
+        if (!bStillBound)
+        {
+            Previous->OnHealthChanged.RemoveDynamic(this, &USERaidManager::HandleBossHealthChanged);
         }
     }
 
-    // Load raid data
-    UDataTable* RaidTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
-    if (!RaidTable)
+    if (!Boss || !ActiveRaids.Contains(RaidID))
+    {
+        return;
+    }
+
+    RaidBosses.Add(RaidID, Boss);
+    Boss->OnHealthChanged.AddUniqueDynamic(this, &USERaidManager::HandleBossHealthChanged);
+    ReportBossHealth(RaidID, Boss->GetHealthPercent());
+}
+
+void USERaidManager::HandleBossHealthChanged(float NewHealth, float MaxHealth)
+{
+    // The delegate does not say whose health changed; there are only a handful of raids, so report every boss
+    for (const auto& Pair : RaidBosses)
+    {
+        if (const ASECharacterBase* Boss = Pair.Value.Get())
+        {
+            ReportBossHealth(Pair.Key, Boss->GetHealthPercent());
+        }
+    }
+}
+
+bool USERaidManager::ValidateRaidRequirements(const FString& RaidID, const TArray<FSEEntityID>& ParticipantIDs) const
+{
+    if (ActiveRaids.Num() >= MaxSimultaneousRaids)
+    {
+        return false;
+    }
+
+    // Check raid lockouts, one probe per participant
+    if (GameInstance && GameInstance->GetLockouts().IsAnyLockedOut(ParticipantIDs, SERaidManager::GetLockoutContent(RaidID), FSELockoutStore::Now()))
     {
         return false;
     }
 
-    FRaidEncounter* Encounter = RaidTable->FindRow<FRaidEncounter>(*RaidID, "");
+    const FRaidEncounter* Encounter = Encounters.Find(RaidID);
     if (!Encounter)
     {
         return false;
@@ -256,60 +330,120 @@ bool USERaidManager::ValidateRaidRequirements(const FString& RaidID, const TArra
     return true;
 }
 
-void USERaidManager::ProcessRaidMechanics(const FString& RaidID)
+void USERaidManager::ProcessRaidMechanics()
 {
-    if (!ActiveRaids.Contains(RaidID))
+    // Every raid runs the whole fixed steps of world time that elapsed since the last pass
+    UWorld* World = GetWorld();
+    if (!World)
     {
         return;
     }
 
-    FRaidProgress& Progress = ActiveRaids[RaidID];
+    // A new world restarts its clock; its first pass only sets the baseline
+    const double Now = World->GetTimeSeconds();
+    const float DeltaSeconds = MechanicWorld == World ? static_cast<float>(FMath::Max(Now - LastMechanicTime, 0.0)) : 0.0f;
+    MechanicWorld = World;
+    LastMechanicTime = Now;
 
-    // Update mechanics
-    UDataTable* MechanicTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
-    if (MechanicTable)
+    TArray<TPair<FString, TArray<FSERaidOutput>>> RaidOutputs;
+    for (auto& Pair : RaidInstances)
+    {
+        TArray<FSERaidOutput> Outputs;
+        Pair.Value.Advance(DeltaSeconds, Outputs);
+        if (FRaidProgress* Progress = ActiveRaids.Find(Pair.Key))
+        {
+            Progress->TimeElapsed = Pair.Value.GetElapsedSeconds();
+        }
+        if (Outputs.Num() > 0)
+        {
+            RaidOutputs.Emplace(Pair.Key, MoveTemp(Outputs));
+        }
+    }
+
+    // Outputs can end raids, so they are handled once the loop is done
+    for (const TPair<FString, TArray<FSERaidOutput>>& Pair : RaidOutputs)
     {
-        // Process active mechanics
-        // Similar to Dark Souls boss mechanics
+        HandleRaidOutputs(Pair.Key, Pair.Value);
     }
 }
 
-void USERaidManager::UpdateRaidState(const FString& RaidID)
+void USERaidManager::HandleRaidOutputs(const FString& RaidID, const TArray<FSERaidOutput>& Outputs)
 {
-    if (!ActiveRaids.Contains(RaidID))
+    // Output indices refer to the schedule the raid started with; held here since EndRaid drops the instance
+    const FSERaidInstance* Instance = RaidInstances.Find(RaidID);
+    if (!Instance)
     {
         return;
     }
+    const TSharedPtr<const FSERaidSchedule> Schedule = Instance->GetSchedule();
 
-    FRaidProgress& Progress = ActiveRaids[RaidID];
+    for (const FSERaidOutput& Output : Outputs)
+    {
+        switch (Output.Kind)
+        {
+            case ESERaidOutputKind::MechanicStarted:
+                ApplyMechanicEffects(RaidID, Schedule->GetMechanic(Output.Index).ID, Output.Difficulty);
+                break;
+
+            case ESERaidOutputKind::MechanicEnded:
+                if (FRaidProgress* Progress = ActiveRaids.Find(RaidID))
+                {
+                    Progress->CompletedMechanics.AddUnique(Schedule->GetMechanic(Output.Index).ID);
+                }
+                break;
+
+            case ESERaidOutputKind::PhaseChanged:
+            {
+                const FSERaidSchedule::FPhase& Phase = Schedule->GetPhase(Output.Index);
+                if (FRaidProgress* Progress = ActiveRaids.Find(RaidID))
+                {
+                    Progress->CurrentPhase = Phase.Phase;
+                }
+
+                TArray<FName> PhaseMechanics;
+                for (int32 MechanicIndex = 0; MechanicIndex < Schedule->NumMechanics(); ++MechanicIndex)
+                {
+                    if ((Phase.Mechanics >> MechanicIndex) & 1)
+                    {
+                        PhaseMechanics.Add(Schedule->GetMechanic(MechanicIndex).ID);
+                    }
+                }
+
+                // Notify phase change
+                OnRaidPhaseChanged.Broadcast(Phase.Phase, PhaseMechanics);
+                BP_OnRaidPhaseChanged(Phase.Phase, PhaseMechanics);
+                break;
+            }
 
-    // FromSoftware-style: Dynamic difficulty adjustment
-    float DifficultyModifier = 1.0f + (Progress.DeathCounter * 0.1f);
-    // Apply difficulty modifier to mechanics
+            case ESERaidOutputKind::Succeeded:
+            case ESERaidOutputKind::Failed:
+                EndRaid(RaidID, Output.Kind == ESERaidOutputKind::Succeeded);
+                return;
+        }
+    }
 }
 
-void USERaidManager::ApplyMechanicEffects(const FRaidMechanic& Mechanic)
+void USERaidManager::UpdateRaidState(const FString& RaidID)
 {
-    // FromSoftware-style: Complex mechanic effects
-    float Difficulty = GetMechanicDifficulty(Mechanic);
-
-    // Apply effects based on mechanic type
-    switch (Mechanic.Phase)
+    if (!ActiveRaids.Contains(RaidID))
     {
-        case ERaidPhase::Combat:
-            // Combat mechanics
-            break;
-
-        case ERaidPhase::Transition:
-            // Timeline transition mechanics
-            break;
+        return;
+    }
 
-        case ERaidPhase::Final:
-            // Final phase mechanics
-            break;
+    // FromSoftware-style: Dynamic difficulty adjustment; the executor scales mechanics by deaths
+    if (FSERaidInstance* Instance = RaidInstances.Find(RaidID))
+    {
+        Instance->GetConditions().Deaths = ActiveRaids[RaidID].DeathCounter;
     }
 }
 
+void USERaidManager::ApplyMechanicEffects(const FString& RaidID, FName MechanicID, float Difficulty)
+{
+    // FromSoftware-style: Complex mechanic effects, authored per mechanic in Blueprint
+    OnRaidMechanic.Broadcast(RaidID, MechanicID, Difficulty);
+    BP_OnRaidMechanic(RaidID, MechanicID, Difficulty);
+}
+
 void USERaidManager::CheckTimelineCompatibility(const FString& RaidID, ETimelineState NewState)
 {
     if (!ActiveRaids.Contains(RaidID))
@@ -317,14 +451,13 @@ void USERaidManager::CheckTimelineCompatibility(const FString& RaidID, ETimeline
         return;
     }
 
-    // Load raid data
-    UDataTable* RaidTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_RaidContent")));
-    if (!RaidTable)
+    // Mechanics in the new timeline hit softer from the next step on
+    if (FSERaidInstance* Instance = RaidInstances.Find(RaidID))
     {
-        return;
+        Instance->GetConditions().Timeline = NewState;
     }
 
-    FRaidEncounter* Encounter = RaidTable->FindRow<FRaidEncounter>(*RaidID, "");
+    const FRaidEncounter* Encounter = Encounters.Find(RaidID);
     if (!Encounter)
     {
         return;
@@ -345,24 +478,15 @@ bool USERaidManager::ValidatePhaseTransition(const FString& RaidID, ERaidPhase N
         return false;
     }
 
-    const FRaidProgress& Progress = ActiveRaids[RaidID];
-
-    // FromSoftware-style: Phase requirements
-    switch (NewPhase)
+    // FromSoftware-style: Phases only move forward, one at a time, in the authored order
+    const FSERaidInstance* Instance = RaidInstances.Find(RaidID);
+    if (!Instance || Instance->IsFinished())
     {
-        case ERaidPhase::Combat:
-            return Progress.CurrentPhase == ERaidPhase::Preparation;
-
-        case ERaidPhase::Transition:
-            return Progress.CurrentPhase == ERaidPhase::Combat;
-
-        case ERaidPhase::Final:
-            // Check if all previous mechanics are completed
-            return Progress.CurrentPhase == ERaidPhase::Transition;
-
-        default:
-            return false;
+        return false;
     }
+
+    const int32 NextPhase = Instance->GetPhaseIndex() + 1;
+    return NextPhase < Instance->GetSchedule()->NumPhases() && Instance->GetSchedule()->GetPhase(NextPhase).Phase == NewPhase;
 }
 
 void USERaidManager::CalculateRewards(const FString& RaidID, bool bSuccess)
@@ -384,24 +508,3 @@ void USERaidManager::CalculateRewards(const FString& RaidID, bool bSuccess)
     // Grant rewards based on multiplier
     // Similar to Dark Souls boss rewards
 }
-
-float USERaidManager::GetMechanicDifficulty(const FRaidMechanic& Mechanic) const
-{
-    // FromSoftware-style: Complex difficulty calculation
-    float BaseDifficulty = Mechanic.DamageMultiplier;
-
-    // Modify based on timeline state
-    if (TimelineManager)
-    {
-        if (TimelineManager->GetCurrentState() == Mechanic.Timeline)
-        {
-            BaseDifficulty *= 0.8f;  // Easier in correct timeline
-        }
-        else
-        {
-            BaseDifficulty *= 1.2f;  // Harder in wrong timeline
-        }
-    }
-
-    return BaseDifficulty;
-}
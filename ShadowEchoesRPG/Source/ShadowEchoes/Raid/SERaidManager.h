@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Core/SEEntityID.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/DataTable.h"
+#include "Raid/SERaidSchedule.h"
 #include "SERaidManager.generated.h"
 
+class ASECharacterBase;
 class USEGameInstance;
 class UTimelineManager;
 
@@ -19,8 +24,30 @@ enum class ERaidPhase : uint8
     Final          UMETA(DisplayName = "Final Phase")
 };
 
+/** When a phase hands over to the next one; every condition must hold */
 USTRUCT(BlueprintType)
-struct FRaidEncounter
+struct FRaidPhaseRule
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere)
+    ERaidPhase Phase = ERaidPhase::None;
+
+    /** Seconds the phase lasts at least */
+    UPROPERTY(EditAnywhere)
+    float MinDuration = 0.0f;
+
+    /** Boss health fraction at or below which the phase may end */
+    UPROPERTY(EditAnywhere)
+    float BossHealthBelow = 1.0f;
+
+    /** Every mechanic of the phase must have run once */
+    UPROPERTY(EditAnywhere)
+    bool bRequireAllMechanics = false;
+};
+
+USTRUCT(BlueprintType)
+struct FRaidEncounter : public FTableRowBase
 {
     GENERATED_BODY()
 
@@ -47,10 +74,18 @@ struct FRaidEncounter
 
     UPROPERTY()
     TArray<FName> RewardIDs;
+
+    /** Phase transition predicates; phases without one change only by hand */
+    UPROPERTY()
+    TArray<FRaidPhaseRule> PhaseRules;
+
+    /** Mechanic damage scale over encounter seconds; empty means 1 */
+    UPROPERTY()
+    FRuntimeFloatCurve DifficultyCurve;
 };
 
 USTRUCT(BlueprintType)
-struct FRaidMechanic
+struct FRaidMechanic : public FTableRowBase
 {
     GENERATED_BODY()
 
@@ -74,6 +109,14 @@ struct FRaidMechanic
 
     UPROPERTY()
     TArray<FName> RequiredAbilities;
+
+    /** Seconds after its phase starts that the mechanic first runs */
+    UPROPERTY()
+    float StartTime;
+
+    /** Seconds between repeats; 0 runs once */
+    UPROPERTY()
+    float RepeatInterval;
 };
 
 USTRUCT(BlueprintType)
@@ -91,7 +134,7 @@ struct FRaidProgress
     float TimeElapsed;
 
     UPROPERTY()
-    TArray<FString> ParticipantIDs;
+    TArray<FSEEntityID> ParticipantIDs;
 
     UPROPERTY()
     TArray<FName> CompletedMechanics;
@@ -106,6 +149,7 @@ struct FRaidProgress
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRaidStarted, const FRaidEncounter&, Encounter);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRaidPhaseChanged, ERaidPhase, NewPhase, const TArray<FName>&, Mechanics);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRaidCompleted, const FString&, RaidID, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRaidMechanic, const FString&, RaidID, FName, MechanicID, float, Difficulty);
 
 /**
  * Manages raid encounters with FromSoftware-style mechanics and timeline challenges
@@ -123,7 +167,7 @@ public:
 
     /** Raid management */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Raid")
-    bool StartRaid(const FString& RaidID, const TArray<FString>& ParticipantIDs);
+    bool StartRaid(const FString& RaidID, const TArray<FSEEntityID>& ParticipantIDs);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Raid")
     void EndRaid(const FString& RaidID, bool bSuccess);
@@ -147,7 +191,31 @@ public:
     void GrantRaidRewards(const FString& RaidID);
 
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Raid")
-    bool HasCompletedRaid(const FString& PlayerID, const FString& RaidID) const;
+    bool HasCompletedRaid(const FSEEntityID& PlayerID, const FString& RaidID) const;
+
+    /** Boss health fraction, which drives health-gated phase transitions */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Raid")
+    void ReportBossHealth(const FString& RaidID, float HealthFraction);
+
+    /** Follow the health of an active raid's boss until the raid ends */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Raid")
+    void SetRaidBoss(const FString& RaidID, ASECharacterBase* Boss);
+
+    /** Compiled schedule of an encounter, or null */
+    const FSERaidSchedule* GetSchedule(const FString& RaidID) const
+    {
+        const TSharedRef<const FSERaidSchedule>* Schedule = Schedules.Find(RaidID);
+        return Schedule ? &Schedule->Get() : nullptr;
+    }
+
+    /**
+     * Compile and add an encounter outside DT_RaidContent, e.g. for simulation; false if it has no
+     * phases. Replacing an encounter affects only raids started afterwards.
+     */
+    bool RegisterEncounter(const FString& RaidID, const FRaidEncounter& Encounter, const TMap<FName, FRaidMechanic>& Mechanics);
+
+    /** Progress of an active raid, or null */
+    const FRaidProgress* GetRaidProgress(const FString& RaidID) const { return ActiveRaids.Find(RaidID); }
 
     /** Events */
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Raid|Events")
@@ -159,14 +227,18 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Raid|Events")
     FOnRaidCompleted OnRaidCompleted;
 
+    UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Raid|Events")
+    FOnRaidMechanic OnRaidMechanic;
+
 protected:
-    /** Raid settings */
+    /** Seconds between executor passes; each pass runs the fixed steps that elapsed */
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Raid")
     float MechanicCheckInterval;
 
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Raid")
     int32 MaxSimultaneousRaids;
 
+    /** Seconds a participant stays locked out of a raid they started */
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Raid")
     float RaidLockoutDuration;
 
@@ -175,8 +247,24 @@ private:
     UPROPERTY()
     TMap<FString, FRaidProgress> ActiveRaids;
 
+    /** Encounter rows and their compiled schedules, built once at initialize */
     UPROPERTY()
-    TMap<FString, TArray<FString>> RaidLockouts;
+    TMap<FString, FRaidEncounter> Encounters;
+
+    TMap<FString, TSharedRef<const FSERaidSchedule>> Schedules;
+
+    /** Executor per active raid */
+    TMap<FString, FSERaidInstance> RaidInstances;
+
+    /** Boss of each active raid whose health is reported to its executor */
+    UPROPERTY()
+    TMap<FString, TWeakObjectPtr<ASECharacterBase>> RaidBosses;
+
+    /** World time of the last executor pass */
+    double LastMechanicTime;
+
+    /** World the last pass ran in; time restarts with each world */
+    TWeakObjectPtr<UWorld> MechanicWorld;
 
     /** Game instance reference */
     UPROPERTY()
@@ -186,14 +274,18 @@ private:
     UTimelineManager* TimelineManager;
 
     /** Internal functionality */
-    bool ValidateRaidRequirements(const FString& RaidID, const TArray<FString>& ParticipantIDs) const;
-    void ProcessRaidMechanics(const FString& RaidID);
+    void CompileEncounters();
+    bool ValidateRaidRequirements(const FString& RaidID, const TArray<FSEEntityID>& ParticipantIDs) const;
+    void ProcessRaidMechanics();
     void UpdateRaidState(const FString& RaidID);
-    void ApplyMechanicEffects(const FRaidMechanic& Mechanic);
+    void HandleRaidOutputs(const FString& RaidID, const TArray<FSERaidOutput>& Outputs);
+    void ApplyMechanicEffects(const FString& RaidID, FName MechanicID, float Difficulty);
     void CheckTimelineCompatibility(const FString& RaidID, ETimelineState NewState);
     bool ValidatePhaseTransition(const FString& RaidID, ERaidPhase NewPhase) const;
     void CalculateRewards(const FString& RaidID, bool bSuccess);
-    float GetMechanicDifficulty(const FRaidMechanic& Mechanic) const;
+
+    UFUNCTION()
+    void HandleBossHealthChanged(float NewHealth, float MaxHealth);
 
 protected:
     /** Blueprint events */
@@ -208,4 +300,7 @@ protected:
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Raid|Events")
     void BP_OnTimelineStateChanged(ETimelineState NewState);
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Raid|Events")
+    void BP_OnRaidMechanic(const FString& RaidID, FName MechanicID, float Difficulty);
 };
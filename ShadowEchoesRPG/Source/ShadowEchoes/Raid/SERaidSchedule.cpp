@@ -0,0 +1,281 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Raid/SERaidSchedule.h"
+#include "Raid/SERaidManager.h"
+#include "Core/SETypes.h"
+#include "ShadowEchoes.h"
+#include "Algo/Sort.h"
+
+namespace SERaidSchedule
+{
+    /** Repeating mechanics in encounters without a duration limit are expanded this far */
+    static constexpr uint32 DefaultHorizonSeconds = 3600;
+
+    static uint32 ToTicks(float Seconds)
+    {
+        return static_cast<uint32>(FMath::Max(0, FMath::RoundToInt(Seconds * FSERaidSchedule::TicksPerSecond)));
+    }
+}
+
+bool FSERaidSchedule::Compile(const FRaidEncounter& Encounter, const TMap<FName, FRaidMechanic>& MechanicTable)
+{
+    Mechanics.Reset();
+    Phases.Reset();
+    Events.Reset();
+    DifficultyCurve.Reset();
+    DurationLimitTicks = SERaidSchedule::ToTicks(Encounter.DurationLimit);
+
+    const uint32 HorizonTicks = DurationLimitTicks > 0 ? DurationLimitTicks : SERaidSchedule::DefaultHorizonSeconds * TicksPerSecond;
+
+    // Step 1: Mechanic table, in encounter order
+    TArray<const FRaidMechanic*, TInlineAllocator<MaxMechanics>> Sources;
+    for (const FName& MechanicID : Encounter.MechanicIDs)
+    {
+        const FRaidMechanic* Source = MechanicTable.Find(MechanicID);
+        if (!Source || FindMechanic(MechanicID) != INDEX_NONE)
+        {
+            continue;
+        }
+        if (Mechanics.Num() == MaxMechanics)
+        {
+            SE_LOG_WARNING(TEXT("Raid %s has more than %d mechanics; the rest are ignored"), *Encounter.EncounterID, MaxMechanics);
+            break;
+        }
+
+        FMechanic& Mechanic = Mechanics.AddDefaulted_GetRef();
+        Mechanic.ID = MechanicID;
+        Mechanic.DamageMultiplier = Source->DamageMultiplier;
+        Mechanic.Timeline = Source->Timeline;
+        Sources.Add(Source);
+    }
+
+    // Step 2: Phases in authored order, each with its slice of expanded events
+    for (int32 Index = 0; Index < Encounter.Phases.Num(); ++Index)
+    {
+        FPhase& Phase = Phases.AddDefaulted_GetRef();
+        Phase.Phase = Encounter.Phases[Index];
+        Phase.FirstEvent = Events.Num();
+        Phase.Mechanics = 0;
+
+        for (int32 MechanicIndex = 0; MechanicIndex < Sources.Num(); ++MechanicIndex)
+        {
+            const FRaidMechanic& Source = *Sources[MechanicIndex];
+            if (Source.Phase != Phase.Phase)
+            {
+                continue;
+            }
+
+            Phase.Mechanics |= uint64(1) << MechanicIndex;
+            const uint32 Duration = FMath::Max<uint32>(SERaidSchedule::ToTicks(Source.Duration), 1);
+            const uint32 Interval = SERaidSchedule::ToTicks(Source.RepeatInterval);
+            for (uint32 Start = SERaidSchedule::ToTicks(Source.StartTime); Start < HorizonTicks; Start += Interval)
+            {
+                Events.Add({ Start, static_cast<uint16>(MechanicIndex), ESERaidOp::StartMechanic, 0 });
+                Events.Add({ Start + Duration, static_cast<uint16>(MechanicIndex), ESERaidOp::EndMechanic, 0 });
+                if (Interval == 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Ends sort before starts on the same tick, so back-to-back repeats complete first
+        Phase.NumEvents = Events.Num() - Phase.FirstEvent;
+        Algo::Sort(MakeArrayView(Events.GetData() + Phase.FirstEvent, Phase.NumEvents), [](const FEvent& A, const FEvent& B)
+        {
+            return A.Tick != B.Tick ? A.Tick < B.Tick : A.Op > B.Op;
+        });
+
+        // Phases without a rule only change by hand, except the last, which ends at zero health
+        const FRaidPhaseRule* Rule = Encounter.PhaseRules.FindByPredicate([&Phase](const FRaidPhaseRule& Candidate)
+        {
+            return Candidate.Phase == Phase.Phase;
+        });
+        if (Rule)
+        {
+            Phase.MinTicks = SERaidSchedule::ToTicks(Rule->MinDuration);
+            Phase.BossHealthBelow = Rule->BossHealthBelow;
+            Phase.RequiredMechanics = Rule->bRequireAllMechanics ? Phase.Mechanics : 0;
+        }
+        else
+        {
+            const bool bLast = Index == Encounter.Phases.Num() - 1;
+            Phase.MinTicks = bLast ? 0 : MAX_uint32;
+            Phase.BossHealthBelow = 0.0f;
+            Phase.RequiredMechanics = 0;
+        }
+    }
+
+    // Step 3: Difficulty over encounter time, one sample per second
+    const FRichCurve* Curve = Encounter.DifficultyCurve.GetRichCurveConst();
+    if (Curve && Curve->GetNumKeys() > 0)
+    {
+        const uint32 NumSamples = HorizonTicks / TicksPerSecond + 1;
+        DifficultyCurve.SetNumUninitialized(NumSamples);
+        for (uint32 Second = 0; Second < NumSamples; ++Second)
+        {
+            DifficultyCurve[Second] = Curve->Eval(static_cast<float>(Second));
+        }
+    }
+    else
+    {
+        DifficultyCurve.Add(1.0f);
+    }
+
+    return Phases.Num() > 0;
+}
+
+int32 FSERaidSchedule::FindPhase(ERaidPhase Phase) const
+{
+    return Phases.IndexOfByPredicate([Phase](const FPhase& Candidate) { return Candidate.Phase == Phase; });
+}
+
+int32 FSERaidSchedule::FindMechanic(FName MechanicID) const
+{
+    return Mechanics.IndexOfByPredicate([MechanicID](const FMechanic& Candidate) { return Candidate.ID == MechanicID; });
+}
+
+TArrayView<const FSERaidSchedule::FEvent> FSERaidSchedule::GetEvents(int32 PhaseIndex) const
+{
+    const FPhase& Phase = Phases[PhaseIndex];
+    return TArrayView<const FEvent>(Events.GetData() + Phase.FirstEvent, Phase.NumEvents);
+}
+
+SIZE_T FSERaidSchedule::GetAllocatedSize() const
+{
+    return Mechanics.GetAllocatedSize() + Phases.GetAllocatedSize() + Events.GetAllocatedSize() + DifficultyCurve.GetAllocatedSize();
+}
+
+FSERaidInstance::FSERaidInstance(const TSharedRef<const FSERaidSchedule>& InSchedule)
+    : Schedule(InSchedule)
+{
+    if (Schedule->NumPhases() > 0)
+    {
+        NextEvent = Schedule->GetPhase(0).FirstEvent;
+    }
+    else
+    {
+        bFinished = true;
+    }
+}
+
+void FSERaidInstance::Step(TArray<FSERaidOutput>& OutOutputs)
+{
+    if (bFinished || !Schedule)
+    {
+        return;
+    }
+
+    // Step 1: Fire every event due by this tick of the phase
+    const FSERaidSchedule::FPhase& Phase = Schedule->GetPhase(PhaseIndex);
+    const TArrayView<const FSERaidSchedule::FEvent> Events = Schedule->GetEvents(PhaseIndex);
+    const int32 EndEvent = Phase.FirstEvent + Phase.NumEvents;
+    while (NextEvent < EndEvent && Events[NextEvent - Phase.FirstEvent].Tick <= PhaseTick)
+    {
+        const FSERaidSchedule::FEvent& Event = Events[NextEvent - Phase.FirstEvent];
+        ++NextEvent;
+
+        if (Event.Op == ESERaidOp::StartMechanic)
+        {
+            OutOutputs.Add({ ESERaidOutputKind::MechanicStarted, Event.Mechanic, GetDifficulty(Event.Mechanic) });
+        }
+        else
+        {
+            CompletedMechanics |= uint64(1) << Event.Mechanic;
+            OutOutputs.Add({ ESERaidOutputKind::MechanicEnded, Event.Mechanic, 0.0f });
+        }
+    }
+
+    ++PhaseTick;
+    ++Tick;
+
+    // Step 2: Phase transition, or the end of the encounter after the last phase
+    if (IsTransitionDue())
+    {
+        if (PhaseIndex + 1 < Schedule->NumPhases())
+        {
+            EnterPhase(PhaseIndex + 1, OutOutputs);
+        }
+        else
+        {
+            bFinished = true;
+            OutOutputs.Add({ ESERaidOutputKind::Succeeded, PhaseIndex, 0.0f });
+            return;
+        }
+    }
+
+    // Step 3: Enrage timer
+    const uint32 Limit = Schedule->GetDurationLimitTicks();
+    if (Limit > 0 && Tick >= Limit)
+    {
+        bFinished = true;
+        OutOutputs.Add({ ESERaidOutputKind::Failed, PhaseIndex, 0.0f });
+    }
+}
+
+int32 FSERaidInstance::Advance(float DeltaSeconds, TArray<FSERaidOutput>& OutOutputs, int32 MaxSteps)
+{
+    Accumulator += DeltaSeconds;
+
+    int32 NumSteps = 0;
+    while (Accumulator >= FSERaidSchedule::StepSeconds && NumSteps < MaxSteps && !bFinished)
+    {
+        Accumulator -= FSERaidSchedule::StepSeconds;
+        Step(OutOutputs);
+        ++NumSteps;
+    }
+
+    // After a long hitch, drop the backlog rather than spiral
+    if (NumSteps == MaxSteps)
+    {
+        Accumulator = FMath::Min(Accumulator, FSERaidSchedule::StepSeconds);
+    }
+    return NumSteps;
+}
+
+void FSERaidInstance::EnterPhase(int32 InPhaseIndex, TArray<FSERaidOutput>& OutOutputs)
+{
+    if (bFinished || !Schedule || InPhaseIndex < 0 || InPhaseIndex >= Schedule->NumPhases())
+    {
+        return;
+    }
+
+    PhaseIndex = InPhaseIndex;
+    PhaseTick = 0;
+    NextEvent = Schedule->GetPhase(PhaseIndex).FirstEvent;
+    OutOutputs.Add({ ESERaidOutputKind::PhaseChanged, PhaseIndex, 0.0f });
+}
+
+void FSERaidInstance::TriggerMechanic(int32 MechanicIndex, TArray<FSERaidOutput>& OutOutputs)
+{
+    if (bFinished || !Schedule || MechanicIndex < 0 || MechanicIndex >= Schedule->NumMechanics())
+    {
+        return;
+    }
+
+    CompletedMechanics |= uint64(1) << MechanicIndex;
+    OutOutputs.Add({ ESERaidOutputKind::MechanicStarted, MechanicIndex, GetDifficulty(MechanicIndex) });
+}
+
+float FSERaidInstance::GetDifficulty(int32 MechanicIndex) const
+{
+    const FSERaidSchedule::FMechanic& Mechanic = Schedule->GetMechanic(MechanicIndex);
+
+    // FromSoftware-style: deaths and encounter time both raise the stakes
+    float Difficulty = Mechanic.DamageMultiplier * Schedule->GetCurve(Tick) * (1.0f + Conditions.Deaths * 0.1f);
+
+    if (Conditions.Timeline.IsSet())
+    {
+        Difficulty *= Conditions.Timeline.GetValue() == Mechanic.Timeline ? 0.8f : 1.2f;
+    }
+    return Difficulty;
+}
+
+bool FSERaidInstance::IsTransitionDue() const
+{
+    const FSERaidSchedule::FPhase& Phase = Schedule->GetPhase(PhaseIndex);
+    return Phase.MinTicks != MAX_uint32
+        && PhaseTick >= Phase.MinTicks
+        && Conditions.BossHealth <= Phase.BossHealthBelow
+        && (CompletedMechanics & Phase.RequiredMechanics) == Phase.RequiredMechanics;
+}
@@ -0,0 +1,188 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FRaidEncounter;
+struct FRaidMechanic;
+enum class ERaidPhase : uint8;
+enum class ETimelineState : uint8;
+
+/** What a schedule event does when its tick comes up */
+enum class ESERaidOp : uint8
+{
+    StartMechanic,
+    EndMechanic
+};
+
+/** Something the executor did in a step, for the owner to act on */
+enum class ESERaidOutputKind : uint8
+{
+    MechanicStarted,
+    MechanicEnded,
+    PhaseChanged,
+    Succeeded,
+    Failed
+};
+
+struct FSERaidOutput
+{
+    ESERaidOutputKind Kind;
+
+    /** Mechanic index for mechanic outputs, phase index for PhaseChanged */
+    int32 Index;
+
+    /** Damage multiplier for MechanicStarted, after curve, deaths and timeline */
+    float Difficulty;
+};
+
+/**
+ * Raid encounter compiled into flat tables
+ *
+ * Built once at load from an encounter row and its mechanic rows. Every mechanic occurrence,
+ * repeats included, becomes an 8-byte event with a tick relative to its phase start; each
+ * phase owns a sorted slice of the event table and a transition predicate. The difficulty
+ * curve is sampled once per second of encounter time. Nothing here is touched while raids
+ * run, so one schedule is shared by every instance of the encounter.
+ */
+class SHADOWECHOES_API FSERaidSchedule
+{
+public:
+    /** Fixed simulation step */
+    static constexpr int32 TicksPerSecond = 10;
+    static constexpr float StepSeconds = 1.0f / TicksPerSecond;
+
+    /** Mechanic completion is tracked in a 64-bit mask */
+    static constexpr int32 MaxMechanics = 64;
+
+    struct FEvent
+    {
+        uint32 Tick;
+        uint16 Mechanic;
+        ESERaidOp Op;
+        uint8 Padding;
+    };
+
+    struct FMechanic
+    {
+        FName ID;
+        float DamageMultiplier;
+        ETimelineState Timeline;
+    };
+
+    struct FPhase
+    {
+        ERaidPhase Phase;
+
+        /** Slice of Events */
+        int32 FirstEvent;
+        int32 NumEvents;
+
+        /** Transition predicate; MinTicks of MAX_uint32 means manual only */
+        uint32 MinTicks;
+        float BossHealthBelow;
+        uint64 RequiredMechanics;
+
+        /** Mechanics scheduled in this phase, for phase change notifications */
+        uint64 Mechanics;
+    };
+
+    /** Compile an encounter; mechanics not in the table or past MaxMechanics are skipped */
+    bool Compile(const FRaidEncounter& Encounter, const TMap<FName, FRaidMechanic>& MechanicTable);
+
+    int32 NumPhases() const { return Phases.Num(); }
+    const FPhase& GetPhase(int32 Index) const { return Phases[Index]; }
+    int32 FindPhase(ERaidPhase Phase) const;
+
+    int32 NumMechanics() const { return Mechanics.Num(); }
+    const FMechanic& GetMechanic(int32 Index) const { return Mechanics[Index]; }
+    int32 FindMechanic(FName MechanicID) const;
+
+    TArrayView<const FEvent> GetEvents(int32 PhaseIndex) const;
+
+    /** Curve value at a tick of encounter time */
+    float GetCurve(uint32 Tick) const
+    {
+        return DifficultyCurve[FMath::Min<uint32>(Tick / TicksPerSecond, DifficultyCurve.Num() - 1)];
+    }
+
+    /** The encounter fails at this tick; 0 for no limit */
+    uint32 GetDurationLimitTicks() const { return DurationLimitTicks; }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    TArray<FMechanic> Mechanics;
+    TArray<FPhase> Phases;
+    TArray<FEvent> Events;
+    TArray<float> DifficultyCurve;
+    uint32 DurationLimitTicks = 0;
+};
+
+/** Inputs a raid instance scales its mechanics by */
+struct FSERaidConditions
+{
+    /** Fraction of boss health left */
+    float BossHealth = 1.0f;
+
+    int32 Deaths = 0;
+
+    /** World timeline, if known; mechanics in the current timeline hit softer */
+    TOptional<ETimelineState> Timeline;
+};
+
+/**
+ * Fixed-step deterministic executor for one running raid
+ *
+ * Advances in whole ticks of FSERaidSchedule::StepSeconds, so the same inputs at the same
+ * ticks always give the same outputs regardless of frame rate. A step is a compare against
+ * the next event in the phase slice plus the transition predicate, so many concurrent
+ * instances cost a short loop each, and Advance can run an encounter faster than real time.
+ * Each instance shares ownership of its schedule, so recompiling an encounter leaves running
+ * raids on the schedule they started with.
+ */
+class SHADOWECHOES_API FSERaidInstance
+{
+public:
+    FSERaidInstance() = default;
+    explicit FSERaidInstance(const TSharedRef<const FSERaidSchedule>& InSchedule);
+
+    /** Run one tick */
+    void Step(TArray<FSERaidOutput>& OutOutputs);
+
+    /** Run as many whole ticks as DeltaSeconds covers, carrying the remainder; returns ticks run */
+    int32 Advance(float DeltaSeconds, TArray<FSERaidOutput>& OutOutputs, int32 MaxSteps = 600);
+
+    /** Jump to a phase, e.g. on a manual transition */
+    void EnterPhase(int32 PhaseIndex, TArray<FSERaidOutput>& OutOutputs);
+
+    /** Start a mechanic outside the schedule */
+    void TriggerMechanic(int32 MechanicIndex, TArray<FSERaidOutput>& OutOutputs);
+
+    FSERaidConditions& GetConditions() { return Conditions; }
+    const FSERaidConditions& GetConditions() const { return Conditions; }
+
+    int32 GetPhaseIndex() const { return PhaseIndex; }
+    uint32 GetTick() const { return Tick; }
+    float GetElapsedSeconds() const { return Tick * FSERaidSchedule::StepSeconds; }
+    bool IsFinished() const { return bFinished; }
+    bool IsMechanicCompleted(int32 MechanicIndex) const { return (CompletedMechanics >> MechanicIndex) & 1; }
+    int32 NumCompletedMechanics() const { return FMath::CountBits(CompletedMechanics); }
+    const TSharedPtr<const FSERaidSchedule>& GetSchedule() const { return Schedule; }
+
+private:
+    float GetDifficulty(int32 MechanicIndex) const;
+    bool IsTransitionDue() const;
+
+    TSharedPtr<const FSERaidSchedule> Schedule;
+    FSERaidConditions Conditions;
+
+    uint32 Tick = 0;
+    uint32 PhaseTick = 0;
+    int32 PhaseIndex = 0;
+    int32 NextEvent = 0;
+    uint64 CompletedMechanics = 0;
+    float Accumulator = 0.0f;
+    bool bFinished = false;
+};
@@ -0,0 +1,621 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Raid/SERaidSimulation.h"
+#include "Characters/SECharacterBase.h"
+#include "Combat/CombatComponent.h"
+#include "Core/SEEntityID.h"
+#include "ShadowEchoes.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+
+namespace SERaidSimulation
+{
+    static const TCHAR* const BuiltInRaidID = TEXT("Sim_Raid");
+    static const FName BuiltInBossID = TEXT("Sim_Boss");
+    static const FName StrikeAbility = TEXT("Sim_Strike");
+
+    /** Built-in boss health per raid member, so smaller raids take about as long */
+    static constexpr float BossHealthPerPlayer = 25000.0f;
+
+    /** Seconds between bot actions, like a global cooldown */
+    static constexpr double BotActionInterval = 0.5;
+    static constexpr double BossSwingInterval = 2.0;
+
+    static constexpr float RaidRadius = 800.0f;
+    static constexpr float MechanicRadius = 500.0f;
+    static constexpr float MechanicBaseDamage = 300.0f;
+
+    /**
+     * Reads the engine's allocator counters around its scope
+     *
+     * Calls are counted on every thread and only in builds with stats; memory growth is the
+     * change in used physical memory, so it includes pool and cache growth, not just this run.
+     */
+    class FScopedAllocationCount
+    {
+    public:
+        FScopedAllocationCount()
+            : StartAllocations(GetAllocatorCalls())
+            , StartUsedPhysical(FPlatformMemory::GetStats().UsedPhysical)
+        {
+        }
+
+        static bool IsAvailable() { return STATS != 0; }
+
+        uint64 GetAllocations() const { return GetAllocatorCalls() - StartAllocations; }
+        int64 GetMemoryGrowth() const { return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(StartUsedPhysical); }
+
+    private:
+        static uint64 GetAllocatorCalls()
+        {
+#if STATS
+            return FMalloc::TotalMallocCalls.load(std::memory_order_relaxed) + FMalloc::TotalReallocCalls.load(std::memory_order_relaxed);
+#else
+            return 0;
+#endif
+        }
+
+        uint64 StartAllocations;
+        uint64 StartUsedPhysical;
+    };
+
+    static FRaidMechanic MakeMechanic(FName ID, ERaidPhase Phase, ETimelineState Timeline, float StartTime, float Duration, float RepeatInterval)
+    {
+        FRaidMechanic Mechanic;
+        Mechanic.MechanicID = ID;
+        Mechanic.Name = ID.ToString();
+        Mechanic.Phase = Phase;
+        Mechanic.Timeline = Timeline;
+        Mechanic.Duration = Duration;
+        Mechanic.DamageMultiplier = 1.0f;
+        Mechanic.StartTime = StartTime;
+        Mechanic.RepeatInterval = RepeatInterval;
+        return Mechanic;
+    }
+
+    /** Combat to 60% health, a transition that waits on its rift, then the burn to the kill */
+    static void MakeEncounter(int32 NumPlayers, FRaidEncounter& OutEncounter, TMap<FName, FRaidMechanic>& OutMechanics)
+    {
+        OutEncounter.EncounterID = BuiltInRaidID;
+        OutEncounter.Name = TEXT("Simulated Raid");
+        OutEncounter.Phases = { ERaidPhase::Combat, ERaidPhase::Transition, ERaidPhase::Final };
+        OutEncounter.RequiredPlayers = NumPlayers;
+        OutEncounter.DurationLimit = 900.0f;
+        OutEncounter.MechanicIDs = { TEXT("Sim_Cleave"), TEXT("Sim_Rift"), TEXT("Sim_Collapse") };
+
+        FRaidPhaseRule& CombatRule = OutEncounter.PhaseRules.AddDefaulted_GetRef();
+        CombatRule.Phase = ERaidPhase::Combat;
+        CombatRule.BossHealthBelow = 0.6f;
+
+        FRaidPhaseRule& TransitionRule = OutEncounter.PhaseRules.AddDefaulted_GetRef();
+        TransitionRule.Phase = ERaidPhase::Transition;
+        TransitionRule.bRequireAllMechanics = true;
+
+        OutEncounter.DifficultyCurve.GetRichCurve()->AddKey(0.0f, 1.0f);
+        OutEncounter.DifficultyCurve.GetRichCurve()->AddKey(900.0f, 1.5f);
+
+        OutMechanics.Add(TEXT("Sim_Cleave"), MakeMechanic(TEXT("Sim_Cleave"), ERaidPhase::Combat, ETimelineState::BrightWorld, 5.0f, 1.0f, 12.0f));
+        OutMechanics.Add(TEXT("Sim_Rift"), MakeMechanic(TEXT("Sim_Rift"), ERaidPhase::Transition, ETimelineState::DarkWorld, 2.0f, 4.0f, 0.0f));
+        OutMechanics.Add(TEXT("Sim_Collapse"), MakeMechanic(TEXT("Sim_Collapse"), ERaidPhase::Final, ETimelineState::DarkWorld, 3.0f, 2.0f, 8.0f));
+    }
+
+    static FBossInfo MakeBoss(int32 NumPlayers)
+    {
+        FBossInfo Boss;
+        Boss.BossID = BuiltInBossID;
+        Boss.Name = FText::FromString(TEXT("Simulated Boss"));
+        Boss.BaseStats.MaxHealth = BossHealthPerPlayer * NumPlayers;
+        Boss.BaseStats.Health = Boss.BaseStats.MaxHealth;
+        Boss.BaseStats.Attack = 1.0f;
+        Boss.BaseStats.Defense = 10.0f;
+        Boss.BaseStats.CriticalChance = 0.05f;
+        Boss.BaseStats.CriticalDamage = 1.5f;
+
+        const float Thresholds[] = { 1.0f, 0.6f, 0.3f };
+        for (float Threshold : Thresholds)
+        {
+            FBossPhaseInfo& Phase = Boss.Phases.AddDefaulted_GetRef();
+            Phase.HealthThreshold = Threshold;
+            Phase.PhaseStats = Boss.BaseStats;
+        }
+        return Boss;
+    }
+
+    static int32 GetDamageBucket(float Damage)
+    {
+        const uint32 Whole = static_cast<uint32>(FMath::Max(Damage, 1.0f));
+        return FMath::Min<int32>(FMath::FloorLog2(Whole), FSERaidSimulationReport::NumDamageBuckets - 1);
+    }
+
+    static double Percentile(const TArray<float>& Sorted, double Fraction)
+    {
+        return Sorted.Num() > 0 ? Sorted[FMath::Min(FMath::FloorToInt(Sorted.Num() * Fraction), Sorted.Num() - 1)] : 0.0;
+    }
+}
+
+TArray<FString> FSERaidSimulationReport::ToLines() const
+{
+    TArray<FString> Lines;
+    Lines.Add(FString::Printf(TEXT("Raid %s after %.1f s (%s), %d deaths, %d raid and %d boss phase changes, %d mechanics"),
+        bRaidFinished ? (bRaidSucceeded ? TEXT("won") : TEXT("lost")) : TEXT("unfinished"), SimulatedSeconds,
+        bBossKilled ? TEXT("boss killed") : TEXT("boss alive"), PlayerDeaths, RaidPhaseChanges, BossPhaseChanges, MechanicsStarted));
+    Lines.Add(FString::Printf(TEXT("%d frames in %.2f s wall, %.1fx real time"), Frames, WallSeconds, GetSpeedup()));
+    Lines.Add(FString::Printf(TEXT("Frame ms: avg %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f"),
+        FrameMsAverage, FrameMsP50, FrameMsP95, FrameMsP99, FrameMsMax));
+    if (bAllocationsCounted)
+    {
+        Lines.Add(FString::Printf(TEXT("Allocations: %llu (%.1f per frame), memory growth %.1f KB"),
+            Allocations, GetAllocationsPerFrame(), MemoryGrowth / 1024.0));
+    }
+    else
+    {
+        Lines.Add(FString::Printf(TEXT("Allocations: not counted without stats, memory growth %.1f KB"), MemoryGrowth / 1024.0));
+    }
+    Lines.Add(FString::Printf(TEXT("Damage: %lld events, %lld critical, %.0f total"), DamageEvents, CriticalHits, TotalDamage));
+
+    for (int32 Bucket = 0; Bucket < NumDamageBuckets; ++Bucket)
+    {
+        if (DamageHistogram[Bucket] > 0)
+        {
+            const double Share = DamageEvents > 0 ? 100.0 * DamageHistogram[Bucket] / DamageEvents : 0.0;
+            Lines.Add(FString::Printf(TEXT("  [%6d, %6d): %8lld  %5.1f%%"), 1 << Bucket, 1 << (Bucket + 1), DamageHistogram[Bucket], Share));
+        }
+    }
+    return Lines;
+}
+
+bool USERaidSimulation::Run(const FSERaidSimulationSettings& Settings, FSERaidSimulationReport& OutReport)
+{
+    if (!GEngine)
+    {
+        SE_LOG_ERROR(TEXT("Raid simulation needs a running engine"));
+        return false;
+    }
+
+    // Step 1: A private game world with its subsystems, outside any map; the game mode needs a game instance
+    UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+    GameInstance->AddToRoot();
+    GameInstance->InitializeStandalone(TEXT("SERaidSimulation"));
+    UWorld* World = GameInstance->GetWorld();
+
+    const FURL URL;
+    World->SetGameMode(URL);
+    World->InitializeActorsForPlay(URL);
+    World->BeginPlay();
+
+    // Step 2: Spawn, run and tear down
+    USERaidSimulation* Simulation = NewObject<USERaidSimulation>(World);
+    Simulation->AddToRoot();
+
+    const bool bReady = Simulation->Setup(World, Settings);
+    if (bReady)
+    {
+        Simulation->RunFrames(OutReport);
+    }
+    Simulation->Teardown();
+    Simulation->RemoveFromRoot();
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    GameInstance->Shutdown();
+    GameInstance->RemoveFromRoot();
+    return bReady;
+}
+
+bool USERaidSimulation::Setup(UWorld* InWorld, const FSERaidSimulationSettings& InSettings)
+{
+    using namespace SERaidSimulation;
+
+    World = InWorld;
+    Settings = InSettings;
+    Settings.NumPlayers = FMath::Max(Settings.NumPlayers, 1);
+    Random.Initialize(Settings.Seed);
+
+    // Step 1: Managers load their tables; fall back to the built-in content
+    RaidManager = NewObject<USERaidManager>(this);
+    RaidManager->Initialize(nullptr);
+    RaidID = Settings.RaidID;
+    if (RaidID.IsEmpty() || !RaidManager->GetSchedule(RaidID))
+    {
+        if (!RaidID.IsEmpty())
+        {
+            SE_LOG_WARNING(TEXT("Raid %s not found; simulating the built-in encounter"), *RaidID);
+        }
+
+        FRaidEncounter Encounter;
+        TMap<FName, FRaidMechanic> Mechanics;
+        MakeEncounter(Settings.NumPlayers, Encounter, Mechanics);
+        RaidID = BuiltInRaidID;
+        RaidManager->RegisterEncounter(RaidID, Encounter, Mechanics);
+    }
+
+    BossManager = NewObject<USEBossManager>(this);
+    BossManager->Initialize(nullptr);
+    BossID = Settings.BossID;
+    if (BossID.IsNone() || !BossManager->GetBossInfo(BossID))
+    {
+        if (!BossID.IsNone())
+        {
+            SE_LOG_WARNING(TEXT("Boss %s not found; simulating the built-in boss"), *BossID.ToString());
+        }
+
+        BossID = BuiltInBossID;
+        BossManager->RegisterBoss(MakeBoss(Settings.NumPlayers));
+    }
+
+    RaidManager->OnRaidMechanic.AddDynamic(this, &USERaidSimulation::HandleRaidMechanic);
+    RaidManager->OnRaidPhaseChanged.AddDynamic(this, &USERaidSimulation::HandleRaidPhaseChanged);
+    RaidManager->OnRaidCompleted.AddDynamic(this, &USERaidSimulation::HandleRaidCompleted);
+    BossManager->OnBossPhaseChanged.AddDynamic(this, &USERaidSimulation::HandleBossPhaseChanged);
+
+    // Step 2: The boss in the middle
+    const FBossInfo* BossInfo = BossManager->GetBossInfo(BossID);
+    Boss = SpawnCharacter(FVector::ZeroVector);
+    if (!Boss)
+    {
+        return false;
+    }
+
+    FCharacterStats BossStats;
+    BossStats.MaxHealth = BossInfo->BaseStats.MaxHealth;
+    BossStats.AttackPower = BossInfo->BaseStats.Attack;
+    BossStats.Defense = BossInfo->BaseStats.Defense;
+    BossStats.CriticalChance = BossInfo->BaseStats.CriticalChance;
+    BossStats.CriticalMultiplier = BossInfo->BaseStats.CriticalDamage;
+    Boss->InitializeStats(BossStats);
+    Boss->OnTakeAnyDamage.AddDynamic(this, &USERaidSimulation::HandleTakeAnyDamage);
+    Boss->OnHealthChanged.AddDynamic(this, &USERaidSimulation::HandleBossHealthChanged);
+    Boss->GetCombatComponent()->OnDamageDealt.AddDynamic(this, &USERaidSimulation::HandleDamageDealt);
+
+    // Step 3: The raid in a ring around it; two tanks, a healer per five, the rest damage
+    FAbilityData Strike;
+    Strike.Name = StrikeAbility;
+    Strike.BaseDamage = 120.0f;
+    Strike.ResourceCost = 0.0f;
+    Strike.Cooldown = 3.0f;
+    Strike.RequiredState = ETimelineState::None;
+    Strike.bCanCombo = true;
+
+    TArray<FSEEntityID> ParticipantIDs;
+    const int32 NumHealers = FMath::Max(Settings.NumPlayers / 5, 1);
+    for (int32 Index = 0; Index < Settings.NumPlayers; ++Index)
+    {
+        const float Angle = 2.0f * PI * Index / Settings.NumPlayers;
+        ASECharacterBase* Character = SpawnCharacter(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * RaidRadius);
+        if (!Character)
+        {
+            return false;
+        }
+
+        FBot& Bot = Bots.AddDefaulted_GetRef();
+        Bot.Character = Character;
+        Bot.Role = Index < 2 ? EBotRole::Tank : (Index < 2 + NumHealers ? EBotRole::Healer : EBotRole::Damage);
+        Bot.NextActionTime = Random.FRandRange(0.0f, BotActionInterval);
+
+        FCharacterStats Stats;
+        Stats.MaxHealth = Bot.Role == EBotRole::Tank ? 8000.0f : 2500.0f;
+        Stats.AttackPower = Bot.Role == EBotRole::Damage ? 1.0f : 0.4f;
+        Stats.Defense = Bot.Role == EBotRole::Tank ? 150.0f : 20.0f;
+        Stats.CriticalChance = 0.15f;
+        Stats.CriticalMultiplier = 2.0f;
+        Character->InitializeStats(Stats);
+        Character->LearnAbility(Strike);
+
+        Character->OnTakeAnyDamage.AddDynamic(this, &USERaidSimulation::HandleTakeAnyDamage);
+        Character->OnCharacterDeath.AddDynamic(this, &USERaidSimulation::HandlePlayerDeath);
+        Character->GetCombatComponent()->OnDamageDealt.AddDynamic(this, &USERaidSimulation::HandleDamageDealt);
+        Character->GetCombatComponent()->EnterCombat(Boss);
+
+        // Fixed names, so repeated runs reuse the same IDs
+        ParticipantIDs.Add(FSEEntityID::Intern(FString::Printf(TEXT("SimBot_%d"), Index)));
+    }
+
+    // Step 4: Start the fight in both managers
+    Boss->GetCombatComponent()->EnterCombat(FindBossTarget());
+    if (!RaidManager->StartRaid(RaidID, ParticipantIDs) || !BossManager->StartBossFight(BossID))
+    {
+        SE_LOG_ERROR(TEXT("Raid simulation could not start %s against %s"), *RaidID, *BossID.ToString());
+        return false;
+    }
+    RaidManager->SetRaidBoss(RaidID, Boss);
+
+    NextBossSwingTime = World->GetTimeSeconds() + BossSwingInterval;
+    return true;
+}
+
+void USERaidSimulation::RunFrames(FSERaidSimulationReport& OutReport)
+{
+    OutReport = FSERaidSimulationReport();
+    Report = &OutReport;
+    bRaidEnded = false;
+
+    const int32 MaxFrames = FMath::CeilToInt(Settings.MaxSimulatedSeconds / Settings.FrameSeconds);
+    TArray<float> FrameMs;
+    FrameMs.Reserve(MaxFrames);
+
+    const double WallStart = FPlatformTime::Seconds();
+    {
+        SERaidSimulation::FScopedAllocationCount AllocationCount;
+
+        // Frames back to back at a fixed step: the world tick runs components, timers and jobs
+        while (!bRaidEnded && FrameMs.Num() < MaxFrames)
+        {
+            const double FrameStart = FPlatformTime::Seconds();
+
+            const double Now = World->GetTimeSeconds();
+            ThinkBoss(Now);
+            for (FBot& Bot : Bots)
+            {
+                ThinkBot(Bot, Now);
+            }
+
+            World->Tick(LEVELTICK_All, Settings.FrameSeconds);
+            ++GFrameCounter;
+
+            FrameMs.Add(static_cast<float>((FPlatformTime::Seconds() - FrameStart) * 1000.0));
+        }
+
+        OutReport.bAllocationsCounted = AllocationCount.IsAvailable();
+        OutReport.Allocations = AllocationCount.GetAllocations();
+        OutReport.MemoryGrowth = AllocationCount.GetMemoryGrowth();
+    }
+    OutReport.WallSeconds = FPlatformTime::Seconds() - WallStart;
+
+    OutReport.Frames = FrameMs.Num();
+    OutReport.SimulatedSeconds = World->GetTimeSeconds();
+    OutReport.bRaidFinished = bRaidEnded;
+    OutReport.bBossKilled = Boss->GetHealthPercent() <= 0.0f;
+
+    double TotalMs = 0.0;
+    for (float Ms : FrameMs)
+    {
+        TotalMs += Ms;
+    }
+    FrameMs.Sort();
+    OutReport.FrameMsAverage = FrameMs.Num() > 0 ? TotalMs / FrameMs.Num() : 0.0;
+    OutReport.FrameMsP50 = SERaidSimulation::Percentile(FrameMs, 0.50);
+    OutReport.FrameMsP95 = SERaidSimulation::Percentile(FrameMs, 0.95);
+    OutReport.FrameMsP99 = SERaidSimulation::Percentile(FrameMs, 0.99);
+    OutReport.FrameMsMax = FrameMs.Num() > 0 ? FrameMs.Last() : 0.0;
+
+    Report = nullptr;
+}
+
+void USERaidSimulation::Teardown()
+{
+    if (BossManager && BossManager->IsBossFightActive())
+    {
+        BossManager->EndBossFight(false);
+    }
+    if (RaidManager && RaidManager->GetRaidProgress(RaidID))
+    {
+        RaidManager->EndRaid(RaidID, false);
+    }
+
+    for (FBot& Bot : Bots)
+    {
+        if (IsValid(Bot.Character))
+        {
+            Bot.Character->Destroy();
+        }
+    }
+    if (IsValid(Boss))
+    {
+        Boss->Destroy();
+    }
+
+    Bots.Reset();
+    Boss = nullptr;
+    RaidManager = nullptr;
+    BossManager = nullptr;
+    World = nullptr;
+}
+
+ASECharacterBase* USERaidSimulation::SpawnCharacter(const FVector& Location) const
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    return World->SpawnActor<ASECharacterBase>(ASECharacterBase::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+}
+
+void USERaidSimulation::ThinkBot(FBot& Bot, double Now)
+{
+    using namespace SERaidSimulation;
+
+    ASECharacterBase* Character = Bot.Character;
+    if (Now < Bot.NextActionTime || Character->GetHealthPercent() <= 0.0f || Boss->GetHealthPercent() <= 0.0f)
+    {
+        return;
+    }
+    Bot.NextActionTime = Now + BotActionInterval;
+
+    switch (Bot.Role)
+    {
+        case EBotRole::Healer:
+            if (ASECharacterBase* Ally = FindLowestHealthAlly())
+            {
+                Ally->ApplyHealing(Ally == Character ? 250.0f : 400.0f);
+            }
+            break;
+
+        case EBotRole::Tank:
+        case EBotRole::Damage:
+        {
+            // Signature ability off cooldown, auto attack otherwise
+            FAttackData Attack;
+            const bool bStrike = Character->ActivateAbility(StrikeAbility);
+            Attack.AbilityName = bStrike ? StrikeAbility : NAME_None;
+            Attack.BaseDamage = bStrike ? 120.0f : 40.0f;
+            Attack.bCanCombo = bStrike;
+            Character->GetCombatComponent()->ExecuteAttack(Attack, Boss);
+            break;
+        }
+    }
+}
+
+void USERaidSimulation::ThinkBoss(double Now)
+{
+    if (Now < NextBossSwingTime || Boss->GetHealthPercent() <= 0.0f)
+    {
+        return;
+    }
+    NextBossSwingTime = Now + SERaidSimulation::BossSwingInterval;
+
+    if (ASECharacterBase* Target = FindBossTarget())
+    {
+        FAttackData Attack;
+        Attack.BaseDamage = 400.0f;
+        Boss->GetCombatComponent()->ExecuteAttack(Attack, Target);
+    }
+}
+
+ASECharacterBase* USERaidSimulation::FindLowestHealthAlly() const
+{
+    ASECharacterBase* Lowest = nullptr;
+    float LowestHealth = 1.0f;
+    for (const FBot& Bot : Bots)
+    {
+        const float Health = Bot.Character->GetHealthPercent();
+        if (Health > 0.0f && Health < LowestHealth)
+        {
+            Lowest = Bot.Character;
+            LowestHealth = Health;
+        }
+    }
+    return Lowest;
+}
+
+ASECharacterBase* USERaidSimulation::FindBossTarget() const
+{
+    // First living tank, then whoever is left
+    ASECharacterBase* Fallback = nullptr;
+    for (const FBot& Bot : Bots)
+    {
+        if (Bot.Character->GetHealthPercent() <= 0.0f)
+        {
+            continue;
+        }
+        if (Bot.Role == EBotRole::Tank)
+        {
+            return Bot.Character;
+        }
+        Fallback = Fallback ? Fallback : Bot.Character;
+    }
+    return Fallback;
+}
+
+void USERaidSimulation::RecordDamage(float Damage)
+{
+    if (!Report)
+    {
+        return;
+    }
+
+    ++Report->DamageEvents;
+    Report->TotalDamage += Damage;
+    ++Report->DamageHistogram[SERaidSimulation::GetDamageBucket(Damage)];
+}
+
+void USERaidSimulation::HandleTakeAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser)
+{
+    RecordDamage(Damage);
+}
+
+void USERaidSimulation::HandleDamageDealt(float Damage, AActor* Target, bool bWasCritical)
+{
+    if (Report && bWasCritical)
+    {
+        ++Report->CriticalHits;
+    }
+}
+
+void USERaidSimulation::HandlePlayerDeath()
+{
+    if (Report)
+    {
+        ++Report->PlayerDeaths;
+    }
+
+    // Deaths feed the executor's difficulty scaling
+    if (const FRaidProgress* Current = RaidManager->GetRaidProgress(RaidID))
+    {
+        FRaidProgress Progress = *Current;
+        ++Progress.DeathCounter;
+        RaidManager->UpdateRaidProgress(Progress);
+    }
+}
+
+void USERaidSimulation::HandleBossHealthChanged(float NewHealth, float MaxHealth)
+{
+    // The raid manager follows the boss itself; only the boss manager is fed here
+    const float Fraction = MaxHealth > 0.0f ? NewHealth / MaxHealth : 0.0f;
+    BossManager->UpdateBossHealth(Fraction);
+
+    if (Fraction <= 0.0f && BossManager->IsBossFightActive())
+    {
+        BossManager->EndBossFight(true);
+    }
+}
+
+void USERaidSimulation::HandleRaidMechanic(const FString& InRaidID, FName MechanicID, float Difficulty)
+{
+    using namespace SERaidSimulation;
+
+    if (Report)
+    {
+        ++Report->MechanicsStarted;
+    }
+
+    // The boss slams a random raid member's spot; everyone nearby takes it
+    const FBot& Marked = Bots[Random.RandHelper(Bots.Num())];
+    const FVector Center = Marked.Character->GetActorLocation();
+
+    FAttackData Attack;
+    Attack.AbilityName = MechanicID;
+    Attack.BaseDamage = MechanicBaseDamage * Difficulty;
+    Boss->GetCombatComponent()->ExecuteAreaAttack(Attack, Center, MechanicRadius);
+
+    // Survivors in the blast scatter to a new spot on the ring
+    for (const FBot& Bot : Bots)
+    {
+        ASECharacterBase* Character = Bot.Character;
+        if (Character->GetHealthPercent() > 0.0f && FVector::DistSquared(Character->GetActorLocation(), Center) <= FMath::Square(MechanicRadius))
+        {
+            const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+            Character->SetActorLocation(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * RaidRadius);
+        }
+    }
+}
+
+void USERaidSimulation::HandleRaidPhaseChanged(ERaidPhase NewPhase, const TArray<FName>& Mechanics)
+{
+    if (Report)
+    {
+        ++Report->RaidPhaseChanges;
+    }
+}
+
+void USERaidSimulation::HandleRaidCompleted(const FString& InRaidID, bool bSuccess)
+{
+    if (InRaidID != RaidID)
+    {
+        return;
+    }
+
+    bRaidEnded = true;
+    if (Report)
+    {
+        Report->bRaidSucceeded = bSuccess;
+    }
+}
+
+void USERaidSimulation::HandleBossPhaseChanged(const FBossPhaseInfo& NewPhase)
+{
+    if (Report)
+    {
+        ++Report->BossPhaseChanges;
+    }
+}
@@ -0,0 +1,170 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Combat/SEBossManager.h"
+#include "Raid/SERaidManager.h"
+#include "SERaidSimulation.generated.h"
+
+class ASECharacterBase;
+class UDamageType;
+
+/** What to simulate; empty IDs use the built-in encounter and boss */
+struct FSERaidSimulationSettings
+{
+    /** Row in DT_RaidContent */
+    FString RaidID;
+
+    /** Row in DT_BossFights */
+    FName BossID;
+
+    int32 NumPlayers = 40;
+
+    /** Fixed frame step; frames run back to back, not at this rate */
+    float FrameSeconds = 1.0f / 30.0f;
+
+    /** Stop here if the raid has not ended */
+    float MaxSimulatedSeconds = 900.0f;
+
+    int32 Seed = 48;
+};
+
+/** What a simulation run measured */
+struct FSERaidSimulationReport
+{
+    /** Damage buckets are powers of two: bucket N holds hits of [2^N, 2^(N+1)) */
+    static constexpr int32 NumDamageBuckets = 16;
+
+    bool bRaidFinished = false;
+    bool bRaidSucceeded = false;
+    bool bBossKilled = false;
+
+    int32 Frames = 0;
+    double SimulatedSeconds = 0.0;
+    double WallSeconds = 0.0;
+
+    /** Gameplay cost of a frame: world tick plus bot decisions */
+    double FrameMsAverage = 0.0;
+    double FrameMsP50 = 0.0;
+    double FrameMsP95 = 0.0;
+    double FrameMsP99 = 0.0;
+    double FrameMsMax = 0.0;
+
+    /** Allocator calls on all threads inside the frame loop; only counted in builds with stats */
+    bool bAllocationsCounted = false;
+    uint64 Allocations = 0;
+
+    /** Change in used physical memory over the frame loop */
+    int64 MemoryGrowth = 0;
+
+    int64 DamageEvents = 0;
+    int64 CriticalHits = 0;
+    double TotalDamage = 0.0;
+    int64 DamageHistogram[NumDamageBuckets] = {};
+
+    int32 PlayerDeaths = 0;
+    int32 RaidPhaseChanges = 0;
+    int32 BossPhaseChanges = 0;
+    int32 MechanicsStarted = 0;
+
+    double GetSpeedup() const { return WallSeconds > 0.0 ? SimulatedSeconds / WallSeconds : 0.0; }
+    double GetAllocationsPerFrame() const { return Frames > 0 ? double(Allocations) / Frames : 0.0; }
+
+    /** Multi-line summary for logs and automation output */
+    TArray<FString> ToLines() const;
+};
+
+/**
+ * Headless raid encounter simulation
+ *
+ * Creates a private game world, spawns scripted bots and a boss as real characters with their
+ * combat and ability components, and drives them through a raid manager encounter and a boss
+ * manager fight. Frames run back to back at a fixed step, so an encounter runs as fast as the
+ * gameplay code allows; the report holds per-frame cost, allocations and a damage histogram.
+ * Run it from the command line with -run=SERaidSimulation -nullrhi, or through automation.
+ */
+UCLASS()
+class SHADOWECHOES_API USERaidSimulation : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Run a whole encounter in a fresh world; false if the world or encounter could not be set up */
+    static bool Run(const FSERaidSimulationSettings& Settings, FSERaidSimulationReport& OutReport);
+
+private:
+    /** Scripted roles; tanks hold the boss, healers top up the lowest ally, everyone else attacks */
+    enum class EBotRole : uint8
+    {
+        Tank,
+        Healer,
+        Damage
+    };
+
+    struct FBot
+    {
+        ASECharacterBase* Character = nullptr;
+        EBotRole Role = EBotRole::Damage;
+        double NextActionTime = 0.0;
+    };
+
+    bool Setup(UWorld* InWorld, const FSERaidSimulationSettings& InSettings);
+    void RunFrames(FSERaidSimulationReport& OutReport);
+    void Teardown();
+
+    ASECharacterBase* SpawnCharacter(const FVector& Location) const;
+    void ThinkBot(FBot& Bot, double Now);
+    void ThinkBoss(double Now);
+    ASECharacterBase* FindLowestHealthAlly() const;
+    ASECharacterBase* FindBossTarget() const;
+    void RecordDamage(float Damage);
+
+    UFUNCTION()
+    void HandleTakeAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser);
+
+    UFUNCTION()
+    void HandleDamageDealt(float Damage, AActor* Target, bool bWasCritical);
+
+    UFUNCTION()
+    void HandlePlayerDeath();
+
+    UFUNCTION()
+    void HandleBossHealthChanged(float NewHealth, float MaxHealth);
+
+    UFUNCTION()
+    void HandleRaidMechanic(const FString& InRaidID, FName MechanicID, float Difficulty);
+
+    UFUNCTION()
+    void HandleRaidPhaseChanged(ERaidPhase NewPhase, const TArray<FName>& Mechanics);
+
+    UFUNCTION()
+    void HandleRaidCompleted(const FString& InRaidID, bool bSuccess);
+
+    UFUNCTION()
+    void HandleBossPhaseChanged(const FBossPhaseInfo& NewPhase);
+
+    UPROPERTY()
+    UWorld* World;
+
+    UPROPERTY()
+    USERaidManager* RaidManager;
+
+    UPROPERTY()
+    USEBossManager* BossManager;
+
+    UPROPERTY()
+    ASECharacterBase* Boss;
+
+    TArray<FBot> Bots;
+    FSERaidSimulationSettings Settings;
+    FString RaidID;
+    FName BossID;
+    FRandomStream Random;
+    double NextBossSwingTime = 0.0;
+
+    /** Counters the delegates write into while frames run */
+    FSERaidSimulationReport* Report = nullptr;
+    bool bRaidEnded = false;
+};
@@ -0,0 +1,74 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Raid/SERaidSimulationCommandlet.h"
+#include "Raid/SERaidSimulation.h"
+#include "ShadowEchoes.h"
+
+USERaidSimulationCommandlet::USERaidSimulationCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Simulates a raid encounter with scripted bots and reports frame cost, allocations and damage");
+    HelpUsage = TEXT("-run=SERaidSimulation -nullrhi [-Raid=] [-Boss=] [-Players=] [-Seconds=] [-FrameSeconds=] [-Seed=] [-Runs=] [-MaxFrameMsP99=] [-MaxAllocsPerFrame=]");
+}
+
+int32 USERaidSimulationCommandlet::Main(const FString& Params)
+{
+    FSERaidSimulationSettings Settings;
+    FParse::Value(*Params, TEXT("Raid="), Settings.RaidID);
+    FParse::Value(*Params, TEXT("Boss="), Settings.BossID);
+    FParse::Value(*Params, TEXT("Players="), Settings.NumPlayers);
+    FParse::Value(*Params, TEXT("Seconds="), Settings.MaxSimulatedSeconds);
+    FParse::Value(*Params, TEXT("FrameSeconds="), Settings.FrameSeconds);
+    FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+
+    int32 NumRuns = 1;
+    float MaxFrameMsP99 = 0.0f;
+    float MaxAllocsPerFrame = 0.0f;
+    FParse::Value(*Params, TEXT("Runs="), NumRuns);
+    FParse::Value(*Params, TEXT("MaxFrameMsP99="), MaxFrameMsP99);
+    FParse::Value(*Params, TEXT("MaxAllocsPerFrame="), MaxAllocsPerFrame);
+
+    if (Settings.FrameSeconds <= 0.0f || Settings.MaxSimulatedSeconds <= 0.0f)
+    {
+        SE_LOG_ERROR(TEXT("FrameSeconds and Seconds must be positive"));
+        return 1;
+    }
+
+    // Every run must stay within budget; repeat runs show the cost once caches and pools are warm
+    int32 Result = 0;
+    for (int32 Run = 0; Run < FMath::Max(NumRuns, 1); ++Run)
+    {
+        FSERaidSimulationReport Report;
+        if (!USERaidSimulation::Run(Settings, Report))
+        {
+            SE_LOG_ERROR(TEXT("Raid simulation could not be set up"));
+            return 1;
+        }
+
+        SE_LOG(Display, TEXT("Raid simulation run %d of %d, %d players, seed %d"), Run + 1, NumRuns, Settings.NumPlayers, Settings.Seed);
+        for (const FString& Line : Report.ToLines())
+        {
+            SE_LOG(Display, TEXT("%s"), *Line);
+        }
+
+        if (MaxFrameMsP99 > 0.0f && Report.FrameMsP99 > MaxFrameMsP99)
+        {
+            SE_LOG_ERROR(TEXT("p99 frame %.3f ms is over the %.3f ms budget"), Report.FrameMsP99, MaxFrameMsP99);
+            Result = 1;
+        }
+        if (MaxAllocsPerFrame > 0.0f && !Report.bAllocationsCounted)
+        {
+            SE_LOG_WARNING(TEXT("Allocations are only counted in builds with stats; the allocation budget is not checked"));
+        }
+        else if (MaxAllocsPerFrame > 0.0f && Report.GetAllocationsPerFrame() > MaxAllocsPerFrame)
+        {
+            SE_LOG_ERROR(TEXT("%.1f allocations per frame is over the %.1f budget"), Report.GetAllocationsPerFrame(), MaxAllocsPerFrame);
+            Result = 1;
+        }
+    }
+    return Result;
+}
@@ -0,0 +1,27 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SERaidSimulationCommandlet.generated.h"
+
+/**
+ * Runs the headless raid simulation from the command line
+ *
+ * UnrealEditor-Cmd ShadowEchoes.uproject -run=SERaidSimulation -nullrhi -unattended
+ *     [-Raid=<DT_RaidContent row>] [-Boss=<DT_BossFights row>] [-Players=40] [-Seconds=900]
+ *     [-FrameSeconds=0.0333] [-Seed=48] [-Runs=1] [-MaxFrameMsP99=<ms>] [-MaxAllocsPerFrame=<n>]
+ *
+ * Returns non-zero when setup fails or a budget is exceeded, so a build step can gate on it.
+ */
+UCLASS()
+class SHADOWECHOES_API USERaidSimulationCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USERaidSimulationCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
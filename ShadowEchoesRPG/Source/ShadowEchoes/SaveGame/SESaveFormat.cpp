@@ -0,0 +1,726 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "SaveGame/SESaveFormat.h"
+#include "ShadowEchoes.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SESaveFormatPrivate
+{
+    /** Directory id of the name table blob */
+    static const uint8 NameTableId = 0xFF;
+
+    enum class ECodec : uint8
+    {
+        None  = 0,
+        Zlib  = 1,
+        Oodle = 2
+    };
+
+    /** Magic, version, directory entry count, directory CRC */
+    static const int32 HeaderSize = 16;
+
+    /** Id, codec, offset, stored size, raw size, CRC */
+    static const int32 DirectoryEntrySize = 18;
+
+    /** Quest states per packed byte */
+    static const int32 QuestStatesPerByte = 4;
+
+    static FName GetCodecFormat(ECodec Codec)
+    {
+        return Codec == ECodec::Oodle ? NAME_Oodle : NAME_Zlib;
+    }
+
+    /** Oodle compresses and decompresses faster than zlib; use it whenever it is linked in */
+    static ECodec GetPreferredCodec()
+    {
+        static const ECodec Preferred = FCompression::IsFormatValid(NAME_Oodle) ? ECodec::Oodle : ECodec::Zlib;
+        return Preferred;
+    }
+
+    /** Signed varint with zigzag encoding */
+    static void SerializeVarInt(FArchive& Ar, int32& Value)
+    {
+        uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+        Ar.SerializeIntPacked(Encoded);
+        if (Ar.IsLoading())
+        {
+            Value = static_cast<int32>(Encoded >> 1) ^ -static_cast<int32>(Encoded & 1);
+        }
+    }
+
+    static void SerializeCount(FArchive& Ar, int32& Count)
+    {
+        uint32 Packed = static_cast<uint32>(Count);
+        Ar.SerializeIntPacked(Packed);
+        Count = static_cast<int32>(Packed);
+    }
+
+    /** Assigns each distinct name one index while sections are written */
+    struct FNameTableWriter
+    {
+        TMap<FName, uint32> Indices;
+        TArray<FName> Names;
+
+        void Write(FArchive& Ar, FName Name)
+        {
+            uint32 Index = 0;
+            if (const uint32* Existing = Indices.Find(Name))
+            {
+                Index = *Existing;
+            }
+            else
+            {
+                Index = Names.Add(Name);
+                Indices.Add(Name, Index);
+            }
+            Ar.SerializeIntPacked(Index);
+        }
+    };
+
+    static FName ReadName(FArchive& Ar, const TArray<FName>& NameTable)
+    {
+        uint32 Index = 0;
+        Ar.SerializeIntPacked(Index);
+        if (!NameTable.IsValidIndex(Index))
+        {
+            Ar.SetError();
+            return NAME_None;
+        }
+        return NameTable[Index];
+    }
+
+    static bool IsCountSane(FArchive& Ar, int32 Count)
+    {
+        // Every element takes at least one byte
+        return Count >= 0 && Count <= Ar.TotalSize() - Ar.Tell();
+    }
+
+    /** Section writers */
+    static void WriteNameArray(FArchive& Ar, FNameTableWriter& Names, const TArray<FName>& Array)
+    {
+        int32 Count = Array.Num();
+        SerializeCount(Ar, Count);
+        for (const FName& Name : Array)
+        {
+            Names.Write(Ar, Name);
+        }
+    }
+
+    static void WriteFloatMap(FArchive& Ar, FNameTableWriter& Names, const TMap<FName, float>& Map)
+    {
+        int32 Count = Map.Num();
+        SerializeCount(Ar, Count);
+        for (const auto& Pair : Map)
+        {
+            Names.Write(Ar, Pair.Key);
+            float Value = Pair.Value;
+            Ar << Value;
+        }
+    }
+
+    static void WriteCore(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot)
+    {
+        // Metadata
+        FDateTime LastSaveTime = Snapshot.LastSaveTime;
+        FString SaveSlotName = Snapshot.SaveSlotName;
+        uint32 JournalGeneration = Snapshot.JournalGeneration;
+        Ar << LastSaveTime << SaveSlotName;
+        Ar.SerializeIntPacked(JournalGeneration);
+
+        // Player data
+        int32 PlayerLevel = Snapshot.PlayerLevel;
+        int32 PlayerExperience = Snapshot.PlayerExperience;
+        int32 PlayerCurrency = Snapshot.PlayerCurrency;
+        uint8 TimelineState = static_cast<uint8>(Snapshot.CurrentTimelineState);
+        SerializeVarInt(Ar, PlayerLevel);
+        SerializeVarInt(Ar, PlayerExperience);
+        SerializeVarInt(Ar, PlayerCurrency);
+        Ar << TimelineState;
+
+        // Combat stats and mastery
+        float Floats[] = { Snapshot.MaxHealth, Snapshot.MaxTimelineEnergy, Snapshot.BaseDamage,
+            Snapshot.BrightTimelineMastery, Snapshot.DarkTimelineMastery };
+        for (float& Value : Floats)
+        {
+            Ar << Value;
+        }
+
+        WriteNameArray(Ar, Names, Snapshot.UnlockedAbilities);
+        WriteFloatMap(Ar, Names, Snapshot.GameSettings);
+    }
+
+    static void WriteQuests(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot)
+    {
+        int32 Count = Snapshot.QuestStates.Num();
+        SerializeCount(Ar, Count);
+
+        // Names first, then the states packed two bits each
+        TArray<uint8> Packed;
+        Packed.SetNumZeroed(FMath::DivideAndRoundUp(Count, QuestStatesPerByte));
+        int32 Index = 0;
+        for (const auto& Pair : Snapshot.QuestStates)
+        {
+            Names.Write(Ar, Pair.Key);
+            const int32 Shift = (Index % QuestStatesPerByte) * 2;
+            Packed[Index / QuestStatesPerByte] |= (static_cast<uint8>(Pair.Value) & 0x3) << Shift;
+            ++Index;
+        }
+        Ar.Serialize(Packed.GetData(), Packed.Num());
+    }
+
+    static void WriteInventory(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot)
+    {
+        WriteNameArray(Ar, Names, Snapshot.InventoryItems);
+
+        int32 Count = Snapshot.EquippedItems.Num();
+        SerializeCount(Ar, Count);
+        for (const auto& Pair : Snapshot.EquippedItems)
+        {
+            Names.Write(Ar, Pair.Key);
+            Names.Write(Ar, Pair.Value);
+        }
+    }
+
+    /** Bit count, the registry IDs those bits refer to, then the bits themselves */
+    static void WriteProgression(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot, ESEProgressionDomain Domain)
+    {
+        const TBitArray<>& Bits = Snapshot.Progression.GetBits(Domain);
+        TSharedPtr<const TArray<FName>, ESPMode::ThreadSafe> IDs = Snapshot.Progression.IDs[static_cast<int32>(Domain)];
+        if (!IDs.IsValid())
+        {
+            check(IsInGameThread());
+            IDs = FSEProgressionRegistry::Get().GetIDs(Domain);
+        }
+
+        // Trailing clear bits carry no information
+        int32 NumBits = FMath::Min(Bits.FindLast(true) + 1, IDs->Num());
+        SerializeCount(Ar, NumBits);
+        for (int32 Index = 0; Index < NumBits; ++Index)
+        {
+            Names.Write(Ar, (*IDs)[Index]);
+        }
+
+        TArray<uint8> Packed;
+        Packed.SetNumZeroed(FMath::DivideAndRoundUp(NumBits, 8));
+        for (TConstSetBitIterator<> It(Bits); It && It.GetIndex() < NumBits; ++It)
+        {
+            Packed[It.GetIndex() / 8] |= 1 << (It.GetIndex() % 8);
+        }
+        Ar.Serialize(Packed.GetData(), Packed.Num());
+    }
+
+    static void WriteAchievements(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot)
+    {
+        WriteFloatMap(Ar, Names, Snapshot.AchievementProgress);
+        WriteProgression(Ar, Names, Snapshot, ESEProgressionDomain::Achievement);
+    }
+
+    static void WriteWorld(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot)
+    {
+        WriteProgression(Ar, Names, Snapshot, ESEProgressionDomain::Area);
+        WriteProgression(Ar, Names, Snapshot, ESEProgressionDomain::Secret);
+        WriteProgression(Ar, Names, Snapshot, ESEProgressionDomain::Location);
+        WriteFloatMap(Ar, Names, Snapshot.BossFightRecords);
+    }
+
+    /** Player string, content name, absolute expiry */
+    static void WriteLockouts(FArchive& Ar, FNameTableWriter& Names, const FSESaveSnapshot& Snapshot)
+    {
+        int32 Count = Snapshot.Lockouts.Num();
+        SerializeCount(Ar, Count);
+        for (const FSELockoutRecord& Record : Snapshot.Lockouts)
+        {
+            FSEEntityID PlayerID = Record.PlayerID;
+            int64 ExpiresAt = Record.ExpiresAt;
+            Ar << PlayerID;
+            Names.Write(Ar, Record.Content);
+            Ar << ExpiresAt;
+        }
+    }
+
+    /** Section readers */
+    static void ReadNameArray(FArchive& Ar, const TArray<FName>& NameTable, TArray<FName>& OutArray)
+    {
+        int32 Count = 0;
+        SerializeCount(Ar, Count);
+        if (!IsCountSane(Ar, Count))
+        {
+            Ar.SetError();
+            return;
+        }
+
+        OutArray.Reset(Count);
+        for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+        {
+            OutArray.Add(ReadName(Ar, NameTable));
+        }
+    }
+
+    static void ReadFloatMap(FArchive& Ar, const TArray<FName>& NameTable, TMap<FName, float>& OutMap)
+    {
+        int32 Count = 0;
+        SerializeCount(Ar, Count);
+        if (!IsCountSane(Ar, Count))
+        {
+            Ar.SetError();
+            return;
+        }
+
+        OutMap.Reset();
+        OutMap.Reserve(Count);
+        for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+        {
+            const FName Key = ReadName(Ar, NameTable);
+            float Value = 0.0f;
+            Ar << Value;
+            OutMap.Add(Key, Value);
+        }
+    }
+
+    static void ReadCore(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        Ar << Snapshot.LastSaveTime << Snapshot.SaveSlotName;
+        Ar.SerializeIntPacked(Snapshot.JournalGeneration);
+
+        uint8 TimelineState = 0;
+        SerializeVarInt(Ar, Snapshot.PlayerLevel);
+        SerializeVarInt(Ar, Snapshot.PlayerExperience);
+        SerializeVarInt(Ar, Snapshot.PlayerCurrency);
+        Ar << TimelineState;
+        Snapshot.CurrentTimelineState = static_cast<ETimelineState>(TimelineState);
+
+        Ar << Snapshot.MaxHealth << Snapshot.MaxTimelineEnergy << Snapshot.BaseDamage;
+        Ar << Snapshot.BrightTimelineMastery << Snapshot.DarkTimelineMastery;
+
+        ReadNameArray(Ar, NameTable, Snapshot.UnlockedAbilities);
+        ReadFloatMap(Ar, NameTable, Snapshot.GameSettings);
+    }
+
+    static void ReadQuests(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        int32 Count = 0;
+        SerializeCount(Ar, Count);
+        if (!IsCountSane(Ar, Count))
+        {
+            Ar.SetError();
+            return;
+        }
+
+        TArray<FName> QuestIDs;
+        QuestIDs.Reserve(Count);
+        for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+        {
+            QuestIDs.Add(ReadName(Ar, NameTable));
+        }
+
+        TArray<uint8> Packed;
+        Packed.SetNumUninitialized(FMath::DivideAndRoundUp(Count, QuestStatesPerByte));
+        Ar.Serialize(Packed.GetData(), Packed.Num());
+        if (Ar.IsError())
+        {
+            return;
+        }
+
+        Snapshot.QuestStates.Reset();
+        Snapshot.QuestStates.Reserve(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const int32 Shift = (Index % QuestStatesPerByte) * 2;
+            const uint8 State = (Packed[Index / QuestStatesPerByte] >> Shift) & 0x3;
+            Snapshot.QuestStates.Add(QuestIDs[Index], static_cast<EQuestState>(State));
+        }
+    }
+
+    static void ReadInventory(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        ReadNameArray(Ar, NameTable, Snapshot.InventoryItems);
+
+        int32 Count = 0;
+        SerializeCount(Ar, Count);
+        if (!IsCountSane(Ar, Count))
+        {
+            Ar.SetError();
+            return;
+        }
+
+        Snapshot.EquippedItems.Reset();
+        for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+        {
+            const FName Slot = ReadName(Ar, NameTable);
+            const FName Item = ReadName(Ar, NameTable);
+            Snapshot.EquippedItems.Add(Slot, Item);
+        }
+    }
+
+    static void ReadProgression(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot, ESEProgressionDomain Domain)
+    {
+        TArray<FName> IDs;
+        ReadNameArray(Ar, NameTable, IDs);
+
+        TArray<uint8> Packed;
+        Packed.SetNumUninitialized(FMath::DivideAndRoundUp(IDs.Num(), 8));
+        Ar.Serialize(Packed.GetData(), Packed.Num());
+        if (Ar.IsError())
+        {
+            return;
+        }
+
+        // Same index assignment as when the save was written: take the bits as they are
+        FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+        bool bSameIndices = IDs.Num() <= Registry.Num(Domain);
+        for (int32 Index = 0; Index < IDs.Num() && bSameIndices; ++Index)
+        {
+            bSameIndices = Registry.GetID(Domain, Index) == IDs[Index];
+        }
+
+        TBitArray<>& Bits = Snapshot.Progression.GetBits(Domain);
+        Bits.Init(false, bSameIndices ? IDs.Num() : 0);
+        for (int32 Index = 0; Index < IDs.Num(); ++Index)
+        {
+            if (Packed[Index / 8] & (1 << (Index % 8)))
+            {
+                if (bSameIndices)
+                {
+                    Bits[Index] = true;
+                }
+                else
+                {
+                    // Data tables changed since the save; remap by ID
+                    Snapshot.Progression.SetID(Domain, IDs[Index]);
+                }
+            }
+        }
+    }
+
+    static void ReadAchievements(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        ReadFloatMap(Ar, NameTable, Snapshot.AchievementProgress);
+        ReadProgression(Ar, NameTable, Snapshot, ESEProgressionDomain::Achievement);
+    }
+
+    static void ReadWorld(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        ReadProgression(Ar, NameTable, Snapshot, ESEProgressionDomain::Area);
+        ReadProgression(Ar, NameTable, Snapshot, ESEProgressionDomain::Secret);
+        ReadProgression(Ar, NameTable, Snapshot, ESEProgressionDomain::Location);
+        ReadFloatMap(Ar, NameTable, Snapshot.BossFightRecords);
+    }
+
+    /** Version 3 layouts: no achievement bits, discovered locations stored by name */
+    static void ReadAchievementsV3(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        ReadFloatMap(Ar, NameTable, Snapshot.AchievementProgress);
+    }
+
+    static void ReadWorldV3(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        TArray<FName> DiscoveredLocations;
+        ReadNameArray(Ar, NameTable, DiscoveredLocations);
+        Snapshot.Progression.SetIDs(ESEProgressionDomain::Location, DiscoveredLocations);
+        ReadFloatMap(Ar, NameTable, Snapshot.BossFightRecords);
+    }
+
+    static void ReadLockouts(FArchive& Ar, const TArray<FName>& NameTable, FSESaveSnapshot& Snapshot)
+    {
+        int32 Count = 0;
+        SerializeCount(Ar, Count);
+        if (!IsCountSane(Ar, Count))
+        {
+            Ar.SetError();
+            return;
+        }
+
+        Snapshot.Lockouts.Reset(Count);
+        for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+        {
+            FSELockoutRecord& Record = Snapshot.Lockouts.AddDefaulted_GetRef();
+            Ar << Record.PlayerID;
+            Record.Content = ReadName(Ar, NameTable);
+            Ar << Record.ExpiresAt;
+        }
+    }
+
+    typedef void (*FSectionWriter)(FArchive&, FNameTableWriter&, const FSESaveSnapshot&);
+    typedef void (*FSectionReader)(FArchive&, const TArray<FName>&, FSESaveSnapshot&);
+
+    /** Indexed by ESESaveSection */
+    static const FSectionWriter SectionWriters[] = { &WriteCore, &WriteQuests, &WriteInventory, &WriteAchievements, &WriteWorld, &WriteLockouts };
+    static const FSectionReader SectionReaders[] = { &ReadCore, &ReadQuests, &ReadInventory, &ReadAchievements, &ReadWorld, &ReadLockouts };
+    static const FSectionReader SectionReadersV3[] = { &ReadCore, &ReadQuests, &ReadInventory, &ReadAchievementsV3, &ReadWorldV3, &ReadLockouts };
+    static_assert(UE_ARRAY_COUNT(SectionWriters) == static_cast<int32>(ESESaveSection::Num), "Missing save section writer");
+    static_assert(UE_ARRAY_COUNT(SectionReaders) == static_cast<int32>(ESESaveSection::Num), "Missing save section reader");
+    static_assert(UE_ARRAY_COUNT(SectionReadersV3) == static_cast<int32>(ESESaveSection::Num), "Missing save section reader");
+
+    /** Compress a blob if that makes it smaller */
+    static ECodec CompressBlob(const TArray<uint8>& Raw, TArray<uint8>& OutStored)
+    {
+        const ECodec Codec = GetPreferredCodec();
+        const FName Format = GetCodecFormat(Codec);
+
+        int32 CompressedSize = FCompression::CompressMemoryBound(Format, Raw.Num());
+        OutStored.SetNumUninitialized(CompressedSize);
+        if (Raw.Num() > 0 &&
+            FCompression::CompressMemory(Format, OutStored.GetData(), CompressedSize, Raw.GetData(), Raw.Num()) &&
+            CompressedSize < Raw.Num())
+        {
+            OutStored.SetNum(CompressedSize, false);
+            return Codec;
+        }
+
+        OutStored = Raw;
+        return ECodec::None;
+    }
+}
+
+bool FSESaveFormat::Write(const FSESaveSnapshot& Snapshot, TArray<uint8>& OutBytes, FSESaveStats& Stats)
+{
+    using namespace SESaveFormatPrivate;
+
+    struct FBlob
+    {
+        uint8 Id = 0;
+        TArray<uint8> Raw;
+    };
+
+    // Serialize sections; the name table fills as they go
+    const double SerializeStart = FPlatformTime::Seconds();
+    FNameTableWriter Names;
+    TArray<FBlob> Blobs;
+    Blobs.SetNum(static_cast<int32>(ESESaveSection::Num) + 1);
+    for (int32 Section = 0; Section < static_cast<int32>(ESESaveSection::Num); ++Section)
+    {
+        FBlob& Blob = Blobs[Section + 1];
+        Blob.Id = static_cast<uint8>(Section);
+        FMemoryWriter Writer(Blob.Raw);
+        SectionWriters[Section](Writer, Names, Snapshot);
+    }
+
+    // Name table goes first so a reader can resolve every later section
+    {
+        FBlob& Blob = Blobs[0];
+        Blob.Id = NameTableId;
+        FMemoryWriter Writer(Blob.Raw);
+        int32 Count = Names.Names.Num();
+        SerializeCount(Writer, Count);
+        for (const FName& Name : Names.Names)
+        {
+            FString NameString = Name.ToString();
+            Writer << NameString;
+        }
+    }
+    Stats.SerializeMs = static_cast<float>((FPlatformTime::Seconds() - SerializeStart) * 1000.0);
+
+    // Compress each section independently
+    const double CompressStart = FPlatformTime::Seconds();
+    TArray<FSESaveSectionEntry> Directory;
+    TArray<TArray<uint8>> Stored;
+    Directory.SetNum(Blobs.Num());
+    Stored.SetNum(Blobs.Num());
+
+    int32 UncompressedBytes = 0;
+    uint32 Offset = HeaderSize + DirectoryEntrySize * Blobs.Num();
+    for (int32 Index = 0; Index < Blobs.Num(); ++Index)
+    {
+        FSESaveSectionEntry& Entry = Directory[Index];
+        Entry.SectionId = Blobs[Index].Id;
+        Entry.Codec = static_cast<uint8>(CompressBlob(Blobs[Index].Raw, Stored[Index]));
+        Entry.Offset = Offset;
+        Entry.StoredSize = Stored[Index].Num();
+        Entry.RawSize = Blobs[Index].Raw.Num();
+        Entry.Crc = FCrc::MemCrc32(Stored[Index].GetData(), Stored[Index].Num());
+
+        Offset += Entry.StoredSize;
+        UncompressedBytes += Entry.RawSize;
+    }
+    Stats.CompressMs = static_cast<float>((FPlatformTime::Seconds() - CompressStart) * 1000.0);
+    Stats.UncompressedBytes = UncompressedBytes;
+
+    // Directory
+    TArray<uint8> DirectoryBytes;
+    {
+        FMemoryWriter Writer(DirectoryBytes);
+        for (FSESaveSectionEntry& Entry : Directory)
+        {
+            Writer << Entry;
+        }
+    }
+
+    // Assemble
+    OutBytes.Reset(Offset);
+    FMemoryWriter Writer(OutBytes);
+    uint32 FileMagic = Magic;
+    int32 Version = FormatVersion;
+    uint32 NumEntries = Directory.Num();
+    uint32 DirectoryCrc = FCrc::MemCrc32(DirectoryBytes.GetData(), DirectoryBytes.Num());
+    Writer << FileMagic << Version << NumEntries << DirectoryCrc;
+    Writer.Serialize(DirectoryBytes.GetData(), DirectoryBytes.Num());
+    for (TArray<uint8>& Blob : Stored)
+    {
+        Writer.Serialize(Blob.GetData(), Blob.Num());
+    }
+
+    return !Writer.IsError();
+}
+
+int32 FSESaveFormat::PeekVersion(const TArray<uint8>& Bytes)
+{
+    if (Bytes.Num() < 8)
+    {
+        return INDEX_NONE;
+    }
+
+    FMemoryReader Reader(Bytes);
+    uint32 FileMagic = 0;
+    int32 Version = 0;
+    Reader << FileMagic << Version;
+    return FileMagic == Magic ? Version : INDEX_NONE;
+}
+
+TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> FSESaveSlotReader::Open(TArray<uint8>&& InFileBytes)
+{
+    using namespace SESaveFormatPrivate;
+
+    const int32 FileVersion = FSESaveFormat::PeekVersion(InFileBytes);
+    if (FileVersion < FSESaveFormat::MinSectionedVersion || FileVersion > FSESaveFormat::FormatVersion || InFileBytes.Num() < HeaderSize)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SlotReader = MakeShared<FSESaveSlotReader, ESPMode::ThreadSafe>();
+    SlotReader->FileBytes = MoveTemp(InFileBytes);
+    SlotReader->Version = FileVersion;
+    const TArray<uint8>& Bytes = SlotReader->FileBytes;
+
+    // Header and directory
+    FMemoryReader Reader(Bytes);
+    uint32 FileMagic = 0;
+    int32 Version = 0;
+    uint32 NumEntries = 0;
+    uint32 DirectoryCrc = 0;
+    Reader << FileMagic << Version << NumEntries << DirectoryCrc;
+
+    const int64 DirectoryBytes = static_cast<int64>(NumEntries) * DirectoryEntrySize;
+    if (HeaderSize + DirectoryBytes > Bytes.Num() ||
+        FCrc::MemCrc32(Bytes.GetData() + HeaderSize, static_cast<int32>(DirectoryBytes)) != DirectoryCrc)
+    {
+        return nullptr;
+    }
+
+    SlotReader->Directory.SetNum(NumEntries);
+    for (FSESaveSectionEntry& Entry : SlotReader->Directory)
+    {
+        Reader << Entry;
+
+        // Verify every section up front so a damaged file falls back to the backup at load
+        if (static_cast<int64>(Entry.Offset) + Entry.StoredSize > Bytes.Num() ||
+            FCrc::MemCrc32(Bytes.GetData() + Entry.Offset, Entry.StoredSize) != Entry.Crc)
+        {
+            return nullptr;
+        }
+    }
+
+    // Name table
+    const FSESaveSectionEntry* NamesEntry = SlotReader->FindEntry(NameTableId);
+    TArray<uint8> NamesRaw;
+    if (!NamesEntry || !SlotReader->DecodeBlob(*NamesEntry, NamesRaw))
+    {
+        return nullptr;
+    }
+
+    FMemoryReader NamesReader(NamesRaw);
+    int32 Count = 0;
+    SerializeCount(NamesReader, Count);
+    if (!IsCountSane(NamesReader, Count))
+    {
+        return nullptr;
+    }
+
+    SlotReader->NameTable.Reserve(Count);
+    for (int32 Index = 0; Index < Count && !NamesReader.IsError(); ++Index)
+    {
+        FString NameString;
+        NamesReader << NameString;
+        SlotReader->NameTable.Add(FName(*NameString));
+    }
+
+    return NamesReader.IsError() ? nullptr : SlotReader;
+}
+
+bool FSESaveSlotReader::LoadSections(uint32 Mask, FSESaveSnapshot& Snapshot)
+{
+    using namespace SESaveFormatPrivate;
+
+    const FSectionReader* Readers = Version < FSESaveFormat::FormatVersion ? SectionReadersV3 : SectionReaders;
+    bool bSuccess = true;
+    for (int32 Section = 0; Section < static_cast<int32>(ESESaveSection::Num); ++Section)
+    {
+        const uint32 Bit = SESaveSections::Bit(static_cast<ESESaveSection>(Section));
+        if (!(Mask & Bit) || (LoadedMask & Bit))
+        {
+            continue;
+        }
+        LoadedMask |= Bit;
+
+        // A section missing from the file keeps the snapshot defaults
+        const FSESaveSectionEntry* Entry = FindEntry(static_cast<uint8>(Section));
+        if (!Entry)
+        {
+            continue;
+        }
+
+        TArray<uint8> Raw;
+        if (!DecodeBlob(*Entry, Raw))
+        {
+            bSuccess = false;
+            continue;
+        }
+
+        FMemoryReader Reader(Raw);
+        Readers[Section](Reader, NameTable, Snapshot);
+        if (Reader.IsError())
+        {
+            SE_LOG_WARNING(TEXT("Save section %d failed to decode"), Section);
+            bSuccess = false;
+        }
+    }
+
+    // Every section is in the snapshot; the file bytes are no longer needed
+    if (IsFullyLoaded())
+    {
+        FileBytes.Empty();
+        Directory.Empty();
+        NameTable.Empty();
+    }
+
+    return bSuccess;
+}
+
+const FSESaveSectionEntry* FSESaveSlotReader::FindEntry(uint8 SectionId) const
+{
+    return Directory.FindByPredicate([SectionId](const FSESaveSectionEntry& Entry) { return Entry.SectionId == SectionId; });
+}
+
+bool FSESaveSlotReader::DecodeBlob(const FSESaveSectionEntry& Entry, TArray<uint8>& OutRaw) const
+{
+    using namespace SESaveFormatPrivate;
+
+    const uint8* Stored = FileBytes.GetData() + Entry.Offset;
+    const ECodec Codec = static_cast<ECodec>(Entry.Codec);
+
+    if (Codec == ECodec::None)
+    {
+        OutRaw.Reset(Entry.StoredSize);
+        OutRaw.Append(Stored, Entry.StoredSize);
+        return Entry.StoredSize == Entry.RawSize;
+    }
+
+    if (Codec != ECodec::Zlib && Codec != ECodec::Oodle)
+    {
+        return false;
+    }
+
+    OutRaw.SetNumUninitialized(Entry.RawSize);
+    return FCompression::UncompressMemory(GetCodecFormat(Codec), OutRaw.GetData(), OutRaw.Num(), Stored, Entry.StoredSize);
+}
@@ -0,0 +1,111 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGame/SESaveTypes.h"
+
+/**
+ * Sections of a save file. Core is decoded at load; the rest on first use.
+ */
+enum class ESESaveSection : uint8
+{
+    Core         = 0,
+    Quests       = 1,
+    Inventory    = 2,
+    Achievements = 3,
+    World        = 4,
+    Lockouts     = 5,
+
+    Num
+};
+
+namespace SESaveSections
+{
+    inline uint32 Bit(ESESaveSection Section) { return 1u << static_cast<uint32>(Section); }
+
+    static constexpr uint32 All = (1u << static_cast<uint32>(ESESaveSection::Num)) - 1;
+}
+
+/** Directory entry of one stored section */
+struct FSESaveSectionEntry
+{
+    uint8 SectionId = 0;
+    uint8 Codec = 0;
+    uint32 Offset = 0;
+    uint32 StoredSize = 0;
+    uint32 RawSize = 0;
+    uint32 Crc = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FSESaveSectionEntry& Entry)
+    {
+        Ar << Entry.SectionId;
+        Ar << Entry.Codec;
+        Ar << Entry.Offset;
+        Ar << Entry.StoredSize;
+        Ar << Entry.RawSize;
+        Ar << Entry.Crc;
+        return Ar;
+    }
+};
+
+/**
+ * Versioned container format for save slots
+ *
+ * Layout: fixed header, section directory (id, codec, offset, stored/raw size, CRC), then
+ * section blobs. A deduplicated name table is stored as its own blob and every FName in
+ * the other sections is written as a varint index into it. Enums are bit-packed and each
+ * section is compressed independently (Oodle when available, otherwise zlib, or stored raw
+ * when compression does not help), so sections can be decoded one at a time.
+ */
+class SHADOWECHOES_API FSESaveFormat
+{
+public:
+    /** 'SESV' */
+    static const uint32 Magic = 0x53455356;
+
+    /**
+     * 4: progression bitsets in the achievement and world sections; 3: sectioned container
+     * with discovered locations by name; 1-2: single zlib payload of the whole snapshot
+     */
+    static const int32 FormatVersion = 4;
+
+    /** Oldest version read through FSESaveSlotReader */
+    static const int32 MinSectionedVersion = 3;
+
+    /** Encode a full snapshot */
+    static bool Write(const FSESaveSnapshot& Snapshot, TArray<uint8>& OutBytes, FSESaveStats& Stats);
+
+    /** Format version of an encoded file, or INDEX_NONE if it is not a save file */
+    static int32 PeekVersion(const TArray<uint8>& Bytes);
+};
+
+/**
+ * Lazy reader over one encoded save file
+ * Open() verifies the directory and every section CRC and decodes the name table; sections
+ * are decompressed and deserialized only when LoadSections() asks for them.
+ */
+class SHADOWECHOES_API FSESaveSlotReader
+{
+public:
+    /** Validate a file; returns null if it is corrupt or not a sectioned save */
+    static TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> Open(TArray<uint8>&& FileBytes);
+
+    /** Decode sections in Mask that are not loaded yet into Snapshot */
+    bool LoadSections(uint32 Mask, FSESaveSnapshot& Snapshot);
+
+    uint32 GetLoadedMask() const { return LoadedMask; }
+    bool IsFullyLoaded() const { return LoadedMask == SESaveSections::All; }
+
+private:
+    bool DecodeBlob(const FSESaveSectionEntry& Entry, TArray<uint8>& OutRaw) const;
+    const FSESaveSectionEntry* FindEntry(uint8 SectionId) const;
+
+    TArray<uint8> FileBytes;
+    TArray<FSESaveSectionEntry> Directory;
+    TArray<FName> NameTable;
+    uint32 LoadedMask = 0;
+
+    /** Format version of the file, selects the section layout */
+    int32 Version = 0;
+};
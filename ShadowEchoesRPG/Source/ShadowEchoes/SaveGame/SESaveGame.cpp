@@ -69,14 +69,53 @@ void USESaveGame::Serialize(FArchive& Ar)
     // Settings
     Ar << GameSettings;
 
-    // Validate data after loading
-    if (Ar.IsLoading())
-    {
-        if (!ValidateData())
-        {
-            RepairInvalidData();
-        }
-    }
+    // Validation is done on FSESaveSnapshot by the save pipeline, off the game thread
+}
+
+void USESaveGame::ToSnapshot(FSESaveSnapshot& OutSnapshot) const
+{
+    OutSnapshot.PlayerLevel = PlayerLevel;
+    OutSnapshot.PlayerExperience = PlayerExperience;
+    OutSnapshot.PlayerCurrency = PlayerCurrency;
+    OutSnapshot.CurrentTimelineState = CurrentTimelineState;
+    OutSnapshot.QuestStates = QuestStates;
+    OutSnapshot.UnlockedAbilities = UnlockedAbilities;
+    OutSnapshot.InventoryItems = InventoryItems;
+    OutSnapshot.EquippedItems = EquippedItems;
+    OutSnapshot.MaxHealth = MaxHealth;
+    OutSnapshot.MaxTimelineEnergy = MaxTimelineEnergy;
+    OutSnapshot.BaseDamage = BaseDamage;
+    OutSnapshot.BrightTimelineMastery = BrightTimelineMastery;
+    OutSnapshot.DarkTimelineMastery = DarkTimelineMastery;
+    OutSnapshot.AchievementProgress = AchievementProgress;
+    OutSnapshot.Progression.SetIDs(ESEProgressionDomain::Location, DiscoveredLocations);
+    OutSnapshot.BossFightRecords = BossFightRecords;
+    OutSnapshot.GameSettings = GameSettings;
+    OutSnapshot.LastSaveTime = LastSaveTime;
+    OutSnapshot.SaveSlotName = SaveSlotName;
+}
+
+void USESaveGame::FromSnapshot(const FSESaveSnapshot& Snapshot)
+{
+    PlayerLevel = Snapshot.PlayerLevel;
+    PlayerExperience = Snapshot.PlayerExperience;
+    PlayerCurrency = Snapshot.PlayerCurrency;
+    CurrentTimelineState = Snapshot.CurrentTimelineState;
+    QuestStates = Snapshot.QuestStates;
+    UnlockedAbilities = Snapshot.UnlockedAbilities;
+    InventoryItems = Snapshot.InventoryItems;
+    EquippedItems = Snapshot.EquippedItems;
+    MaxHealth = Snapshot.MaxHealth;
+    MaxTimelineEnergy = Snapshot.MaxTimelineEnergy;
+    BaseDamage = Snapshot.BaseDamage;
+    BrightTimelineMastery = Snapshot.BrightTimelineMastery;
+    DarkTimelineMastery = Snapshot.DarkTimelineMastery;
+    AchievementProgress = Snapshot.AchievementProgress;
+    Snapshot.Progression.GetSetIDs(ESEProgressionDomain::Location, DiscoveredLocations);
+    BossFightRecords = Snapshot.BossFightRecords;
+    GameSettings = Snapshot.GameSettings;
+    LastSaveTime = Snapshot.LastSaveTime;
+    SaveSlotName = Snapshot.SaveSlotName;
 }
 
 void USESaveGame::InitializeDefaults()
@@ -128,110 +167,3 @@ void USESaveGame::MigrateFromVersion(int32 OldVersion)
         // Add more version migrations here
     }
 }
-
-bool USESaveGame::ValidateData()
-{
-    bool bIsValid = true;
-
-    bIsValid &= ValidatePlayerData();
-    bIsValid &= ValidateQuestData();
-    bIsValid &= ValidateAbilityData();
-    bIsValid &= ValidateInventoryData();
-
-    return bIsValid;
-}
-
-void USESaveGame::RepairInvalidData()
-{
-    // Fix player data
-    PlayerLevel = FMath::Max(1, PlayerLevel);
-    PlayerExperience = FMath::Max(0, PlayerExperience);
-    PlayerCurrency = FMath::Max(0, PlayerCurrency);
-
-    // Fix combat stats
-    MaxHealth = FMath::Max(100.0f, MaxHealth);
-    MaxTimelineEnergy = FMath::Max(100.0f, MaxTimelineEnergy);
-    BaseDamage = FMath::Max(10.0f, BaseDamage);
-
-    // Fix timeline mastery
-    BrightTimelineMastery = FMath::Clamp(BrightTimelineMastery, 0.0f, 1.0f);
-    DarkTimelineMastery = FMath::Clamp(DarkTimelineMastery, 0.0f, 1.0f);
-
-    // Fix achievement progress
-    for (auto& Pair : AchievementProgress)
-    {
-        Pair.Value = FMath::Max(0.0f, Pair.Value);
-    }
-
-    // Fix game settings
-    for (auto& Pair : GameSettings)
-    {
-        Pair.Value = FMath::Clamp(Pair.Value, 0.0f, 1.0f);
-    }
-}
-
-bool USESaveGame::ValidatePlayerData()
-{
-    if (PlayerLevel < 1 || PlayerExperience < 0 || PlayerCurrency < 0)
-    {
-        return false;
-    }
-
-    if (MaxHealth <= 0.0f || MaxTimelineEnergy <= 0.0f || BaseDamage <= 0.0f)
-    {
-        return false;
-    }
-
-    if (BrightTimelineMastery < 0.0f || BrightTimelineMastery > 1.0f ||
-        DarkTimelineMastery < 0.0f || DarkTimelineMastery > 1.0f)
-    {
-        return false;
-    }
-
-    return true;
-}
-
-bool USESaveGame::ValidateQuestData()
-{
-    for (const auto& Pair : QuestStates)
-    {
-        if (Pair.Key.IsNone())
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool USESaveGame::ValidateAbilityData()
-{
-    for (const FName& AbilityID : UnlockedAbilities)
-    {
-        if (AbilityID.IsNone())
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool USESaveGame::ValidateInventoryData()
-{
-    for (const FName& ItemID : InventoryItems)
-    {
-        if (ItemID.IsNone())
-        {
-            return false;
-        }
-    }
-
-    for (const auto& Pair : EquippedItems)
-    {
-        if (Pair.Key.IsNone() || Pair.Value.IsNone())
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
 #include "Core/SETypes.h"
+#include "SaveGame/SESaveTypes.h"
 #include "SESaveGame.generated.h"
 
 /**
@@ -95,6 +96,10 @@ public:
     /** Serialization */
     virtual void Serialize(FArchive& Ar) override;
 
+    /** Conversion to and from the plain snapshot used by the async save pipeline */
+    void ToSnapshot(FSESaveSnapshot& OutSnapshot) const;
+    void FromSnapshot(const FSESaveSnapshot& Snapshot);
+
 protected:
     /** Initialize default values */
     void InitializeDefaults();
@@ -103,17 +108,7 @@ protected:
     void UpdateToLatestVersion();
     void MigrateFromVersion(int32 OldVersion);
 
-    /** Data validation */
-    bool ValidateData();
-    void RepairInvalidData();
-
 private:
     /** Current save version */
     static const int32 CurrentSaveVersion = 1;
-
-    /** Validation helpers */
-    bool ValidatePlayerData();
-    bool ValidateQuestData();
-    bool ValidateAbilityData();
-    bool ValidateInventoryData();
 };
@@ -0,0 +1,408 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "SaveGame/SESaveGamePipeline.h"
+#include "SaveGame/SESaveFormat.h"
+#include "ShadowEchoes.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC || PLATFORM_ANDROID
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/** Single-payload format written before sectioned saves (versions 1-2) */
+namespace SESaveFile
+{
+    /** 2: journal generation appended to the payload */
+    static const int32 LegacyFormatVersion = 2;
+
+    enum EFlags : uint32
+    {
+        Compressed = 1 << 0
+    };
+
+    struct FHeader
+    {
+        uint32 Magic = 0;
+        int32 FormatVersion = 0;
+        uint32 Flags = 0;
+        int32 UncompressedSize = 0;
+        int32 PayloadSize = 0;
+        uint32 PayloadCrc = 0;
+
+        friend FArchive& operator<<(FArchive& Ar, FHeader& Header)
+        {
+            Ar << Header.Magic;
+            Ar << Header.FormatVersion;
+            Ar << Header.Flags;
+            Ar << Header.UncompressedSize;
+            Ar << Header.PayloadSize;
+            Ar << Header.PayloadCrc;
+            return Ar;
+        }
+    };
+
+    static const int32 HeaderSize = 24;
+}
+
+FSESaveGamePipeline::FSESaveGamePipeline()
+    : bSaveInFlight(false)
+    , WorkerSerial(0)
+    , ReportedSerial(0)
+{
+}
+
+FSESaveGamePipeline::~FSESaveGamePipeline()
+{
+    if (WorkerFuture.IsValid())
+    {
+        WorkerFuture.Wait();
+    }
+}
+
+FString FSESaveGamePipeline::GetSlotPath(const FString& SlotName)
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".sesav"));
+}
+
+void FSESaveGamePipeline::RequestSave(FSESaveSnapshot&& Snapshot, const FString& SlotName, float SnapshotMs)
+{
+    check(IsInGameThread());
+
+    FSaveRequest Request;
+    Request.Snapshot = MoveTemp(Snapshot);
+    Request.SlotName = SlotName;
+    Request.SnapshotMs = SnapshotMs;
+
+    {
+        FScopeLock Lock(&RequestLock);
+        if (bSaveInFlight)
+        {
+            // Back buffer: only the newest waiting snapshot is worth writing
+            WaitingRequest.Emplace(MoveTemp(Request));
+            return;
+        }
+        bSaveInFlight = true;
+    }
+
+    LaunchWorker(MoveTemp(Request));
+}
+
+void FSESaveGamePipeline::LaunchWorker(FSaveRequest&& Request)
+{
+    TWeakPtr<FSESaveGamePipeline, ESPMode::ThreadSafe> WeakThis = AsShared();
+    const uint32 Serial = ++WorkerSerial;
+
+    WorkerFuture = Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, Request = MoveTemp(Request)]() mutable
+    {
+        FSESaveStats Stats;
+        const bool bSuccess = ExecuteSave(Request, Stats);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, bSuccess, Stats]()
+        {
+            if (TSharedPtr<FSESaveGamePipeline, ESPMode::ThreadSafe> Pipeline = WeakThis.Pin())
+            {
+                Pipeline->HandleSaveFinished(Serial, bSuccess, Stats);
+            }
+        });
+        return TPair<bool, FSESaveStats>(bSuccess, Stats);
+    });
+}
+
+bool FSESaveGamePipeline::ExecuteSave(FSaveRequest& Request, FSESaveStats& OutStats)
+{
+    OutStats.SnapshotMs = Request.SnapshotMs;
+    return SaveSlotBlocking(Request.Snapshot, Request.SlotName, OutStats);
+}
+
+bool FSESaveGamePipeline::SaveSlotBlocking(FSESaveSnapshot& Snapshot, const FString& SlotName, FSESaveStats& OutStats)
+{
+    OutStats.JournalGeneration = static_cast<int32>(Snapshot.JournalGeneration);
+
+    // Validation runs here rather than on the game thread
+    if (!Snapshot.Validate())
+    {
+        Snapshot.Repair();
+    }
+
+    TArray<uint8> Bytes;
+    if (!EncodeSnapshot(Snapshot, Bytes, OutStats))
+    {
+        SE_LOG_ERROR(TEXT("Failed to encode save slot %s"), *SlotName);
+        return false;
+    }
+
+    const double WriteStart = FPlatformTime::Seconds();
+    const bool bWritten = WriteFileAtomic(GetSlotPath(SlotName), Bytes);
+    OutStats.WriteMs = static_cast<float>((FPlatformTime::Seconds() - WriteStart) * 1000.0);
+    OutStats.WrittenBytes = Bytes.Num();
+
+    if (!bWritten)
+    {
+        SE_LOG_ERROR(TEXT("Failed to write save slot %s"), *SlotName);
+        return false;
+    }
+
+    // Read the slot back before anyone drops the journals the backup still needs
+    TArray<uint8> Written;
+    if (!FFileHelper::LoadFileToArray(Written, *GetSlotPath(SlotName), FILEREAD_Silent) || !FSESaveSlotReader::Open(MoveTemp(Written)))
+    {
+        SE_LOG_ERROR(TEXT("Save slot %s failed verification after writing"), *SlotName);
+        return false;
+    }
+    return true;
+}
+
+void FSESaveGamePipeline::HandleSaveFinished(uint32 Serial, bool bSuccess, const FSESaveStats& Stats)
+{
+    if (Serial <= ReportedSerial)
+    {
+        return;
+    }
+    ReportedSerial = Serial;
+    LastStats = Stats;
+
+    TOptional<FSaveRequest> NextRequest;
+    {
+        FScopeLock Lock(&RequestLock);
+        if (WaitingRequest.IsSet())
+        {
+            NextRequest = MoveTemp(WaitingRequest);
+            WaitingRequest.Reset();
+        }
+        else
+        {
+            bSaveInFlight = false;
+        }
+    }
+
+    if (NextRequest.IsSet())
+    {
+        LaunchWorker(MoveTemp(NextRequest.GetValue()));
+    }
+
+    OnSaveFinished.ExecuteIfBound(bSuccess, Stats);
+}
+
+void FSESaveGamePipeline::Flush()
+{
+    // The worker's game thread continuation may never run, so its result is reported here
+    if (WorkerFuture.IsValid())
+    {
+        const TPair<bool, FSESaveStats>& Result = WorkerFuture.Get();
+        if (WorkerSerial > ReportedSerial)
+        {
+            ReportedSerial = WorkerSerial;
+            LastStats = Result.Value;
+            OnSaveFinished.ExecuteIfBound(Result.Key, Result.Value);
+        }
+    }
+
+    // Write the waiting snapshot inline
+    TOptional<FSaveRequest> Request;
+    {
+        FScopeLock Lock(&RequestLock);
+        Request = MoveTemp(WaitingRequest);
+        WaitingRequest.Reset();
+        bSaveInFlight = false;
+    }
+
+    if (Request.IsSet())
+    {
+        FSESaveStats Stats;
+        const bool bSuccess = ExecuteSave(Request.GetValue(), Stats);
+        LastStats = Stats;
+        OnSaveFinished.ExecuteIfBound(bSuccess, Stats);
+    }
+}
+
+bool FSESaveGamePipeline::IsSaving() const
+{
+    FScopeLock Lock(&RequestLock);
+    return bSaveInFlight;
+}
+
+bool FSESaveGamePipeline::DoesSlotExist(const FString& SlotName) const
+{
+    const FString Path = GetSlotPath(SlotName);
+    return IFileManager::Get().FileExists(*Path) || IFileManager::Get().FileExists(*(Path + TEXT(".bak")));
+}
+
+bool FSESaveGamePipeline::LoadSlot(const FString& SlotName, FSESaveSnapshot& OutSnapshot) const
+{
+    const FString Path = GetSlotPath(SlotName);
+    const FString Candidates[] = { Path, Path + TEXT(".bak") };
+
+    for (const FString& Candidate : Candidates)
+    {
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *Candidate, FILEREAD_Silent))
+        {
+            continue;
+        }
+
+        if (DecodeSnapshot(MoveTemp(Bytes), OutSnapshot))
+        {
+            if (!OutSnapshot.Validate())
+            {
+                OutSnapshot.Repair();
+            }
+            return true;
+        }
+
+        SE_LOG_WARNING(TEXT("Save file %s is corrupt, trying backup"), *Candidate);
+    }
+
+    return false;
+}
+
+TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> FSESaveGamePipeline::OpenSlot(const FString& SlotName) const
+{
+    const FString Path = GetSlotPath(SlotName);
+    const FString Candidates[] = { Path, Path + TEXT(".bak") };
+
+    for (const FString& Candidate : Candidates)
+    {
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *Candidate, FILEREAD_Silent))
+        {
+            continue;
+        }
+
+        // Older files are read whole through LoadSlot
+        if (FSESaveFormat::PeekVersion(Bytes) < FSESaveFormat::MinSectionedVersion)
+        {
+            return nullptr;
+        }
+
+        if (TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SlotReader = FSESaveSlotReader::Open(MoveTemp(Bytes)))
+        {
+            return SlotReader;
+        }
+
+        SE_LOG_WARNING(TEXT("Save file %s is corrupt, trying backup"), *Candidate);
+    }
+
+    return nullptr;
+}
+
+bool FSESaveGamePipeline::EncodeSnapshot(FSESaveSnapshot& Snapshot, TArray<uint8>& OutBytes, FSESaveStats& Stats)
+{
+    return FSESaveFormat::Write(Snapshot, OutBytes, Stats);
+}
+
+bool FSESaveGamePipeline::DecodeSnapshot(TArray<uint8>&& Bytes, FSESaveSnapshot& OutSnapshot)
+{
+    const int32 Version = FSESaveFormat::PeekVersion(Bytes);
+    if (Version >= FSESaveFormat::MinSectionedVersion)
+    {
+        TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SlotReader = FSESaveSlotReader::Open(MoveTemp(Bytes));
+        return SlotReader && SlotReader->LoadSections(SESaveSections::All, OutSnapshot);
+    }
+
+    if (Version == INDEX_NONE || Version > SESaveFile::LegacyFormatVersion || Bytes.Num() < SESaveFile::HeaderSize)
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    SESaveFile::FHeader Header;
+    Reader << Header;
+
+    if (Header.PayloadSize != Bytes.Num() - SESaveFile::HeaderSize || Header.UncompressedSize < 0)
+    {
+        return false;
+    }
+
+    const uint8* Payload = Bytes.GetData() + SESaveFile::HeaderSize;
+    if (FCrc::MemCrc32(Payload, Header.PayloadSize) != Header.PayloadCrc)
+    {
+        return false;
+    }
+
+    TArray<uint8> Raw;
+    if (Header.Flags & SESaveFile::Compressed)
+    {
+        Raw.SetNumUninitialized(Header.UncompressedSize);
+        if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), Raw.Num(), Payload, Header.PayloadSize))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Raw.Append(Payload, Header.PayloadSize);
+    }
+
+    FMemoryReader RawReader(Raw);
+    RawReader << OutSnapshot;
+    OutSnapshot.JournalGeneration = 0;
+    if (Header.FormatVersion >= 2)
+    {
+        RawReader << OutSnapshot.JournalGeneration;
+    }
+    return !RawReader.IsError();
+}
+
+bool FSESaveGamePipeline::WriteFileAtomic(const FString& Path, const TArray<uint8>& Bytes)
+{
+    IFileManager& FileManager = IFileManager::Get();
+    const FString TempPath = Path + TEXT(".tmp");
+    const FString BackupPath = Path + TEXT(".bak");
+
+    // Write the full file next to the slot first; it must be on disk before a rename publishes it
+    {
+        TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*TempPath));
+        if (!File)
+        {
+            return false;
+        }
+
+        const bool bWriteOk = File->Write(Bytes.GetData(), Bytes.Num()) && File->Flush(true);
+        File.Reset();
+        if (!bWriteOk)
+        {
+            FileManager.Delete(*TempPath, false, false, true);
+            return false;
+        }
+    }
+
+    // Keep the previous slot as backup until the new one is in place
+    if (FileManager.FileExists(*Path) && !FileManager.Move(*BackupPath, *Path, true, true))
+    {
+        return false;
+    }
+
+    if (!FileManager.Move(*Path, *TempPath, true, true))
+    {
+        return false;
+    }
+
+    // Both renames are only durable once the directory entries reach the disk
+    return SyncDirectory(FPaths::GetPath(Path));
+}
+
+bool FSESaveGamePipeline::SyncDirectory(const FString& Directory)
+{
+#if PLATFORM_UNIX || PLATFORM_MAC || PLATFORM_ANDROID
+    const int Descriptor = open(TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(Directory)), O_RDONLY);
+    if (Descriptor < 0)
+    {
+        return false;
+    }
+
+    const bool bSynced = fsync(Descriptor) == 0;
+    close(Descriptor);
+    return bSynced;
+#else
+    // NTFS and the console file systems journal renames with their metadata
+    return true;
+#endif
+}
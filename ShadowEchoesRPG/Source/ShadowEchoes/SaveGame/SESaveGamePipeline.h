@@ -0,0 +1,102 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "SaveGame/SESaveTypes.h"
+
+class FSESaveSlotReader;
+
+DECLARE_DELEGATE_TwoParams(FOnSEAsyncSaveFinished, bool /*bSuccess*/, const FSESaveStats& /*Stats*/);
+
+/**
+ * Asynchronous, double-buffered save writer
+ *
+ * The game thread hands over a captured snapshot; serialization, compression and disk
+ * I/O run on the thread pool. One snapshot is in flight at a time and at most one more
+ * waits behind it (newer requests replace the waiting one). Files are written to a
+ * temporary path, fsynced, and swapped in by rename, keeping the previous file as a backup,
+ * so a valid slot survives a crash or power loss at any point of the write.
+ */
+class SHADOWECHOES_API FSESaveGamePipeline : public TSharedFromThis<FSESaveGamePipeline, ESPMode::ThreadSafe>
+{
+public:
+    FSESaveGamePipeline();
+    ~FSESaveGamePipeline();
+
+    /** Queue a snapshot for writing. Game thread only. */
+    void RequestSave(FSESaveSnapshot&& Snapshot, const FString& SlotName, float SnapshotMs);
+
+    /** Read and validate a slot, falling back to its backup. Blocking. */
+    bool LoadSlot(const FString& SlotName, FSESaveSnapshot& OutSnapshot) const;
+
+    /** Open a sectioned slot for lazy loading, falling back to its backup; null for older formats. Blocking. */
+    TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> OpenSlot(const FString& SlotName) const;
+
+    /** Whether a slot file (or its backup) exists */
+    bool DoesSlotExist(const FString& SlotName) const;
+
+    /** Block until all queued saves are on disk */
+    void Flush();
+
+    /** Whether a save is currently in flight */
+    bool IsSaving() const;
+
+    /** Stats of the most recent completed save */
+    const FSESaveStats& GetLastStats() const { return LastStats; }
+
+    /** Fired on the game thread when a save finishes */
+    FOnSEAsyncSaveFinished OnSaveFinished;
+
+    /** Full path of a slot file */
+    static FString GetSlotPath(const FString& SlotName);
+
+    /** Validate, encode, write and read back a snapshot on the calling thread; false unless the slot verifies */
+    static bool SaveSlotBlocking(FSESaveSnapshot& Snapshot, const FString& SlotName, FSESaveStats& OutStats);
+
+    /**
+     * Durably replace Path with Bytes: write Path.tmp and fsync it, move the old file to
+     * Path.bak, rename the temp file in and fsync the directory. On success the new file
+     * survives power loss; on failure Path (or Path.bak) still holds the previous contents.
+     */
+    static bool WriteFileAtomic(const FString& Path, const TArray<uint8>& Bytes);
+
+    /** Flush a directory's entries so renames within it are durable; no-op where the file system journals them */
+    static bool SyncDirectory(const FString& Directory);
+
+private:
+    struct FSaveRequest
+    {
+        FSESaveSnapshot Snapshot;
+        FString SlotName;
+        float SnapshotMs = 0.0f;
+    };
+
+    /** Start the worker on the given request */
+    void LaunchWorker(FSaveRequest&& Request);
+
+    /** Worker body */
+    static bool ExecuteSave(FSaveRequest& Request, FSESaveStats& OutStats);
+
+    /** Game thread continuation; skipped if Flush already reported the worker */
+    void HandleSaveFinished(uint32 Serial, bool bSuccess, const FSESaveStats& Stats);
+
+    /** File helpers */
+    static bool EncodeSnapshot(FSESaveSnapshot& Snapshot, TArray<uint8>& OutBytes, FSESaveStats& Stats);
+    static bool DecodeSnapshot(TArray<uint8>&& Bytes, FSESaveSnapshot& OutSnapshot);
+
+    /** Guards the in-flight flag and the waiting buffer */
+    mutable FCriticalSection RequestLock;
+    bool bSaveInFlight;
+    TOptional<FSaveRequest> WaitingRequest;
+
+    /** Current worker and its result */
+    TFuture<TPair<bool, FSESaveStats>> WorkerFuture;
+
+    /** Last worker launched and last one reported, game thread only */
+    uint32 WorkerSerial;
+    uint32 ReportedSerial;
+
+    FSESaveStats LastStats;
+};
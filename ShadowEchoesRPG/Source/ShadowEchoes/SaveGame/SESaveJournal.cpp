@@ -0,0 +1,465 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "SaveGame/SESaveJournal.h"
+#include "SaveGame/SESaveGamePipeline.h"
+#include "ShadowEchoes.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SEJournalFile
+{
+    /** Each batch: uint32 payload size, uint32 payload CRC, payload */
+    static const int32 BatchHeaderSize = 8;
+    static const TCHAR* Extension = TEXT(".journal");
+}
+
+FSESaveJournal::FSESaveJournal(const FString& InSlotName)
+    : SlotName(InSlotName)
+    , Generation(0)
+    , NumPendingRecords(0)
+    , JournalBytes(0)
+    , DeferredMask(0)
+{
+}
+
+FSESaveJournal::~FSESaveJournal()
+{
+    LastTask.Wait();
+}
+
+FString FSESaveJournal::GetJournalPath(uint32 InGeneration) const
+{
+    return FSESaveGamePipeline::GetSlotPath(SlotName) + SEJournalFile::Extension + LexToString(InGeneration);
+}
+
+void FSESaveJournal::BeginRecord(ESESaveJournalRecord Type)
+{
+    check(IsInGameThread());
+    PendingBatch.Add(static_cast<uint8>(Type));
+    ++NumPendingRecords;
+}
+
+void FSESaveJournal::WriteName(FName Name)
+{
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    FString NameString = Name.ToString();
+    Writer << NameString;
+}
+
+void FSESaveJournal::RecordPlayerProgress(int32 Level, int32 Experience, int32 Currency)
+{
+    BeginRecord(ESESaveJournalRecord::PlayerProgress);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    Writer << Level << Experience << Currency;
+}
+
+void FSESaveJournal::RecordTimelineState(ETimelineState State)
+{
+    BeginRecord(ESESaveJournalRecord::TimelineState);
+    PendingBatch.Add(static_cast<uint8>(State));
+}
+
+void FSESaveJournal::RecordQuestState(FName QuestID, EQuestState State)
+{
+    BeginRecord(ESESaveJournalRecord::QuestState);
+    WriteName(QuestID);
+    PendingBatch.Add(static_cast<uint8>(State));
+}
+
+void FSESaveJournal::RecordItemGained(FName ItemID)
+{
+    BeginRecord(ESESaveJournalRecord::ItemGained);
+    WriteName(ItemID);
+}
+
+void FSESaveJournal::RecordItemRemoved(FName ItemID)
+{
+    BeginRecord(ESESaveJournalRecord::ItemRemoved);
+    WriteName(ItemID);
+}
+
+void FSESaveJournal::RecordLocationDiscovered(FName LocationID)
+{
+    BeginRecord(ESESaveJournalRecord::LocationDiscovered);
+    WriteName(LocationID);
+}
+
+void FSESaveJournal::RecordMasteryDelta(ETimelineState Timeline, float Delta)
+{
+    BeginRecord(ESESaveJournalRecord::MasteryDelta);
+    PendingBatch.Add(static_cast<uint8>(Timeline));
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    Writer << Delta;
+}
+
+void FSESaveJournal::RecordAchievementProgress(FName AchievementID, float Progress)
+{
+    BeginRecord(ESESaveJournalRecord::AchievementProgress);
+    WriteName(AchievementID);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    Writer << Progress;
+}
+
+void FSESaveJournal::RecordBossRecord(FName BossID, float Time)
+{
+    BeginRecord(ESESaveJournalRecord::BossRecord);
+    WriteName(BossID);
+    FMemoryWriter Writer(PendingBatch);
+    Writer.Seek(PendingBatch.Num());
+    Writer << Time;
+}
+
+void FSESaveJournal::RecordProgressionFlag(ESEProgressionDomain Domain, FName ID)
+{
+    BeginRecord(ESESaveJournalRecord::ProgressionFlag);
+    PendingBatch.Add(static_cast<uint8>(Domain));
+    WriteName(ID);
+}
+
+void FSESaveJournal::Flush()
+{
+    check(IsInGameThread());
+
+    if (PendingBatch.Num() == 0)
+    {
+        return;
+    }
+
+    // Frame the batch so a partially written tail is detected on replay
+    TArray<uint8> Framed;
+    Framed.Reserve(SEJournalFile::BatchHeaderSize + PendingBatch.Num());
+    FMemoryWriter Writer(Framed);
+    uint32 PayloadSize = PendingBatch.Num();
+    uint32 PayloadCrc = FCrc::MemCrc32(PendingBatch.GetData(), PendingBatch.Num());
+    Writer << PayloadSize << PayloadCrc;
+    Writer.Serialize(PendingBatch.GetData(), PendingBatch.Num());
+
+    JournalBytes += Framed.Num();
+    PendingBatch.Reset();
+    NumPendingRecords = 0;
+
+    const FString Path = GetJournalPath(Generation);
+    LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Path, Framed = MoveTemp(Framed)]()
+    {
+        TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append));
+        if (!File)
+        {
+            SE_LOG_ERROR(TEXT("Failed to open save journal %s"), *Path);
+            return;
+        }
+        File->Serialize(const_cast<uint8*>(Framed.GetData()), Framed.Num());
+        File->Flush();
+    }, UE::Tasks::Prerequisites(LastTask));
+}
+
+void FSESaveJournal::FlushBlocking()
+{
+    Flush();
+    LastTask.Wait();
+}
+
+uint32 FSESaveJournal::Rotate()
+{
+    Flush();
+    ++Generation;
+    JournalBytes = 0;
+    return Generation;
+}
+
+void FSESaveJournal::DeleteGenerationsBelow(uint32 InGeneration)
+{
+    const FString Directory = FPaths::GetPath(FSESaveGamePipeline::GetSlotPath(SlotName));
+    const FString Prefix = FPaths::GetCleanFilename(FSESaveGamePipeline::GetSlotPath(SlotName)) + SEJournalFile::Extension;
+
+    // Ordered after pending appends so a file is never deleted mid-write
+    LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Directory, Prefix, InGeneration]()
+    {
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, Prefix + TEXT("*")), true, false);
+        for (const FString& File : Files)
+        {
+            uint32 FileGeneration = 0;
+            LexFromString(FileGeneration, *File.RightChop(Prefix.Len()));
+            if (FileGeneration < InGeneration)
+            {
+                IFileManager::Get().Delete(*FPaths::Combine(Directory, File), false, false, true);
+            }
+        }
+    }, UE::Tasks::Prerequisites(LastTask));
+}
+
+int32 FSESaveJournal::Replay(FSESaveSnapshot& Snapshot, uint32 SectionMask)
+{
+    LastTask.Wait();
+
+    DeferredBatches.Reset();
+    DeferredMask = SESaveSections::All & ~SectionMask;
+
+    const FString Directory = FPaths::GetPath(FSESaveGamePipeline::GetSlotPath(SlotName));
+    const FString Prefix = FPaths::GetCleanFilename(FSESaveGamePipeline::GetSlotPath(SlotName)) + SEJournalFile::Extension;
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, Prefix + TEXT("*")), true, false);
+
+    TArray<uint32> Generations;
+    for (const FString& File : Files)
+    {
+        uint32 FileGeneration = 0;
+        LexFromString(FileGeneration, *File.RightChop(Prefix.Len()));
+        if (FileGeneration >= Snapshot.JournalGeneration)
+        {
+            Generations.Add(FileGeneration);
+        }
+    }
+    Generations.Sort();
+
+    int32 NumApplied = 0;
+    for (uint32 FileGeneration : Generations)
+    {
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *GetJournalPath(FileGeneration), FILEREAD_Silent))
+        {
+            continue;
+        }
+
+        int32 Offset = 0;
+        while (Offset + SEJournalFile::BatchHeaderSize <= Bytes.Num())
+        {
+            uint32 PayloadSize = 0;
+            uint32 PayloadCrc = 0;
+            FMemoryReader Reader(Bytes);
+            Reader.Seek(Offset);
+            Reader << PayloadSize << PayloadCrc;
+
+            const int32 PayloadOffset = Offset + SEJournalFile::BatchHeaderSize;
+            if (PayloadOffset + static_cast<int64>(PayloadSize) > Bytes.Num() ||
+                FCrc::MemCrc32(Bytes.GetData() + PayloadOffset, PayloadSize) != PayloadCrc)
+            {
+                // Torn tail from a crash mid-append; everything before it is intact
+                SE_LOG_WARNING(TEXT("Save journal generation %u truncated at byte %d"), FileGeneration, Offset);
+                break;
+            }
+
+            NumApplied += ApplyBatch(Bytes.GetData() + PayloadOffset, PayloadSize, Snapshot, SectionMask);
+            if (DeferredMask != 0)
+            {
+                DeferredBatches.Emplace(Bytes.GetData() + PayloadOffset, PayloadSize);
+            }
+            Offset = PayloadOffset + PayloadSize;
+        }
+    }
+
+    // Continue in a fresh generation above anything on disk
+    Generation = Snapshot.JournalGeneration;
+    if (Generations.Num() > 0)
+    {
+        Generation = FMath::Max(Generation, Generations.Last() + 1);
+    }
+    JournalBytes = 0;
+
+    return NumApplied;
+}
+
+int32 FSESaveJournal::ApplyDeferred(uint32 SectionMask, FSESaveSnapshot& Snapshot)
+{
+    const uint32 Mask = SectionMask & DeferredMask;
+    if (Mask == 0)
+    {
+        return 0;
+    }
+
+    int32 NumApplied = 0;
+    for (const TArray<uint8>& Batch : DeferredBatches)
+    {
+        NumApplied += ApplyBatch(Batch.GetData(), Batch.Num(), Snapshot, Mask);
+    }
+
+    DeferredMask &= ~Mask;
+    if (DeferredMask == 0)
+    {
+        DeferredBatches.Empty();
+    }
+    return NumApplied;
+}
+
+int32 FSESaveJournal::ApplyBatch(const uint8* Data, int32 Size, FSESaveSnapshot& Snapshot, uint32 SectionMask)
+{
+    TArray<uint8> Batch(Data, Size);
+    FMemoryReader Reader(Batch);
+
+    auto ReadName = [&Reader]()
+    {
+        FString NameString;
+        Reader << NameString;
+        return FName(*NameString);
+    };
+
+    auto Accepts = [SectionMask](ESESaveSection Section)
+    {
+        return (SectionMask & SESaveSections::Bit(Section)) != 0;
+    };
+
+    // Records for filtered sections are still read to keep the stream in step
+    int32 NumApplied = 0;
+    while (!Reader.AtEnd() && !Reader.IsError())
+    {
+        uint8 Type = 0;
+        Reader << Type;
+
+        bool bApplied = false;
+        switch (static_cast<ESESaveJournalRecord>(Type))
+        {
+            case ESESaveJournalRecord::PlayerProgress:
+            {
+                int32 Level = 0;
+                int32 Experience = 0;
+                int32 Currency = 0;
+                Reader << Level << Experience << Currency;
+                bApplied = Accepts(ESESaveSection::Core);
+                if (bApplied)
+                {
+                    Snapshot.PlayerLevel = Level;
+                    Snapshot.PlayerExperience = Experience;
+                    Snapshot.PlayerCurrency = Currency;
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::TimelineState:
+            {
+                uint8 State = 0;
+                Reader << State;
+                bApplied = Accepts(ESESaveSection::Core);
+                if (bApplied)
+                {
+                    Snapshot.CurrentTimelineState = static_cast<ETimelineState>(State);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::QuestState:
+            {
+                const FName QuestID = ReadName();
+                uint8 State = 0;
+                Reader << State;
+                bApplied = Accepts(ESESaveSection::Quests);
+                if (bApplied)
+                {
+                    Snapshot.QuestStates.Add(QuestID, static_cast<EQuestState>(State));
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::ItemGained:
+            {
+                const FName ItemID = ReadName();
+                bApplied = Accepts(ESESaveSection::Inventory);
+                if (bApplied)
+                {
+                    Snapshot.InventoryItems.Add(ItemID);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::ItemRemoved:
+            {
+                const FName ItemID = ReadName();
+                bApplied = Accepts(ESESaveSection::Inventory);
+                if (bApplied)
+                {
+                    Snapshot.InventoryItems.RemoveSingle(ItemID);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::LocationDiscovered:
+            {
+                const FName LocationID = ReadName();
+                bApplied = Accepts(ESESaveSection::World);
+                if (bApplied)
+                {
+                    Snapshot.Progression.SetID(ESEProgressionDomain::Location, LocationID);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::MasteryDelta:
+            {
+                uint8 Timeline = 0;
+                float Delta = 0.0f;
+                Reader << Timeline << Delta;
+                bApplied = Accepts(ESESaveSection::Core);
+                if (bApplied)
+                {
+                    float& Mastery = static_cast<ETimelineState>(Timeline) == ETimelineState::DarkWorld
+                        ? Snapshot.DarkTimelineMastery
+                        : Snapshot.BrightTimelineMastery;
+                    Mastery = FMath::Clamp(Mastery + Delta, 0.0f, 1.0f);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::AchievementProgress:
+            {
+                const FName AchievementID = ReadName();
+                float Progress = 0.0f;
+                Reader << Progress;
+                bApplied = Accepts(ESESaveSection::Achievements);
+                if (bApplied)
+                {
+                    Snapshot.AchievementProgress.Add(AchievementID, Progress);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::BossRecord:
+            {
+                const FName BossID = ReadName();
+                float Time = 0.0f;
+                Reader << Time;
+                bApplied = Accepts(ESESaveSection::World);
+                if (bApplied)
+                {
+                    Snapshot.BossFightRecords.Add(BossID, Time);
+                }
+                break;
+            }
+
+            case ESESaveJournalRecord::ProgressionFlag:
+            {
+                uint8 Domain = 0;
+                Reader << Domain;
+                const FName ID = ReadName();
+                if (Domain >= static_cast<uint8>(ESEProgressionDomain::Num))
+                {
+                    break;
+                }
+                const ESEProgressionDomain ProgressionDomain = static_cast<ESEProgressionDomain>(Domain);
+                bApplied = Accepts(ProgressionDomain == ESEProgressionDomain::Achievement ? ESESaveSection::Achievements : ESESaveSection::World);
+                if (bApplied)
+                {
+                    Snapshot.Progression.SetID(ProgressionDomain, ID);
+                }
+                break;
+            }
+
+            default:
+                SE_LOG_WARNING(TEXT("Unknown save journal record type %d"), Type);
+                return NumApplied;
+        }
+
+        if (bApplied)
+        {
+            ++NumApplied;
+        }
+    }
+
+    return NumApplied;
+}
@@ -0,0 +1,107 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "SaveGame/SESaveTypes.h"
+#include "SaveGame/SESaveFormat.h"
+
+/** Record types stored in the save journal */
+enum class ESESaveJournalRecord : uint8
+{
+    PlayerProgress      = 1,
+    TimelineState       = 2,
+    QuestState          = 3,
+    ItemGained          = 4,
+    ItemRemoved         = 5,
+    LocationDiscovered  = 6,
+    MasteryDelta        = 7,
+    AchievementProgress = 8,
+    BossRecord          = 9,
+    ProgressionFlag     = 10
+};
+
+/**
+ * Append-only change journal for incremental saves
+ *
+ * Gameplay changes are recorded as compact binary records into an in-memory batch on the
+ * game thread. Flush() appends the batch to the slot's journal file on a serial background
+ * task, framed with size and CRC so a torn tail is ignored on replay. Journals are numbered
+ * by generation: compaction rotates to a new generation and writes a base snapshot that
+ * stores it. Once that base is verified on disk, the generations below the previous base
+ * are deleted; the previous base is now the backup and still needs its own. Load replays
+ * base plus every journal generation at or above the base's. When the base is loaded section
+ * by section, records for sections not loaded yet are kept and applied once their section
+ * arrives.
+ */
+class SHADOWECHOES_API FSESaveJournal
+{
+public:
+    explicit FSESaveJournal(const FString& InSlotName);
+    ~FSESaveJournal();
+
+    /** Recording, game thread only */
+    void RecordPlayerProgress(int32 Level, int32 Experience, int32 Currency);
+    void RecordTimelineState(ETimelineState State);
+    void RecordQuestState(FName QuestID, EQuestState State);
+    void RecordItemGained(FName ItemID);
+    void RecordItemRemoved(FName ItemID);
+    void RecordLocationDiscovered(FName LocationID);
+    void RecordMasteryDelta(ETimelineState Timeline, float Delta);
+    void RecordAchievementProgress(FName AchievementID, float Progress);
+    void RecordBossRecord(FName BossID, float Time);
+    void RecordProgressionFlag(ESEProgressionDomain Domain, FName ID);
+
+    /** Append pending records to disk in the background */
+    void Flush();
+
+    /** Append pending records and wait for all journal I/O */
+    void FlushBlocking();
+
+    /** Start a new journal generation; returns it for the next base snapshot */
+    uint32 Rotate();
+
+    /** Delete journals older than Generation; pass the backup's base, whose journals must survive */
+    void DeleteGenerationsBelow(uint32 Generation);
+
+    /**
+     * Apply all journals at or above the snapshot's generation to the sections in SectionMask;
+     * returns the number of records applied. Records for other sections are deferred.
+     */
+    int32 Replay(FSESaveSnapshot& Snapshot, uint32 SectionMask = SESaveSections::All);
+
+    /** Apply deferred records for sections that have just been loaded into Snapshot */
+    int32 ApplyDeferred(uint32 SectionMask, FSESaveSnapshot& Snapshot);
+
+    /** Records waiting for Flush */
+    int32 GetNumPendingRecords() const { return NumPendingRecords; }
+
+    /** Bytes appended to the current generation so far */
+    int64 GetJournalBytes() const { return JournalBytes; }
+
+    uint32 GetGeneration() const { return Generation; }
+
+    /** Apply the records of a single decoded batch that belong to SectionMask */
+    static int32 ApplyBatch(const uint8* Data, int32 Size, FSESaveSnapshot& Snapshot, uint32 SectionMask = SESaveSections::All);
+
+private:
+    FString GetJournalPath(uint32 InGeneration) const;
+    void BeginRecord(ESESaveJournalRecord Type);
+    void WriteName(FName Name);
+
+    FString SlotName;
+    uint32 Generation;
+
+    /** Pending batch */
+    TArray<uint8> PendingBatch;
+    int32 NumPendingRecords;
+    int64 JournalBytes;
+
+    /** Replayed batches still owed to sections that were not loaded at replay */
+    TArray<TArray<uint8>> DeferredBatches;
+    uint32 DeferredMask;
+
+    /** Last background task; every journal task depends on the previous one */
+    UE::Tasks::FTask LastTask;
+};
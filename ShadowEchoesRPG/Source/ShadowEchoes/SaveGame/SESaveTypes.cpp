@@ -0,0 +1,150 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "SaveGame/SESaveTypes.h"
+
+bool FSESaveSnapshot::Validate() const
+{
+    // Player data
+    if (PlayerLevel < 1 || PlayerExperience < 0 || PlayerCurrency < 0)
+    {
+        return false;
+    }
+
+    if (MaxHealth <= 0.0f || MaxTimelineEnergy <= 0.0f || BaseDamage <= 0.0f)
+    {
+        return false;
+    }
+
+    if (BrightTimelineMastery < 0.0f || BrightTimelineMastery > 1.0f ||
+        DarkTimelineMastery < 0.0f || DarkTimelineMastery > 1.0f)
+    {
+        return false;
+    }
+
+    // Quest data
+    for (const auto& Pair : QuestStates)
+    {
+        if (Pair.Key.IsNone())
+        {
+            return false;
+        }
+    }
+
+    // Ability data
+    for (const FName& AbilityID : UnlockedAbilities)
+    {
+        if (AbilityID.IsNone())
+        {
+            return false;
+        }
+    }
+
+    // Inventory data
+    for (const FName& ItemID : InventoryItems)
+    {
+        if (ItemID.IsNone())
+        {
+            return false;
+        }
+    }
+
+    for (const auto& Pair : EquippedItems)
+    {
+        if (Pair.Key.IsNone() || Pair.Value.IsNone())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FSESaveSnapshot::Repair()
+{
+    // Fix player data
+    PlayerLevel = FMath::Max(1, PlayerLevel);
+    PlayerExperience = FMath::Max(0, PlayerExperience);
+    PlayerCurrency = FMath::Max(0, PlayerCurrency);
+
+    // Fix combat stats
+    MaxHealth = FMath::Max(100.0f, MaxHealth);
+    MaxTimelineEnergy = FMath::Max(100.0f, MaxTimelineEnergy);
+    BaseDamage = FMath::Max(10.0f, BaseDamage);
+
+    // Fix timeline mastery
+    BrightTimelineMastery = FMath::Clamp(BrightTimelineMastery, 0.0f, 1.0f);
+    DarkTimelineMastery = FMath::Clamp(DarkTimelineMastery, 0.0f, 1.0f);
+
+    // Drop invalid entries
+    QuestStates.Remove(NAME_None);
+    UnlockedAbilities.Remove(NAME_None);
+    InventoryItems.Remove(NAME_None);
+    for (auto It = EquippedItems.CreateIterator(); It; ++It)
+    {
+        if (It->Key.IsNone() || It->Value.IsNone())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Fix achievement progress
+    for (auto& Pair : AchievementProgress)
+    {
+        Pair.Value = FMath::Max(0.0f, Pair.Value);
+    }
+
+    // Fix game settings
+    for (auto& Pair : GameSettings)
+    {
+        Pair.Value = FMath::Clamp(Pair.Value, 0.0f, 1.0f);
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FSESaveSnapshot& Snapshot)
+{
+    // Save metadata
+    Ar << Snapshot.LastSaveTime;
+    Ar << Snapshot.SaveSlotName;
+
+    // Player data
+    Ar << Snapshot.PlayerLevel;
+    Ar << Snapshot.PlayerExperience;
+    Ar << Snapshot.PlayerCurrency;
+    Ar << Snapshot.CurrentTimelineState;
+
+    // Quest, ability and inventory data
+    Ar << Snapshot.QuestStates;
+    Ar << Snapshot.UnlockedAbilities;
+    Ar << Snapshot.InventoryItems;
+    Ar << Snapshot.EquippedItems;
+
+    // Combat stats
+    Ar << Snapshot.MaxHealth;
+    Ar << Snapshot.MaxTimelineEnergy;
+    Ar << Snapshot.BaseDamage;
+
+    // Timeline mastery
+    Ar << Snapshot.BrightTimelineMastery;
+    Ar << Snapshot.DarkTimelineMastery;
+
+    // Achievement and world data
+    Ar << Snapshot.AchievementProgress;
+
+    // Older formats stored discovered locations by name
+    TArray<FName> DiscoveredLocations;
+    if (Ar.IsSaving())
+    {
+        Snapshot.Progression.GetSetIDs(ESEProgressionDomain::Location, DiscoveredLocations);
+    }
+    Ar << DiscoveredLocations;
+    if (Ar.IsLoading())
+    {
+        Snapshot.Progression.SetIDs(ESEProgressionDomain::Location, DiscoveredLocations);
+    }
+    Ar << Snapshot.BossFightRecords;
+
+    // Settings
+    Ar << Snapshot.GameSettings;
+
+    return Ar;
+}
@@ -0,0 +1,98 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SETypes.h"
+#include "Core/SEProgression.h"
+#include "Core/SELockoutStore.h"
+#include "SESaveTypes.generated.h"
+
+/**
+ * Plain copy of everything that goes into a save slot
+ * Captured on the game thread, then serialized and written on a worker
+ */
+struct SHADOWECHOES_API FSESaveSnapshot
+{
+    /** Player data */
+    int32 PlayerLevel = 1;
+    int32 PlayerExperience = 0;
+    int32 PlayerCurrency = 0;
+    ETimelineState CurrentTimelineState = ETimelineState::BrightWorld;
+
+    /** Progression */
+    TMap<FName, EQuestState> QuestStates;
+    TArray<FName> UnlockedAbilities;
+    TArray<FName> InventoryItems;
+    TMap<FName, FName> EquippedItems;
+
+    /** Combat stats */
+    float MaxHealth = 100.0f;
+    float MaxTimelineEnergy = 100.0f;
+    float BaseDamage = 10.0f;
+
+    /** Timeline mastery */
+    float BrightTimelineMastery = 0.0f;
+    float DarkTimelineMastery = 0.0f;
+
+    /** Achievements and world */
+    TMap<FName, float> AchievementProgress;
+    TMap<FName, float> BossFightRecords;
+
+    /** Unlocked areas, discovered secrets and locations, unlocked achievements */
+    FSEProgressionState Progression;
+
+    /** Raid, invasion and dungeon lockouts still running when the save was taken */
+    TArray<FSELockoutRecord> Lockouts;
+
+    /** Settings */
+    TMap<FName, float> GameSettings;
+
+    /** Metadata */
+    FDateTime LastSaveTime;
+    FString SaveSlotName;
+
+    /** First journal generation not folded into this snapshot */
+    uint32 JournalGeneration = 0;
+
+    /** Data validation, safe to run off the game thread */
+    bool Validate() const;
+    void Repair();
+
+    friend FArchive& operator<<(FArchive& Ar, FSESaveSnapshot& Snapshot);
+};
+
+/**
+ * Timing breakdown of one save request
+ */
+USTRUCT(BlueprintType)
+struct SHADOWECHOES_API FSESaveStats
+{
+    GENERATED_BODY()
+
+    /** Game thread time spent capturing the snapshot */
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    float SnapshotMs = 0.0f;
+
+    /** Worker time spent serializing */
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    float SerializeMs = 0.0f;
+
+    /** Worker time spent compressing */
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    float CompressMs = 0.0f;
+
+    /** Worker time spent writing and renaming */
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    float WriteMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    int32 UncompressedBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    int32 WrittenBytes = 0;
+
+    /** Journal generation stored in the written base snapshot */
+    UPROPERTY(BlueprintReadOnly, Category = "Save")
+    int32 JournalGeneration = 0;
+};
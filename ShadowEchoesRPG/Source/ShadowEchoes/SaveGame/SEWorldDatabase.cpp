@@ -0,0 +1,444 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "SaveGame/SEWorldDatabase.h"
+#include "ShadowEchoes.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace SEWorldDatabaseWriter
+{
+    /** Seconds between attempts to rewrite a rolled-back batch when nothing new is queued */
+    static constexpr double RetryWindowSeconds = 1.0;
+}
+
+FSEWorldDatabase::FSEWorldDatabase(const FString& InPath, int32 InCachedRowsPerTable, float InBatchWindowMs)
+    : Path(InPath)
+    , BatchWindowSeconds(InBatchWindowMs * 0.001f)
+    , bOpen(false)
+    , DiskSchemaVersion(0)
+    , WriterState(MakeShared<FWriterState, ESPMode::ThreadSafe>())
+    , NextBatch(1)
+    , PrunedBatch(0)
+    , LastFlushTime(0.0)
+    , CacheHits(0)
+    , CacheMisses(0)
+{
+    Tables.Reserve(static_cast<int32>(ESEWorldTable::Num));
+    for (int32 Index = 0; Index < static_cast<int32>(ESEWorldTable::Num); ++Index)
+    {
+        Tables.Emplace(FMath::Max(InCachedRowsPerTable, 1));
+    }
+}
+
+FSEWorldDatabase::~FSEWorldDatabase()
+{
+    Close();
+}
+
+const TCHAR* FSEWorldDatabase::GetTableName(ESEWorldTable Table)
+{
+    switch (Table)
+    {
+    case ESEWorldTable::Guilds:         return TEXT("guilds");
+    case ESEWorldTable::GuildHalls:     return TEXT("guild_halls");
+    case ESEWorldTable::GuildMembers:   return TEXT("guild_members");
+    case ESEWorldTable::PvPRatings:     return TEXT("pvp_ratings");
+    case ESEWorldTable::WarScores:      return TEXT("war_scores");
+    default:                            checkNoEntry(); return TEXT("");
+    }
+}
+
+bool FSEWorldDatabase::MigrateTo(FSQLiteDatabase& Database, int32 Version)
+{
+    // Every table is a key/row store; the primary key is the clustered index
+    auto CreateTable = [&Database](const TCHAR* Name)
+    {
+        return Database.Execute(*FString::Printf(TEXT("CREATE TABLE IF NOT EXISTS %s (k TEXT PRIMARY KEY NOT NULL, v BLOB NOT NULL) WITHOUT ROWID;"), Name));
+    };
+
+    // Past versions are frozen; later schemas are new cases, never edits to these
+    switch (Version)
+    {
+    case 1:
+        return CreateTable(TEXT("guilds"))
+            && CreateTable(TEXT("guild_halls"))
+            && CreateTable(TEXT("guild_members"))
+            && CreateTable(TEXT("pvp_ranks"))
+            && CreateTable(TEXT("war_scores"));
+
+    case 2:
+        // Flat integer ranks give way to Glicko-2 ratings; the old points do not convert
+        return Database.Execute(TEXT("DROP TABLE IF EXISTS pvp_ranks;"))
+            && CreateTable(TEXT("pvp_ratings"));
+
+    case 3:
+        // Rating rows gain a leading format version: bare ratings are 0, ratings with a period 1
+        return Database.Execute(TEXT("UPDATE pvp_ratings SET v = CAST(X'00' || v AS BLOB) WHERE length(v) = 24;"))
+            && Database.Execute(TEXT("UPDATE pvp_ratings SET v = CAST(X'01' || v AS BLOB) WHERE length(v) = 28;"));
+
+    default:
+        return false;
+    }
+}
+
+bool FSEWorldDatabase::Open()
+{
+    check(IsInGameThread());
+
+    if (bOpen)
+    {
+        return true;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+
+    // Step 1: Writer connection, in WAL mode so the reader never blocks on it
+    FSQLiteDatabase& Writer = WriterState->Database;
+    if (!Writer.Open(*Path, ESQLiteDatabaseOpenMode::ReadWriteCreate))
+    {
+        SE_LOG_ERROR(TEXT("Failed to open world database %s: %s"), *Path, *Writer.GetLastError());
+        return false;
+    }
+
+    Writer.Execute(TEXT("PRAGMA journal_mode=WAL;"));
+    Writer.Execute(TEXT("PRAGMA synchronous=NORMAL;"));
+
+    // Step 2: Schema version; never touch a database written by a newer build
+    if (!Writer.GetUserVersion(DiskSchemaVersion))
+    {
+        DiskSchemaVersion = 0;
+    }
+
+    if (DiskSchemaVersion > SchemaVersion)
+    {
+        SE_LOG_ERROR(TEXT("World database %s has schema %d, newer than supported %d"), *Path, DiskSchemaVersion, SchemaVersion);
+        Writer.Close();
+        return false;
+    }
+
+    for (int32 Version = DiskSchemaVersion + 1; Version <= SchemaVersion; ++Version)
+    {
+        Writer.Execute(TEXT("BEGIN;"));
+        if (!MigrateTo(Writer, Version) || !Writer.SetUserVersion(Version))
+        {
+            SE_LOG_ERROR(TEXT("World database %s failed migrating to schema %d: %s"), *Path, Version, *Writer.GetLastError());
+            Writer.Execute(TEXT("ROLLBACK;"));
+            Writer.Close();
+            return false;
+        }
+        Writer.Execute(TEXT("COMMIT;"));
+        DiskSchemaVersion = Version;
+    }
+
+    // Step 3: Statements are prepared once and reused for the life of the connection
+    for (int32 Index = 0; Index < static_cast<int32>(ESEWorldTable::Num); ++Index)
+    {
+        const TCHAR* TableName = GetTableName(static_cast<ESEWorldTable>(Index));
+        WriterState->Upserts[Index] = Writer.PrepareStatement(*FString::Printf(TEXT("INSERT OR REPLACE INTO %s (k, v) VALUES (?1, ?2);"), TableName), ESQLitePreparedStatementFlags::Persistent);
+        WriterState->Deletes[Index] = Writer.PrepareStatement(*FString::Printf(TEXT("DELETE FROM %s WHERE k = ?1;"), TableName), ESQLitePreparedStatementFlags::Persistent);
+    }
+
+    // Step 4: Read connection for the game thread
+    if (!Reader.Open(*Path, ESQLiteDatabaseOpenMode::ReadOnly))
+    {
+        SE_LOG_ERROR(TEXT("Failed to open world database reader %s: %s"), *Path, *Reader.GetLastError());
+        for (int32 Index = 0; Index < static_cast<int32>(ESEWorldTable::Num); ++Index)
+        {
+            WriterState->Upserts[Index].Destroy();
+            WriterState->Deletes[Index].Destroy();
+        }
+        Writer.Close();
+        return false;
+    }
+
+    for (int32 Index = 0; Index < static_cast<int32>(ESEWorldTable::Num); ++Index)
+    {
+        const TCHAR* TableName = GetTableName(static_cast<ESEWorldTable>(Index));
+        Selects[Index] = Reader.PrepareStatement(*FString::Printf(TEXT("SELECT v FROM %s WHERE k = ?1;"), TableName), ESQLitePreparedStatementFlags::Persistent);
+        Scans[Index] = Reader.PrepareStatement(*FString::Printf(TEXT("SELECT k, v FROM %s ORDER BY k;"), TableName), ESQLitePreparedStatementFlags::Persistent);
+    }
+
+    bOpen = true;
+    SE_LOG(Log, TEXT("World database %s open at schema %d"), *Path, DiskSchemaVersion);
+    return true;
+}
+
+void FSEWorldDatabase::Close()
+{
+    if (!bOpen)
+    {
+        return;
+    }
+
+    FlushBlocking();
+    if (HasFailedWrites())
+    {
+        SE_LOG_ERROR(TEXT("World database %s closed with %d writes that could not be committed"), *Path, WriterState->RetryOps.Num());
+        WriterState->RetryOps.Reset();
+        WriterState->bRetryPending.store(false, std::memory_order_release);
+    }
+
+    for (int32 Index = 0; Index < static_cast<int32>(ESEWorldTable::Num); ++Index)
+    {
+        Selects[Index].Destroy();
+        Scans[Index].Destroy();
+        WriterState->Upserts[Index].Destroy();
+        WriterState->Deletes[Index].Destroy();
+    }
+
+    Reader.Close();
+    WriterState->Database.Close();
+
+    for (FTableCache& Cache : Tables)
+    {
+        Cache.Pending.Reset();
+        Cache.Hot.Empty(Cache.Hot.Max());
+    }
+
+    bOpen = false;
+}
+
+void FSEWorldDatabase::DeleteFiles(const FString& Path)
+{
+    IFileManager::Get().Delete(*Path, false, true, true);
+    IFileManager::Get().Delete(*(Path + TEXT("-wal")), false, true, true);
+    IFileManager::Get().Delete(*(Path + TEXT("-shm")), false, true, true);
+}
+
+void FSEWorldDatabase::Put(ESEWorldTable Table, const FString& Key, TArray<uint8>&& Value)
+{
+    check(IsInGameThread() && bOpen);
+
+    FTableCache& Cache = Tables[static_cast<int32>(Table)];
+    FPendingRow& Row = Cache.Pending.FindOrAdd(Key);
+    Row.Value = Value;
+    Row.bDeleted = false;
+    Row.Batch = NextBatch;
+    Cache.Hot.Remove(Key);
+
+    QueuedWrites.Add({ Table, false, Key, MoveTemp(Value) });
+}
+
+void FSEWorldDatabase::Delete(ESEWorldTable Table, const FString& Key)
+{
+    check(IsInGameThread() && bOpen);
+
+    FTableCache& Cache = Tables[static_cast<int32>(Table)];
+    FPendingRow& Row = Cache.Pending.FindOrAdd(Key);
+    Row.Value.Reset();
+    Row.bDeleted = true;
+    Row.Batch = NextBatch;
+    Cache.Hot.Remove(Key);
+
+    QueuedWrites.Add({ Table, true, Key, TArray<uint8>() });
+}
+
+bool FSEWorldDatabase::Get(ESEWorldTable Table, const FString& Key, TArray<uint8>& OutValue)
+{
+    check(IsInGameThread());
+
+    if (!bOpen)
+    {
+        return false;
+    }
+
+    // Uncommitted writes win over anything on disk
+    FTableCache& Cache = Tables[static_cast<int32>(Table)];
+    if (const FPendingRow* Row = Cache.Pending.Find(Key))
+    {
+        if (Row->bDeleted)
+        {
+            return false;
+        }
+        OutValue = Row->Value;
+        return true;
+    }
+
+    if (const TArray<uint8>* Hot = Cache.Hot.FindAndTouch(Key))
+    {
+        ++CacheHits;
+        OutValue = *Hot;
+        return true;
+    }
+
+    // Read through and keep the row for next time
+    ++CacheMisses;
+    FSQLitePreparedStatement& Select = Selects[static_cast<int32>(Table)];
+    Select.Reset();
+    Select.ClearBindings();
+    Select.SetBindingValueByIndex(1, Key);
+
+    bool bFound = false;
+    if (Select.Step() == ESQLitePreparedStatementStepResult::Row)
+    {
+        bFound = Select.GetColumnValueByIndex(0, OutValue);
+    }
+    Select.Reset();
+
+    if (bFound)
+    {
+        Cache.Hot.Add(Key, OutValue);
+    }
+    return bFound;
+}
+
+int32 FSEWorldDatabase::LoadAll(ESEWorldTable Table, TFunctionRef<void(const FString& Key, const TArray<uint8>& Value)> Visit)
+{
+    check(IsInGameThread());
+
+    if (!bOpen)
+    {
+        return 0;
+    }
+
+    // The scan reads committed rows only, so commit everything first
+    FlushBlocking();
+
+    FSQLitePreparedStatement& Scan = Scans[static_cast<int32>(Table)];
+    Scan.Reset();
+
+    int32 NumRows = 0;
+    FString Key;
+    TArray<uint8> Value;
+    ESQLitePreparedStatementStepResult Result;
+    while ((Result = Scan.Step()) == ESQLitePreparedStatementStepResult::Row)
+    {
+        Scan.GetColumnValueByIndex(0, Key);
+        Scan.GetColumnValueByIndex(1, Value);
+        Visit(Key, Value);
+        ++NumRows;
+    }
+
+    if (Result != ESQLitePreparedStatementStepResult::Done)
+    {
+        SE_LOG_ERROR(TEXT("World database scan of %s stopped after %d rows: %s"), GetTableName(Table), NumRows, *Reader.GetLastError());
+    }
+
+    Scan.Reset();
+    return NumRows;
+}
+
+void FSEWorldDatabase::PruneCommitted()
+{
+    // Committed rows leave the overlay; live ones become hot since they were just touched
+    const uint64 Committed = WriterState->CommittedBatch.load(std::memory_order_acquire);
+    if (Committed == PrunedBatch)
+    {
+        return;
+    }
+    PrunedBatch = Committed;
+
+    for (FTableCache& Cache : Tables)
+    {
+        for (auto It = Cache.Pending.CreateIterator(); It; ++It)
+        {
+            if (It.Value().Batch > Committed)
+            {
+                continue;
+            }
+
+            if (!It.Value().bDeleted)
+            {
+                Cache.Hot.Add(It.Key(), MoveTemp(It.Value().Value));
+            }
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool FSEWorldDatabase::FlushIfDue()
+{
+    const bool bRetryOnly = QueuedWrites.Num() == 0;
+    if (bRetryOnly && !HasFailedWrites())
+    {
+        PruneCommitted();
+        return false;
+    }
+
+    // Writes keep batching while a transaction is in flight; a lone retry waits longer
+    const double Window = bRetryOnly ? SEWorldDatabaseWriter::RetryWindowSeconds : BatchWindowSeconds;
+    if (FPlatformTime::Seconds() - LastFlushTime < Window || !LastTask.IsCompleted())
+    {
+        return false;
+    }
+
+    Flush();
+    return true;
+}
+
+void FSEWorldDatabase::Flush()
+{
+    check(IsInGameThread());
+
+    PruneCommitted();
+
+    if (!bOpen || (QueuedWrites.Num() == 0 && !HasFailedWrites()))
+    {
+        return;
+    }
+
+    const uint64 Batch = NextBatch++;
+    LastFlushTime = FPlatformTime::Seconds();
+
+    LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [State = WriterState, Batch, Path = Path, NewOps = MoveTemp(QueuedWrites)]() mutable
+    {
+        // A rolled-back batch goes first, so newer writes to the same rows still win; until this
+        // commits CommittedBatch stays put and the overlay keeps every row of both
+        TArray<FWriteOp> Ops = MoveTemp(State->RetryOps);
+        Ops.Append(MoveTemp(NewOps));
+
+        auto Retry = [&State, &Ops]()
+        {
+            State->RetryOps = MoveTemp(Ops);
+            State->bRetryPending.store(true, std::memory_order_release);
+        };
+
+        FSQLiteDatabase& Database = State->Database;
+        if (!Database.Execute(TEXT("BEGIN;")))
+        {
+            SE_LOG_ERROR(TEXT("World database %s failed to begin batch: %s"), *Path, *Database.GetLastError());
+            Retry();
+            return;
+        }
+
+        // One transaction per batch; the statements are already compiled
+        for (const FWriteOp& Op : Ops)
+        {
+            FSQLitePreparedStatement& Statement = Op.bDelete ? State->Deletes[static_cast<int32>(Op.Table)] : State->Upserts[static_cast<int32>(Op.Table)];
+            Statement.Reset();
+            Statement.ClearBindings();
+            Statement.SetBindingValueByIndex(1, Op.Key);
+            if (!Op.bDelete)
+            {
+                Statement.SetBindingValueByIndex(2, TArrayView<const uint8>(Op.Value), false);
+            }
+
+            if (!Statement.Execute())
+            {
+                SE_LOG_ERROR(TEXT("World database %s failed writing %s/%s: %s"), *Path, GetTableName(Op.Table), *Op.Key, *Database.GetLastError());
+                Database.Execute(TEXT("ROLLBACK;"));
+                Retry();
+                return;
+            }
+        }
+
+        if (!Database.Execute(TEXT("COMMIT;")))
+        {
+            SE_LOG_ERROR(TEXT("World database %s failed to commit batch: %s"), *Path, *Database.GetLastError());
+            Database.Execute(TEXT("ROLLBACK;"));
+            Retry();
+            return;
+        }
+
+        State->bRetryPending.store(false, std::memory_order_release);
+        State->CommittedBatch.store(Batch, std::memory_order_release);
+    }, UE::Tasks::Prerequisites(LastTask));
+    QueuedWrites.Reset();
+}
+
+void FSEWorldDatabase::FlushBlocking()
+{
+    Flush();
+    LastTask.Wait();
+    PruneCommitted();
+}
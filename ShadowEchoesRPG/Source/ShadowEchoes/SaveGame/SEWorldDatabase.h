@@ -0,0 +1,177 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "SQLiteDatabase.h"
+#include "SQLitePreparedStatement.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+/** Tables of the world database; each maps a string key to an archived row */
+enum class ESEWorldTable : uint8
+{
+    Guilds,
+    GuildHalls,
+    GuildMembers,
+    PvPRatings,
+    WarScores,
+
+    Num
+};
+
+/**
+ * Embedded SQLite store for shared world state: guilds, halls, membership, PvP ratings and
+ * Timeline War scores
+ *
+ * Writes update an in-memory overlay at once and are queued; Flush hands the queue to a
+ * serial background task that applies it in one transaction through prepared statements on
+ * its own connection. A batch that fails is rolled back and retried ahead of the next one, and
+ * its rows stay in the overlay until a commit includes them. Reads check the overlay, then an LRU cache of hot rows per table, then
+ * read through to the database on a second connection, which WAL mode lets run alongside the
+ * writer. The schema version lives in the database's user_version and is migrated forward
+ * on open; a database from a newer build is refused rather than modified.
+ */
+class SHADOWECHOES_API FSEWorldDatabase
+{
+public:
+    static constexpr int32 SchemaVersion = 3;
+
+    explicit FSEWorldDatabase(const FString& InPath, int32 InCachedRowsPerTable = 4096, float InBatchWindowMs = 50.0f);
+    ~FSEWorldDatabase();
+
+    /** Open both connections and migrate the schema; false if the file is unusable */
+    bool Open();
+
+    /** Flush, wait for the writer and close */
+    void Close();
+
+    bool IsOpen() const { return bOpen; }
+
+    /** Writing, game thread only; visible to Get immediately */
+    void Put(ESEWorldTable Table, const FString& Key, TArray<uint8>&& Value);
+    void Delete(ESEWorldTable Table, const FString& Key);
+
+    /** Row by key, from the overlay, the cache or the database */
+    bool Get(ESEWorldTable Table, const FString& Key, TArray<uint8>& OutValue);
+
+    /** Visit every committed row of a table in key order; for cold start, bypasses the cache */
+    int32 LoadAll(ESEWorldTable Table, TFunctionRef<void(const FString& Key, const TArray<uint8>& Value)> Visit);
+
+    /** Archive a row with its operator<< */
+    template<typename RowType>
+    void PutRow(ESEWorldTable Table, const FString& Key, const RowType& Row)
+    {
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        Writer << const_cast<RowType&>(Row);
+        Put(Table, Key, MoveTemp(Bytes));
+    }
+
+    template<typename RowType>
+    bool GetRow(ESEWorldTable Table, const FString& Key, RowType& OutRow)
+    {
+        TArray<uint8> Bytes;
+        if (!Get(Table, Key, Bytes))
+        {
+            return false;
+        }
+
+        FMemoryReader Reader(Bytes);
+        Reader << OutRow;
+        return !Reader.IsError();
+    }
+
+    /** Hand queued writes to the writer if the batch window has passed and it is idle */
+    bool FlushIfDue();
+
+    /** Hand queued writes to the writer now */
+    void Flush();
+
+    /** Flush and wait until every write is committed */
+    void FlushBlocking();
+
+    int32 GetNumQueuedWrites() const { return QueuedWrites.Num(); }
+
+    /** True while a rolled-back batch waits to be written again */
+    bool HasFailedWrites() const { return WriterState->bRetryPending.load(std::memory_order_acquire); }
+    int32 GetSchemaVersionOnDisk() const { return DiskSchemaVersion; }
+    int64 GetCacheHits() const { return CacheHits; }
+    int64 GetCacheMisses() const { return CacheMisses; }
+
+    /** Delete the database file and its WAL; the database must be closed */
+    static void DeleteFiles(const FString& Path);
+
+    static const TCHAR* GetTableName(ESEWorldTable Table);
+
+private:
+    struct FWriteOp
+    {
+        ESEWorldTable Table;
+        bool bDelete;
+        FString Key;
+        TArray<uint8> Value;
+    };
+
+    /** Written but not yet committed; bDeleted hides the row on disk */
+    struct FPendingRow
+    {
+        TArray<uint8> Value;
+        bool bDeleted = false;
+        uint64 Batch = 0;
+    };
+
+    /** Owned by the serial writer tasks once open */
+    struct FWriterState
+    {
+        FSQLiteDatabase Database;
+        FSQLitePreparedStatement Upserts[static_cast<int32>(ESEWorldTable::Num)];
+        FSQLitePreparedStatement Deletes[static_cast<int32>(ESEWorldTable::Num)];
+        std::atomic<uint64> CommittedBatch{ 0 };
+
+        /** Writes of rolled-back batches, retried first by the next writer task */
+        TArray<FWriteOp> RetryOps;
+        std::atomic<bool> bRetryPending{ false };
+    };
+
+    struct FTableCache
+    {
+        TMap<FString, FPendingRow> Pending;
+        TLruCache<FString, TArray<uint8>> Hot;
+
+        explicit FTableCache(int32 Capacity)
+            : Hot(Capacity)
+        {
+        }
+    };
+
+    static bool MigrateTo(FSQLiteDatabase& Database, int32 Version);
+    void PruneCommitted();
+
+    FString Path;
+    float BatchWindowSeconds;
+    bool bOpen;
+    int32 DiskSchemaVersion;
+
+    TSharedRef<FWriterState, ESPMode::ThreadSafe> WriterState;
+
+    /** Game-thread read connection */
+    FSQLiteDatabase Reader;
+    FSQLitePreparedStatement Selects[static_cast<int32>(ESEWorldTable::Num)];
+    FSQLitePreparedStatement Scans[static_cast<int32>(ESEWorldTable::Num)];
+
+    TArray<FTableCache> Tables;
+    TArray<FWriteOp> QueuedWrites;
+    uint64 NextBatch;
+    uint64 PrunedBatch;
+    double LastFlushTime;
+
+    int64 CacheHits;
+    int64 CacheMisses;
+
+    /** Last writer task; every write task depends on the previous one */
+    UE::Tasks::FTask LastTask;
+};
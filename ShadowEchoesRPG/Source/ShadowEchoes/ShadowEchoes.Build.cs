@@ -21,6 +21,7 @@ public class ShadowEchoes : ModuleRules
         });
 
         PrivateDependencyModuleNames.AddRange(new string[] {
+            "SQLiteCore"
         });
 
         // Add Data directory to included paths
@@ -3,4 +3,6 @@
 #include "ShadowEchoes.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogShadowEchoes);
+
 IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, ShadowEchoes, "ShadowEchoes");
@@ -2,14 +2,37 @@
 
 #include "Systems/SEDungeonManager.h"
 #include "Core/SEGameInstance.h"
+#include "ShadowEchoes.h"
+#include "Systems/SEJobScheduler.h"
 #include "Systems/TimelineManager.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/AssetManager.h"
 #include "Engine/DataTable.h"
+#include "Engine/LevelStreamingDynamic.h"
 #include "Kismet/GameplayStatics.h"
 
+namespace SEDungeonManager
+{
+    /** Lockout store content key of a dungeon's weekly lockout */
+    static FName GetLockoutContent(const FName& DungeonID)
+    {
+        return FName(*FString::Printf(TEXT("Dungeon.%s"), *DungeonID.ToString()));
+    }
+}
+
 USEDungeonManager::USEDungeonManager()
-    : TimelineFluxInterval(30.0f)
+    : DungeonTable(FSoftObjectPath(TEXT("/Game/Data/DT_LegendaryDungeons.DT_LegendaryDungeons")))
+    , MechanicCheckInterval(0.25f)
+    , PreparationTimeout(60.0f)
+    , TimelineFluxInterval(30.0f)
     , MaxRealityTears(5)
     , TimeDilationRange(2.0f)
+    , WeeklyResetDay(static_cast<int32>(EDayOfWeek::Tuesday))
+    , WeeklyResetHour(15)
+    , LoadedDungeonTable(nullptr)
+    , NextFluxEvent(0)
+    , NextTearEvent(0)
+    , EnterTime(0.0)
 {
 }
 
@@ -20,29 +43,111 @@ void USEDungeonManager::Initialize(USEGameInstance* InGameInstance)
     {
         TimelineManager = GameInstance->GetTimelineManager();
     }
+
+    // Preparation polls its worker and the active dungeon plays its schedule back
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        Scheduler->AddJob(TEXT("Dungeon.Schedule"), MechanicCheckInterval, ESEJobPriority::High,
+            [this](const FSEJobBudget&) { ProcessDungeonSchedule(); return true; }, this);
+    }
 }
 
-bool USEDungeonManager::StartDungeon(const FName& DungeonID)
+bool USEDungeonManager::PrepareDungeon(const FName& DungeonID, const TArray<FName>& WeeklyModifiers)
 {
-    if (!ValidateDungeonRequirements(DungeonID))
+    if (DungeonID.IsNone())
     {
         return false;
     }
 
-    // Initialize dungeon state
-    CurrentDungeonID = DungeonID;
-    CurrentProgress = FDungeonProgress();
-    CurrentProgress.DungeonID = DungeonID;
+    // Already underway for the same run
+    if (Preparation.DungeonID == DungeonID && Preparation.WeeklyModifiers == WeeklyModifiers)
+    {
+        return true;
+    }
+
+    CancelPreparation();
+    Preparation.DungeonID = DungeonID;
+    Preparation.WeeklyModifiers = WeeklyModifiers;
+    Preparation.StartTime = FPlatformTime::Seconds();
+
+    // The dungeon table itself streams in on first use
+    if (LoadedDungeonTable)
+    {
+        StreamPreparedInstance();
+    }
+    else
+    {
+        UAssetManager::GetStreamableManager().RequestAsyncLoad(DungeonTable.ToSoftObjectPath(),
+            FStreamableDelegate::CreateUObject(this, &USEDungeonManager::HandleDungeonTableLoaded),
+            FStreamableManager::AsyncLoadHighPriority);
+    }
+    return true;
+}
 
-    // Load dungeon data
-    UDataTable* DungeonTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_LegendaryDungeons")));
-    if (DungeonTable)
+void USEDungeonManager::CancelPreparation()
+{
+    UnloadLevels(PreparedLevels);
+    if (Preparation.Assets.IsValid())
     {
-        // Setup initial mechanics
-        ProcessTimelineFlux();
-        ManageRealityTears();
+        if (Preparation.Assets->IsLoadingInProgress())
+        {
+            Preparation.Assets->CancelHandle();
+        }
+        else
+        {
+            Preparation.Assets->ReleaseHandle();
+        }
+    }
+
+    // A schedule still on the worker finishes on its own and is dropped with the task
+    Preparation = FPreparation();
+}
+
+bool USEDungeonManager::IsDungeonPrepared(const FName& DungeonID) const
+{
+    return Preparation.bReady && Preparation.DungeonID == DungeonID;
+}
+
+bool USEDungeonManager::EnterDungeon(const FName& DungeonID, const TArray<FSEEntityID>& PartyIDs)
+{
+    if (!CurrentDungeonID.IsNone() || !IsDungeonPrepared(DungeonID))
+    {
+        return false;
     }
 
+    if (!ValidateDungeonRequirements(DungeonID, PartyIDs))
+    {
+        return false;
+    }
+
+    // Step 1: Swap the prepared instance in; everything here is already loaded or built
+    ReleaseActiveInstance();
+    for (ULevelStreamingDynamic* Level : PreparedLevels)
+    {
+        Level->OnLevelShown.RemoveAll(this);
+    }
+    ActiveLevels = MoveTemp(PreparedLevels);
+    ActiveAssets = MoveTemp(Preparation.Assets);
+    ActiveSchedule = MoveTemp(Preparation.Schedule.GetResult());
+    for (const FVector& SpawnPoint : Preparation.Row.RealityTearSpawnPoints)
+    {
+        ActiveTearLocations.Add(Preparation.Row.InstanceOrigin + SpawnPoint);
+    }
+    NextFluxEvent = 0;
+    NextTearEvent = 0;
+    EnterTime = GetWorld()->GetTimeSeconds();
+
+    ActiveSettings = Preparation.Settings;
+    ActiveModifiers = MoveTemp(Preparation.WeeklyModifiers);
+    Preparation = FPreparation();
+
+    // Step 2: Initialize dungeon state
+    CurrentDungeonID = DungeonID;
+    CurrentParty = PartyIDs;
+    CurrentProgress = FDungeonProgress();
+    CurrentProgress.DungeonID = DungeonID;
+    ManageRealityTears();
+
     // Notify events
     OnDungeonStarted.Broadcast(DungeonID);
     BP_OnDungeonStarted(DungeonID);
@@ -62,6 +167,12 @@ void USEDungeonManager::EndDungeon(bool bSuccess)
         // Add to completed dungeons
         CompletedDungeons.AddUnique(CurrentDungeonID);
 
+        // Lock the party out until the weekly reset
+        if (GameInstance)
+        {
+            GameInstance->GetLockouts().Add(CurrentParty, SEDungeonManager::GetLockoutContent(CurrentDungeonID), GetNextWeeklyReset());
+        }
+
         // Grant rewards
         GrantLegendaryReward();
     }
@@ -72,7 +183,9 @@ void USEDungeonManager::EndDungeon(bool bSuccess)
 
     // Reset state
     CurrentDungeonID = NAME_None;
+    CurrentParty.Reset();
     CurrentProgress = FDungeonProgress();
+    ReleaseActiveInstance();
 }
 
 void USEDungeonManager::UpdateDungeonProgress(const FDungeonProgress& Progress)
@@ -82,14 +195,13 @@ void USEDungeonManager::UpdateDungeonProgress(const FDungeonProgress& Progress)
         return;
     }
 
+    const bool bPhaseAdvanced = Progress.CurrentPhase > CurrentProgress.CurrentPhase;
     CurrentProgress = Progress;
 
-    // Check for phase transitions
-    if (Progress.CurrentPhase > CurrentProgress.CurrentPhase)
+    // Open tears are ours to count; tears and flux carry across phases
+    ManageRealityTears();
+    if (bPhaseAdvanced)
     {
-        // Update mechanics for new phase
-        ProcessTimelineFlux();
-        ManageRealityTears();
         UpdateTimeDilation();
     }
 }
@@ -102,24 +214,17 @@ void USEDungeonManager::TriggerTimelineFlux()
     }
 
     // Randomly switch timeline
-    ETimelineState NewState = FMath::RandBool() ? ETimelineState::BrightWorld : ETimelineState::DarkWorld;
-    TimelineManager->SetTimelineState(NewState);
-
-    // Apply effects
-    BP_OnTimelineFlux();
+    ApplyTimelineFlux(FMath::RandBool() ? ETimelineState::BrightWorld : ETimelineState::DarkWorld);
 }
 
 void USEDungeonManager::CreateRealityTear(const FVector& Location)
 {
-    if (CurrentDungeonID.IsNone() || CurrentProgress.RealityTearCount >= MaxRealityTears)
+    if (CurrentDungeonID.IsNone())
     {
         return;
     }
 
-    CurrentProgress.RealityTearCount++;
-
-    // Spawn VFX and apply gameplay effects
-    BP_OnRealityTearCreated(Location);
+    OpenRealityTear(Location);
 }
 
 void USEDungeonManager::TriggerTimeDilation(float DilationFactor)
@@ -141,20 +246,19 @@ void USEDungeonManager::TriggerTimeDilation(float DilationFactor)
 
 void USEDungeonManager::ActivateWeeklyModifier(const FName& ModifierID)
 {
-    if (CurrentDungeonID.IsNone())
+    if (CurrentDungeonID.IsNone() || ActiveModifiers.Contains(ModifierID))
     {
         return;
     }
 
-    // Apply modifier effects
-    if (ModifierID == "Timeline_Storm")
-    {
-        TimelineFluxInterval *= 0.5f;
-    }
-    else if (ModifierID == "Reality_Fracture")
-    {
-        MaxRealityTears *= 2;
-    }
+    // Same seed and modifiers as a run prepared with it, so the remaining events match that run
+    ActiveModifiers.Add(ModifierID);
+    ActiveSettings.ApplyWeeklyModifiers(MakeArrayView(&ModifierID, 1));
+    ActiveSchedule = FSEDungeonSchedule::Build(ActiveSettings);
+
+    const float Elapsed = static_cast<float>(GetWorld()->GetTimeSeconds() - EnterTime);
+    NextFluxEvent = Algo::UpperBoundBy(ActiveSchedule.Flux, Elapsed, &FSEDungeonFluxEvent::Time);
+    NextTearEvent = Algo::UpperBoundBy(ActiveSchedule.Tears, Elapsed, &FSEDungeonTearEvent::Time);
 }
 
 void USEDungeonManager::StartTimeParadoxChallenge()
@@ -190,13 +294,24 @@ bool USEDungeonManager::HasCompletedDungeon(const FName& DungeonID) const
     return CompletedDungeons.Contains(DungeonID);
 }
 
-bool USEDungeonManager::ValidateDungeonRequirements(const FName& DungeonID) const
+bool USEDungeonManager::HasWeeklyLockout(const FSEEntityID& PlayerID, const FName& DungeonID) const
+{
+    return GameInstance && GameInstance->GetLockouts().IsLockedOut(PlayerID, SEDungeonManager::GetLockoutContent(DungeonID), FSELockoutStore::Now());
+}
+
+bool USEDungeonManager::ValidateDungeonRequirements(const FName& DungeonID, const TArray<FSEEntityID>& PartyIDs) const
 {
     if (!GameInstance)
     {
         return false;
     }
 
+    // Check weekly lockouts for the whole party
+    if (GameInstance->GetLockouts().IsAnyLockedOut(PartyIDs, SEDungeonManager::GetLockoutContent(DungeonID), FSELockoutStore::Now()))
+    {
+        return false;
+    }
+
     // Check level requirement
     if (!CheckGroupRequirements(DungeonID))
     {
@@ -209,9 +324,8 @@ bool USEDungeonManager::ValidateDungeonRequirements(const FName& DungeonID) cons
         return false;
     }
 
-    // Check prerequisite dungeons
-    UDataTable* DungeonTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_LegendaryDungeons")));
-    if (DungeonTable)
+    // Check prerequisite dungeons; the table was loaded by the preparation
+    if (LoadedDungeonTable)
     {
         // TODO: Check required dungeons from data table
     }
@@ -233,8 +347,7 @@ bool USEDungeonManager::CheckTimelineMasteryRequirements(const FName& DungeonID)
     }
 
     // Check mastery levels from dungeon data
-    UDataTable* DungeonTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_LegendaryDungeons")));
-    if (DungeonTable)
+    if (LoadedDungeonTable)
     {
         // TODO: Check timeline mastery requirements from data table
     }
@@ -242,30 +355,243 @@ bool USEDungeonManager::CheckTimelineMasteryRequirements(const FName& DungeonID)
     return true;
 }
 
-void USEDungeonManager::ProcessTimelineFlux()
+int64 USEDungeonManager::GetNextWeeklyReset() const
+{
+    return FSELockoutStore::GetNextWeeklyReset(FSELockoutStore::Now(),
+        static_cast<EDayOfWeek>(FMath::Clamp(WeeklyResetDay, 0, 6)), WeeklyResetHour);
+}
+
+void USEDungeonManager::FailPreparation(const FString& Reason)
+{
+    const FName DungeonID = Preparation.DungeonID;
+    SE_LOG_WARNING(TEXT("Dungeon %s preparation failed: %s"), *DungeonID.ToString(), *Reason);
+    CancelPreparation();
+
+    OnDungeonPreparationFailed.Broadcast(DungeonID);
+    BP_OnDungeonPreparationFailed(DungeonID);
+}
+
+void USEDungeonManager::HandleDungeonTableLoaded()
+{
+    LoadedDungeonTable = DungeonTable.Get();
+
+    // Each preparation requests the table until it arrives; only the first arrival streams
+    if (!Preparation.DungeonID.IsNone() && !Preparation.bStreamed)
+    {
+        StreamPreparedInstance();
+    }
+}
+
+void USEDungeonManager::StreamPreparedInstance()
+{
+    const FLegendaryDungeonData* Row = LoadedDungeonTable
+        ? LoadedDungeonTable->FindRow<FLegendaryDungeonData>(Preparation.DungeonID, TEXT("PrepareDungeon"))
+        : nullptr;
+    if (!Row)
+    {
+        FailPreparation(TEXT("no row in the dungeon table"));
+        return;
+    }
+    Preparation.Row = *Row;
+    Preparation.bStreamed = true;
+
+    // Step 1: Flux and tear schedule on a worker, seeded by the lockout week so the week's runs share it
+    FSEDungeonScheduleSettings& Settings = Preparation.Settings;
+    Settings.Duration = Row->DurationLimit;
+    Settings.FluxInterval = Row->TimelineFluxInterval > 0.0f ? Row->TimelineFluxInterval : TimelineFluxInterval;
+    Settings.TearInterval = Row->RealityTearInterval;
+    Settings.TearLifetime = Row->RealityTearLifetime;
+    Settings.MaxRealityTears = MaxRealityTears;
+    Settings.NumTearSpawnPoints = Row->RealityTearSpawnPoints.Num();
+    Settings.Seed = FSEDungeonScheduleSettings::MakeSeed(Preparation.DungeonID, GetNextWeeklyReset());
+    Settings.ApplyWeeklyModifiers(Preparation.WeeklyModifiers);
+    Preparation.Schedule = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Settings = Preparation.Settings]()
+    {
+        return FSEDungeonSchedule::Build(Settings);
+    });
+
+    // Step 2: Effects and mechanic data
+    TArray<FSoftObjectPath> AssetPaths;
+    for (const TSoftObjectPtr<UParticleSystem>& Effect : Row->Effects)
+    {
+        AssetPaths.Add(Effect.ToSoftObjectPath());
+    }
+    for (const TSoftObjectPtr<UDataTable>& MechanicTable : Row->MechanicTables)
+    {
+        AssetPaths.Add(MechanicTable.ToSoftObjectPath());
+    }
+    if (AssetPaths.Num() > 0)
+    {
+        Preparation.Assets = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths,
+            FStreamableDelegate::CreateUObject(this, &USEDungeonManager::HandleAssetsLoaded),
+            FStreamableManager::AsyncLoadHighPriority);
+    }
+    else
+    {
+        Preparation.bAssetsLoaded = true;
+    }
+
+    // Step 3: Sublevels, shown at the instance origin away from the party until it enters
+    for (const TSoftObjectPtr<UWorld>& Sublevel : Row->Sublevels)
+    {
+        bool bSuccess = false;
+        ULevelStreamingDynamic* Level = ULevelStreamingDynamic::LoadLevelInstanceBySoftObjectPtr(
+            this, Sublevel, Row->InstanceOrigin, FRotator::ZeroRotator, bSuccess);
+        if (!bSuccess || !Level)
+        {
+            FailPreparation(FString::Printf(TEXT("could not stream %s"), *Sublevel.ToString()));
+            return;
+        }
+
+        Level->OnLevelShown.AddDynamic(this, &USEDungeonManager::HandleSublevelShown);
+        PreparedLevels.Add(Level);
+        ++Preparation.PendingLevels;
+    }
+
+    UpdatePreparation();
+}
+
+void USEDungeonManager::HandleAssetsLoaded()
+{
+    Preparation.bAssetsLoaded = true;
+    UpdatePreparation();
+}
+
+void USEDungeonManager::HandleSublevelShown()
+{
+    Preparation.PendingLevels = FMath::Max(0, Preparation.PendingLevels - 1);
+    UpdatePreparation();
+}
+
+void USEDungeonManager::UpdatePreparation()
+{
+    if (Preparation.DungeonID.IsNone() || Preparation.bReady)
+    {
+        return;
+    }
+
+    // A sublevel that never shows or a load that never finishes would otherwise hold the party forever
+    if (PreparationTimeout > 0.0f && FPlatformTime::Seconds() - Preparation.StartTime > PreparationTimeout)
+    {
+        FailPreparation(FString::Printf(TEXT("not ready after %.0f s, %d sublevels still pending"), PreparationTimeout, Preparation.PendingLevels));
+        return;
+    }
+
+    if (!Preparation.bAssetsLoaded || Preparation.PendingLevels > 0)
+    {
+        return;
+    }
+
+    // The schedule is usually done long before the levels; otherwise the next pass picks it up
+    if (!Preparation.Schedule.IsValid() || !Preparation.Schedule.IsCompleted())
+    {
+        return;
+    }
+
+    Preparation.bReady = true;
+    SE_LOG(Log, TEXT("Dungeon %s prepared in %.0f ms: %d sublevels, %d fluxes, %d tears"),
+        *Preparation.DungeonID.ToString(), (FPlatformTime::Seconds() - Preparation.StartTime) * 1000.0,
+        PreparedLevels.Num(), Preparation.Schedule.GetResult().Flux.Num(), Preparation.Schedule.GetResult().Tears.Num());
+
+    const FName DungeonID = Preparation.DungeonID;
+    OnDungeonPrepared.Broadcast(DungeonID);
+    BP_OnDungeonPrepared(DungeonID);
+}
+
+void USEDungeonManager::UnloadLevels(TArray<ULevelStreamingDynamic*>& Levels)
+{
+    for (ULevelStreamingDynamic* Level : Levels)
+    {
+        if (Level)
+        {
+            Level->OnLevelShown.RemoveAll(this);
+            Level->SetIsRequestingUnloadAndRemoval(true);
+        }
+    }
+    Levels.Reset();
+}
+
+void USEDungeonManager::ReleaseActiveInstance()
+{
+    UnloadLevels(ActiveLevels);
+    if (ActiveAssets.IsValid())
+    {
+        ActiveAssets->ReleaseHandle();
+        ActiveAssets.Reset();
+    }
+    ActiveSchedule = FSEDungeonSchedule();
+    ActiveSettings = FSEDungeonScheduleSettings();
+    ActiveModifiers.Reset();
+    ActiveTearLocations.Reset();
+    OpenTearCloseTimes.Reset();
+}
+
+void USEDungeonManager::ProcessDungeonSchedule()
+{
+    UpdatePreparation();
+
+    if (CurrentDungeonID.IsNone())
+    {
+        return;
+    }
+
+    // Fire every flux and tear that came due since the last pass
+    const float Elapsed = static_cast<float>(GetWorld()->GetTimeSeconds() - EnterTime);
+    while (NextFluxEvent < ActiveSchedule.Flux.Num() && ActiveSchedule.Flux[NextFluxEvent].Time <= Elapsed)
+    {
+        ApplyTimelineFlux(ActiveSchedule.Flux[NextFluxEvent++].State);
+    }
+    while (NextTearEvent < ActiveSchedule.Tears.Num() && ActiveSchedule.Tears[NextTearEvent].Time <= Elapsed)
+    {
+        const int32 SpawnPoint = ActiveSchedule.Tears[NextTearEvent++].SpawnPoint;
+        if (ActiveTearLocations.IsValidIndex(SpawnPoint))
+        {
+            OpenRealityTear(ActiveTearLocations[SpawnPoint]);
+        }
+    }
+    ManageRealityTears();
+}
+
+void USEDungeonManager::ApplyTimelineFlux(ETimelineState NewState)
 {
     if (!TimelineManager)
     {
         return;
     }
 
-    // Schedule periodic timeline shifts
-    FTimerHandle FluxTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        FluxTimer,
-        this,
-        &USEDungeonManager::TriggerTimelineFlux,
-        TimelineFluxInterval,
-        true
-    );
+    TimelineManager->SetTimelineState(NewState);
+
+    // Apply effects
+    BP_OnTimelineFlux();
 }
 
-void USEDungeonManager::ManageRealityTears()
+void USEDungeonManager::OpenRealityTear(const FVector& Location)
 {
-    // Reset tear count for new phase
-    CurrentProgress.RealityTearCount = 0;
+    // Scheduled tears fit under the cap by construction; tears made by hand may not
+    ManageRealityTears();
+    if (OpenTearCloseTimes.Num() >= ActiveSettings.MaxRealityTears)
+    {
+        return;
+    }
+
+    OpenTearCloseTimes.Add(GetWorld()->GetTimeSeconds() + ActiveSettings.TearLifetime);
+    CurrentProgress.RealityTearCount = OpenTearCloseTimes.Num();
+
+    // Spawn VFX and apply gameplay effects
+    BP_OnRealityTearCreated(Location);
+}
 
-    // TODO: Setup reality tear spawn points
+void USEDungeonManager::ManageRealityTears()
+{
+    // Every tear has the same lifetime, so they close in opening order
+    const double Now = GetWorld()->GetTimeSeconds();
+    int32 NumClosed = 0;
+    while (NumClosed < OpenTearCloseTimes.Num() && OpenTearCloseTimes[NumClosed] <= Now)
+    {
+        ++NumClosed;
+    }
+    OpenTearCloseTimes.RemoveAt(0, NumClosed);
+    CurrentProgress.RealityTearCount = OpenTearCloseTimes.Num();
 }
 
 void USEDungeonManager::UpdateTimeDilation()
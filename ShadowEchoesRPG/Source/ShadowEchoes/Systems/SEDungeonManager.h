@@ -5,11 +5,20 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Combat/SECombatTypes.h"
+#include "Core/SEEntityID.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
+#include "Systems/SEDungeonSchedule.h"
+#include "Tasks/Task.h"
 #include "SEDungeonManager.generated.h"
 
 class USEGameInstance;
 class UTimelineManager;
+class ULevelStreamingDynamic;
+class UParticleSystem;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDungeonPrepared, const FName&, DungeonID);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDungeonPreparationFailed, const FName&, DungeonID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDungeonStarted, const FName&, DungeonID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDungeonCompleted, const FName&, DungeonID, bool, bSuccess);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLegendaryRewardGranted, const FName&, ItemID, const FName&, DungeonID);
@@ -37,12 +46,63 @@ struct FDungeonProgress
     UPROPERTY()
     bool bTimelineChallengeActive;
 
+    /** Reality tears open right now, scheduled or created by hand */
     UPROPERTY()
     int32 RealityTearCount;
 };
 
+/** Row of DT_LegendaryDungeons: what PrepareDungeon streams in and schedules */
+USTRUCT(BlueprintType)
+struct FLegendaryDungeonData : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    /** Streamed in together as one instance at InstanceOrigin; empty runs the dungeon in the current level */
+    UPROPERTY(EditAnywhere)
+    TArray<TSoftObjectPtr<UWorld>> Sublevels;
+
+    UPROPERTY(EditAnywhere)
+    FVector InstanceOrigin = FVector::ZeroVector;
+
+    /** Flux, tear and encounter effects */
+    UPROPERTY(EditAnywhere)
+    TArray<TSoftObjectPtr<UParticleSystem>> Effects;
+
+    /** Mechanic data the dungeon's encounters read */
+    UPROPERTY(EditAnywhere)
+    TArray<TSoftObjectPtr<UDataTable>> MechanicTables;
+
+    /** Seconds of flux and tears to schedule */
+    UPROPERTY(EditAnywhere)
+    float DurationLimit = 1800.0f;
+
+    /** Seconds between fluxes; 0 uses the manager's TimelineFluxInterval */
+    UPROPERTY(EditAnywhere)
+    float TimelineFluxInterval = 0.0f;
+
+    UPROPERTY(EditAnywhere)
+    float RealityTearInterval = 20.0f;
+
+    UPROPERTY(EditAnywhere)
+    float RealityTearLifetime = 15.0f;
+
+    /** Relative to InstanceOrigin */
+    UPROPERTY(EditAnywhere)
+    TArray<FVector> RealityTearSpawnPoints;
+};
+
 /**
  * Manages legendary dungeons, their mechanics, and rewards
+ *
+ * Runs in two phases. PrepareDungeon, called while the party forms, streams the dungeon's
+ * sublevels in at their own origin, loads its effects and mechanic data asynchronously and
+ * builds the flux and tear schedule on a worker. EnterDungeon then only swaps the prepared
+ * instance in, so entry never waits on a load. A preparation that fails or outlasts
+ * PreparationTimeout is cancelled and reported through OnDungeonPreparationFailed.
+ *
+ * MaxRealityTears caps the tears open at once, not the tears per phase; each closes after the
+ * row's RealityTearLifetime. The schedule already respects the cap, and tears created by hand
+ * share it.
  */
 UCLASS()
 class SHADOWECHOES_API USEDungeonManager : public UObject
@@ -56,8 +116,21 @@ public:
     void Initialize(USEGameInstance* InGameInstance);
 
     /** Dungeon management */
+    /** Start streaming a dungeon instance for the party being formed; replaces any other preparation */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
+    bool PrepareDungeon(const FName& DungeonID, const TArray<FName>& WeeklyModifiers);
+
+    /** Drop a preparation that will not be entered */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
+    void CancelPreparation();
+
+    /** True once the instance is streamed in and its schedule is built */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Dungeons")
+    bool IsDungeonPrepared(const FName& DungeonID) const;
+
+    /** Swap in the prepared instance; fails if it is not ready or a party member is under this week's lockout */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
-    bool StartDungeon(const FName& DungeonID);
+    bool EnterDungeon(const FName& DungeonID, const TArray<FSEEntityID>& PartyIDs);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
     void EndDungeon(bool bSuccess);
@@ -69,13 +142,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
     void TriggerTimelineFlux();
 
+    /** Open a tear unless MaxRealityTears are already open */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
     void CreateRealityTear(const FVector& Location);
 
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
     void TriggerTimeDilation(float DilationFactor);
 
-    /** Challenge modes */
+    /** Challenge modes; the rest of the running dungeon's schedule is rebuilt with the modifier */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Dungeons")
     void ActivateWeeklyModifier(const FName& ModifierID);
 
@@ -89,7 +163,17 @@ public:
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Dungeons")
     bool HasCompletedDungeon(const FName& DungeonID) const;
 
+    /** True until the weekly reset after the player last cleared the dungeon */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Dungeons")
+    bool HasWeeklyLockout(const FSEEntityID& PlayerID, const FName& DungeonID) const;
+
     /** Events */
+    UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Dungeons|Events")
+    FOnDungeonPrepared OnDungeonPrepared;
+
+    UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Dungeons|Events")
+    FOnDungeonPreparationFailed OnDungeonPreparationFailed;
+
     UPROPERTY(BlueprintAssignable, Category = "Shadow Echoes|Dungeons|Events")
     FOnDungeonStarted OnDungeonStarted;
 
@@ -101,6 +185,17 @@ public:
 
 protected:
     /** Dungeon settings */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons")
+    TSoftObjectPtr<UDataTable> DungeonTable;
+
+    /** Seconds between schedule playback passes */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons")
+    float MechanicCheckInterval;
+
+    /** Seconds a preparation may take before it is cancelled, e.g. when a sublevel never shows */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons")
+    float PreparationTimeout;
+
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons")
     float TimelineFluxInterval;
 
@@ -110,7 +205,57 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons")
     float TimeDilationRange;
 
+    /** Weekly lockouts lift at this UTC day (0 = Monday) and hour */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons", meta = (ClampMin = "0", ClampMax = "6"))
+    int32 WeeklyResetDay;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|Dungeons", meta = (ClampMin = "0", ClampMax = "23"))
+    int32 WeeklyResetHour;
+
 private:
+    /** Instance being prepared, or ready to enter */
+    struct FPreparation
+    {
+        FName DungeonID;
+        TArray<FName> WeeklyModifiers;
+        FLegendaryDungeonData Row;
+        FSEDungeonScheduleSettings Settings;
+        TSharedPtr<FStreamableHandle> Assets;
+        UE::Tasks::TTask<FSEDungeonSchedule> Schedule;
+        int32 PendingLevels = 0;
+        bool bStreamed = false;
+        bool bAssetsLoaded = false;
+        bool bReady = false;
+        double StartTime = 0.0;
+    };
+
+    FPreparation Preparation;
+
+    UPROPERTY()
+    TArray<ULevelStreamingDynamic*> PreparedLevels;
+
+    /** Loaded from DungeonTable on the first preparation */
+    UPROPERTY()
+    UDataTable* LoadedDungeonTable;
+
+    /** Entered instance */
+    UPROPERTY()
+    TArray<ULevelStreamingDynamic*> ActiveLevels;
+
+    TSharedPtr<FStreamableHandle> ActiveAssets;
+    FSEDungeonScheduleSettings ActiveSettings;
+    TArray<FName> ActiveModifiers;
+    FSEDungeonSchedule ActiveSchedule;
+    TArray<FVector> ActiveTearLocations;
+
+    /** World times the open tears close, in opening order */
+    TArray<double> OpenTearCloseTimes;
+    int32 NextFluxEvent;
+    int32 NextTearEvent;
+
+    /** World time the party entered */
+    double EnterTime;
+
     /** Current state */
     UPROPERTY()
     FName CurrentDungeonID;
@@ -118,6 +263,9 @@ private:
     UPROPERTY()
     FDungeonProgress CurrentProgress;
 
+    UPROPERTY()
+    TArray<FSEEntityID> CurrentParty;
+
     UPROPERTY()
     TArray<FName> CompletedDungeons;
 
@@ -129,12 +277,27 @@ private:
     UTimelineManager* TimelineManager;
 
     /** Validation */
-    bool ValidateDungeonRequirements(const FName& DungeonID) const;
+    bool ValidateDungeonRequirements(const FName& DungeonID, const TArray<FSEEntityID>& PartyIDs) const;
     bool CheckGroupRequirements(const FName& DungeonID) const;
     bool CheckTimelineMasteryRequirements(const FName& DungeonID) const;
 
+    /** Preparation */
+    int64 GetNextWeeklyReset() const;
+    void FailPreparation(const FString& Reason);
+    void HandleDungeonTableLoaded();
+    void StreamPreparedInstance();
+    void HandleAssetsLoaded();
+    void UpdatePreparation();
+    void UnloadLevels(TArray<ULevelStreamingDynamic*>& Levels);
+    void ReleaseActiveInstance();
+
+    UFUNCTION()
+    void HandleSublevelShown();
+
     /** Mechanics */
-    void ProcessTimelineFlux();
+    void ProcessDungeonSchedule();
+    void ApplyTimelineFlux(ETimelineState NewState);
+    void OpenRealityTear(const FVector& Location);
     void ManageRealityTears();
     void UpdateTimeDilation();
     void HandleTimeParadox();
@@ -146,6 +309,12 @@ private:
 
 protected:
     /** Blueprint events */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Dungeons|Events")
+    void BP_OnDungeonPrepared(const FName& DungeonID);
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Dungeons|Events")
+    void BP_OnDungeonPreparationFailed(const FName& DungeonID);
+
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|Dungeons|Events")
     void BP_OnDungeonStarted(const FName& DungeonID);
 
@@ -0,0 +1,76 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Systems/SEDungeonSchedule.h"
+
+namespace SEDungeonSchedule
+{
+    /** Fluxes and tears land within this fraction of their interval either side of the beat */
+    static constexpr float Jitter = 0.25f;
+}
+
+int32 FSEDungeonScheduleSettings::MakeSeed(FName DungeonID, int64 WeeklyReset)
+{
+    // CRCs of the name and the little-endian reset time, not FName hashes, which depend on the
+    // process's name table; names compare case-insensitively, so the string is lowercased
+    const uint32 NameCrc = FCrc::StrCrc32(*DungeonID.ToString().ToLower());
+    return static_cast<int32>(FCrc::MemCrc32(&WeeklyReset, sizeof(WeeklyReset), NameCrc));
+}
+
+void FSEDungeonScheduleSettings::ApplyWeeklyModifiers(TArrayView<const FName> ModifierIDs)
+{
+    for (const FName& ModifierID : ModifierIDs)
+    {
+        if (ModifierID == "Timeline_Storm")
+        {
+            FluxInterval *= 0.5f;
+        }
+        else if (ModifierID == "Reality_Fracture")
+        {
+            MaxRealityTears *= 2;
+            TearInterval *= 0.5f;
+        }
+    }
+}
+
+FSEDungeonSchedule FSEDungeonSchedule::Build(const FSEDungeonScheduleSettings& Settings)
+{
+    FSEDungeonSchedule Schedule;
+    FRandomStream Random(Settings.Seed);
+
+    // Step 1: Timeline fluxes, each one a coin flip like a manual flux
+    if (Settings.FluxInterval > 0.0f)
+    {
+        const float Spread = Settings.FluxInterval * SEDungeonSchedule::Jitter;
+        Schedule.Flux.Reserve(FMath::FloorToInt(Settings.Duration / Settings.FluxInterval));
+        for (float Beat = Settings.FluxInterval; Beat < Settings.Duration; Beat += Settings.FluxInterval)
+        {
+            const float Time = Beat + Random.FRandRange(-Spread, Spread);
+            Schedule.Flux.Add({ Time, Random.FRand() < 0.5f ? ETimelineState::BrightWorld : ETimelineState::DarkWorld });
+        }
+    }
+
+    // Step 2: Reality tears at random spawn points, skipping beats while too many are open
+    if (Settings.TearInterval > 0.0f && Settings.NumTearSpawnPoints > 0 && Settings.MaxRealityTears > 0)
+    {
+        const float Spread = Settings.TearInterval * SEDungeonSchedule::Jitter;
+        Schedule.Tears.Reserve(FMath::FloorToInt(Settings.Duration / Settings.TearInterval));
+        for (float Beat = Settings.TearInterval; Beat < Settings.Duration; Beat += Settings.TearInterval)
+        {
+            const float Time = Beat + Random.FRandRange(-Spread, Spread);
+            const int32 SpawnPoint = Random.RandHelper(Settings.NumTearSpawnPoints);
+
+            int32 NumOpen = 0;
+            for (int32 Index = Schedule.Tears.Num() - 1; Index >= 0 && Schedule.Tears[Index].Time > Time - Settings.TearLifetime; --Index)
+            {
+                ++NumOpen;
+            }
+            if (NumOpen < Settings.MaxRealityTears)
+            {
+                Schedule.Tears.Add({ Time, SpawnPoint });
+            }
+        }
+    }
+
+    // Jitter never exceeds half an interval, so beats stay in order
+    return Schedule;
+}
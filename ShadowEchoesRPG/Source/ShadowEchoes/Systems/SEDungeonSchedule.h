@@ -0,0 +1,65 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/SETypes.h"
+
+/** Inputs of a dungeon schedule, copied off the dungeon row with the weekly modifiers folded in */
+struct FSEDungeonScheduleSettings
+{
+    /** Seconds of dungeon time to schedule */
+    float Duration = 1800.0f;
+
+    /** Seconds between timeline fluxes; 0 disables flux */
+    float FluxInterval = 30.0f;
+
+    /** Seconds between reality tears; 0 disables tears */
+    float TearInterval = 20.0f;
+
+    /** Tears open at once at most */
+    int32 MaxRealityTears = 5;
+
+    /** Seconds a tear stays open */
+    float TearLifetime = 15.0f;
+
+    int32 NumTearSpawnPoints = 0;
+
+    /** Same seed, same schedule; the dungeon manager seeds by dungeon and lockout week */
+    int32 Seed = 0;
+
+    /** Apply weekly modifiers by ID, before a run or during one; unknown IDs are ignored */
+    void ApplyWeeklyModifiers(TArrayView<const FName> ModifierIDs);
+
+    /** Seed of a dungeon's runs in the lockout week ending at WeeklyReset; the same on every server */
+    static int32 MakeSeed(FName DungeonID, int64 WeeklyReset);
+};
+
+struct FSEDungeonFluxEvent
+{
+    float Time;
+    ETimelineState State;
+};
+
+struct FSEDungeonTearEvent
+{
+    float Time;
+    int32 SpawnPoint;
+};
+
+/**
+ * Timeline flux and reality tear timetable of one dungeon run
+ *
+ * Pure data built on a worker while the party forms, then played back by time on the game
+ * thread, so entering a dungeon rolls no dice and allocates nothing. Events are sorted by
+ * time; tears never exceed MaxRealityTears open at once.
+ */
+struct SHADOWECHOES_API FSEDungeonSchedule
+{
+    TArray<FSEDungeonFluxEvent> Flux;
+    TArray<FSEDungeonTearEvent> Tears;
+
+    static FSEDungeonSchedule Build(const FSEDungeonScheduleSettings& Settings);
+
+    SIZE_T GetAllocatedSize() const { return Flux.GetAllocatedSize() + Tears.GetAllocatedSize(); }
+};
@@ -0,0 +1,243 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Systems/SEJobScheduler.h"
+#include "ShadowEchoes.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Scheduler Frame"), STAT_SEJobs_Frame, STATGROUP_SEJobs);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Frame Budget Used (ms)"), STAT_SEJobs_FrameMs, STATGROUP_SEJobs);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slices Run"), STAT_SEJobs_Slices, STATGROUP_SEJobs);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Overrun Frames"), STAT_SEJobs_OverrunFrames, STATGROUP_SEJobs);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Deadline Misses"), STAT_SEJobs_DeadlineMisses, STATGROUP_SEJobs);
+
+static TAutoConsoleVariable<float> CVarJobBudgetMs(
+    TEXT("se.Jobs.BudgetMs"),
+    2.0f,
+    TEXT("Milliseconds per frame the manager job scheduler may spend"),
+    ECVF_Default
+);
+
+FSEJobScheduler::FSEJobScheduler()
+    : bInFrame(false)
+    , NextHandle(1)
+    , OverrunFrames(0)
+    , LastFrameMs(0.0)
+{
+}
+
+int32 FSEJobScheduler::AddJob(FName Name, float Period, ESEJobPriority Priority, FSEJobSlice Slice, double FirstDueTime, const UObject* Owner, float MaxLatency)
+{
+    FJob Job;
+    Job.Handle = NextHandle++;
+    Job.Name = Name;
+    Job.Period = FMath::Max(Period, 0.0f);
+    Job.MaxLatency = MaxLatency >= 0.0f ? MaxLatency : Job.Period;
+    Job.Priority = Priority;
+    Job.Slice = MoveTemp(Slice);
+    Job.Owner = Owner;
+    Job.bHasOwner = Owner != nullptr;
+    Job.DueTime = FirstDueTime;
+    Job.Deadline = FirstDueTime + Job.MaxLatency;
+
+#if STATS
+    Job.StatId = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_SEJobs>(Name.ToString());
+#endif
+
+    const int32 Handle = Job.Handle;
+
+    // Slices may schedule follow-up jobs; the job array must not move under them
+    (bInFrame ? PendingJobs : Jobs).Add(MoveTemp(Job));
+    return Handle;
+}
+
+void FSEJobScheduler::RemoveJob(int32 Handle)
+{
+    // Compacted at the start of the next frame
+    if (FJob* Job = FindJob(Handle))
+    {
+        Job->bRemoved = true;
+    }
+}
+
+void FSEJobScheduler::RemoveJobsForOwner(const UObject* Owner)
+{
+    for (FJob& Job : Jobs)
+    {
+        if (Job.bHasOwner && Job.Owner.Get() == Owner)
+        {
+            Job.bRemoved = true;
+        }
+    }
+    PendingJobs.RemoveAll([Owner](const FJob& Job) { return Job.bHasOwner && Job.Owner.Get() == Owner; });
+}
+
+FSEJobScheduler::FJob* FSEJobScheduler::FindJob(int32 Handle)
+{
+    FJob* Job = Jobs.FindByPredicate([Handle](const FJob& Candidate) { return Candidate.Handle == Handle; });
+    return Job ? Job : PendingJobs.FindByPredicate([Handle](const FJob& Candidate) { return Candidate.Handle == Handle; });
+}
+
+const FSEJobScheduler::FJob* FSEJobScheduler::FindJob(int32 Handle) const
+{
+    return const_cast<FSEJobScheduler*>(this)->FindJob(Handle);
+}
+
+const FSEJobStats* FSEJobScheduler::GetJobStats(int32 Handle) const
+{
+    const FJob* Job = FindJob(Handle);
+    return Job && !Job->bRemoved ? &Job->Stats : nullptr;
+}
+
+bool FSEJobScheduler::IsJobRunning(int32 Handle) const
+{
+    const FJob* Job = FindJob(Handle);
+    return Job && !Job->bRemoved && Job->bRunning;
+}
+
+double FSEJobScheduler::RunFrame(double WorldTime, double BudgetMs)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SEJobs_Frame);
+
+    const double FrameStart = FPlatformTime::Seconds();
+    const double BudgetEnd = FrameStart + BudgetMs * 0.001;
+
+    Jobs.RemoveAll([](const FJob& Job) { return Job.bRemoved || (Job.bHasOwner && !Job.Owner.IsValid()); });
+
+    DueScratch.Reset();
+    for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+    {
+        if (IsDue(Jobs[Index], WorldTime))
+        {
+            DueScratch.Add(Index);
+        }
+    }
+
+    // Jobs past their deadline go first, oldest deadline first, so busy high priority work cannot starve the rest
+    DueScratch.Sort([this, WorldTime](int32 A, int32 B)
+    {
+        const FJob& JobA = Jobs[A];
+        const FJob& JobB = Jobs[B];
+        const bool bOverdueA = WorldTime > JobA.Deadline;
+        const bool bOverdueB = WorldTime > JobB.Deadline;
+        if (bOverdueA != bOverdueB)
+        {
+            return bOverdueA;
+        }
+        if (!bOverdueA && JobA.Priority != JobB.Priority)
+        {
+            return JobA.Priority < JobB.Priority;
+        }
+        return JobA.Deadline < JobB.Deadline;
+    });
+
+    bInFrame = true;
+    int32 SlicesRun = 0;
+    for (const int32 Index : DueScratch)
+    {
+        // The most urgent job always makes progress, even on a frame with no budget left
+        if (SlicesRun > 0 && FPlatformTime::Seconds() >= BudgetEnd)
+        {
+            break;
+        }
+
+        FJob& Job = Jobs[Index];
+        if (!Job.bRemoved)
+        {
+            RunSlice(Job, WorldTime, BudgetEnd);
+            ++SlicesRun;
+        }
+    }
+    bInFrame = false;
+
+    Jobs.Append(MoveTemp(PendingJobs));
+    PendingJobs.Reset();
+
+    LastFrameMs = (FPlatformTime::Seconds() - FrameStart) * 1000.0;
+    if (SlicesRun > 0 && LastFrameMs > BudgetMs)
+    {
+        ++OverrunFrames;
+        INC_DWORD_STAT(STAT_SEJobs_OverrunFrames);
+        SE_LOG(Verbose, TEXT("Job scheduler overran its %.2f ms budget: %.2f ms over %d slices"), BudgetMs, LastFrameMs, SlicesRun);
+    }
+
+    SET_FLOAT_STAT(STAT_SEJobs_FrameMs, LastFrameMs);
+    INC_DWORD_STAT_BY(STAT_SEJobs_Slices, SlicesRun);
+    return LastFrameMs;
+}
+
+void FSEJobScheduler::RunSlice(FJob& Job, double WorldTime, double BudgetEnd)
+{
+#if STATS
+    FScopeCycleCounter JobCounter(Job.StatId);
+#endif
+
+    if (!Job.bRunning)
+    {
+        Job.bRunning = true;
+        Job.PassMs = 0.0;
+        Job.PassMaxSliceMs = 0.0;
+        Job.PassFrames = 0;
+    }
+
+    const double SliceStart = FPlatformTime::Seconds();
+    const bool bDone = Job.Slice(FSEJobBudget(BudgetEnd));
+    const double SliceMs = (FPlatformTime::Seconds() - SliceStart) * 1000.0;
+
+    Job.PassMs += SliceMs;
+    Job.PassMaxSliceMs = FMath::Max(Job.PassMaxSliceMs, SliceMs);
+    ++Job.PassFrames;
+    ++Job.Stats.Slices;
+
+    if (!bDone)
+    {
+        return;
+    }
+
+    Job.bRunning = false;
+    ++Job.Stats.Passes;
+    Job.Stats.LastPassMs = Job.PassMs;
+    Job.Stats.LastPassMaxSliceMs = Job.PassMaxSliceMs;
+    Job.Stats.LastPassFrames = Job.PassFrames;
+
+    if (WorldTime > Job.Deadline)
+    {
+        ++Job.Stats.DeadlineMisses;
+        INC_DWORD_STAT(STAT_SEJobs_DeadlineMisses);
+        SE_LOG(Verbose, TEXT("Job %s missed its deadline by %.2f s"), *Job.Name.ToString(), WorldTime - Job.Deadline);
+    }
+
+    // Keep the cadence, but a long stall runs one catch-up pass rather than a burst
+    Job.DueTime = FMath::Max(Job.DueTime + Job.Period, WorldTime);
+    Job.Deadline = Job.DueTime + Job.MaxLatency;
+}
+
+USEJobSchedulerSubsystem* USEJobSchedulerSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USEJobSchedulerSubsystem>() : nullptr;
+}
+
+TStatId USEJobSchedulerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USEJobSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void USEJobSchedulerSubsystem::Deinitialize()
+{
+    Scheduler = FSEJobScheduler();
+    Super::Deinitialize();
+}
+
+void USEJobSchedulerSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    Scheduler.RunFrame(GetWorld()->GetTimeSeconds(), CVarJobBudgetMs.GetValueOnGameThread());
+}
+
+int32 USEJobSchedulerSubsystem::AddJob(FName Name, float Period, ESEJobPriority Priority, FSEJobSlice Slice, const UObject* Owner, float MaxLatency)
+{
+    return Scheduler.AddJob(Name, Period, Priority, MoveTemp(Slice), GetWorld()->GetTimeSeconds() + Period, Owner, MaxLatency);
+}
@@ -0,0 +1,175 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SEJobScheduler.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("SEJobs"), STATGROUP_SEJobs, STATCAT_Advanced);
+
+/** Order in which due jobs get the frame budget */
+UENUM(BlueprintType)
+enum class ESEJobPriority : uint8
+{
+    High        UMETA(DisplayName = "High"),
+    Normal      UMETA(DisplayName = "Normal"),
+    Low         UMETA(DisplayName = "Low")
+};
+
+/** Time a job slice may use before yielding */
+struct FSEJobBudget
+{
+    /** FPlatformTime::Seconds() at which the slice should return */
+    double EndTime;
+
+    explicit FSEJobBudget(double InEndTime) : EndTime(InEndTime) {}
+
+    bool HasTimeLeft() const { return FPlatformTime::Seconds() < EndTime; }
+
+    /** Budget for running a whole pass at once */
+    static FSEJobBudget Unbounded() { return FSEJobBudget(MAX_dbl); }
+    bool IsUnbounded() const { return EndTime == MAX_dbl; }
+};
+
+/**
+ * One slice of a resumable job. Keeps its own cursor, does work until the budget runs out and
+ * returns true once the pass is finished; otherwise it is called again next frame.
+ */
+using FSEJobSlice = TFunction<bool(const FSEJobBudget& Budget)>;
+
+/** Running totals of a job, shown on the SEJobs stat page */
+struct FSEJobStats
+{
+    int32 Passes = 0;
+    int32 Slices = 0;
+
+    /** Passes finished after their deadline */
+    int32 DeadlineMisses = 0;
+
+    /** Milliseconds of the last finished pass, and of its longest slice */
+    double LastPassMs = 0.0;
+    double LastPassMaxSliceMs = 0.0;
+
+    /** Frames the last finished pass was spread over */
+    int32 LastPassFrames = 0;
+};
+
+/**
+ * Frame-budgeted scheduler for periodic jobs
+ *
+ * Jobs become due every Period seconds of world time and must finish within MaxLatency of
+ * becoming due. Each frame due jobs run by priority, then earliest deadline, until the budget
+ * is spent; a job that does not finish resumes next frame. Jobs past their deadline jump ahead
+ * of every priority, so low priority work still runs under sustained high priority load. The
+ * most urgent due job always gets one slice, which is the only way a frame can overrun the budget.
+ */
+class SHADOWECHOES_API FSEJobScheduler
+{
+public:
+    FSEJobScheduler();
+
+    /**
+     * Returns a handle for RemoveJob. MaxLatency defaults to the period; jobs bound to an owner
+     * are dropped once it is gone.
+     */
+    int32 AddJob(FName Name, float Period, ESEJobPriority Priority, FSEJobSlice Slice, double FirstDueTime, const UObject* Owner = nullptr, float MaxLatency = -1.0f);
+    void RemoveJob(int32 Handle);
+    void RemoveJobsForOwner(const UObject* Owner);
+
+    /** Run due jobs for one frame; returns milliseconds spent */
+    double RunFrame(double WorldTime, double BudgetMs);
+
+    const FSEJobStats* GetJobStats(int32 Handle) const;
+    bool IsJobRunning(int32 Handle) const;
+    int32 Num() const { return Jobs.Num(); }
+
+    /** Frames that went over the budget */
+    int32 GetOverrunFrames() const { return OverrunFrames; }
+    double GetLastFrameMs() const { return LastFrameMs; }
+
+private:
+    struct FJob
+    {
+        int32 Handle = INDEX_NONE;
+        FName Name;
+        float Period = 0.0f;
+        float MaxLatency = 0.0f;
+        ESEJobPriority Priority = ESEJobPriority::Normal;
+        FSEJobSlice Slice;
+
+        TWeakObjectPtr<const UObject> Owner;
+        bool bHasOwner = false;
+        bool bRemoved = false;
+
+        /** World time the next pass is due, and the pass in progress must finish by */
+        double DueTime = 0.0;
+        double Deadline = 0.0;
+        bool bRunning = false;
+
+        /** Cost of the pass in progress */
+        double PassMs = 0.0;
+        double PassMaxSliceMs = 0.0;
+        int32 PassFrames = 0;
+
+        FSEJobStats Stats;
+
+#if STATS
+        TStatId StatId;
+#endif
+    };
+
+    bool IsDue(const FJob& Job, double WorldTime) const { return Job.bRunning || WorldTime >= Job.DueTime; }
+    void RunSlice(FJob& Job, double WorldTime, double BudgetEnd);
+
+    FJob* FindJob(int32 Handle);
+    const FJob* FindJob(int32 Handle) const;
+
+    TArray<FJob> Jobs;
+
+    /** Jobs added by a slice, merged once the frame is done */
+    TArray<FJob> PendingJobs;
+    bool bInFrame;
+
+    TArray<int32> DueScratch;
+    int32 NextHandle;
+
+    int32 OverrunFrames;
+    double LastFrameMs;
+};
+
+/**
+ * Shared frame-budgeted scheduler for manager jobs
+ *
+ * Managers submit their periodic work here instead of to the timer manager, so scans whose
+ * periods line up are spread across frames rather than landing in one. Gameplay that changes
+ * a job's inputs should mark them dirty for the job rather than run a pass inline, as the trade
+ * manager does for trades and timeline changes. The budget comes from
+ * se.Jobs.BudgetMs; stat SEJobs shows the per-job cost, frame time used and overrun frames.
+ */
+UCLASS()
+class SHADOWECHOES_API USEJobSchedulerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USEJobSchedulerSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void Deinitialize() override;
+
+    /** Schedule a periodic job; the first pass is due one period from now */
+    int32 AddJob(FName Name, float Period, ESEJobPriority Priority, FSEJobSlice Slice, const UObject* Owner, float MaxLatency = -1.0f);
+    void RemoveJob(int32 Handle) { Scheduler.RemoveJob(Handle); }
+    void RemoveJobsForOwner(const UObject* Owner) { Scheduler.RemoveJobsForOwner(Owner); }
+
+    const FSEJobScheduler& GetScheduler() const { return Scheduler; }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Jobs")
+    int32 GetOverrunFrames() const { return Scheduler.GetOverrunFrames(); }
+
+private:
+    FSEJobScheduler Scheduler;
+};
@@ -0,0 +1,250 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "Systems/SESignificanceManager.h"
+#include "Characters/SECharacterBase.h"
+#include "Combat/CombatComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarSignificanceDebug(
+    TEXT("se.Significance.Debug"),
+    0,
+    TEXT("Show character significance tier counts on screen"),
+    ECVF_Cheat
+);
+
+namespace SESignificance
+{
+    /** Squared distances in cm */
+    static const float HighDistanceSq = FMath::Square(2000.0f);
+    static const float CombatHighDistanceSq = FMath::Square(4000.0f);
+    static const float MediumDistanceSq = FMath::Square(6000.0f);
+    static const float CombatMediumDistanceSq = FMath::Square(10000.0f);
+    static const float LowDistanceSq = FMath::Square(15000.0f);
+
+    static const uint64 DebugMessageKey = 0x5E516;
+}
+
+USESignificanceManager::USESignificanceManager()
+    : NextToScore(0)
+{
+    FMemory::Memzero(TierCounts);
+}
+
+USESignificanceManager* USESignificanceManager::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USESignificanceManager>() : nullptr;
+}
+
+TStatId USESignificanceManager::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USESignificanceManager, STATGROUP_Tickables);
+}
+
+void USESignificanceManager::Deinitialize()
+{
+    Entries.Reset();
+    EntryIndices.Reset();
+    Super::Deinitialize();
+}
+
+float USESignificanceManager::GetTickInterval(ESESignificance Tier)
+{
+    switch (Tier)
+    {
+        case ESESignificance::High:
+            return 0.0f;
+
+        case ESESignificance::Medium:
+            return 1.0f / 20.0f;
+
+        case ESESignificance::Low:
+            return 1.0f / 5.0f;
+
+        default:
+            return 0.0f;
+    }
+}
+
+void USESignificanceManager::Register(ASECharacterBase* Character)
+{
+    if (!Character || EntryIndices.Contains(Character))
+    {
+        return;
+    }
+
+    // New characters start at full rate until their first score
+    EntryIndices.Add(Character, Entries.Num());
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Character = Character;
+    Entry.Tier = ESESignificance::High;
+    ++TierCounts[static_cast<int32>(ESESignificance::High)];
+    Character->ApplySignificanceTickRate(GetTickInterval(ESESignificance::High), true);
+}
+
+void USESignificanceManager::Unregister(ASECharacterBase* Character)
+{
+    if (const int32* Index = EntryIndices.Find(Character))
+    {
+        RemoveEntryAt(*Index);
+    }
+}
+
+void USESignificanceManager::RemoveEntryAt(int32 Index)
+{
+    --TierCounts[static_cast<int32>(Entries[Index].Tier)];
+    EntryIndices.Remove(Entries[Index].Character);
+
+    // The last entry moves into the hole
+    Entries.RemoveAtSwap(Index, 1, false);
+    if (Entries.IsValidIndex(Index))
+    {
+        EntryIndices.Add(Entries[Index].Character, Index);
+    }
+}
+
+ESESignificance USESignificanceManager::GetSignificance(const ASECharacterBase* Character) const
+{
+    const int32* Index = EntryIndices.Find(const_cast<ASECharacterBase*>(Character));
+    return Index ? Entries[*Index].Tier : ESESignificance::High;
+}
+
+void USESignificanceManager::GatherViewpoints(TArray<FVector>& OutViewpoints) const
+{
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* Controller = It->Get();
+        if (Controller && Controller->IsLocalController())
+        {
+            FVector Location;
+            FRotator Rotation;
+            Controller->GetPlayerViewPoint(Location, Rotation);
+            OutViewpoints.Add(Location);
+        }
+    }
+}
+
+ESESignificance USESignificanceManager::Score(const ASECharacterBase& Character, const TArray<FVector>& Viewpoints) const
+{
+    float DistanceSq = MAX_flt;
+    for (const FVector& Viewpoint : Viewpoints)
+    {
+        DistanceSq = FMath::Min(DistanceSq, FVector::DistSquared(Viewpoint, Character.GetActorLocation()));
+    }
+
+    const UCombatComponent* Combat = Character.GetCombatComponent();
+    return Classify(Character.IsPlayerControlled(), Combat && Combat->IsInCombat(), Character.WasRecentlyRendered(0.5f), Viewpoints.Num() > 0, DistanceSq);
+}
+
+ESESignificance USESignificanceManager::Classify(bool bPlayerControlled, bool bInCombat, bool bVisible, bool bHasViewpoint, float DistanceSq)
+{
+    using namespace SESignificance;
+
+    if (bPlayerControlled)
+    {
+        return ESESignificance::High;
+    }
+
+    // No viewpoint (dedicated server): fights at full rate, everyone else at a moderate rate
+    if (!bHasViewpoint)
+    {
+        return bInCombat ? ESESignificance::High : ESESignificance::Medium;
+    }
+
+    if ((bInCombat && DistanceSq < CombatHighDistanceSq) || (bVisible && DistanceSq < HighDistanceSq))
+    {
+        return ESESignificance::High;
+    }
+    if ((bInCombat && DistanceSq < CombatMediumDistanceSq) || (bVisible && DistanceSq < MediumDistanceSq))
+    {
+        return ESESignificance::Medium;
+    }
+    if (bInCombat || bVisible || DistanceSq < LowDistanceSq)
+    {
+        return ESESignificance::Low;
+    }
+    return ESESignificance::Dormant;
+}
+
+void USESignificanceManager::ApplyTier(FEntry& Entry, ESESignificance NewTier)
+{
+    if (Entry.Tier == NewTier)
+    {
+        return;
+    }
+
+    ASECharacterBase* Character = Entry.Character.Get();
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    if (Entry.Tier == ESESignificance::Dormant)
+    {
+        // Disabled ticks restart with a fresh delta, so hand over the slept time explicitly
+        Character->ApplySignificanceTickRate(GetTickInterval(NewTier), true);
+        Character->CatchUpSkippedTime(static_cast<float>(Now - Entry.DormantSince));
+    }
+    else if (NewTier == ESESignificance::Dormant)
+    {
+        Entry.DormantSince = Now;
+        Character->ApplySignificanceTickRate(0.0f, false);
+    }
+    else
+    {
+        Character->ApplySignificanceTickRate(GetTickInterval(NewTier), true);
+    }
+
+    --TierCounts[static_cast<int32>(Entry.Tier)];
+    ++TierCounts[static_cast<int32>(NewTier)];
+    Entry.Tier = NewTier;
+}
+
+void USESignificanceManager::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Entries.Num() > 0)
+    {
+        TArray<FVector> Viewpoints;
+        GatherViewpoints(Viewpoints);
+
+        // Round-robin slice keeps scoring cost flat as the population grows
+        const int32 NumToScore = FMath::Min(ScoresPerFrame, Entries.Num());
+        for (int32 Scored = 0; Scored < NumToScore && Entries.Num() > 0; ++Scored)
+        {
+            NextToScore = NextToScore % Entries.Num();
+            FEntry& Entry = Entries[NextToScore];
+
+            if (!Entry.Character.IsValid())
+            {
+                RemoveEntryAt(NextToScore);
+                continue;
+            }
+
+            ApplyTier(Entry, Score(*Entry.Character, Viewpoints));
+            ++NextToScore;
+        }
+    }
+
+    if (CVarSignificanceDebug.GetValueOnGameThread() != 0)
+    {
+        DrawDebugOverlay();
+    }
+}
+
+void USESignificanceManager::DrawDebugOverlay() const
+{
+    if (!GEngine)
+    {
+        return;
+    }
+
+    GEngine->AddOnScreenDebugMessage(SESignificance::DebugMessageKey, 0.0f, FColor::Cyan, FString::Printf(
+        TEXT("Significance: %d characters | every frame %d | 20 Hz %d | 5 Hz %d | dormant %d"),
+        Entries.Num(),
+        GetTierCount(ESESignificance::High),
+        GetTierCount(ESESignificance::Medium),
+        GetTierCount(ESESignificance::Low),
+        GetTierCount(ESESignificance::Dormant)));
+}
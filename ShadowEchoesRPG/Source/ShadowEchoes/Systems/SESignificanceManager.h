@@ -0,0 +1,93 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SESignificanceManager.generated.h"
+
+class ASECharacterBase;
+
+/** Update rate tier of a character */
+UENUM(BlueprintType)
+enum class ESESignificance : uint8
+{
+    High        UMETA(DisplayName = "High (every frame)"),
+    Medium      UMETA(DisplayName = "Medium (20 Hz)"),
+    Low         UMETA(DisplayName = "Low (5 Hz)"),
+    Dormant     UMETA(DisplayName = "Dormant"),
+    Num         UMETA(Hidden)
+};
+
+/**
+ * Throttles character ticking by significance
+ *
+ * Characters are scored by distance to the nearest local viewpoint, whether they were
+ * rendered recently and whether they are in combat, a slice per frame. Without a viewpoint
+ * (dedicated server) fights stay at full rate and everyone else is moderate. Their actor tick
+ * and timeline, combat and ability components run at the tier's interval; the engine hands
+ * interval ticks the full time since the last one, so timers stay correct. Dormant characters
+ * stop ticking and are caught up with the slept time when they wake. Spatial grid cells follow
+ * movement, not ticks, so they stay current in every tier. se.Significance.Debug shows the
+ * tier counts on screen.
+ */
+UCLASS()
+class SHADOWECHOES_API USESignificanceManager : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    USESignificanceManager();
+
+    static USESignificanceManager* Get(const UObject* WorldContextObject);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void Deinitialize() override;
+
+    void Register(ASECharacterBase* Character);
+    void Unregister(ASECharacterBase* Character);
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Significance")
+    ESESignificance GetSignificance(const ASECharacterBase* Character) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Significance")
+    int32 GetTierCount(ESESignificance Tier) const { return TierCounts[static_cast<int32>(Tier)]; }
+
+    /** Tick interval of a tier in seconds; 0 is every frame, and dormant does not tick at all */
+    static float GetTickInterval(ESESignificance Tier);
+
+    /**
+     * Tier for one character; NearestViewpointDistSq is ignored without a viewpoint
+     * Player-controlled characters are always High.
+     */
+    static ESESignificance Classify(bool bPlayerControlled, bool bInCombat, bool bVisible, bool bHasViewpoint, float NearestViewpointDistSq);
+
+    /** Characters re-scored per frame */
+    static constexpr int32 ScoresPerFrame = 64;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<ASECharacterBase> Character;
+        ESESignificance Tier = ESESignificance::High;
+
+        /** World time the character went dormant */
+        double DormantSince = 0.0;
+    };
+
+    ESESignificance Score(const ASECharacterBase& Character, const TArray<FVector>& Viewpoints) const;
+    void ApplyTier(FEntry& Entry, ESESignificance NewTier);
+    void GatherViewpoints(TArray<FVector>& OutViewpoints) const;
+    void DrawDebugOverlay() const;
+
+    void RemoveEntryAt(int32 Index);
+
+    TArray<FEntry> Entries;
+
+    /** Position of each character in Entries */
+    TMap<TWeakObjectPtr<ASECharacterBase>, int32> EntryIndices;
+
+    int32 NextToScore;
+    int32 TierCounts[static_cast<int32>(ESESignificance::Num)];
+};
@@ -0,0 +1,67 @@
+#include "World/SEAreaGraph.h"
+#include "World/SEWorldManager.h"
+#include "Core/SEProgression.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEAreaGraphTest, "ShadowEchoes.World.AreaGraph", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEAreaGraphTest::RunTest(const FString& Parameters)
+{
+    FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+
+    // Start - A - B - C, and a side branch A - D
+    const FName Start(TEXT("Test_AreaGraph_Start"));
+    const FName A(TEXT("Test_AreaGraph_A"));
+    const FName B(TEXT("Test_AreaGraph_B"));
+    const FName C(TEXT("Test_AreaGraph_C"));
+    const FName D(TEXT("Test_AreaGraph_D"));
+
+    TMap<FName, FWorldArea> Areas;
+    auto AddArea = [&Areas](FName AreaID, TArray<FName> Connected)
+    {
+        FWorldArea& Area = Areas.Add(AreaID);
+        Area.AreaID = AreaID;
+        Area.ConnectedAreas = MoveTemp(Connected);
+    };
+    AddArea(Start, { A });
+    AddArea(A, { Start, B, D });
+    AddArea(B, { A, C });
+    AddArea(C, { B });
+    AddArea(D, { A });
+
+    FSEAreaGraph Graph;
+    Graph.Build(Areas);
+
+    auto Index = [&Registry](FName AreaID) { return Registry.Find(ESEProgressionDomain::Area, AreaID); };
+
+    TestTrue(TEXT("Edge Start->A"), Graph.HasEdge(Index(Start), Index(A)));
+    TestFalse(TEXT("No edge Start->B"), Graph.HasEdge(Index(Start), Index(B)));
+
+    // Only the start is unlocked
+    FSEProgressionState Progression;
+    Progression.Set(ESEProgressionDomain::Area, Index(Start));
+    const TBitArray<>& Unlocked = Progression.GetBits(ESEProgressionDomain::Area);
+    Graph.ResetReachability(Index(Start), Unlocked);
+
+    TestTrue(TEXT("Start reachable"), Graph.IsReachable(Index(Start)));
+    TestTrue(TEXT("A revealed"), Graph.IsFrontier(Index(A)));
+    TestFalse(TEXT("B hidden"), Graph.IsFrontier(Index(B)));
+
+    // Route may end in a locked area but not pass through one
+    TArray<int32> Route;
+    TestTrue(TEXT("Route to locked neighbor"), Graph.FindRoute(Index(Start), Index(A), Unlocked, Route));
+    TestFalse(TEXT("No route through locked area"), Graph.FindRoute(Index(Start), Index(C), Unlocked, Route));
+
+    // Unlocking grows reachability incrementally and invalidates routes
+    Progression.Set(ESEProgressionDomain::Area, Index(A));
+    Graph.OnAreaUnlocked(Index(A), Progression.GetBits(ESEProgressionDomain::Area));
+    Progression.Set(ESEProgressionDomain::Area, Index(B));
+    Graph.OnAreaUnlocked(Index(B), Progression.GetBits(ESEProgressionDomain::Area));
+
+    TestTrue(TEXT("B reachable"), Graph.IsReachable(Index(B)));
+    TestTrue(TEXT("C and D revealed"), Graph.IsFrontier(Index(C)) && Graph.IsFrontier(Index(D)));
+    TestTrue(TEXT("Route to C"), Graph.FindRoute(Index(Start), Index(C), Progression.GetBits(ESEProgressionDomain::Area), Route));
+    TestEqual(TEXT("Route length"), Route.Num(), 4);
+    TestEqual(TEXT("Hop distance"), Graph.GetHopDistance(Index(Start), Index(D), Progression.GetBits(ESEProgressionDomain::Area)), 2);
+
+    return true;
+}
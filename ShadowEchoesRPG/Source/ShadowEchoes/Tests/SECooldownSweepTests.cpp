@@ -0,0 +1,33 @@
+#include "UI/Widgets/AbilitySlotWidget.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSECooldownSweepClockTest, "ShadowEchoes.UI.CooldownSweepClock", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSECooldownSweepClockTest::RunTest(const FString& Parameters)
+{
+    // A 10 s cooldown started at world time 100, while the UI clock reads 5000
+    const float StartTime = 100.0f;
+    const float Duration = 10.0f;
+    FSECooldownSweepClock Clock;
+    Clock.Rebase(5000.0f, StartTime, 1.0f);
+    TestEqual(TEXT("Just started"), Clock.GetRemaining(5000.0f, StartTime, Duration), 1.0f);
+    TestEqual(TEXT("Half way at normal speed"), Clock.GetRemaining(5005.0f, StartTime, Duration), 0.5f, 1e-4f);
+
+    // Pause two seconds in: the UI clock keeps running, the sweep does not
+    Clock.Rebase(5002.0f, 102.0f, 0.0f);
+    TestEqual(TEXT("Frozen while paused"), Clock.GetRemaining(5030.0f, StartTime, Duration), 0.8f, 1e-4f);
+
+    // Resume at half speed after 30 UI seconds of pause
+    Clock.Rebase(5032.0f, 102.0f, 0.5f);
+    TestEqual(TEXT("No jump on resume"), Clock.GetRemaining(5032.0f, StartTime, Duration), 0.8f, 1e-4f);
+    TestEqual(TEXT("Dilated progress"), Clock.GetRemaining(5036.0f, StartTime, Duration), 0.6f, 1e-4f);
+
+    // Ready exactly when the world clock reaches the end, never below zero
+    TestEqual(TEXT("Ready at world expiry"), Clock.GetRemaining(5048.0f, StartTime, Duration), 0.0f, 1e-4f);
+    TestEqual(TEXT("Clamped after expiry"), Clock.GetRemaining(5100.0f, StartTime, Duration), 0.0f);
+
+    // A zero duration reads as no cooldown, and no world reads as paused
+    TestEqual(TEXT("No duration"), Clock.GetRemaining(5000.0f, StartTime, 0.0f), 0.0f);
+    TestEqual(TEXT("No world"), FSECooldownSweepClock::GetWorldRate(nullptr), 0.0f);
+
+    return true;
+}
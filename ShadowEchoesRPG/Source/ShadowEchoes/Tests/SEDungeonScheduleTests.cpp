@@ -0,0 +1,114 @@
+#include "Systems/SEDungeonSchedule.h"
+#include "Misc/AutomationTest.h"
+
+namespace SEDungeonScheduleTests
+{
+    static FSEDungeonScheduleSettings MakeSettings(int32 Seed)
+    {
+        FSEDungeonScheduleSettings Settings;
+        Settings.Duration = 600.0f;
+        Settings.FluxInterval = 30.0f;
+        Settings.TearInterval = 10.0f;
+        Settings.TearLifetime = 25.0f;
+        Settings.MaxRealityTears = 2;
+        Settings.NumTearSpawnPoints = 6;
+        Settings.Seed = Seed;
+        return Settings;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEDungeonScheduleTest, "ShadowEchoes.Dungeon.Schedule", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEDungeonScheduleTest::RunTest(const FString& Parameters)
+{
+    const FSEDungeonScheduleSettings Settings = SEDungeonScheduleTests::MakeSettings(50);
+    const FSEDungeonSchedule Schedule = FSEDungeonSchedule::Build(Settings);
+
+    // One flux per interval inside the duration, in time order
+    TestEqual(TEXT("Flux count"), Schedule.Flux.Num(), 19);
+    bool bSorted = true;
+    for (int32 Index = 1; Index < Schedule.Flux.Num(); ++Index)
+    {
+        bSorted &= Schedule.Flux[Index - 1].Time < Schedule.Flux[Index].Time;
+    }
+    TestTrue(TEXT("Fluxes sorted"), bSorted);
+    TestTrue(TEXT("Fluxes inside the run"), Schedule.Flux[0].Time > 0.0f && Schedule.Flux.Last().Time < Settings.Duration);
+
+    // Never more tears open at once than allowed, and every spawn point valid
+    bool bWithinCap = true;
+    bool bValidSpawns = true;
+    for (int32 Index = 0; Index < Schedule.Tears.Num(); ++Index)
+    {
+        int32 NumOpen = 0;
+        for (int32 Other = 0; Other <= Index; ++Other)
+        {
+            NumOpen += Schedule.Tears[Other].Time > Schedule.Tears[Index].Time - Settings.TearLifetime ? 1 : 0;
+        }
+        bWithinCap &= NumOpen <= Settings.MaxRealityTears;
+        bValidSpawns &= Schedule.Tears[Index].SpawnPoint >= 0 && Schedule.Tears[Index].SpawnPoint < Settings.NumTearSpawnPoints;
+    }
+    TestTrue(TEXT("Open tears capped"), bWithinCap);
+    TestTrue(TEXT("Spawn points valid"), bValidSpawns);
+    TestTrue(TEXT("Some beats skipped by the cap"), Schedule.Tears.Num() > 0 && Schedule.Tears.Num() < 59);
+
+    // Same seed, same schedule; another week, another schedule
+    const FSEDungeonSchedule Again = FSEDungeonSchedule::Build(Settings);
+    TestEqual(TEXT("Deterministic flux"), Again.Flux.Num(), Schedule.Flux.Num());
+    TestEqual(TEXT("Deterministic first flux"), Again.Flux[0].Time, Schedule.Flux[0].Time);
+    TestEqual(TEXT("Deterministic tears"), Again.Tears.Num(), Schedule.Tears.Num());
+    const FSEDungeonSchedule OtherWeek = FSEDungeonSchedule::Build(SEDungeonScheduleTests::MakeSettings(51));
+    TestNotEqual(TEXT("Seed matters"), OtherWeek.Flux[0].Time, Schedule.Flux[0].Time);
+
+    // Weekly modifiers: storms double the fluxes, fractures allow more tears
+    FSEDungeonScheduleSettings Modified = Settings;
+    const FName Modifiers[] = { TEXT("Timeline_Storm"), TEXT("Reality_Fracture"), TEXT("Unknown") };
+    Modified.ApplyWeeklyModifiers(Modifiers);
+    TestEqual(TEXT("Storm halves the flux interval"), Modified.FluxInterval, 15.0f);
+    TestEqual(TEXT("Fracture doubles the tear cap"), Modified.MaxRealityTears, 4);
+    const FSEDungeonSchedule Stormy = FSEDungeonSchedule::Build(Modified);
+    TestEqual(TEXT("Stormy flux count"), Stormy.Flux.Num(), 39);
+    TestTrue(TEXT("More tears"), Stormy.Tears.Num() > Schedule.Tears.Num());
+
+    // No spawn points, no tears
+    FSEDungeonScheduleSettings NoTears = Settings;
+    NoTears.NumTearSpawnPoints = 0;
+    TestEqual(TEXT("No spawn points"), FSEDungeonSchedule::Build(NoTears).Tears.Num(), 0);
+
+    // Seeds are pinned: every server builds the week's schedule from the same one
+    const int64 WeeklyReset = 1700524800;
+    TestEqual(TEXT("Seed pinned"), FSEDungeonScheduleSettings::MakeSeed(TEXT("Dungeon_VoidBetween"), WeeklyReset), -193086198);
+    TestEqual(TEXT("Seed ignores name case"), FSEDungeonScheduleSettings::MakeSeed(TEXT("dungeon_voidbetween"), WeeklyReset), -193086198);
+    TestNotEqual(TEXT("Seed changes each week"), FSEDungeonScheduleSettings::MakeSeed(TEXT("Dungeon_VoidBetween"), WeeklyReset + 7 * 86400), -193086198);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEDungeonScheduleBenchmark, "ShadowEchoes.Dungeon.ScheduleBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSEDungeonScheduleBenchmark::RunTest(const FString& Parameters)
+{
+    // Hour-long storm runs with fast tears: the worst case a preparation builds off the game thread
+    const int32 NumSchedules = 10000;
+    FSEDungeonScheduleSettings Settings = SEDungeonScheduleTests::MakeSettings(0);
+    Settings.Duration = 3600.0f;
+    Settings.TearInterval = 2.0f;
+    Settings.MaxRealityTears = 8;
+    const FName Modifiers[] = { TEXT("Timeline_Storm"), TEXT("Reality_Fracture") };
+    Settings.ApplyWeeklyModifiers(Modifiers);
+
+    int64 NumEvents = 0;
+    SIZE_T Bytes = 0;
+    const double Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumSchedules; ++Index)
+    {
+        Settings.Seed = Index;
+        const FSEDungeonSchedule Schedule = FSEDungeonSchedule::Build(Settings);
+        NumEvents += Schedule.Flux.Num() + Schedule.Tears.Num();
+        Bytes = FMath::Max(Bytes, Schedule.GetAllocatedSize());
+    }
+    const double Seconds = FPlatformTime::Seconds() - Start;
+
+    TestTrue(TEXT("Events scheduled"), NumEvents > 0);
+
+    AddInfo(FString::Printf(TEXT("%d schedules, %lld events in %.1f ms (%.1f us/schedule, %.0f events each, %.1f KB)"),
+        NumSchedules, NumEvents, Seconds * 1000.0, Seconds * 1e6 / NumSchedules, double(NumEvents) / NumSchedules, Bytes / 1024.0));
+    return true;
+}
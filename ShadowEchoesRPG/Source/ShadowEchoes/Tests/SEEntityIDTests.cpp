@@ -0,0 +1,200 @@
+#include "Core/SEEntityID.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEEntityIDTest, "ShadowEchoes.Core.EntityID", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEEntityIDTest::RunTest(const FString& Parameters)
+{
+    const FString Name(TEXT("Test_Player_7E2A"));
+    const FSEEntityID Player = FSEEntityID::Intern(Name);
+
+    TestTrue(TEXT("Interned ID is valid"), Player.IsValid());
+    TestEqual(TEXT("Interning is idempotent"), FSEEntityID::Intern(Name), Player);
+    TestEqual(TEXT("Find returns the interned ID"), FSEEntityID::Find(Name), Player);
+    TestEqual(TEXT("String form round trips"), Player.ToString(), Name);
+    TestFalse(TEXT("Unknown names are not interned by Find"), FSEEntityID::Find(TEXT("Test_Never_Interned")).IsValid());
+    TestFalse(TEXT("Empty name is the invalid ID"), FSEEntityID::Intern(FString()).IsValid());
+    TestTrue(TEXT("Invalid ID has an empty string form"), FSEEntityID().ToString().IsEmpty());
+
+    const FSEEntityID Fresh = FSEEntityID::NewID();
+    TestNotEqual(TEXT("New IDs are unique"), Fresh, FSEEntityID::NewID());
+
+    // Archives carry the string form, not the process-local handle
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    FSEEntityID Written = Player;
+    Writer << Written;
+
+    FString Stored;
+    FMemoryReader StringReader(Bytes);
+    StringReader << Stored;
+    TestEqual(TEXT("Archived as its name"), Stored, Name);
+
+    FSEEntityID Loaded;
+    FMemoryReader Reader(Bytes);
+    Reader << Loaded;
+    TestEqual(TEXT("Loads back to the same ID"), Loaded, Player);
+
+    // Text import stops at the enclosing delimiter
+    FSEEntityID Imported;
+    const FString Text = Name + TEXT(",Next");
+    const TCHAR* Buffer = *Text;
+    Imported.ImportTextItem(Buffer, PPF_None, nullptr, nullptr);
+    TestEqual(TEXT("Imported from text"), Imported, Player);
+    TestEqual(TEXT("Import stopped at delimiter"), *Buffer, TEXT(','));
+
+    // Any other character is allowed, and names with delimiters round trip quoted
+    const FSEEntityID Dotted = FSEEntityID::Intern(TEXT("guild.Shadow:7"));
+    Buffer = TEXT("guild.Shadow:7)");
+    Imported.ImportTextItem(Buffer, PPF_None, nullptr, nullptr);
+    TestEqual(TEXT("Punctuation imported"), Imported, Dotted);
+
+    const FSEEntityID Spaced = FSEEntityID::Intern(TEXT("Night \"Watch\", East"));
+    FString Exported;
+    Spaced.ExportTextItem(Exported, FSEEntityID(), nullptr, PPF_None, nullptr);
+    Exported += TEXT(",");
+    Buffer = *Exported;
+    TestTrue(TEXT("Quoted import"), Imported.ImportTextItem(Buffer, PPF_None, nullptr, nullptr));
+    TestEqual(TEXT("Quoted name round trips"), Imported, Spaced);
+    TestEqual(TEXT("Quoted import stopped after the quote"), *Buffer, TEXT(','));
+
+    // Replication carries the name too
+    TArray<uint8> NetBytes;
+    FMemoryWriter NetWriter(NetBytes);
+    bool bNetOk = false;
+    Written.NetSerialize(NetWriter, nullptr, bNetOk);
+    FSEEntityID Received;
+    FMemoryReader NetReader(NetBytes);
+    Received.NetSerialize(NetReader, nullptr, bNetOk);
+    TestTrue(TEXT("Net serialized"), bNetOk);
+    TestEqual(TEXT("Received as the same ID"), Received, Player);
+
+    // Released IDs give their slot back; stale copies never match the new name
+    const int32 NumBefore = FSEEntityRegistry::Get().Num();
+    const FSEEntityID Match = FSEEntityID::NewID();
+    const FString MatchName = Match.ToString();
+    const FString HeldName = Match.ToString();
+    FSEEntityID::Release(Match);
+    TestEqual(TEXT("Released name dropped"), FSEEntityRegistry::Get().Num(), NumBefore);
+    TestFalse(TEXT("Released name no longer found"), FSEEntityID::Find(MatchName).IsValid());
+    TestTrue(TEXT("Stale copy reads as empty"), Match.ToString().IsEmpty());
+
+    const FSEEntityID Reused = FSEEntityID::NewID();
+    TestEqual(TEXT("Slot reused"), static_cast<uint32>(Reused.GetValue()), static_cast<uint32>(Match.GetValue()));
+    TestNotEqual(TEXT("Stale copy differs from the reuse"), Match, Reused);
+    TestEqual(TEXT("Names read before release survive the slot's reuse"), HeldName, MatchName);
+    FSEEntityID::Release(Match);
+    TestTrue(TEXT("Releasing twice leaves the reuse alone"), FSEEntityID::Find(Reused.ToString()) == Reused);
+    FSEEntityID::Release(Reused);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEEntityIDBenchmark, "ShadowEchoes.Core.EntityIDBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSEEntityIDBenchmark::RunTest(const FString& Parameters)
+{
+    // 100k players with ratings and 50-member guild rosters, keyed both ways
+    const int32 NumPlayers = 100000;
+    const int32 GuildSize = 50;
+    const int32 NumLookups = 1000000;
+
+    TArray<FString> Names;
+    Names.Reserve(NumPlayers);
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        Names.Add(FGuid::NewGuid().ToString());
+    }
+
+    // String keys: every map key and roster entry owns a copy of the GUID string
+    double StringBuildSeconds = 0.0;
+    TMap<FString, int32> StringRatings;
+    TArray<TArray<FString>> StringRosters;
+    {
+        const double Start = FPlatformTime::Seconds();
+        StringRosters.SetNum(NumPlayers / GuildSize);
+        for (int32 Index = 0; Index < NumPlayers; ++Index)
+        {
+            StringRatings.Add(Names[Index], 1500);
+            StringRosters[Index / GuildSize].Add(Names[Index]);
+        }
+        StringBuildSeconds = FPlatformTime::Seconds() - Start;
+    }
+
+    SIZE_T StringBytes = StringRatings.GetAllocatedSize() + StringRosters.GetAllocatedSize();
+    for (const auto& Pair : StringRatings)
+    {
+        StringBytes += Pair.Key.GetAllocatedSize();
+    }
+    for (const TArray<FString>& Roster : StringRosters)
+    {
+        StringBytes += Roster.GetAllocatedSize();
+        for (const FString& Member : Roster)
+        {
+            StringBytes += Member.GetAllocatedSize();
+        }
+    }
+
+    // Interned IDs: one shared copy of each name in the registry
+    const SIZE_T RegistryBytesBefore = FSEEntityRegistry::Get().GetAllocatedSize();
+    double IDBuildSeconds = 0.0;
+    TArray<FSEEntityID> IDs;
+    TMap<FSEEntityID, int32> IDRatings;
+    TArray<TArray<FSEEntityID>> IDRosters;
+    {
+        const double Start = FPlatformTime::Seconds();
+        IDs.Reserve(NumPlayers);
+        IDRosters.SetNum(NumPlayers / GuildSize);
+        for (int32 Index = 0; Index < NumPlayers; ++Index)
+        {
+            const FSEEntityID ID = FSEEntityID::Intern(Names[Index]);
+            IDs.Add(ID);
+            IDRatings.Add(ID, 1500);
+            IDRosters[Index / GuildSize].Add(ID);
+        }
+        IDBuildSeconds = FPlatformTime::Seconds() - Start;
+    }
+
+    const SIZE_T RegistryBytes = FSEEntityRegistry::Get().GetAllocatedSize() - RegistryBytesBefore;
+    SIZE_T IDBytes = IDRatings.GetAllocatedSize() + IDRosters.GetAllocatedSize() + IDs.GetAllocatedSize();
+    for (const TArray<FSEEntityID>& Roster : IDRosters)
+    {
+        IDBytes += Roster.GetAllocatedSize();
+    }
+
+    // Same pseudo-random access pattern for both
+    FRandomStream Random(41);
+    TArray<int32> Probes;
+    Probes.SetNumUninitialized(NumLookups);
+    for (int32& Probe : Probes)
+    {
+        Probe = Random.RandHelper(NumPlayers);
+    }
+
+    int64 StringSum = 0;
+    const double StringLookupStart = FPlatformTime::Seconds();
+    for (const int32 Probe : Probes)
+    {
+        StringSum += StringRatings.FindChecked(Names[Probe]);
+        StringSum += StringRosters[Probe / GuildSize].Contains(Names[Probe]) ? 1 : 0;
+    }
+    const double StringLookupSeconds = FPlatformTime::Seconds() - StringLookupStart;
+
+    int64 IDSum = 0;
+    const double IDLookupStart = FPlatformTime::Seconds();
+    for (const int32 Probe : Probes)
+    {
+        IDSum += IDRatings.FindChecked(IDs[Probe]);
+        IDSum += IDRosters[Probe / GuildSize].Contains(IDs[Probe]) ? 1 : 0;
+    }
+    const double IDLookupSeconds = FPlatformTime::Seconds() - IDLookupStart;
+
+    TestEqual(TEXT("Both layouts agree"), IDSum, StringSum);
+
+    AddInfo(FString::Printf(TEXT("FString keys: %.1f MB, build %.1f ms, %d lookups+roster checks %.1f ms"),
+        StringBytes / (1024.0 * 1024.0), StringBuildSeconds * 1000.0, NumLookups, StringLookupSeconds * 1000.0));
+    AddInfo(FString::Printf(TEXT("Entity IDs: %.1f MB (+%.1f MB shared registry), build %.1f ms, %d lookups+roster checks %.1f ms"),
+        IDBytes / (1024.0 * 1024.0), RegistryBytes / (1024.0 * 1024.0), IDBuildSeconds * 1000.0, NumLookups, IDLookupSeconds * 1000.0));
+    AddInfo(FString::Printf(TEXT("Lookup speedup: %.1fx"), StringLookupSeconds / FMath::Max(IDLookupSeconds, 1e-9)));
+    return true;
+}
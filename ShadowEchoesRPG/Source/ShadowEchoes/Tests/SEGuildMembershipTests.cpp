@@ -0,0 +1,96 @@
+#include "Guild/SEGuildMembership.h"
+#include "Guild/SEGuildManager.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEGuildMembershipTest, "ShadowEchoes.Guild.Membership", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEGuildMembershipTest::RunTest(const FString& Parameters)
+{
+    FSEGuildMembershipStore Store;
+    const FSEEntityID Guild = FSEEntityID::Intern(TEXT("Test_Guild_A"));
+    const FSEEntityID Other = FSEEntityID::Intern(TEXT("Test_Guild_B"));
+    const FSEEntityID Master = FSEEntityID::Intern(TEXT("Test_Master"));
+    const FSEEntityID Officer = FSEEntityID::Intern(TEXT("Test_Officer"));
+    const FSEEntityID Member = FSEEntityID::Intern(TEXT("Test_Member"));
+
+    TestTrue(TEXT("Founder added"), Store.AddMember(Guild, Master, EGuildRank::GuildMaster));
+    TestTrue(TEXT("Officer added"), Store.AddMember(Guild, Officer, EGuildRank::Officer));
+    TestTrue(TEXT("Member added"), Store.AddMember(Guild, Member, EGuildRank::Member));
+    TestFalse(TEXT("One guild per player"), Store.AddMember(Other, Member, EGuildRank::Member));
+
+    TestEqual(TEXT("Reverse index"), Store.GetGuild(Officer), Guild);
+    TestEqual(TEXT("Member count"), Store.NumMembers(Guild), 3);
+    TestEqual(TEXT("Rank weight"), Store.GetAggregate(Guild)->RankWeight, 4 + 2 + 1);
+
+    // Removing the first row swaps the last one into it; its index entry must follow
+    TestEqual(TEXT("Left the right guild"), Store.RemoveMember(Master), Guild);
+    TestFalse(TEXT("Removed player has no guild"), Store.GetGuild(Master).IsValid());
+    EGuildRank Rank;
+    TestTrue(TEXT("Moved row still indexed"), Store.GetRank(Member, Rank) && Rank == EGuildRank::Member);
+    TestTrue(TEXT("Moved row still writable"), Store.SetRank(Member, EGuildRank::TimelineGuide));
+    TestTrue(TEXT("Rank changed in place"), Store.GetRank(Member, Rank) && Rank == EGuildRank::TimelineGuide);
+    TestEqual(TEXT("Highest ranked"), Store.FindHighestRanked(Guild), Member);
+
+    const FSEGuildMemberAggregate* Aggregate = Store.GetAggregate(Guild);
+    TestEqual(TEXT("Aggregate count"), Aggregate->NumMembers, 2);
+    TestEqual(TEXT("Aggregate weight"), Aggregate->RankWeight, 2 + 3);
+    TestEqual(TEXT("No guild master left"), Aggregate->NumByRank[static_cast<int32>(EGuildRank::GuildMaster)], 0);
+
+    Store.RemoveGuild(Guild);
+    TestFalse(TEXT("Disband clears the index"), Store.GetGuild(Officer).IsValid());
+    TestTrue(TEXT("Free to join again"), Store.AddMember(Other, Officer, EGuildRank::Member));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEGuildMembershipBenchmark, "ShadowEchoes.Guild.MembershipBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSEGuildMembershipBenchmark::RunTest(const FString& Parameters)
+{
+    // 20k guilds of 60 members, then heavy churn and lookups
+    const int32 NumGuilds = 20000;
+    const int32 GuildSize = 60;
+    const int32 NumPlayers = NumGuilds * GuildSize;
+    const int32 NumOps = 1000000;
+
+    TArray<FSEEntityID> Guilds;
+    TArray<FSEEntityID> Players;
+    Guilds.Reserve(NumGuilds);
+    Players.Reserve(NumPlayers);
+    for (int32 Index = 0; Index < NumGuilds; ++Index)
+    {
+        Guilds.Add(FSEEntityID::Intern(FString::Printf(TEXT("Bench_Guild_%d"), Index)));
+    }
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        Players.Add(FSEEntityID::Intern(FString::Printf(TEXT("Bench_Player_%d"), Index)));
+    }
+
+    FSEGuildMembershipStore Store;
+    double Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        Store.AddMember(Guilds[Index / GuildSize], Players[Index], Index % GuildSize == 0 ? EGuildRank::GuildMaster : EGuildRank::Member);
+    }
+    const double BuildSeconds = FPlatformTime::Seconds() - Start;
+
+    // Each op moves a random player to a random guild and reads another player's guild
+    FRandomStream Random(42);
+    int32 NumFound = 0;
+    Start = FPlatformTime::Seconds();
+    for (int32 Op = 0; Op < NumOps; ++Op)
+    {
+        const FSEEntityID& Player = Players[Random.RandHelper(NumPlayers)];
+        Store.RemoveMember(Player);
+        Store.AddMember(Guilds[Random.RandHelper(NumGuilds)], Player, EGuildRank::Member);
+        NumFound += Store.GetGuild(Players[Random.RandHelper(NumPlayers)]).IsValid() ? 1 : 0;
+    }
+    const double ChurnSeconds = FPlatformTime::Seconds() - Start;
+
+    TestEqual(TEXT("Everyone still in a guild"), NumFound, NumOps);
+    TestEqual(TEXT("Index covers every player"), Store.NumPlayers(), NumPlayers);
+
+    AddInfo(FString::Printf(TEXT("%d guilds, %d players: build %.1f ms, %.1f MB"),
+        NumGuilds, NumPlayers, BuildSeconds * 1000.0, Store.GetAllocatedSize() / (1024.0 * 1024.0)));
+    AddInfo(FString::Printf(TEXT("%d leave+join+lookup ops: %.1f ms (%.0f ns/op)"),
+        NumOps, ChurnSeconds * 1000.0, ChurnSeconds * 1e9 / NumOps));
+    return true;
+}
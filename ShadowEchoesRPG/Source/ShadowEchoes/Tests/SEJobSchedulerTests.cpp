@@ -0,0 +1,84 @@
+#include "Systems/SEJobScheduler.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEJobSchedulerTest, "ShadowEchoes.Systems.JobScheduler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEJobSchedulerTest::RunTest(const FString& Parameters)
+{
+    FSEJobScheduler Scheduler;
+
+    // With no budget each frame runs a single slice, and each slice a single item
+    int32 ScanCursor = 0;
+    int32 ScanPasses = 0;
+    const int32 Scan = Scheduler.AddJob(TEXT("Test.Scan"), 10.0f, ESEJobPriority::Low, [&](const FSEJobBudget& Budget)
+    {
+        while (ScanCursor < 3)
+        {
+            ++ScanCursor;
+            if (ScanCursor < 3 && !Budget.HasTimeLeft())
+            {
+                return false;
+            }
+        }
+        ScanCursor = 0;
+        ++ScanPasses;
+        return true;
+    }, 10.0);
+
+    int32 UrgentRuns = 0;
+    const int32 Urgent = Scheduler.AddJob(TEXT("Test.Urgent"), 5.0f, ESEJobPriority::High, [&](const FSEJobBudget&)
+    {
+        ++UrgentRuns;
+        return true;
+    }, 10.0);
+
+    Scheduler.RunFrame(5.0, 0.0);
+    TestEqual(TEXT("Nothing due early"), UrgentRuns + ScanCursor, 0);
+
+    // Both due: the higher priority job takes the frame
+    Scheduler.RunFrame(10.0, 0.0);
+    TestEqual(TEXT("High priority ran first"), UrgentRuns, 1);
+    TestEqual(TEXT("Low priority waited"), ScanCursor, 0);
+    TestTrue(TEXT("Frame counted as overrun"), Scheduler.GetOverrunFrames() > 0);
+
+    // The scan resumes across frames until its pass is done
+    Scheduler.RunFrame(10.1, 0.0);
+    TestEqual(TEXT("First slice"), ScanCursor, 1);
+    TestTrue(TEXT("Pass in progress"), Scheduler.IsJobRunning(Scan));
+    Scheduler.RunFrame(10.2, 0.0);
+    Scheduler.RunFrame(10.3, 0.0);
+    TestEqual(TEXT("Pass finished"), ScanPasses, 1);
+    TestEqual(TEXT("Spread over three frames"), Scheduler.GetJobStats(Scan)->LastPassFrames, 3);
+    TestEqual(TEXT("On time"), Scheduler.GetJobStats(Scan)->DeadlineMisses, 0);
+
+    // A pass finishing after its period is a deadline miss
+    Scheduler.RemoveJob(Urgent);
+    Scheduler.RunFrame(20.0, 0.0);
+    Scheduler.RunFrame(25.0, 0.0);
+    Scheduler.RunFrame(31.0, 0.0);
+    TestEqual(TEXT("Second pass finished"), ScanPasses, 2);
+    TestEqual(TEXT("Deadline missed"), Scheduler.GetJobStats(Scan)->DeadlineMisses, 1);
+    TestEqual(TEXT("Removed job no longer runs"), UrgentRuns, 1);
+    TestNull(TEXT("Removed job has no stats"), Scheduler.GetJobStats(Urgent));
+
+    // A generous budget finishes the pass in one frame
+    Scheduler.RunFrame(41.0, 1000.0);
+    TestEqual(TEXT("Whole pass in one frame"), Scheduler.GetJobStats(Scan)->LastPassFrames, 1);
+
+    // A high priority job due every frame takes each slice, until a low priority one is overdue
+    FSEJobScheduler Busy;
+    int32 BusyRuns = 0;
+    int32 StarvedRuns = 0;
+    Busy.AddJob(TEXT("Test.Busy"), 1.0f, ESEJobPriority::High, [&](const FSEJobBudget&) { ++BusyRuns; return true; }, 1.0);
+    Busy.AddJob(TEXT("Test.Starved"), 5.0f, ESEJobPriority::Low, [&](const FSEJobBudget&) { ++StarvedRuns; return true; }, 1.0);
+    for (int32 Second = 1; Second <= 6; ++Second)
+    {
+        Busy.RunFrame(Second, 0.0);
+    }
+    TestEqual(TEXT("High priority took every frame"), BusyRuns, 6);
+    TestEqual(TEXT("Low priority waited until its deadline"), StarvedRuns, 0);
+    Busy.RunFrame(7.0, 0.0);
+    TestEqual(TEXT("Overdue low priority job ran"), StarvedRuns, 1);
+    TestEqual(TEXT("Ahead of the high priority job"), BusyRuns, 6);
+
+    return true;
+}
@@ -0,0 +1,181 @@
+#include "Core/SELockoutStore.h"
+#include "SaveGame/SESaveFormat.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSELockoutStoreTest, "ShadowEchoes.Core.LockoutStore", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSELockoutStoreTest::RunTest(const FString& Parameters)
+{
+    const FSEEntityID Tank = FSEEntityID::Intern(TEXT("Test_Lockout_Tank"));
+    const FSEEntityID Healer = FSEEntityID::Intern(TEXT("Test_Lockout_Healer"));
+    const FSEEntityID Rogue = FSEEntityID::Intern(TEXT("Test_Lockout_Rogue"));
+    const FName Raid(TEXT("Raid.Test"));
+    const FName Invasion(TEXT("Invasion"));
+    const int64 Start = 1700000000;
+    const int64 Week = 7 * 24 * 3600;
+
+    FSELockoutStore Store;
+    Store.Purge(Start);
+
+    // Raid lockouts for a party, an invasion cooldown for one of them
+    const FSEEntityID Party[] = { Tank, Healer };
+    Store.Add(Party, Raid, Start + Week);
+    Store.Add(Rogue, Invasion, Start + 300);
+    TestTrue(TEXT("Party member locked"), Store.IsLockedOut(Healer, Raid, Start));
+    TestFalse(TEXT("Content is part of the key"), Store.IsLockedOut(Rogue, Raid, Start));
+    TestEqual(TEXT("Expiry"), Store.GetExpiry(Tank, Raid, Start), Start + Week);
+
+    const FSEEntityID Group[] = { Rogue, Healer, Tank };
+    TArray<FSEEntityID> Locked;
+    TestEqual(TEXT("Batch query"), Store.FindLockedOut(Group, Raid, Start, Locked), 2);
+    TestTrue(TEXT("Batch any"), Store.IsAnyLockedOut(Group, Raid, Start));
+
+    // Expired entries read as absent before they are purged, then the sweep drops them
+    TestFalse(TEXT("Cooldown over"), Store.IsLockedOut(Rogue, Invasion, Start + 300));
+    TestEqual(TEXT("Still held until swept"), Store.Num(), 3);
+    TestEqual(TEXT("Sweep removes the cooldown"), Store.Purge(Start + 600), 1);
+    TestEqual(TEXT("Lockouts beyond one turn stay"), Store.Num(), 2);
+
+    // A week spans many turns of the wheel; each turn keeps the entry until its own
+    int64 Time = Start + 600;
+    int32 NumRemoved = 0;
+    while (Time < Start + Week)
+    {
+        Time += 3600;
+        NumRemoved += Store.Purge(Time);
+        if (Time < Start + Week)
+        {
+            TestEqual(TEXT("Kept until expiry"), NumRemoved, 0);
+        }
+    }
+    TestEqual(TEXT("Both raid lockouts expire on their turn"), NumRemoved, 2);
+    TestEqual(TEXT("Empty"), Store.Num(), 0);
+
+    // Extending an expiry moves the entry; the old wheel slot is dropped on sweep
+    Store.Add(Tank, Invasion, Time + 120);
+    Store.Add(Tank, Invasion, Time + 7200);
+    TestEqual(TEXT("Extension survives the old slot"), Store.Purge(Time + 600), 0);
+    TestTrue(TEXT("Extended"), Store.IsLockedOut(Tank, Invasion, Time + 600));
+    TestTrue(TEXT("Removed by hand"), Store.Remove(Tank, Invasion));
+    TestEqual(TEXT("Nothing left to sweep"), Store.Purge(Time + 8000), 0);
+    Time += 8000;
+
+    // Round trip through the save section; expired records are dropped on import
+    FSESaveSnapshot Snapshot;
+    Store.Add(Party, Raid, Time + Week);
+    Store.Add(Rogue, Invasion, Time + 60);
+    Store.Export(Snapshot.Lockouts, Time);
+    TestEqual(TEXT("Exported"), Snapshot.Lockouts.Num(), 3);
+
+    TArray<uint8> Bytes;
+    FSESaveStats Stats;
+    TestTrue(TEXT("Save encodes"), FSESaveFormat::Write(Snapshot, Bytes, Stats));
+    FSESaveSnapshot Loaded;
+    TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SlotReader = FSESaveSlotReader::Open(MoveTemp(Bytes));
+    TestTrue(TEXT("Lockouts decode"), SlotReader.IsValid() && SlotReader->LoadSections(SESaveSections::Bit(ESESaveSection::Lockouts), Loaded));
+    TestEqual(TEXT("Records loaded"), Loaded.Lockouts.Num(), 3);
+
+    FSELockoutStore Restored;
+    Restored.Import(Loaded.Lockouts, Time + 120);
+    TestEqual(TEXT("Expired record dropped"), Restored.Num(), 2);
+    TestEqual(TEXT("Expiry survives"), Restored.GetExpiry(Healer, Raid, Time + 120), Time + Week);
+
+    // Weekly reset: Monday 2024-01-01 noon to Tuesday 15:00, and Tuesday evening to the next week
+    const int64 Monday = FDateTime(2024, 1, 1, 12).ToUnixTimestamp();
+    TestEqual(TEXT("Reset later this week"), FSELockoutStore::GetNextWeeklyReset(Monday, EDayOfWeek::Tuesday, 15), FDateTime(2024, 1, 2, 15).ToUnixTimestamp());
+    const int64 TuesdayEvening = FDateTime(2024, 1, 2, 18).ToUnixTimestamp();
+    TestEqual(TEXT("Reset next week"), FSELockoutStore::GetNextWeeklyReset(TuesdayEvening, EDayOfWeek::Tuesday, 15), FDateTime(2024, 1, 9, 15).ToUnixTimestamp());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSELockoutStoreBenchmark, "ShadowEchoes.Core.LockoutStoreBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSELockoutStoreBenchmark::RunTest(const FString& Parameters)
+{
+    // 200k players, each locked out of a few of 50 raids and on invasion cooldown, then a
+    // simulated day of 40-player party checks with new lockouts and lazy purging
+    const int32 NumPlayers = 200000;
+    const int32 NumRaids = 50;
+    const int32 LockoutsPerPlayer = 4;
+    const int32 PartySize = 40;
+    const int32 NumChecks = 200000;
+    const int64 Start = 1700000000;
+    const int64 Day = 24 * 3600;
+    const int32 Week = 7 * 24 * 3600;
+
+    TArray<FSEEntityID> Players;
+    Players.Reserve(NumPlayers);
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        Players.Add(FSEEntityID::Intern(FString::Printf(TEXT("Bench_Lockout_%d"), Index)));
+    }
+
+    TArray<FName> Raids;
+    for (int32 Index = 0; Index < NumRaids; ++Index)
+    {
+        Raids.Add(FName(*FString::Printf(TEXT("Raid.Bench_%d"), Index)));
+    }
+    const FName Invasion(TEXT("Invasion"));
+
+    FRandomStream Random(49);
+    FSELockoutStore Store;
+    Store.Purge(Start);
+
+    double Begin = FPlatformTime::Seconds();
+    for (const FSEEntityID& Player : Players)
+    {
+        for (int32 Lockout = 0; Lockout < LockoutsPerPlayer; ++Lockout)
+        {
+            Store.Add(Player, Raids[Random.RandHelper(NumRaids)], Start + Random.RandRange(60, Week));
+        }
+        Store.Add(Player, Invasion, Start + Random.RandRange(1, 300));
+    }
+    const double BuildSeconds = FPlatformTime::Seconds() - Begin;
+    const int32 NumBuilt = Store.Num();
+    const SIZE_T BuiltBytes = Store.GetAllocatedSize();
+
+    // Each check is a party of 40 against one raid; a clean party gets locked out
+    TArray<FSEEntityID> Party;
+    TArray<FSEEntityID> Locked;
+    int64 NumBlocked = 0;
+    int64 NumPurged = 0;
+    double PurgeSeconds = 0.0;
+    Begin = FPlatformTime::Seconds();
+    for (int32 Check = 0; Check < NumChecks; ++Check)
+    {
+        const int64 Time = Start + Day * Check / NumChecks;
+        if (Check % 1000 == 0)
+        {
+            const double PurgeBegin = FPlatformTime::Seconds();
+            NumPurged += Store.Purge(Time);
+            PurgeSeconds += FPlatformTime::Seconds() - PurgeBegin;
+        }
+
+        Party.Reset();
+        for (int32 Member = 0; Member < PartySize; ++Member)
+        {
+            Party.Add(Players[Random.RandHelper(NumPlayers)]);
+        }
+
+        const FName Raid = Raids[Random.RandHelper(NumRaids)];
+        Locked.Reset();
+        if (Store.FindLockedOut(Party, Raid, Time, Locked) > 0)
+        {
+            ++NumBlocked;
+        }
+        else
+        {
+            Store.Add(Party, Raid, Time + Week);
+        }
+    }
+    const double CheckSeconds = FPlatformTime::Seconds() - Begin;
+
+    TestTrue(TEXT("Invasion cooldowns purged"), NumPurged >= NumPlayers);
+
+    AddInfo(FString::Printf(TEXT("%d lockouts: build %.1f ms (%.0f ns/add), %.1f MB"),
+        NumBuilt, BuildSeconds * 1000.0, BuildSeconds * 1e9 / NumBuilt, BuiltBytes / (1024.0 * 1024.0)));
+    AddInfo(FString::Printf(TEXT("%d party checks of %d: %.1f ms (%.0f ns/player), %lld blocked"),
+        NumChecks, PartySize, CheckSeconds * 1000.0, CheckSeconds * 1e9 / (double(NumChecks) * PartySize), NumBlocked));
+    AddInfo(FString::Printf(TEXT("Lazy purge over one day: %lld removed in %.1f ms, %d left"),
+        NumPurged, PurgeSeconds * 1000.0, Store.Num()));
+    return true;
+}
@@ -0,0 +1,130 @@
+#include "Economy/SEMarketSimulation.h"
+#include "Core/SETypes.h"
+#include "Economy/SETradeManager.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEMarketSimulationTest, "ShadowEchoes.Economy.MarketSimulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEMarketSimulationTest::RunTest(const FString& Parameters)
+{
+    FSEMarketSnapshot Snapshot;
+    Snapshot.MarketVolatility = 0.2f;
+    Snapshot.PriceModifiers.Add(ETradeItemType::Equipment, 1.1f);
+    Snapshot.bHasTimeline = true;
+    Snapshot.CurrentTimeline = ETimelineState::BrightWorld;
+    Snapshot.Seed = 1234;
+
+    for (int32 Index = 0; Index < 1000; ++Index)
+    {
+        FSEMarketListingInput& Listing = Snapshot.Listings.AddDefaulted_GetRef();
+        Listing.ListingID = FSEEntityID::Intern(FString::Printf(TEXT("Listing_%d"), Index));
+        Listing.Type = Index % 2 ? ETradeItemType::Equipment : ETradeItemType::Resource;
+        Listing.PreferredTimeline = Index % 3 ? ETimelineState::Any : ETimelineState::DarkWorld;
+    }
+
+    // 50 supply for 150 demand hits the 2x cap
+    Snapshot.Supply = { 50 };
+    Snapshot.Demand = { 150 };
+    Snapshot.TradeVolatility = 0.7f;
+    Snapshot.bHasTrades = true;
+
+    // The same snapshot steps to the same result, on any thread
+    const FSEMarketStepResult Inline = FSEMarketSimulation::Step(Snapshot);
+    UE::Tasks::TTask<FSEMarketStepResult> Worker = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Snapshot]()
+    {
+        return FSEMarketSimulation::Step(Snapshot);
+    });
+    const FSEMarketStepResult& Threaded = Worker.GetResult();
+
+    TestEqual(TEXT("One modifier per listing"), Inline.ListingModifiers.Num(), Snapshot.Listings.Num());
+    TestTrue(TEXT("Deterministic across threads"), Inline.ListingModifiers == Threaded.ListingModifiers);
+
+    for (const float Modifier : Inline.ListingModifiers)
+    {
+        if (Modifier < 1.0f - Snapshot.MaxPriceFluctuation || Modifier > 1.0f + Snapshot.MaxPriceFluctuation)
+        {
+            AddError(FString::Printf(TEXT("Modifier %f outside fluctuation range"), Modifier));
+            break;
+        }
+    }
+
+    Snapshot.Seed = 4321;
+    TestFalse(TEXT("Seed drives the noise"), FSEMarketSimulation::Step(Snapshot).ListingModifiers == Inline.ListingModifiers);
+
+    TestEqual(TEXT("Scarcity capped"), Inline.PriceModifiers.FindRef(ETradeItemType::Resource), 2.0f);
+    TestEqual(TEXT("Other modifiers carried over"), Inline.PriceModifiers.FindRef(ETradeItemType::Equipment), 1.1f);
+
+    // A tenth of the way toward the traded volatility
+    TestEqual(TEXT("Volatility trends toward trade prices"), Inline.MarketVolatility, 0.25f, 0.0001f);
+
+    // Sold out with demand is scarce, an empty market with no demand is neutral
+    Snapshot.Supply = { 0 };
+    Snapshot.Demand = { 10 };
+    TestEqual(TEXT("Sold out"), FSEMarketSimulation::Step(Snapshot).PriceModifiers.FindRef(ETradeItemType::Resource), 2.0f);
+    Snapshot.Demand = { 0 };
+    TestEqual(TEXT("Empty market neutral"), FSEMarketSimulation::Step(Snapshot).PriceModifiers.FindRef(ETradeItemType::Resource), 1.0f);
+
+    return true;
+}
+
+namespace SEMarketSimulationTests
+{
+    static FMarketItem MakeItem(const TCHAR* ItemID, ETradeItemType Type, int32 Quantity, int32 BasePrice)
+    {
+        FMarketItem Item;
+        Item.ItemID = ItemID;
+        Item.Type = Type;
+        Item.Quantity = Quantity;
+        Item.BasePrice = BasePrice;
+        Item.CurrentPriceModifier = 1.0f;
+        Item.PreferredTimeline = ETimelineState::Any;
+        Item.bIsAuction = false;
+        Item.EndTime = 0;
+        return Item;
+    }
+
+    /** Lists the same book on a deterministic market; returns the resource listings' prices */
+    static TArray<float> RunMarket(int32 Seed, bool bReprice)
+    {
+        USETradeManager* Manager = NewObject<USETradeManager>();
+        Manager->SetDeterministicMarket(Seed);
+
+        const FSEEntityID Seller = FSEEntityID::Intern(TEXT("Test_Seller"));
+        for (int32 Index = 0; Index < 8; ++Index)
+        {
+            Manager->ListItem(Seller, MakeItem(TEXT("Ore"), ETradeItemType::Resource, 10 + Index, 100));
+        }
+
+        if (bReprice)
+        {
+            Manager->BuyItem(FSEEntityID::Intern(TEXT("Test_Buyer")), Manager->GetListedItems(ETradeItemType::Resource)[0].ListingID);
+            Manager->UpdateMarketPrices();
+        }
+
+        TArray<float> Prices;
+        for (const FMarketItem& Item : Manager->GetListedItems(ETradeItemType::Resource))
+        {
+            Prices.Add(Manager->GetCurrentPrice(Item.ListingID));
+        }
+        return Prices;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEDeterministicMarketTest, "ShadowEchoes.Economy.DeterministicMarket", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEDeterministicMarketTest::RunTest(const FString& Parameters)
+{
+    using namespace SEMarketSimulationTests;
+
+    // Each listing is priced from the seed as it is listed
+    const TArray<float> Listed = RunMarket(77, false);
+    TestEqual(TEXT("All listed"), Listed.Num(), 8);
+    TestTrue(TEXT("Listing is repeatable"), Listed == RunMarket(77, false));
+
+    // A pass after a trade reprices the same way for the same seed
+    const TArray<float> Repriced = RunMarket(77, true);
+    TestEqual(TEXT("Bought listing gone"), Repriced.Num(), 7);
+    TestTrue(TEXT("Repricing is repeatable"), Repriced == RunMarket(77, true));
+    TestFalse(TEXT("Seed drives the prices"), Repriced == RunMarket(78, true));
+
+    return true;
+}
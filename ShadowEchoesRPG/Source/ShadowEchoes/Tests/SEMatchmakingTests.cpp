@@ -0,0 +1,158 @@
+#include "PvP/SEMatchmaker.h"
+#include "Core/SETypes.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEMatchmakingTest, "ShadowEchoes.PvP.Matchmaking", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEMatchmakingTest::RunTest(const FString& Parameters)
+{
+    FSEMatchmakingSettings Settings;
+    Settings.BaseWindow = 50.0f;
+    Settings.WindowGrowthPerSecond = 10.0f;
+    Settings.MaxWindow = 400.0f;
+    FSEMatchmaker Matchmaker(Settings);
+
+    const FSEEntityID Low = FSEEntityID::Intern(TEXT("Test_MM_Low"));
+    const FSEEntityID Mid = FSEEntityID::Intern(TEXT("Test_MM_Mid"));
+    const FSEEntityID High = FSEEntityID::Intern(TEXT("Test_MM_High"));
+    const FSEEntityID Ranked = FSEEntityID::Intern(TEXT("Test_MM_Ranked"));
+
+    TestTrue(TEXT("Queued"), Matchmaker.Enqueue(Low, 1000, false, ETimelineState::DarkWorld, 0.0));
+    TestFalse(TEXT("No double queue"), Matchmaker.Enqueue(Low, 1000, false, ETimelineState::DarkWorld, 0.0));
+    TestTrue(TEXT("Queued"), Matchmaker.Enqueue(High, 1200, false, ETimelineState::DarkWorld, 0.0));
+    TestTrue(TEXT("Other partition"), Matchmaker.Enqueue(Ranked, 1010, true, ETimelineState::DarkWorld, 0.0));
+
+    // 200 apart: out of the opening window, and partitions never mix
+    TArray<FSEArenaPairing> Pairings;
+    TestEqual(TEXT("Nothing in window yet"), Matchmaker.FormMatches(0.0, Pairings), 0);
+
+    // A closer player arriving later is preferred over the one across the window
+    TestTrue(TEXT("Queued"), Matchmaker.Enqueue(Mid, 1040, false, ETimelineState::DarkWorld, 5.0));
+    TestEqual(TEXT("Nearest pair formed"), Matchmaker.FormMatches(5.0, Pairings), 1);
+    TestEqual(TEXT("Oldest seeker first"), Pairings[0].Players[0], Low);
+    TestEqual(TEXT("Nearest opponent"), Pairings[0].Players[1], Mid);
+    TestEqual(TEXT("Seeker waited"), Pairings[0].WaitSeconds[0], 5.0f);
+    TestFalse(TEXT("Unranked pairing"), Pairings[0].bRanked);
+    TestEqual(TEXT("Partition timeline"), Pairings[0].Timeline, ETimelineState::DarkWorld);
+    TestFalse(TEXT("Matched players leave the queue"), Matchmaker.IsQueued(Low));
+
+    // Windows widen with time; 30 s later a 200-point gap is acceptable
+    const FSEEntityID Late = FSEEntityID::Intern(TEXT("Test_MM_Late"));
+    Matchmaker.Enqueue(Late, 1400, false, ETimelineState::DarkWorld, 30.0);
+    Pairings.Reset();
+    TestEqual(TEXT("Widened window matches"), Matchmaker.FormMatches(30.0, Pairings), 1);
+    TestEqual(TEXT("Waiting player matched"), Pairings[0].Players[0], High);
+    TestEqual(TEXT("Window capped"), Matchmaker.GetSearchWindow(1000.0), 400.0f);
+
+    TestTrue(TEXT("Leaves queue"), Matchmaker.Remove(Ranked));
+    TestEqual(TEXT("Queue empty"), Matchmaker.Num(), 0);
+    TestEqual(TEXT("Partition empty"), Matchmaker.NumInQueue(true, ETimelineState::DarkWorld), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEMatchmakingSimulation, "ShadowEchoes.PvP.MatchmakingSimulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSEMatchmakingSimulation::RunTest(const FString& Parameters)
+{
+    // 100k synthetic players arriving over 20 minutes, matched on the server's 5 s cadence
+    const int32 NumPlayers = 100000;
+    const double ArrivalSeconds = 1200.0;
+    const double Cadence = 5.0;
+    const double DrainSeconds = 600.0;
+
+    FRandomStream Random(44);
+    struct FSyntheticPlayer
+    {
+        FSEEntityID ID;
+        int32 Rating;
+        double ArrivalTime;
+        bool bRanked;
+        ETimelineState Timeline;
+    };
+
+    // Ratings are roughly normal around 1500; arrivals uniform, processed in time order
+    TArray<FSyntheticPlayer> Players;
+    Players.Reserve(NumPlayers);
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        const float U1 = FMath::Max(Random.GetFraction(), 1e-6f);
+        const float U2 = Random.GetFraction();
+        const float Normal = FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(2.0f * PI * U2);
+
+        FSyntheticPlayer& Player = Players.AddDefaulted_GetRef();
+        Player.ID = FSEEntityID::Intern(FString::Printf(TEXT("Sim_MM_%d"), Index));
+        Player.Rating = FMath::Clamp(FMath::RoundToInt(1500.0f + 300.0f * Normal), 0, 5000);
+        Player.ArrivalTime = Random.GetFraction() * ArrivalSeconds;
+        Player.bRanked = Random.RandHelper(3) == 0;
+        Player.Timeline = static_cast<ETimelineState>(Random.RandHelper(3));
+    }
+    Players.Sort([](const FSyntheticPlayer& A, const FSyntheticPlayer& B) { return A.ArrivalTime < B.ArrivalTime; });
+
+    FSEMatchmaker Matchmaker;
+    TArray<FSEArenaPairing> Pairings;
+    TArray<float> Waits;
+    TArray<int32> Spreads;
+    Waits.Reserve(NumPlayers);
+    Spreads.Reserve(NumPlayers / 2);
+
+    int32 NextArrival = 0;
+    int32 PeakQueue = 0;
+    double FormSeconds = 0.0;
+    double WorstPassSeconds = 0.0;
+    int32 NumPasses = 0;
+
+    for (double Now = Cadence; Now <= ArrivalSeconds + DrainSeconds; Now += Cadence)
+    {
+        while (NextArrival < Players.Num() && Players[NextArrival].ArrivalTime <= Now)
+        {
+            const FSyntheticPlayer& Player = Players[NextArrival++];
+            Matchmaker.Enqueue(Player.ID, Player.Rating, Player.bRanked, Player.Timeline, Player.ArrivalTime);
+        }
+        PeakQueue = FMath::Max(PeakQueue, Matchmaker.Num());
+
+        Pairings.Reset();
+        const double Start = FPlatformTime::Seconds();
+        Matchmaker.FormMatches(Now, Pairings);
+        const double PassSeconds = FPlatformTime::Seconds() - Start;
+        FormSeconds += PassSeconds;
+        WorstPassSeconds = FMath::Max(WorstPassSeconds, PassSeconds);
+        ++NumPasses;
+
+        for (const FSEArenaPairing& Pairing : Pairings)
+        {
+            Waits.Add(Pairing.WaitSeconds[0]);
+            Waits.Add(Pairing.WaitSeconds[1]);
+            Spreads.Add(FMath::Abs(Pairing.Ratings[0] - Pairing.Ratings[1]));
+        }
+
+        if (NextArrival == Players.Num() && Matchmaker.Num() < 2)
+        {
+            break;
+        }
+    }
+
+    TestEqual(TEXT("Every player arrived"), NextArrival, NumPlayers);
+    TestTrue(TEXT("Nearly everyone matched"), Waits.Num() >= NumPlayers * 99 / 100);
+
+    Waits.Sort();
+    Spreads.Sort();
+    auto Percentile = [](const auto& Sorted, double Fraction)
+    {
+        return Sorted.Num() > 0 ? Sorted[FMath::Min(Sorted.Num() - 1, FMath::FloorToInt(Sorted.Num() * Fraction))] : 0;
+    };
+
+    double SpreadSum = 0.0;
+    for (const int32 Spread : Spreads)
+    {
+        SpreadSum += Spread;
+    }
+
+    AddInfo(FString::Printf(TEXT("%d players, %d matched, %d left in queue, peak queue %d"),
+        NumPlayers, Waits.Num(), Matchmaker.Num(), PeakQueue));
+    AddInfo(FString::Printf(TEXT("Time to match: p50 %.1f s, p90 %.1f s, p99 %.1f s, max %.1f s"),
+        Percentile(Waits, 0.5), Percentile(Waits, 0.9), Percentile(Waits, 0.99), Waits.Num() > 0 ? Waits.Last() : 0.0f));
+    AddInfo(FString::Printf(TEXT("Rating spread: mean %.1f, p50 %d, p90 %d, p99 %d, max %d"),
+        Spreads.Num() > 0 ? SpreadSum / Spreads.Num() : 0.0, Percentile(Spreads, 0.5), Percentile(Spreads, 0.9), Percentile(Spreads, 0.99), Spreads.Num() > 0 ? Spreads.Last() : 0));
+    AddInfo(FString::Printf(TEXT("%d passes: %.1f ms total, worst pass %.2f ms"),
+        NumPasses, FormSeconds * 1000.0, WorstPassSeconds * 1000.0));
+    return true;
+}
@@ -0,0 +1,82 @@
+#include "UI/Core/SENotificationPipeline.h"
+#include "Misc/AutomationTest.h"
+
+namespace SENotificationPipelineTests
+{
+    static FSENotificationMessage MakeMessage(const FString& Text, ENotificationType Type = ENotificationType::Default, const FString& ItemID = FString(), int32 Quantity = 0)
+    {
+        FSENotificationMessage Message;
+        Message.Message = Text;
+        Message.Type = Type;
+        Message.ItemID = ItemID;
+        Message.Quantity = Quantity;
+        return Message;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSENotificationPipelineTest, "ShadowEchoes.UI.NotificationPipeline", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSENotificationPipelineTest::RunTest(const FString& Parameters)
+{
+    using namespace SENotificationPipelineTests;
+
+    // A private pipeline, so the HUD's queue and budget are left alone
+    FSENotificationPipeline Pipeline;
+    Pipeline.SetMaxPerSecond(100.0f);
+    double Time = 10.0;
+
+    // Identical messages collapse into one entry with a count
+    for (int32 Index = 0; Index < 5; ++Index)
+    {
+        Pipeline.Push(MakeMessage(TEXT("Quest updated"), ENotificationType::Quest));
+    }
+
+    // Item messages merge per item and sum their quantities
+    Pipeline.Push(MakeMessage(TEXT("Trade completed"), ENotificationType::Default, TEXT("Iron_Ore"), 3));
+    Pipeline.Push(MakeMessage(TEXT("Trade completed"), ENotificationType::Default, TEXT("Iron_Ore"), 4));
+    Pipeline.Push(MakeMessage(TEXT("Trade completed"), ENotificationType::Default, TEXT("Moonstone"), 1));
+    Pipeline.Push(MakeMessage(TEXT("Legend reborn"), ENotificationType::Achievement));
+    Pipeline.Drain();
+    TestEqual(TEXT("Pending after merging"), Pipeline.GetNumPending(), 4);
+    TestEqual(TEXT("Merged count"), Pipeline.GetNumMerged(), 5);
+
+    // Higher priority types pop first, then oldest first within a type
+    FSEPendingNotification Pending;
+    TestTrue(TEXT("Achievement popped"), Pipeline.Pop(Time, Pending));
+    TestEqual(TEXT("Achievement first"), Pending.Notification.Type, ENotificationType::Achievement);
+    TestTrue(TEXT("Quest popped"), Pipeline.Pop(Time, Pending));
+    TestEqual(TEXT("Quest merge suffix"), Pending.GetDisplayText().ToString(), FString(TEXT("Quest updated x5")));
+    TestTrue(TEXT("Trade popped"), Pipeline.Pop(Time, Pending));
+    TestEqual(TEXT("Item carried"), Pending.Notification.ItemID, FString(TEXT("Iron_Ore")));
+    TestEqual(TEXT("Quantities summed"), Pending.Notification.Quantity, 7);
+    TestEqual(TEXT("Item text"), Pending.GetDisplayText().ToString(), FString(TEXT("Trade completed: Iron_Ore x7")));
+    TestTrue(TEXT("Other item popped"), Pipeline.Pop(Time, Pending));
+    TestEqual(TEXT("Other item kept apart"), Pending.Notification.Quantity, 1);
+    TestFalse(TEXT("Empty"), Pipeline.Pop(Time, Pending));
+
+    // The per-second budget holds back a burst and refills over time
+    Pipeline.SetMaxPerSecond(2.0f);
+    Time += 10.0;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        Pipeline.Push(MakeMessage(FString::Printf(TEXT("Burst %d"), Index)));
+    }
+    Pipeline.Drain();
+    TestTrue(TEXT("Budget first"), Pipeline.Pop(Time, Pending));
+    TestTrue(TEXT("Budget second"), Pipeline.Pop(Time, Pending));
+    TestFalse(TEXT("Budget exhausted"), Pipeline.Pop(Time, Pending));
+    TestTrue(TEXT("Budget refilled"), Pipeline.Pop(Time + 0.5, Pending));
+    TestEqual(TEXT("Oldest first"), Pending.Notification.Message, FString(TEXT("Burst 2")));
+
+    // A full ring evicts its oldest entries
+    for (int32 Index = 0; Index < 40; ++Index)
+    {
+        Pipeline.Push(MakeMessage(FString::Printf(TEXT("Flood %d"), Index), ENotificationType::Combat));
+    }
+    Pipeline.Drain();
+    TestEqual(TEXT("Ring capacity"), Pipeline.GetNumPending(), 32);
+    TestEqual(TEXT("Evicted"), Pipeline.GetNumDropped(), 8);
+    TestTrue(TEXT("Oldest survivor popped"), Pipeline.Pop(Time + 10.0, Pending));
+    TestEqual(TEXT("Oldest survivor"), Pending.Notification.Message, FString(TEXT("Flood 8")));
+
+    return true;
+}
@@ -0,0 +1,74 @@
+#include "Economy/SEPriceHistory.h"
+#include "Economy/SETradeManager.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEPriceHistoryTest, "ShadowEchoes.Economy.PriceHistory", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEPriceHistoryTest::RunTest(const FString& Parameters)
+{
+    FSEPriceHistory History;
+    const FString Ore(TEXT("Item_Ore"));
+    const int64 Start = 1700000000 - 1700000000 % 86400;
+
+    // Three trades in the first minute, one in the next
+    History.RecordTrade(Ore, ETradeItemType::Resource, 100.0f, 2, Start + 5);
+    History.RecordTrade(Ore, ETradeItemType::Resource, 120.0f, 1, Start + 20);
+    History.RecordTrade(Ore, ETradeItemType::Resource, 90.0f, 3, Start + 50);
+    History.RecordTrade(Ore, ETradeItemType::Resource, 110.0f, 1, Start + 70);
+
+    TArray<FSEPriceCandle> Minutes;
+    History.GetCandles(Ore, ESEPriceResolution::Minute, 10, Minutes);
+    TestEqual(TEXT("Two minute candles"), Minutes.Num(), 2);
+    TestEqual(TEXT("Oldest first"), Minutes[0].StartTime, Start);
+    TestEqual(TEXT("Open"), Minutes[0].Open, 100.0f);
+    TestEqual(TEXT("High"), Minutes[0].High, 120.0f);
+    TestEqual(TEXT("Low"), Minutes[0].Low, 90.0f);
+    TestEqual(TEXT("Close"), Minutes[0].Close, 90.0f);
+    TestEqual(TEXT("Volume"), Minutes[0].Volume, 6);
+
+    // Coarser resolutions aggregate the same trades
+    const FSEPriceCandle* Hour = History.GetLatestCandle(Ore, ESEPriceResolution::Hour);
+    TestEqual(TEXT("Hour open"), Hour->Open, 100.0f);
+    TestEqual(TEXT("Hour close"), Hour->Close, 110.0f);
+    TestEqual(TEXT("Hour volume"), Hour->Volume, 7);
+    TestEqual(TEXT("Minute trend"), History.GetTrend(Ore, ESEPriceResolution::Minute, 1), 110.0f / 90.0f - 1.0f, 0.0001f);
+
+    // The ring keeps a fixed number of candles
+    for (int32 Minute = 2; Minute < FSEPriceHistory::MinuteCandles + 50; ++Minute)
+    {
+        History.RecordTrade(Ore, ETradeItemType::Resource, 100.0f, 1, Start + Minute * 60);
+    }
+    History.GetCandles(Ore, ESEPriceResolution::Minute, MAX_int32, Minutes);
+    TestEqual(TEXT("Minute ring bounded"), Minutes.Num(), FSEPriceHistory::MinuteCandles);
+    TestEqual(TEXT("Newest kept"), Minutes.Last().StartTime, Start + (FSEPriceHistory::MinuteCandles + 49) * 60);
+    TestEqual(TEXT("Hours cover the span"), History.GetLatestCandle(Ore, ESEPriceResolution::Hour)->StartTime, Start + 3600 * 2);
+    History.GetCandles(Ore, ESEPriceResolution::Minute, -1, Minutes);
+    TestEqual(TEXT("Negative count reads nothing"), Minutes.Num(), 0);
+
+    // Flat prices decay volatility; other types are unaffected
+    const float Volatile = History.GetItemVolatility(Ore);
+    TestTrue(TEXT("Moves raised volatility"), Volatile > 0.0f);
+    History.RecordTrade(Ore, ETradeItemType::Resource, 100.0f, 1, Start + 86400);
+    TestTrue(TEXT("Flat trade decays volatility"), History.GetItemVolatility(Ore) < Volatile);
+    TestEqual(TEXT("Type volatility tracked"), History.GetTypeVolatility(ETradeItemType::Resource), History.GetItemVolatility(Ore), 0.0001f);
+    TestEqual(TEXT("Untraded type"), History.GetTypeVolatility(ETradeItemType::Equipment), 0.0f);
+    TestEqual(TEXT("Day candles"), History.GetLatestCandle(Ore, ESEPriceResolution::Day)->StartTime, Start + 86400);
+
+    // A checkpointed history charts and trends exactly like the original
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    History.Serialize(Writer);
+    FSEPriceHistory Restored;
+    FMemoryReader Reader(Bytes);
+    Restored.Serialize(Reader);
+    TestFalse(TEXT("Restored cleanly"), Reader.IsError());
+    Restored.GetCandles(Ore, ESEPriceResolution::Minute, MAX_int32, Minutes);
+    TestEqual(TEXT("Restored minute ring"), Minutes.Num(), FSEPriceHistory::MinuteCandles);
+    TestEqual(TEXT("Restored newest"), Minutes.Last().StartTime, Start + 86400);
+    TestEqual(TEXT("Restored hour trend"), Restored.GetTrend(Ore, ESEPriceResolution::Hour, 2), History.GetTrend(Ore, ESEPriceResolution::Hour, 2), 0.0001f);
+    TestEqual(TEXT("Restored volatility"), Restored.GetItemVolatility(Ore), History.GetItemVolatility(Ore), 0.0001f);
+    TestEqual(TEXT("Restored type volatility"), Restored.GetTypeVolatility(ETradeItemType::Resource), History.GetTypeVolatility(ETradeItemType::Resource), 0.0001f);
+
+    return true;
+}
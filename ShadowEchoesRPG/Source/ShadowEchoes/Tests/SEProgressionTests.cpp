@@ -0,0 +1,42 @@
+#include "Core/SEProgression.h"
+#include "SaveGame/SESaveFormat.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEProgressionBitsetTest, "ShadowEchoes.Progression.Bitsets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEProgressionBitsetTest::RunTest(const FString& Parameters)
+{
+    FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+
+    // Dense, stable indices
+    const int32 First = Registry.FindOrAdd(ESEProgressionDomain::Location, TEXT("Test_Progression_LocationA"));
+    const int32 Second = Registry.FindOrAdd(ESEProgressionDomain::Location, TEXT("Test_Progression_LocationB"));
+    TestEqual(TEXT("Indices are dense"), Second, First + 1);
+    TestEqual(TEXT("Lookup is stable"), Registry.Find(ESEProgressionDomain::Location, TEXT("Test_Progression_LocationA")), First);
+
+    // Secrets are keyed by area and secret without building names
+    const int32 Secret = Registry.FindOrAddSecret(TEXT("Test_Progression_Area"), TEXT("Test_Progression_Secret"));
+    TestEqual(TEXT("Secret lookup"), Registry.FindSecret(TEXT("Test_Progression_Area"), TEXT("Test_Progression_Secret")), Secret);
+    TestEqual(TEXT("Unknown secret"), Registry.FindSecret(TEXT("Test_Progression_Area"), TEXT("Test_Progression_Missing")), static_cast<int32>(INDEX_NONE));
+
+    // Bits
+    FSESaveSnapshot Snapshot;
+    TestTrue(TEXT("First set reports new"), Snapshot.Progression.Set(ESEProgressionDomain::Location, Second));
+    TestFalse(TEXT("Second set reports existing"), Snapshot.Progression.Set(ESEProgressionDomain::Location, Second));
+    TestFalse(TEXT("Unset bit"), Snapshot.Progression.Test(ESEProgressionDomain::Location, First));
+    Snapshot.Progression.Set(ESEProgressionDomain::Secret, Secret);
+
+    // Save round trip
+    Snapshot.Progression.CaptureIDs();
+    TArray<uint8> Bytes;
+    FSESaveStats Stats;
+    TestTrue(TEXT("Snapshot encodes"), FSESaveFormat::Write(Snapshot, Bytes, Stats));
+
+    FSESaveSnapshot Loaded;
+    TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SlotReader = FSESaveSlotReader::Open(MoveTemp(Bytes));
+    TestTrue(TEXT("Snapshot decodes"), SlotReader.IsValid() && SlotReader->LoadSections(SESaveSections::All, Loaded));
+    TestTrue(TEXT("Location bit restored"), Loaded.Progression.TestID(ESEProgressionDomain::Location, TEXT("Test_Progression_LocationB")));
+    TestFalse(TEXT("Clear bit stays clear"), Loaded.Progression.TestID(ESEProgressionDomain::Location, TEXT("Test_Progression_LocationA")));
+    TestTrue(TEXT("Secret bit restored"), Loaded.Progression.Test(ESEProgressionDomain::Secret, Secret));
+
+    return true;
+}
@@ -0,0 +1,200 @@
+#include "Raid/SERaidSchedule.h"
+#include "Raid/SERaidManager.h"
+#include "Core/SETypes.h"
+#include "Misc/AutomationTest.h"
+
+namespace SERaidScheduleTests
+{
+    static FRaidMechanic MakeMechanic(FName ID, ERaidPhase Phase, float StartTime, float Duration, float RepeatInterval)
+    {
+        FRaidMechanic Mechanic;
+        Mechanic.MechanicID = ID;
+        Mechanic.Phase = Phase;
+        Mechanic.Timeline = ETimelineState::DarkWorld;
+        Mechanic.Duration = Duration;
+        Mechanic.DamageMultiplier = 1.0f;
+        Mechanic.StartTime = StartTime;
+        Mechanic.RepeatInterval = RepeatInterval;
+        return Mechanic;
+    }
+
+    /** Combat until 30 s and half health, a transition that runs its mechanic, then a final phase to the kill */
+    static void MakeEncounter(FRaidEncounter& OutEncounter, TMap<FName, FRaidMechanic>& OutMechanics)
+    {
+        OutEncounter.EncounterID = TEXT("Test_Raid");
+        OutEncounter.Phases = { ERaidPhase::Combat, ERaidPhase::Transition, ERaidPhase::Final };
+        OutEncounter.DurationLimit = 600.0f;
+        OutEncounter.MechanicIDs = { TEXT("Cleave"), TEXT("Rift"), TEXT("Collapse") };
+
+        FRaidPhaseRule& CombatRule = OutEncounter.PhaseRules.AddDefaulted_GetRef();
+        CombatRule.Phase = ERaidPhase::Combat;
+        CombatRule.MinDuration = 30.0f;
+        CombatRule.BossHealthBelow = 0.5f;
+
+        FRaidPhaseRule& TransitionRule = OutEncounter.PhaseRules.AddDefaulted_GetRef();
+        TransitionRule.Phase = ERaidPhase::Transition;
+        TransitionRule.bRequireAllMechanics = true;
+
+        // Enrage: twice the damage by the ten minute mark
+        OutEncounter.DifficultyCurve.GetRichCurve()->AddKey(0.0f, 1.0f);
+        OutEncounter.DifficultyCurve.GetRichCurve()->AddKey(600.0f, 2.0f);
+
+        OutMechanics.Add(TEXT("Cleave"), MakeMechanic(TEXT("Cleave"), ERaidPhase::Combat, 2.0f, 1.0f, 10.0f));
+        OutMechanics.Add(TEXT("Rift"), MakeMechanic(TEXT("Rift"), ERaidPhase::Transition, 5.0f, 3.0f, 0.0f));
+        OutMechanics.Add(TEXT("Collapse"), MakeMechanic(TEXT("Collapse"), ERaidPhase::Final, 0.0f, 2.0f, 20.0f));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSERaidScheduleTest, "ShadowEchoes.Raid.Schedule", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSERaidScheduleTest::RunTest(const FString& Parameters)
+{
+    FRaidEncounter Encounter;
+    TMap<FName, FRaidMechanic> Mechanics;
+    SERaidScheduleTests::MakeEncounter(Encounter, Mechanics);
+
+    FSERaidSchedule Schedule;
+    if (!TestTrue(TEXT("Compiles"), Schedule.Compile(Encounter, Mechanics)))
+    {
+        return false;
+    }
+    TestEqual(TEXT("Phases"), Schedule.NumPhases(), 3);
+    TestEqual(TEXT("Mechanics"), Schedule.NumMechanics(), 3);
+
+    // Cleave repeats every 10 s until the 600 s limit: 60 starts and 60 ends
+    TestEqual(TEXT("Repeats expanded"), Schedule.GetEvents(0).Num(), 120);
+    TestEqual(TEXT("First cleave tick"), Schedule.GetEvents(0)[0].Tick, 2u * FSERaidSchedule::TicksPerSecond);
+    TestEqual(TEXT("Curve start"), Schedule.GetCurve(0), 1.0f);
+    TestEqual(TEXT("Curve midpoint"), Schedule.GetCurve(300 * FSERaidSchedule::TicksPerSecond), 1.5f, 0.01f);
+
+    const TSharedRef<const FSERaidSchedule> Shared = MakeShared<FSERaidSchedule>(Schedule);
+    FSERaidInstance Raid(Shared);
+    TArray<FSERaidOutput> Outputs;
+
+    // Full health holds combat past its minimum duration
+    Raid.Advance(40.0f, Outputs);
+    TestEqual(TEXT("Still in combat"), Raid.GetPhaseIndex(), 0);
+    const int32 NumCleaves = Outputs.FilterByPredicate([](const FSERaidOutput& Output) { return Output.Kind == ESERaidOutputKind::MechanicStarted; }).Num();
+    TestEqual(TEXT("Cleaves at 2, 12, 22 and 32 s"), NumCleaves, 4);
+
+    // Half health moves on at the next step
+    Raid.GetConditions().BossHealth = 0.4f;
+    Outputs.Reset();
+    Raid.Step(Outputs);
+    TestEqual(TEXT("Transition"), Raid.GetPhaseIndex(), 1);
+    const uint32 TransitionStart = Raid.GetTick();
+    TestTrue(TEXT("Phase change reported"), Outputs.Num() > 0 && Outputs.Last().Kind == ESERaidOutputKind::PhaseChanged);
+
+    // The transition waits for its mechanic, which ends 8 s in
+    Raid.Advance(7.0f, Outputs);
+    TestEqual(TEXT("Waiting on the rift"), Raid.GetPhaseIndex(), 1);
+    while (Raid.GetPhaseIndex() == 1)
+    {
+        Raid.Step(Outputs);
+    }
+    TestEqual(TEXT("Final phase"), Raid.GetPhaseIndex(), 2);
+    TestEqual(TEXT("Left on the step the rift ended"), Raid.GetTick() - TransitionStart, 81u);
+    TestTrue(TEXT("Rift completed"), Raid.IsMechanicCompleted(1));
+
+    // Deaths and the wrong timeline make mechanics hit harder
+    Raid.GetConditions().Deaths = 2;
+    Raid.GetConditions().Timeline = ETimelineState::BrightWorld;
+    Outputs.Reset();
+    Raid.Step(Outputs);
+    const FSERaidOutput* Collapse = Outputs.FindByPredicate([](const FSERaidOutput& Output) { return Output.Kind == ESERaidOutputKind::MechanicStarted; });
+    if (TestNotNull(TEXT("Collapse on phase start"), Collapse))
+    {
+        const float Expected = Schedule.GetCurve(Raid.GetTick() - 1) * 1.2f * 1.2f;
+        TestEqual(TEXT("Scaled difficulty"), Collapse->Difficulty, Expected, 0.001f);
+    }
+
+    // The kill ends the last phase
+    Raid.GetConditions().BossHealth = 0.0f;
+    Outputs.Reset();
+    Raid.Step(Outputs);
+    TestTrue(TEXT("Finished"), Raid.IsFinished());
+    TestTrue(TEXT("Succeeded"), Outputs.Num() > 0 && Outputs.Last().Kind == ESERaidOutputKind::Succeeded);
+
+    // Same inputs, same outputs: a raid left alone enrages at exactly the limit
+    FSERaidInstance Idle(Shared);
+    Outputs.Reset();
+    int32 NumSteps = 0;
+    while (!Idle.IsFinished())
+    {
+        Idle.Step(Outputs);
+        ++NumSteps;
+    }
+    TestEqual(TEXT("Enrage tick"), NumSteps, 600 * FSERaidSchedule::TicksPerSecond);
+    TestTrue(TEXT("Failed"), Outputs.Last().Kind == ESERaidOutputKind::Failed);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSERaidScheduleBenchmark, "ShadowEchoes.Raid.ScheduleBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSERaidScheduleBenchmark::RunTest(const FString& Parameters)
+{
+    // 10k concurrent raids on one encounter, each killed on its own timetable
+    const int32 NumRaids = 10000;
+    const float PassSeconds = 0.1f;
+
+    FRaidEncounter Encounter;
+    TMap<FName, FRaidMechanic> Mechanics;
+    SERaidScheduleTests::MakeEncounter(Encounter, Mechanics);
+
+    const TSharedRef<FSERaidSchedule> Schedule = MakeShared<FSERaidSchedule>();
+    Schedule->Compile(Encounter, Mechanics);
+
+    FRandomStream Random(47);
+    TArray<FSERaidInstance> Raids;
+    TArray<float> HealthPerSecond;
+    Raids.Reserve(NumRaids);
+    for (int32 Index = 0; Index < NumRaids; ++Index)
+    {
+        Raids.Emplace(Schedule);
+        HealthPerSecond.Add(Random.FRandRange(0.001f, 0.004f));
+    }
+
+    int64 NumSteps = 0;
+    int64 NumOutputs = 0;
+    int32 NumPasses = 0;
+    int32 NumSucceeded = 0;
+    int32 NumFinished = 0;
+    TArray<FSERaidOutput> Outputs;
+
+    const double Start = FPlatformTime::Seconds();
+    while (NumFinished < NumRaids)
+    {
+        for (int32 Index = 0; Index < NumRaids; ++Index)
+        {
+            FSERaidInstance& Raid = Raids[Index];
+            if (Raid.IsFinished())
+            {
+                continue;
+            }
+
+            FSERaidConditions& Conditions = Raid.GetConditions();
+            Conditions.BossHealth = FMath::Max(0.0f, Conditions.BossHealth - HealthPerSecond[Index] * PassSeconds);
+
+            Outputs.Reset();
+            NumSteps += Raid.Advance(PassSeconds, Outputs);
+            NumOutputs += Outputs.Num();
+            if (Raid.IsFinished())
+            {
+                ++NumFinished;
+                NumSucceeded += Outputs.Last().Kind == ESERaidOutputKind::Succeeded ? 1 : 0;
+            }
+        }
+        ++NumPasses;
+    }
+    const double Seconds = FPlatformTime::Seconds() - Start;
+    const double SimulatedSeconds = NumPasses * PassSeconds;
+
+    TestEqual(TEXT("Every raid finished"), NumFinished, NumRaids);
+
+    AddInfo(FString::Printf(TEXT("Schedule: %d events, %.1f KB"),
+        Schedule->GetEvents(0).Num() + Schedule->GetEvents(1).Num() + Schedule->GetEvents(2).Num(), Schedule->GetAllocatedSize() / 1024.0));
+    AddInfo(FString::Printf(TEXT("%d raids, %lld steps, %lld outputs in %.1f ms (%.0f ns/step)"),
+        NumRaids, NumSteps, NumOutputs, Seconds * 1000.0, Seconds * 1e9 / FMath::Max<int64>(NumSteps, 1)));
+    AddInfo(FString::Printf(TEXT("%.0f s of encounter time for all raids, %.0fx real time; %d killed, %d enraged"),
+        SimulatedSeconds, SimulatedSeconds / FMath::Max(Seconds, 1e-9), NumSucceeded, NumRaids - NumSucceeded));
+    return true;
+}
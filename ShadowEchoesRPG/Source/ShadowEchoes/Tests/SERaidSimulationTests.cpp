@@ -0,0 +1,53 @@
+#include "Raid/SERaidSimulation.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSERaidSimulationTest, "ShadowEchoes.Raid.Simulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSERaidSimulationTest::RunTest(const FString& Parameters)
+{
+    // A small raid on the built-in encounter runs to an end on its own
+    FSERaidSimulationSettings Settings;
+    Settings.NumPlayers = 10;
+
+    FSERaidSimulationReport Report;
+    if (!TestTrue(TEXT("Simulation set up"), USERaidSimulation::Run(Settings, Report)))
+    {
+        return false;
+    }
+
+    TestTrue(TEXT("Raid finished"), Report.bRaidFinished);
+    TestTrue(TEXT("Boss phases followed health"), Report.BossPhaseChanges >= 2);
+    TestTrue(TEXT("Raid phases ran"), Report.RaidPhaseChanges >= 1);
+    TestTrue(TEXT("Mechanics fired"), Report.MechanicsStarted > 0);
+    TestTrue(TEXT("Damage recorded"), Report.DamageEvents > 0 && Report.TotalDamage > 0.0);
+    TestTrue(TEXT("Faster than real time"), Report.GetSpeedup() > 1.0);
+
+    int64 Histogram = 0;
+    for (int64 Count : Report.DamageHistogram)
+    {
+        Histogram += Count;
+    }
+    TestEqual(TEXT("Histogram holds every hit"), Histogram, Report.DamageEvents);
+    TestTrue(TEXT("Percentiles ordered"), Report.FrameMsP50 <= Report.FrameMsP99 && Report.FrameMsP99 <= Report.FrameMsMax);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSERaidSimulationBenchmark, "ShadowEchoes.Raid.SimulationBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSERaidSimulationBenchmark::RunTest(const FString& Parameters)
+{
+    // The full 40-player raid; the command line equivalent is -run=SERaidSimulation
+    FSERaidSimulationSettings Settings;
+
+    FSERaidSimulationReport Report;
+    if (!TestTrue(TEXT("Simulation set up"), USERaidSimulation::Run(Settings, Report)))
+    {
+        return false;
+    }
+
+    TestTrue(TEXT("Raid finished"), Report.bRaidFinished);
+    for (const FString& Line : Report.ToLines())
+    {
+        AddInfo(Line);
+    }
+    return true;
+}
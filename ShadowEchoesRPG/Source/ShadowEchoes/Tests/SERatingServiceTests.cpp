@@ -0,0 +1,181 @@
+#include "PvP/SERatingService.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSERatingServiceTest, "ShadowEchoes.PvP.RatingService", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSERatingServiceTest::RunTest(const FString& Parameters)
+{
+    // Glickman's example player beating his first opponent, as a one-game period
+    FSEGlickoRating Player;
+    Player.Rating = 1500.0;
+    Player.Deviation = 200.0;
+    FSEGlickoRating Opponent;
+    Opponent.Rating = 1400.0;
+    Opponent.Deviation = 30.0;
+    const FSEGlickoRating Updated = FSERatingService::Update(Player, Opponent, 1.0);
+    TestEqual(TEXT("Rating"), Updated.Rating, 1563.56, 0.01);
+    TestEqual(TEXT("Deviation"), Updated.Deviation, 175.40, 0.01);
+    TestEqual(TEXT("Volatility"), Updated.Volatility, 0.06, 0.0001);
+
+    // Matches move players on the board and leave both less uncertain
+    FSERatingService Service;
+    const FSEEntityID A = FSEEntityID::Intern(TEXT("Test_Rated_A"));
+    const FSEEntityID B = FSEEntityID::Intern(TEXT("Test_Rated_B"));
+    const FSEEntityID C = FSEEntityID::Intern(TEXT("Test_Rated_C"));
+    const FSEEntityID D = FSEEntityID::Intern(TEXT("Test_Rated_D"));
+    Service.RecordResult(A, B, 1.0);
+    Service.RecordResult(C, D, 0.5);
+    Service.RecordResult(A, C, 1.0);
+
+    TestTrue(TEXT("Winner gained"), Service.GetRating(A).Rating > 1500.0);
+    TestTrue(TEXT("Loser dropped"), Service.GetRating(B).Rating < 1500.0);
+    TestEqual(TEXT("Draw between equals holds"), Service.GetRating(D).Rating, 1500.0, 0.001);
+    TestTrue(TEXT("Deviation shrank"), Service.GetRating(A).Deviation < 350.0);
+    TestEqual(TEXT("Top of the board"), Service.GetGlobalRank(A), 1);
+    TestEqual(TEXT("Bottom of the board"), Service.GetGlobalRank(B), 4);
+    TestEqual(TEXT("Unrated"), Service.GetGlobalRank(FSEEntityID::Intern(TEXT("Test_Unrated"))), 0);
+
+    TArray<FSEEntityID> Top;
+    Service.GetTopPlayers(2, Top);
+    TestTrue(TEXT("Top two in order"), Top.Num() == 2 && Top[0] == A && Top[1] == D);
+
+    TArray<FSEEntityID> Around;
+    Service.GetPlayersAround(C, 1, Around);
+    TestTrue(TEXT("Neighbours either side"), Around.Num() == 3 && Around[0] == D && Around[1] == C && Around[2] == B);
+
+    // Everyone played in the first period, so it ends without growth
+    const double PlayedDeviation = Service.GetRating(B).Deviation;
+    Service.EndRatingPeriod();
+    TestEqual(TEXT("Active players unchanged"), Service.GetRating(B).Deviation, PlayedDeviation);
+
+    // Only B and D sit out the next one; their deviation grows when read
+    Service.RecordResult(A, C, 0.0);
+    const double ActiveDeviation = Service.GetRating(A).Deviation;
+    Service.EndRatingPeriod();
+    TestTrue(TEXT("Idle deviation grew"), Service.GetRating(B).Deviation > PlayedDeviation);
+    TestEqual(TEXT("Active deviation kept"), Service.GetRating(A).Deviation, ActiveDeviation);
+
+    // Many idle periods at once match ageing one period at a time, up to the cap
+    const FSEGlickoRating Idle = Service.GetRating(B);
+    FSEGlickoRating Stepped = Idle;
+    for (int32 Step = 0; Step < 3; ++Step)
+    {
+        Stepped = FSERatingService::Age(Stepped, Stepped.Period + 2);
+    }
+    TestEqual(TEXT("Three periods at once"), FSERatingService::Age(Idle, Idle.Period + 4).Deviation, Stepped.Deviation, 1e-9);
+    TestEqual(TEXT("Capped"), FSERatingService::Age(Idle, Idle.Period + 1000000).Deviation, FSERatingService::MaxDeviation);
+
+    // Stored rows carry their format version and period; version 0 rows keep the reader's default
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    FSEGlickoRating Stored = Idle;
+    Writer << Stored;
+    FSEGlickoRating Loaded;
+    FMemoryReader Reader(Bytes);
+    Reader << Loaded;
+    TestEqual(TEXT("Period stored"), Loaded.Period, Idle.Period);
+
+    TestEqual(TEXT("Version leads the row"), Bytes[0], FSEGlickoRating::LatestVersion);
+
+    FSEGlickoRating Legacy;
+    Legacy.Period = 42;
+    TArray<uint8> LegacyBytes(Bytes.GetData(), 1 + 3 * sizeof(double));
+    LegacyBytes[0] = 0;
+    FMemoryReader OldRowReader(LegacyBytes);
+    OldRowReader << Legacy;
+    TestFalse(TEXT("Version 0 row read"), OldRowReader.IsError());
+    TestEqual(TEXT("Version 0 row keeps default period"), Legacy.Period, 42);
+    TestEqual(TEXT("Version 0 row keeps its rating"), Legacy.Rating, Idle.Rating);
+
+    TArray<uint8> FutureBytes = Bytes;
+    FutureBytes[0] = FSEGlickoRating::LatestVersion + 1;
+    FSEGlickoRating Future;
+    FMemoryReader FutureReader(FutureBytes);
+    FutureReader << Future;
+    TestTrue(TEXT("Newer row refused"), FutureReader.IsError());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSERatingServiceBenchmark, "ShadowEchoes.PvP.RatingServiceBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSERatingServiceBenchmark::RunTest(const FString& Parameters)
+{
+    // 1M rated players, a day of matches, leaderboard queries and a period end
+    const int32 NumPlayers = 1000000;
+    const int32 NumMatches = 500000;
+    const int32 NumQueries = 100000;
+
+    TArray<FSEEntityID> Players;
+    Players.Reserve(NumPlayers);
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        Players.Add(FSEEntityID::Intern(FString::Printf(TEXT("Bench_Rated_%d"), Index)));
+    }
+
+    FSERatingService Service;
+    Service.Reserve(NumPlayers);
+    FRandomStream Random(45);
+
+    double Start = FPlatformTime::Seconds();
+    for (const FSEEntityID& Player : Players)
+    {
+        FSEGlickoRating Rating;
+        Rating.Rating = 1500.0 + Random.FRandRange(-600.0f, 600.0f);
+        Rating.Deviation = Random.FRandRange(50.0f, 350.0f);
+        Service.SetRating(Player, Rating);
+    }
+    const double LoadSeconds = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    for (int32 Match = 0; Match < NumMatches; ++Match)
+    {
+        const int32 First = Random.RandHelper(NumPlayers);
+        const int32 Second = (First + 1 + Random.RandHelper(NumPlayers - 1)) % NumPlayers;
+        Service.RecordResult(Players[First], Players[Second], Random.RandHelper(2) == 0 ? 1.0 : 0.0);
+    }
+    const double MatchSeconds = FPlatformTime::Seconds() - Start;
+
+    // Each query is a global rank plus the ten players around them
+    int64 RankSum = 0;
+    TArray<FSEEntityID> Around;
+    Start = FPlatformTime::Seconds();
+    for (int32 Query = 0; Query < NumQueries; ++Query)
+    {
+        const FSEEntityID& Player = Players[Random.RandHelper(NumPlayers)];
+        RankSum += Service.GetGlobalRank(Player);
+        Around.Reset();
+        Service.GetPlayersAround(Player, 5, Around);
+    }
+    const double QuerySeconds = FPlatformTime::Seconds() - Start;
+
+    TArray<FSEEntityID> Top;
+    Start = FPlatformTime::Seconds();
+    Service.GetTopPlayers(100, Top);
+    const double TopSeconds = FPlatformTime::Seconds() - Start;
+
+    // Idle players age when read, so a period end costs nothing up front
+    Service.EndRatingPeriod();
+    Service.EndRatingPeriod();
+    double DeviationSum = 0.0;
+    Start = FPlatformTime::Seconds();
+    for (int32 Query = 0; Query < NumQueries; ++Query)
+    {
+        DeviationSum += Service.GetRating(Players[Random.RandHelper(NumPlayers)]).Deviation;
+    }
+    const double AgedReadSeconds = FPlatformTime::Seconds() - Start;
+
+    TestEqual(TEXT("Everyone rated"), Service.Num(), NumPlayers);
+    TestEqual(TEXT("Top 100 returned"), Top.Num(), 100);
+    TestTrue(TEXT("Ranks in range"), RankSum > 0 && RankSum <= int64(NumQueries) * NumPlayers);
+
+    AddInfo(FString::Printf(TEXT("%d players loaded in %.1f ms, %.1f MB"),
+        NumPlayers, LoadSeconds * 1000.0, Service.GetAllocatedSize() / (1024.0 * 1024.0)));
+    AddInfo(FString::Printf(TEXT("%d matches: %.1f ms (%.0f ns/match incl. two board moves)"),
+        NumMatches, MatchSeconds * 1000.0, MatchSeconds * 1e9 / NumMatches));
+    AddInfo(FString::Printf(TEXT("%d rank + around-me queries: %.1f ms (%.0f ns/query); top 100 in %.3f ms"),
+        NumQueries, QuerySeconds * 1000.0, QuerySeconds * 1e9 / NumQueries, TopSeconds * 1000.0));
+    AddInfo(FString::Printf(TEXT("%d reads after two idle periods: %.1f ms (mean deviation %.1f)"),
+        NumQueries, AgedReadSeconds * 1000.0, DeviationSum / NumQueries));
+    return true;
+}
@@ -0,0 +1,183 @@
+#include "SaveGame/SESaveFormat.h"
+#include "SaveGame/SESaveGamePipeline.h"
+#include "SaveGame/SESaveJournal.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SESaveBenchmark
+{
+    static const TCHAR* SlotName = TEXT("Benchmark_SaveJournal");
+
+    /** Long-lived character with large progression maps */
+    static void BuildLargeSnapshot(FSESaveSnapshot& Snapshot)
+    {
+        Snapshot.PlayerLevel = 80;
+        Snapshot.PlayerExperience = 1500000;
+        Snapshot.PlayerCurrency = 250000;
+
+        for (int32 Index = 0; Index < 4000; ++Index)
+        {
+            Snapshot.QuestStates.Add(FName(*FString::Printf(TEXT("Quest_%d"), Index)), EQuestState::Completed);
+            Snapshot.AchievementProgress.Add(FName(*FString::Printf(TEXT("Achievement_%d"), Index)), 0.5f);
+        }
+
+        for (int32 Index = 0; Index < 2000; ++Index)
+        {
+            Snapshot.Progression.SetID(ESEProgressionDomain::Location, FName(*FString::Printf(TEXT("Location_%d"), Index)));
+            Snapshot.InventoryItems.Add(FName(*FString::Printf(TEXT("Item_%d"), Index)));
+            Snapshot.BossFightRecords.Add(FName(*FString::Printf(TEXT("Boss_%d"), Index % 200)), 120.0f);
+        }
+    }
+
+    /** Typical changes between two autosaves */
+    static void RecordTypicalChanges(FSESaveJournal& Journal, int32 Round)
+    {
+        Journal.RecordPlayerProgress(80, 1500000 + Round * 100, 250000 + Round * 10);
+        Journal.RecordQuestState(FName(*FString::Printf(TEXT("Quest_New_%d"), Round)), EQuestState::InProgress);
+        Journal.RecordItemGained(FName(*FString::Printf(TEXT("Loot_%d"), Round)));
+        Journal.RecordItemGained(FName(*FString::Printf(TEXT("Loot_%d_b"), Round)));
+        Journal.RecordLocationDiscovered(FName(*FString::Printf(TEXT("Location_New_%d"), Round)));
+        Journal.RecordMasteryDelta(ETimelineState::BrightWorld, 0.001f);
+        Journal.RecordAchievementProgress(TEXT("Achievement_1"), 0.5f + Round * 0.001f);
+    }
+
+    static void DeleteSlotFiles()
+    {
+        const FString Path = FSESaveGamePipeline::GetSlotPath(SlotName);
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *(Path + TEXT("*")), true, false);
+        for (const FString& File : Files)
+        {
+            IFileManager::Get().Delete(*FPaths::Combine(FPaths::GetPath(Path), File), false, false, true);
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESaveJournalBenchmark, "ShadowEchoes.SaveGame.JournalBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSESaveJournalBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace SESaveBenchmark;
+
+    const int32 NumAutosaves = 20;
+    DeleteSlotFiles();
+
+    FSESaveSnapshot Base;
+    BuildLargeSnapshot(Base);
+
+    // Full save on every autosave (previous behavior)
+    double FullSaveSeconds = 0.0;
+    int64 FullSaveBytes = 0;
+    for (int32 Round = 0; Round < NumAutosaves; ++Round)
+    {
+        FSESaveSnapshot Snapshot = Base;
+        FSESaveStats Stats;
+        const double Start = FPlatformTime::Seconds();
+        TestTrue(TEXT("Full save written"), FSESaveGamePipeline::SaveSlotBlocking(Snapshot, SlotName, Stats));
+        FullSaveSeconds += FPlatformTime::Seconds() - Start;
+        FullSaveBytes += Stats.WrittenBytes;
+    }
+
+    // Journal append on every autosave
+    double JournalSeconds = 0.0;
+    int64 JournalBytes = 0;
+    {
+        FSESaveJournal Journal(SlotName);
+        Journal.Rotate();
+        for (int32 Round = 0; Round < NumAutosaves; ++Round)
+        {
+            RecordTypicalChanges(Journal, Round);
+            const double Start = FPlatformTime::Seconds();
+            Journal.FlushBlocking();
+            JournalSeconds += FPlatformTime::Seconds() - Start;
+        }
+        JournalBytes = Journal.GetJournalBytes();
+    }
+
+    // Replay must reproduce the journaled changes on top of the base
+    FSESaveSnapshot Loaded;
+    TestTrue(TEXT("Base loads"), FSESaveGamePipeline().LoadSlot(SlotName, Loaded));
+    FSESaveJournal ReplayJournal(SlotName);
+    TestEqual(TEXT("All journal records replayed"), ReplayJournal.Replay(Loaded), NumAutosaves * 7);
+    TestTrue(TEXT("Journaled quest present"), Loaded.QuestStates.Contains(TEXT("Quest_New_0")));
+    TestEqual(TEXT("Journaled items present"), Loaded.InventoryItems.Num(), Base.InventoryItems.Num() + NumAutosaves * 2);
+
+    AddInfo(FString::Printf(TEXT("Full save:   %.3f ms/autosave, %lld bytes/autosave"),
+        FullSaveSeconds * 1000.0 / NumAutosaves, FullSaveBytes / NumAutosaves));
+    AddInfo(FString::Printf(TEXT("Journal:     %.3f ms/autosave, %lld bytes/autosave"),
+        JournalSeconds * 1000.0 / NumAutosaves, JournalBytes / NumAutosaves));
+
+    DeleteSlotFiles();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESaveFormatBenchmark, "ShadowEchoes.SaveGame.FormatBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSESaveFormatBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace SESaveBenchmark;
+
+    const int32 NumRuns = 20;
+
+    FSESaveSnapshot Base;
+    BuildLargeSnapshot(Base);
+
+    // Previous format: whole snapshot with inline names, zlib over everything
+    TArray<uint8> LegacyRaw;
+    FMemoryWriter LegacyWriter(LegacyRaw);
+    LegacyWriter << Base;
+    int32 LegacyBytes = FCompression::CompressMemoryBound(NAME_Zlib, LegacyRaw.Num());
+    TArray<uint8> LegacyCompressed;
+    LegacyCompressed.SetNumUninitialized(LegacyBytes);
+    FCompression::CompressMemory(NAME_Zlib, LegacyCompressed.GetData(), LegacyBytes, LegacyRaw.GetData(), LegacyRaw.Num());
+
+    double LegacyLoadSeconds = 0.0;
+    for (int32 Run = 0; Run < NumRuns; ++Run)
+    {
+        const double Start = FPlatformTime::Seconds();
+        TArray<uint8> Raw;
+        Raw.SetNumUninitialized(LegacyRaw.Num());
+        FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), Raw.Num(), LegacyCompressed.GetData(), LegacyBytes);
+        FSESaveSnapshot Loaded;
+        FMemoryReader Reader(Raw);
+        Reader << Loaded;
+        LegacyLoadSeconds += FPlatformTime::Seconds() - Start;
+    }
+
+    // Sectioned format
+    TArray<uint8> Encoded;
+    FSESaveStats Stats;
+    TestTrue(TEXT("Sectioned save encodes"), FSESaveFormat::Write(Base, Encoded, Stats));
+
+    double CoreLoadSeconds = 0.0;
+    double FullLoadSeconds = 0.0;
+    for (int32 Run = 0; Run < NumRuns; ++Run)
+    {
+        FSESaveSnapshot Loaded;
+        TArray<uint8> Bytes = Encoded;
+
+        const double Start = FPlatformTime::Seconds();
+        TSharedPtr<FSESaveSlotReader, ESPMode::ThreadSafe> SlotReader = FSESaveSlotReader::Open(MoveTemp(Bytes));
+        TestTrue(TEXT("Sectioned save opens"), SlotReader.IsValid() && SlotReader->LoadSections(SESaveSections::Bit(ESESaveSection::Core), Loaded));
+        CoreLoadSeconds += FPlatformTime::Seconds() - Start;
+
+        TestTrue(TEXT("Remaining sections load"), SlotReader.IsValid() && SlotReader->LoadSections(SESaveSections::All, Loaded));
+        FullLoadSeconds += FPlatformTime::Seconds() - Start;
+
+        if (Run == 0)
+        {
+            TestEqual(TEXT("Level round-trips"), Loaded.PlayerLevel, Base.PlayerLevel);
+            TestEqual(TEXT("Quests round-trip"), Loaded.QuestStates.Num(), Base.QuestStates.Num());
+            TestTrue(TEXT("Quest state round-trips"), Loaded.QuestStates.FindRef(TEXT("Quest_17")) == EQuestState::Completed);
+            TestEqual(TEXT("Locations round-trip"), Loaded.Progression.CountSet(ESEProgressionDomain::Location), Base.Progression.CountSet(ESEProgressionDomain::Location));
+            TestEqual(TEXT("Boss records round-trip"), Loaded.BossFightRecords.Num(), Base.BossFightRecords.Num());
+        }
+    }
+
+    AddInfo(FString::Printf(TEXT("Previous format:  %d bytes, %.3f ms full load"),
+        LegacyBytes, LegacyLoadSeconds * 1000.0 / NumRuns));
+    AddInfo(FString::Printf(TEXT("Sectioned format: %d bytes, %.3f ms to core stats, %.3f ms full load"),
+        Encoded.Num(), CoreLoadSeconds * 1000.0 / NumRuns, FullLoadSeconds * 1000.0 / NumRuns));
+    return true;
+}
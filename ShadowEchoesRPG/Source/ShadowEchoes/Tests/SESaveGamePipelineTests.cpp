@@ -0,0 +1,151 @@
+#include "SaveGame/SESaveGamePipeline.h"
+#include "SaveGame/SESaveJournal.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace SESaveGamePipelineTests
+{
+    static const TCHAR* SlotName = TEXT("Test_SavePipeline");
+
+    /** Slot, temp, backup and journal files */
+    static void DeleteSlotFiles()
+    {
+        const FString Path = FSESaveGamePipeline::GetSlotPath(SlotName);
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *(Path + TEXT("*")), true, false);
+        for (const FString& File : Files)
+        {
+            IFileManager::Get().Delete(*FPaths::Combine(FPaths::GetPath(Path), File), false, false, true);
+        }
+    }
+
+    static TArray<uint8> MakeBytes(uint8 Fill, int32 Num)
+    {
+        TArray<uint8> Bytes;
+        Bytes.Init(Fill, Num);
+        return Bytes;
+    }
+
+    static bool FileEquals(const FString& Path, const TArray<uint8>& Expected)
+    {
+        TArray<uint8> Bytes;
+        return FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) && Bytes == Expected;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESaveGamePipelineTest, "ShadowEchoes.SaveGame.Pipeline", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSESaveGamePipelineTest::RunTest(const FString& Parameters)
+{
+    using namespace SESaveGamePipelineTests;
+
+    IFileManager& FileManager = IFileManager::Get();
+    const FString Path = FSESaveGamePipeline::GetSlotPath(SlotName);
+    const FString TempPath = Path + TEXT(".tmp");
+    const FString BackupPath = Path + TEXT(".bak");
+    DeleteSlotFiles();
+    FileManager.MakeDirectory(*FPaths::GetPath(Path), true);
+
+    // A first write leaves only the slot file behind
+    const TArray<uint8> First = MakeBytes(1, 1000);
+    TestTrue(TEXT("First write"), FSESaveGamePipeline::WriteFileAtomic(Path, First));
+    TestTrue(TEXT("First contents"), FileEquals(Path, First));
+    TestFalse(TEXT("Temp file renamed away"), FileManager.FileExists(*TempPath));
+    TestFalse(TEXT("Nothing to back up yet"), FileManager.FileExists(*BackupPath));
+
+    // A second write keeps the previous slot as backup
+    const TArray<uint8> Second = MakeBytes(2, 2000);
+    TestTrue(TEXT("Second write"), FSESaveGamePipeline::WriteFileAtomic(Path, Second));
+    TestTrue(TEXT("Second contents"), FileEquals(Path, Second));
+    TestTrue(TEXT("Backup holds the first"), FileEquals(BackupPath, First));
+
+    // A temp file left by a crashed write is overwritten, never published
+    TestTrue(TEXT("Stale temp written"), FFileHelper::SaveArrayToFile(MakeBytes(9, 10), *TempPath));
+    const TArray<uint8> Third = MakeBytes(3, 500);
+    TestTrue(TEXT("Write over stale temp"), FSESaveGamePipeline::WriteFileAtomic(Path, Third));
+    TestTrue(TEXT("Third contents"), FileEquals(Path, Third));
+    TestTrue(TEXT("Backup rotated"), FileEquals(BackupPath, Second));
+    TestFalse(TEXT("No temp left"), FileManager.FileExists(*TempPath));
+    DeleteSlotFiles();
+
+    // A corrupt slot falls back to the backup written by the previous save
+    FSESaveSnapshot Older;
+    Older.PlayerLevel = 10;
+    FSESaveSnapshot Newer;
+    Newer.PlayerLevel = 20;
+    FSESaveStats Stats;
+    TestTrue(TEXT("Older saved"), FSESaveGamePipeline::SaveSlotBlocking(Older, SlotName, Stats));
+    TestTrue(TEXT("Newer saved"), FSESaveGamePipeline::SaveSlotBlocking(Newer, SlotName, Stats));
+
+    TSharedRef<FSESaveGamePipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FSESaveGamePipeline, ESPMode::ThreadSafe>();
+    FSESaveSnapshot Loaded;
+    TestTrue(TEXT("Slot loads"), Pipeline->LoadSlot(SlotName, Loaded));
+    TestEqual(TEXT("Newest slot read"), Loaded.PlayerLevel, 20);
+
+    TestTrue(TEXT("Slot corrupted"), FFileHelper::SaveArrayToFile(MakeBytes(0xAB, 64), *Path));
+    FSESaveSnapshot Recovered;
+    TestTrue(TEXT("Backup loads"), Pipeline->LoadSlot(SlotName, Recovered));
+    TestEqual(TEXT("Backup read"), Recovered.PlayerLevel, 10);
+
+    // Queued saves: the newest waiting snapshot wins, and Flush puts it on disk
+    for (int32 Level = 30; Level <= 32; ++Level)
+    {
+        FSESaveSnapshot Snapshot;
+        Snapshot.PlayerLevel = Level;
+        Pipeline->RequestSave(MoveTemp(Snapshot), SlotName, 0.0f);
+    }
+    Pipeline->Flush();
+    FSESaveSnapshot Flushed;
+    TestTrue(TEXT("Flushed slot loads"), Pipeline->LoadSlot(SlotName, Flushed));
+    TestEqual(TEXT("Newest request written last"), Flushed.PlayerLevel, 32);
+    TestFalse(TEXT("No temp after flush"), FileManager.FileExists(*TempPath));
+
+    DeleteSlotFiles();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESaveBackupJournalTest, "ShadowEchoes.SaveGame.BackupJournals", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSESaveBackupJournalTest::RunTest(const FString& Parameters)
+{
+    using namespace SESaveGamePipelineTests;
+
+    DeleteSlotFiles();
+    FSESaveStats Stats;
+
+    // Base at generation A, then progress journaled on top of it
+    FSESaveJournal Journal(SlotName);
+    FSESaveSnapshot First;
+    First.PlayerLevel = 10;
+    First.JournalGeneration = Journal.Rotate();
+    const uint32 FirstGeneration = First.JournalGeneration;
+    TestTrue(TEXT("First base saved"), FSESaveGamePipeline::SaveSlotBlocking(First, SlotName, Stats));
+    Journal.RecordPlayerProgress(11, 0, 0);
+    Journal.FlushBlocking();
+
+    // Compaction into a new base at generation B; the first base becomes the backup
+    FSESaveSnapshot Second;
+    Second.PlayerLevel = 11;
+    Second.JournalGeneration = Journal.Rotate();
+    TestTrue(TEXT("Second base saved and verified"), FSESaveGamePipeline::SaveSlotBlocking(Second, SlotName, Stats));
+    Journal.RecordPlayerProgress(12, 0, 0);
+    Journal.FlushBlocking();
+
+    // The game instance only drops journals below the backup's base
+    Journal.DeleteGenerationsBelow(FirstGeneration);
+    Journal.FlushBlocking();
+
+    // A corrupt main file falls back to the backup, and its journals bring back every change
+    TestTrue(TEXT("Slot corrupted"), FFileHelper::SaveArrayToFile(MakeBytes(0xCD, 64), *FSESaveGamePipeline::GetSlotPath(SlotName)));
+    TSharedRef<FSESaveGamePipeline, ESPMode::ThreadSafe> Pipeline = MakeShared<FSESaveGamePipeline, ESPMode::ThreadSafe>();
+    FSESaveSnapshot Loaded;
+    TestTrue(TEXT("Backup loads"), Pipeline->LoadSlot(SlotName, Loaded));
+    TestEqual(TEXT("Backup base"), Loaded.PlayerLevel, 10);
+
+    FSESaveJournal Replayer(SlotName);
+    TestEqual(TEXT("Both generations replayed"), Replayer.Replay(Loaded), 2);
+    TestEqual(TEXT("No progress lost"), Loaded.PlayerLevel, 12);
+
+    DeleteSlotFiles();
+    return true;
+}
@@ -0,0 +1,39 @@
+#include "Systems/SESignificanceManager.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESignificanceTest, "ShadowEchoes.Systems.Significance", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSESignificanceTest::RunTest(const FString& Parameters)
+{
+    auto Classify = [](bool bPlayer, bool bCombat, bool bVisible, bool bViewpoint, float Distance)
+    {
+        return USESignificanceManager::Classify(bPlayer, bCombat, bVisible, bViewpoint, FMath::Square(Distance));
+    };
+
+    // Players are always at full rate
+    TestEqual(TEXT("Player far away"), Classify(true, false, false, true, 1.0e6f), ESESignificance::High);
+
+    // Dedicated server: fights keep full rate, the rest is moderate
+    TestEqual(TEXT("No viewpoint, in combat"), Classify(false, true, false, false, MAX_flt), ESESignificance::High);
+    TestEqual(TEXT("No viewpoint, idle"), Classify(false, false, false, false, MAX_flt), ESESignificance::Medium);
+
+    // Visible characters fall off with distance
+    TestEqual(TEXT("Visible and near"), Classify(false, false, true, true, 1000.0f), ESESignificance::High);
+    TestEqual(TEXT("Visible mid range"), Classify(false, false, true, true, 4000.0f), ESESignificance::Medium);
+    TestEqual(TEXT("Visible far"), Classify(false, false, true, true, 50000.0f), ESESignificance::Low);
+
+    // Combat reaches further than sight alone
+    TestEqual(TEXT("Combat mid range"), Classify(false, true, false, true, 3000.0f), ESESignificance::High);
+    TestEqual(TEXT("Combat far"), Classify(false, true, false, true, 8000.0f), ESESignificance::Medium);
+    TestEqual(TEXT("Combat never dormant"), Classify(false, true, false, true, 1.0e6f), ESESignificance::Low);
+
+    // Unseen and idle
+    TestEqual(TEXT("Unseen nearby"), Classify(false, false, false, true, 10000.0f), ESESignificance::Low);
+    TestEqual(TEXT("Unseen far"), Classify(false, false, false, true, 20000.0f), ESESignificance::Dormant);
+
+    // High ticks every frame, the others at their rates
+    TestEqual(TEXT("High every frame"), USESignificanceManager::GetTickInterval(ESESignificance::High), 0.0f);
+    TestEqual(TEXT("Medium 20 Hz"), USESignificanceManager::GetTickInterval(ESESignificance::Medium), 1.0f / 20.0f);
+    TestEqual(TEXT("Low 5 Hz"), USESignificanceManager::GetTickInterval(ESESignificance::Low), 1.0f / 5.0f);
+
+    return true;
+}
@@ -0,0 +1,121 @@
+#include "World/SESpatialGrid.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+
+namespace SESpatialGridBenchmark
+{
+    /** Weather event sized arena; hazards and AoE use a few hundred units */
+    static const float ArenaSize = 40000.0f;
+    static const float QueryRadius = 600.0f;
+
+    static void ScatterLocations(FRandomStream& Random, int32 NumActors, TArray<FVector>& OutLocations)
+    {
+        OutLocations.Reset(NumActors);
+        for (int32 Index = 0; Index < NumActors; ++Index)
+        {
+            OutLocations.Emplace(Random.FRandRange(0.0f, ArenaSize), Random.FRandRange(0.0f, ArenaSize), Random.FRandRange(0.0f, 500.0f));
+        }
+    }
+
+    /** Previous behavior: test every actor */
+    static void BruteForceQuery(const TArray<FVector>& Locations, const FVector& Center, float Radius, TArray<int32>& OutHandles)
+    {
+        OutHandles.Reset();
+        const float RadiusSquared = Radius * Radius;
+        for (int32 Index = 0; Index < Locations.Num(); ++Index)
+        {
+            if (FVector::DistSquared(Locations[Index], Center) <= RadiusSquared)
+            {
+                OutHandles.Add(Index);
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESpatialGridTest, "ShadowEchoes.World.SpatialGrid", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSESpatialGridTest::RunTest(const FString& Parameters)
+{
+    FSESpatialHashGrid Grid(100.0f);
+    const int32 Near = Grid.Add(FVector(10.0f, 10.0f, 0.0f));
+    const int32 Far = Grid.Add(FVector(1000.0f, 0.0f, 0.0f));
+    const int32 Edge = Grid.Add(FVector(-140.0f, 0.0f, 0.0f));
+
+    TArray<int32> Found;
+    Grid.QueryRadius(FVector::ZeroVector, 150.0f, Found);
+    TestEqual(TEXT("Neighbors across cells"), Found.Num(), 2);
+    TestTrue(TEXT("Near found"), Found.Contains(Near) && Found.Contains(Edge));
+
+    // Moving across a cell boundary relinks, moving within a cell does not
+    TestTrue(TEXT("Cell change reported"), Grid.Update(Far, FVector(50.0f, 50.0f, 0.0f)));
+    TestFalse(TEXT("Same cell move"), Grid.Update(Far, FVector(60.0f, 60.0f, 0.0f)));
+    Grid.QueryRadius(FVector::ZeroVector, 150.0f, Found);
+    TestEqual(TEXT("Moved entry found"), Found.Num(), 3);
+
+    // Removal keeps the other entries of the cell intact
+    Grid.Remove(Near);
+    Grid.QueryRadius(FVector::ZeroVector, 150.0f, Found);
+    TestEqual(TEXT("Removed entry gone"), Found.Num(), 2);
+    TestTrue(TEXT("Swapped entry still found"), Found.Contains(Far));
+    TestEqual(TEXT("Handle reused"), Grid.Add(FVector::ZeroVector), Near);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSESpatialGridBenchmark, "ShadowEchoes.World.SpatialGridBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSESpatialGridBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace SESpatialGridBenchmark;
+
+    const int32 NumQueries = 2000;
+
+    for (const int32 NumActors : { 1000, 10000 })
+    {
+        FRandomStream Random(NumActors);
+        TArray<FVector> Locations;
+        ScatterLocations(Random, NumActors, Locations);
+
+        FSESpatialHashGrid Grid(USESpatialGridSubsystem::DefaultCellSize);
+        for (const FVector& Location : Locations)
+        {
+            Grid.Add(Location);
+        }
+
+        TArray<FVector> Centers;
+        ScatterLocations(Random, NumQueries, Centers);
+
+        // Radius queries, checked against a full scan
+        TArray<int32> Expected;
+        TArray<int32> Found;
+        double ScanSeconds = 0.0;
+        double GridSeconds = 0.0;
+        bool bMatches = true;
+        for (const FVector& Center : Centers)
+        {
+            double Start = FPlatformTime::Seconds();
+            BruteForceQuery(Locations, Center, QueryRadius, Expected);
+            ScanSeconds += FPlatformTime::Seconds() - Start;
+
+            Start = FPlatformTime::Seconds();
+            Grid.QueryRadius(Center, QueryRadius, Found);
+            GridSeconds += FPlatformTime::Seconds() - Start;
+
+            Found.Sort();
+            bMatches &= Found == Expected;
+        }
+        TestTrue(FString::Printf(TEXT("Grid matches scan at %d actors"), NumActors), bMatches);
+
+        // One frame of movement for every actor
+        const double MoveStart = FPlatformTime::Seconds();
+        for (int32 Handle = 0; Handle < NumActors; ++Handle)
+        {
+            Locations[Handle] += FVector(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-10.0f, 10.0f), 0.0f);
+            Grid.Update(Handle, Locations[Handle]);
+        }
+        const double MoveSeconds = FPlatformTime::Seconds() - MoveStart;
+
+        AddInfo(FString::Printf(TEXT("%5d actors: scan %.2f us/query, grid %.2f us/query, update %.3f ms/frame (%d cells)"),
+            NumActors, ScanSeconds * 1e6 / NumQueries, GridSeconds * 1e6 / NumQueries, MoveSeconds * 1000.0, Grid.NumCells()));
+    }
+
+    return true;
+}
@@ -0,0 +1,257 @@
+#include "Economy/SETradeJournal.h"
+#include "Core/SETypes.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+namespace SETradeJournalTest
+{
+    static FMarketItem MakeListing(int32 Index)
+    {
+        FMarketItem Item;
+        Item.ItemID = FString::Printf(TEXT("Item_%d"), Index % 50);
+        Item.SellerID = FSEEntityID::Intern(FString::Printf(TEXT("Seller_%d"), Index % 200));
+        Item.Type = ETradeItemType::Resource;
+        Item.Quantity = 1 + Index % 5;
+        Item.BasePrice = 100 + Index % 17;
+        Item.PreferredTimeline = ETimelineState::Any;
+        Item.bIsAuction = Index % 4 == 0;
+        Item.EndTime = Item.bIsAuction ? 1700000000 + Index : 0;
+        return Item;
+    }
+
+    /** Recovered order book: listing ID to bids */
+    static int32 Replay(const FString& Name, TArray<uint8>& OutCheckpoint, TMap<FSEEntityID, TArray<FSEEntityID>>& OutListings)
+    {
+        FSETradeJournal Journal(Name);
+        return Journal.Recover(OutCheckpoint, [&OutListings](const FSETradeJournalEntry& Entry)
+        {
+            switch (Entry.Type)
+            {
+                case ESETradeJournalRecord::List:
+                    OutListings.Add(Entry.ListingID, Entry.Item.Bids);
+                    break;
+
+                case ESETradeJournalRecord::Bid:
+                    OutListings.FindOrAdd(Entry.ListingID).Add(Entry.ActorID);
+                    break;
+
+                default:
+                    OutListings.Remove(Entry.ListingID);
+                    break;
+            }
+        });
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSETradeJournalRecoveryTest, "ShadowEchoes.Economy.TradeJournal.Recovery", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSETradeJournalRecoveryTest::RunTest(const FString& Parameters)
+{
+    const FString Name(TEXT("Test_TradeJournal"));
+    const FSEEntityID L1 = FSEEntityID::Intern(TEXT("Test_Listing_1"));
+    const FSEEntityID L2 = FSEEntityID::Intern(TEXT("Test_Listing_2"));
+    const FSEEntityID L3 = FSEEntityID::Intern(TEXT("Test_Listing_3"));
+    uint64 BuySequence = 0;
+    {
+        FSETradeJournal Journal(Name);
+        Journal.DeleteFiles();
+
+        Journal.AppendList(L1, SETradeJournalTest::MakeListing(1));
+        Journal.AppendList(L2, SETradeJournalTest::MakeListing(2));
+        Journal.AppendBid(L2, FSEEntityID::Intern(TEXT("Bidder")), 150);
+        TestEqual(TEXT("Records grouped"), Journal.GetNumPendingRecords(), 3);
+        TestEqual(TEXT("Nothing durable before commit"), Journal.GetDurableSequence(), static_cast<uint64>(0));
+
+        Journal.CommitBlocking();
+        TestEqual(TEXT("Group durable"), Journal.GetDurableSequence(), static_cast<uint64>(3));
+
+        // Checkpoint holds L1 and L2; only later records replay on top of it
+        TArray<uint8> Payload = { 1, 2, 3 };
+        Journal.Checkpoint(MoveTemp(Payload));
+        BuySequence = Journal.AppendBuy(L1, FSEEntityID::Intern(TEXT("Buyer")), 120, 1700000000);
+        Journal.AppendList(L3, SETradeJournalTest::MakeListing(3));
+    }
+
+    TArray<uint8> Checkpoint;
+    TMap<FSEEntityID, TArray<FSEEntityID>> Listings;
+    int32 NumReplayed = SETradeJournalTest::Replay(Name, Checkpoint, Listings);
+    TestEqual(TEXT("Checkpoint loaded"), Checkpoint.Num(), 3);
+    TestEqual(TEXT("Only post-checkpoint records replayed"), NumReplayed, 2);
+    TestEqual(TEXT("Sequence after checkpoint"), BuySequence, static_cast<uint64>(4));
+    TestFalse(TEXT("Sold listing not in book"), Listings.Contains(L1));
+    TestTrue(TEXT("Later listing replayed"), Listings.Contains(L3));
+
+    // A crash mid-append leaves a torn group, which is dropped along with anything after it
+    {
+        FSETradeJournal Journal(Name);
+        TArray<uint8> Ignored;
+        Journal.Recover(Ignored, [](const FSETradeJournalEntry&) {});
+        TestEqual(TEXT("Sequence continues"), Journal.GetLastSequence(), static_cast<uint64>(5));
+
+        Journal.AppendBid(L3, FSEEntityID::Intern(TEXT("Late")), 200);
+        Journal.CommitBlocking();
+
+        const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Trade"), Name + TEXT(".journal") + LexToString(Journal.GetGeneration()));
+        TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true, false));
+        const uint8 Torn[] = { 64, 0, 0, 0, 1, 2, 3, 4, 1 };
+        File->Write(Torn, sizeof(Torn));
+    }
+
+    Listings.Reset();
+    NumReplayed = SETradeJournalTest::Replay(Name, Checkpoint, Listings);
+    TestEqual(TEXT("Torn tail ignored"), NumReplayed, 3);
+    TestEqual(TEXT("Committed bid survives"), Listings.FindRef(L3).Num(), 1);
+
+    FSETradeJournal(Name).DeleteFiles();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSETradeJournalFailedWriteTest, "ShadowEchoes.Economy.TradeJournal.FailedWrite", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSETradeJournalFailedWriteTest::RunTest(const FString& Parameters)
+{
+    const FString Name(TEXT("Test_TradeJournalFailed"));
+    const FSEEntityID L1 = FSEEntityID::Intern(TEXT("Test_Listing_1"));
+    const FSEEntityID L2 = FSEEntityID::Intern(TEXT("Test_Listing_2"));
+    {
+        FSETradeJournal Journal(Name);
+        Journal.DeleteFiles();
+
+        // A directory where the journal should be makes every append fail
+        const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Trade"), Name + TEXT(".journal") + LexToString(Journal.GetGeneration()));
+        IFileManager::Get().MakeDirectory(*Path, true);
+
+        Journal.AppendList(L1, SETradeJournalTest::MakeListing(1));
+        AddExpectedError(TEXT("Failed to append trade journal"), EAutomationExpectedErrorFlags::Contains, 0);
+        Journal.CommitBlocking();
+        TestEqual(TEXT("Failed group not durable"), Journal.GetDurableSequence(), static_cast<uint64>(0));
+        TestTrue(TEXT("Failed group kept"), Journal.HasFailedWrites());
+
+        // A later success writes the failed group ahead of its own and covers both
+        IFileManager::Get().DeleteDirectory(*Path, false, true);
+        Journal.AppendList(L2, SETradeJournalTest::MakeListing(2));
+        Journal.CommitBlocking();
+        TestEqual(TEXT("Both groups durable"), Journal.GetDurableSequence(), static_cast<uint64>(2));
+        TestFalse(TEXT("Retry written"), Journal.HasFailedWrites());
+    }
+
+    TArray<uint8> Checkpoint;
+    TMap<FSEEntityID, TArray<FSEEntityID>> Listings;
+    TestEqual(TEXT("Both records replayed"), SETradeJournalTest::Replay(Name, Checkpoint, Listings), 2);
+    TestTrue(TEXT("Retried listing recovered"), Listings.Contains(L1));
+    TestTrue(TEXT("Later listing recovered"), Listings.Contains(L2));
+
+    FSETradeJournal(Name).DeleteFiles();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSETradeJournalBackupTest, "ShadowEchoes.Economy.TradeJournal.BackupCheckpoint", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSETradeJournalBackupTest::RunTest(const FString& Parameters)
+{
+    const FString Name(TEXT("Test_TradeJournalBackup"));
+    const FSEEntityID Auction = FSEEntityID::Intern(TEXT("Test_Auction"));
+    {
+        FSETradeJournal Journal(Name);
+        Journal.DeleteFiles();
+
+        // Two checkpoints; the first becomes the backup and keeps the journals after it
+        Journal.AppendList(FSEEntityID::Intern(TEXT("Test_Listing_1")), SETradeJournalTest::MakeListing(1));
+        TArray<uint8> First = { 1 };
+        Journal.Checkpoint(MoveTemp(First));
+        Journal.AppendList(Auction, SETradeJournalTest::MakeListing(4));
+        TArray<uint8> Second = { 2 };
+        Journal.Checkpoint(MoveTemp(Second));
+        Journal.AppendList(FSEEntityID::Intern(TEXT("Test_Listing_3")), SETradeJournalTest::MakeListing(3));
+    }
+
+    // A torn checkpoint falls back to the backup and replays everything since it
+    const FString CheckpointPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Trade"), Name + TEXT(".checkpoint"));
+    {
+        TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*CheckpointPath));
+        const uint8 Torn[] = { 0x43, 0x54 };
+        File->Write(Torn, sizeof(Torn));
+    }
+
+    int64 AuctionEndTime = 0;
+    TArray<uint8> Checkpoint;
+    FSETradeJournal Journal(Name);
+    const int32 NumReplayed = Journal.Recover(Checkpoint, [&](const FSETradeJournalEntry& Entry)
+    {
+        if (Entry.ListingID == Auction)
+        {
+            AuctionEndTime = Entry.Item.EndTime;
+        }
+    });
+    TestTrue(TEXT("Backup checkpoint loaded"), Checkpoint == TArray<uint8>({ 1 }));
+    TestEqual(TEXT("Journals after the backup kept"), NumReplayed, 2);
+    TestEqual(TEXT("Auction end time journaled"), AuctionEndTime, static_cast<int64>(1700000004));
+
+    Journal.DeleteFiles();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSETradeJournalBenchmark, "ShadowEchoes.Economy.TradeJournal.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSETradeJournalBenchmark::RunTest(const FString& Parameters)
+{
+    const FString Name(TEXT("Benchmark_TradeJournal"));
+    const FSEEntityID Buyer = FSEEntityID::Intern(TEXT("Buyer"));
+    const int32 NumTrades = 20000;
+
+    // Group commit: the game thread appends and only commits when the window has passed
+    double GroupSeconds = 0.0;
+    {
+        FSETradeJournal Journal(Name, 5.0f);
+        Journal.DeleteFiles();
+
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumTrades; ++Index)
+        {
+            const FSEEntityID ListingID = FSEEntityID::Intern(FString::Printf(TEXT("L%d"), Index));
+            Journal.AppendList(ListingID, SETradeJournalTest::MakeListing(Index));
+            Journal.AppendBuy(ListingID, Buyer, 100, 1700000000);
+            Journal.CommitIfDue();
+        }
+        Journal.CommitBlocking();
+        GroupSeconds = FPlatformTime::Seconds() - Start;
+
+        TestEqual(TEXT("Every trade durable"), Journal.GetDurableSequence(), static_cast<uint64>(NumTrades * 2));
+        Journal.DeleteFiles();
+    }
+
+    // One fsync per trade, on a tenth of the trades to keep the run short
+    const int32 NumSyncedTrades = NumTrades / 10;
+    double SyncedSeconds = 0.0;
+    {
+        FSETradeJournal Journal(Name, 0.0f);
+
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumSyncedTrades; ++Index)
+        {
+            const FSEEntityID ListingID = FSEEntityID::Intern(FString::Printf(TEXT("L%d"), Index));
+            Journal.AppendList(ListingID, SETradeJournalTest::MakeListing(Index));
+            Journal.AppendBuy(ListingID, Buyer, 100, 1700000000);
+            Journal.CommitBlocking();
+        }
+        SyncedSeconds = FPlatformTime::Seconds() - Start;
+    }
+
+    // Recovery replays the whole log
+    double RecoverSeconds = 0.0;
+    {
+        TArray<uint8> Checkpoint;
+        TMap<FSEEntityID, TArray<FSEEntityID>> Listings;
+        const double Start = FPlatformTime::Seconds();
+        const int32 NumReplayed = SETradeJournalTest::Replay(Name, Checkpoint, Listings);
+        RecoverSeconds = FPlatformTime::Seconds() - Start;
+        TestEqual(TEXT("Replayed every record"), NumReplayed, NumSyncedTrades * 2);
+    }
+
+    FSETradeJournal(Name).DeleteFiles();
+
+    AddInfo(FString::Printf(TEXT("Group commit: %.0f trades/s (%d trades in %.1f ms)"),
+        NumTrades / FMath::Max(GroupSeconds, 1e-6), NumTrades, GroupSeconds * 1000.0));
+    AddInfo(FString::Printf(TEXT("Commit per trade: %.0f trades/s (%d trades in %.1f ms)"),
+        NumSyncedTrades / FMath::Max(SyncedSeconds, 1e-6), NumSyncedTrades, SyncedSeconds * 1000.0));
+    AddInfo(FString::Printf(TEXT("Recovery: %d records in %.1f ms"), NumSyncedTrades * 2, RecoverSeconds * 1000.0));
+    return true;
+}
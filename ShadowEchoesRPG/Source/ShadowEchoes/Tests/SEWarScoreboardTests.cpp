@@ -0,0 +1,112 @@
+#include "PvP/SEWarScoreboard.h"
+#include "Core/SETypes.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWarScoreboardTest, "ShadowEchoes.PvP.WarScoreboard", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEWarScoreboardTest::RunTest(const FString& Parameters)
+{
+    FSEWarScoreboard Scoreboard(4, 4);
+    const int32 Ashfields = Scoreboard.FindOrAddRegion(TEXT("Ashfields"));
+    const int32 Mirrorwood = Scoreboard.FindOrAddRegion(TEXT("Mirrorwood"));
+    TestEqual(TEXT("Regions are stable"), Scoreboard.FindOrAddRegion(TEXT("Ashfields")), Ashfields);
+    TestEqual(TEXT("Unassigned region"), Scoreboard.FindOrAddRegion(NAME_None), 0);
+
+    // Scores from many threads are all counted
+    ParallelFor(64, [&](int32 Task)
+    {
+        for (int32 Point = 0; Point < 100; ++Point)
+        {
+            Scoreboard.AddPoints(ETimelineState::DarkWorld, Task % 2 == 0 ? Ashfields : Mirrorwood, 1);
+            Scoreboard.AddPoints(ETimelineState::BrightWorld, 0, 2);
+        }
+    });
+
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Empty = Scoreboard.GetSnapshot();
+    TestEqual(TEXT("Nothing published yet"), Empty->GetScore(ETimelineState::DarkWorld), 0);
+
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> First = Scoreboard.Publish();
+    TestEqual(TEXT("Dark total"), First->GetScore(ETimelineState::DarkWorld), 6400);
+    TestEqual(TEXT("Bright total"), First->GetScore(ETimelineState::BrightWorld), 12800);
+    TestEqual(TEXT("Ashfields share"), First->GetRegionScore(ETimelineState::DarkWorld, TEXT("Ashfields")), 3200);
+    TestEqual(TEXT("Mirrorwood share"), First->GetRegionScore(ETimelineState::DarkWorld, TEXT("Mirrorwood")), 3200);
+    TestEqual(TEXT("Unknown region"), First->GetRegionScore(ETimelineState::DarkWorld, TEXT("Nowhere")), 0);
+    TestEqual(TEXT("Readers see the published snapshot"), Scoreboard.GetSnapshot()->Sequence, First->Sequence);
+
+    // Shards were drained; published snapshots never change
+    Scoreboard.AddPoints(ETimelineState::DarkWorld, Ashfields, 50);
+    Scoreboard.Decay(100);
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Second = Scoreboard.Publish();
+    TestEqual(TEXT("Decay then new points"), Second->GetScore(ETimelineState::DarkWorld), 6350);
+    TestEqual(TEXT("Region decays too"), Second->GetRegionScore(ETimelineState::DarkWorld, TEXT("Ashfields")), 3150);
+    TestEqual(TEXT("Decay floors at zero"), Second->GetScore(ETimelineState::Any), 0);
+    TestEqual(TEXT("Old snapshot untouched"), First->GetScore(ETimelineState::DarkWorld), 6400);
+    TestTrue(TEXT("Sequence advances"), Second->Sequence > First->Sequence);
+
+    // Regions past capacity fold into the unassigned region
+    Scoreboard.FindOrAddRegion(TEXT("Hollowmere"));
+    TestEqual(TEXT("Full"), Scoreboard.FindOrAddRegion(TEXT("Overflow")), 0);
+
+    // Restored totals show at the next publish
+    Scoreboard.Restore(ETimelineState::BrightWorld, NAME_None, 500);
+    Scoreboard.Restore(ETimelineState::BrightWorld, TEXT("Mirrorwood"), 75);
+    const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Restored = Scoreboard.Publish();
+    TestEqual(TEXT("Restored total"), Restored->GetScore(ETimelineState::BrightWorld), 500);
+    TestEqual(TEXT("Restored region"), Restored->GetRegionScore(ETimelineState::BrightWorld, TEXT("Mirrorwood")), 75);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWarScoreboardBenchmark, "ShadowEchoes.PvP.WarScoreboardBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSEWarScoreboardBenchmark::RunTest(const FString& Parameters)
+{
+    // Every worker thread scoring into a handful of hot cells, sharded and unsharded
+    const int32 NumTasks = 256;
+    const int32 PointsPerTask = 100000;
+    const int32 NumRegions = 32;
+
+    auto Run = [&](FSEWarScoreboard& Scoreboard, double& OutScoreSeconds, double& OutPublishSeconds)
+    {
+        TArray<int32> Regions;
+        for (int32 Region = 0; Region < NumRegions; ++Region)
+        {
+            Regions.Add(Scoreboard.FindOrAddRegion(FName(*FString::Printf(TEXT("Bench_Region_%d"), Region))));
+        }
+
+        const double Start = FPlatformTime::Seconds();
+        ParallelFor(NumTasks, [&](int32 Task)
+        {
+            for (int32 Point = 0; Point < PointsPerTask; ++Point)
+            {
+                Scoreboard.AddPoints(static_cast<ETimelineState>(Point & 1), Regions[(Task + Point) % NumRegions], 1);
+            }
+        });
+        OutScoreSeconds = FPlatformTime::Seconds() - Start;
+
+        const double PublishStart = FPlatformTime::Seconds();
+        const TSharedRef<const FSEWarScoreSnapshot, ESPMode::ThreadSafe> Snapshot = Scoreboard.Publish();
+        OutPublishSeconds = FPlatformTime::Seconds() - PublishStart;
+
+        return int64(Snapshot->GetScore(ETimelineState::BrightWorld)) + Snapshot->GetScore(ETimelineState::DarkWorld);
+    };
+
+    double ShardedSeconds = 0.0;
+    double ShardedPublish = 0.0;
+    FSEWarScoreboard Sharded;
+    const int64 ShardedTotal = Run(Sharded, ShardedSeconds, ShardedPublish);
+
+    double SharedSeconds = 0.0;
+    double SharedPublish = 0.0;
+    FSEWarScoreboard Shared(64, 1);
+    const int64 SharedTotal = Run(Shared, SharedSeconds, SharedPublish);
+
+    const int64 Expected = int64(NumTasks) * PointsPerTask;
+    TestEqual(TEXT("Sharded counts every point"), ShardedTotal, Expected);
+    TestEqual(TEXT("Single shard counts every point"), SharedTotal, Expected);
+
+    AddInfo(FString::Printf(TEXT("%lld points over %d regions, %d shards: %.1f ms (%.1f M points/s), publish %.3f ms"),
+        Expected, NumRegions, Sharded.GetNumShards(), ShardedSeconds * 1000.0, Expected / FMath::Max(ShardedSeconds, 1e-9) / 1e6, ShardedPublish * 1000.0));
+    AddInfo(FString::Printf(TEXT("Same load, one shard: %.1f ms (%.1f M points/s), publish %.3f ms"),
+        SharedSeconds * 1000.0, Expected / FMath::Max(SharedSeconds, 1e-9) / 1e6, SharedPublish * 1000.0));
+    return true;
+}
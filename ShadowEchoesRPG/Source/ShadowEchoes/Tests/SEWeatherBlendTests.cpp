@@ -0,0 +1,71 @@
+#include "World/SEWeatherSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+namespace SEWeatherBlendTests
+{
+    static FSEWeatherParams MakeParams(float Intensity, float Fog)
+    {
+        FSEWeatherParams Params;
+        Params.Intensity = Intensity;
+        Params.FogDensity = Fog;
+        return Params;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWeatherBlendTest, "ShadowEchoes.World.WeatherBlend", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEWeatherBlendTest::RunTest(const FString& Parameters)
+{
+    using namespace SEWeatherBlendTests;
+
+    // Snapping reports once, then stays quiet
+    FSEWeatherBlend Blend;
+    Blend.Snap(EWeatherType::Clear, MakeParams(0.0f, 0.0f));
+    TestTrue(TEXT("First state reported"), Blend.UpdateThreshold());
+    TestFalse(TEXT("Unchanged state quiet"), Blend.UpdateThreshold());
+
+    // A 10 s blend into a full storm, smoothstep without a curve
+    Blend.Begin(EWeatherType::VoidStorm, MakeParams(1.0f, 0.8f), 10.0f);
+    TestTrue(TEXT("Transitioning"), Blend.IsTransitioning());
+
+    Blend.Advance(2.0f);
+    TestEqual(TEXT("Eased start"), Blend.CurrentParams.Intensity, FMath::SmoothStep(0.0f, 1.0f, 0.2f), 1e-4f);
+    TestFalse(TEXT("Same band, source still dominant"), Blend.UpdateThreshold());
+
+    Blend.Advance(2.0f);
+    TestTrue(TEXT("Next intensity band"), Blend.UpdateThreshold());
+    TestEqual(TEXT("Source dominant before midpoint"), Blend.DominantWeather, EWeatherType::Clear);
+
+    Blend.Advance(1.0f);
+    TestEqual(TEXT("Half way"), Blend.CurrentParams.Intensity, 0.5f, 1e-4f);
+    TestEqual(TEXT("Every parameter blends"), Blend.CurrentParams.FogDensity, 0.4f, 1e-4f);
+    TestTrue(TEXT("Midpoint reported"), Blend.UpdateThreshold());
+    TestEqual(TEXT("Target dominant at midpoint"), Blend.DominantWeather, EWeatherType::VoidStorm);
+
+    // Retargeting mid-blend starts from where the blend got to
+    const FSEWeatherParams MidBlend = Blend.CurrentParams;
+    Blend.Begin(EWeatherType::ShadowMist, MakeParams(0.0f, 0.9f), 4.0f);
+    TestTrue(TEXT("No jump on retarget"), Blend.CurrentParams.Equals(MidBlend));
+    TestEqual(TEXT("Blends away from the dominant weather"), Blend.SourceWeather, EWeatherType::VoidStorm);
+
+    // Overshooting the duration lands exactly on the target
+    Blend.Advance(100.0f);
+    TestFalse(TEXT("Finished"), Blend.IsTransitioning());
+    TestTrue(TEXT("Target reached"), Blend.CurrentParams.Equals(MakeParams(0.0f, 0.9f)));
+    TestTrue(TEXT("Final state reported"), Blend.UpdateThreshold());
+    TestEqual(TEXT("Target dominant"), Blend.DominantWeather, EWeatherType::ShadowMist);
+    TestEqual(TEXT("Lowest band"), Blend.NotifiedBand, 0);
+
+    // A zero-length blend snaps
+    Blend.Begin(EWeatherType::RadiantGlow, MakeParams(0.6f, 0.3f), 0.0f);
+    TestFalse(TEXT("Zero duration snaps"), Blend.IsTransitioning());
+    TestEqual(TEXT("Snapped intensity"), Blend.CurrentParams.Intensity, 0.6f);
+
+    // Band edges
+    TestEqual(TEXT("Band of zero"), FSEWeatherBlend::GetIntensityBand(0.0f), 0);
+    TestEqual(TEXT("Band below edge"), FSEWeatherBlend::GetIntensityBand(0.249f), 0);
+    TestEqual(TEXT("Band at edge"), FSEWeatherBlend::GetIntensityBand(0.25f), 1);
+    TestEqual(TEXT("Full intensity"), FSEWeatherBlend::GetIntensityBand(1.0f), 4);
+    TestEqual(TEXT("Clamped above one"), FSEWeatherBlend::GetIntensityBand(3.0f), 4);
+
+    return true;
+}
@@ -0,0 +1,253 @@
+#include "SaveGame/SEWorldDatabase.h"
+#include "PvP/SERatingService.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+namespace SEWorldDatabaseTests
+{
+    static FString GetTestPath(const TCHAR* Name)
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), Name);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWorldDatabaseTest, "ShadowEchoes.SaveGame.WorldDatabase", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEWorldDatabaseTest::RunTest(const FString& Parameters)
+{
+    const FString Path = SEWorldDatabaseTests::GetTestPath(TEXT("WorldDatabaseTest.db"));
+    FSEWorldDatabase::DeleteFiles(Path);
+
+    {
+        FSEWorldDatabase Database(Path, 16);
+        if (!TestTrue(TEXT("Fresh database opens"), Database.Open()))
+        {
+            return false;
+        }
+        TestEqual(TEXT("Migrated to current schema"), Database.GetSchemaVersionOnDisk(), FSEWorldDatabase::SchemaVersion);
+
+        // Uncommitted writes are readable straight away
+        Database.PutRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), 1250);
+        Database.PutRow(ESEWorldTable::WarScores, TEXT("Timeline_1"), 900);
+        int32 Score = 0;
+        TestTrue(TEXT("Read from overlay"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), Score) && Score == 1250);
+        TestEqual(TEXT("Writes queued"), Database.GetNumQueuedWrites(), 2);
+
+        Database.FlushBlocking();
+        TestEqual(TEXT("Queue drained"), Database.GetNumQueuedWrites(), 0);
+
+        // Tables are separate key spaces
+        TestFalse(TEXT("Other table is empty"), Database.GetRow(ESEWorldTable::Guilds, TEXT("Timeline_0"), Score));
+
+        Database.PutRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), 1300);
+        Database.Delete(ESEWorldTable::WarScores, TEXT("Timeline_1"));
+        TestFalse(TEXT("Delete hides the committed row"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_1"), Score));
+        Database.Close();
+    }
+
+    {
+        FSEWorldDatabase Database(Path, 16);
+        TestTrue(TEXT("Reopens"), Database.Open());
+
+        // Cold cache reads through, then hits
+        int32 Score = 0;
+        TestTrue(TEXT("Update survived reopen"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), Score) && Score == 1300);
+        TestEqual(TEXT("First read missed the cache"), Database.GetCacheMisses(), 1LL);
+        TestTrue(TEXT("Second read"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), Score));
+        TestEqual(TEXT("Second read hit the cache"), Database.GetCacheHits(), 1LL);
+        TestFalse(TEXT("Delete survived reopen"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_1"), Score));
+
+        int32 NumRows = Database.LoadAll(ESEWorldTable::WarScores, [](const FString&, const TArray<uint8>&) {});
+        TestEqual(TEXT("Scan sees one row"), NumRows, 1);
+        Database.Close();
+    }
+
+    FSEWorldDatabase::DeleteFiles(Path);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWorldDatabaseRetryTest, "ShadowEchoes.SaveGame.WorldDatabaseRetry", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEWorldDatabaseRetryTest::RunTest(const FString& Parameters)
+{
+    const FString Path = SEWorldDatabaseTests::GetTestPath(TEXT("WorldDatabaseRetryTest.db"));
+    FSEWorldDatabase::DeleteFiles(Path);
+
+    {
+        FSEWorldDatabase Database(Path, 16);
+        if (!TestTrue(TEXT("Fresh database opens"), Database.Open()))
+        {
+            return false;
+        }
+
+        // Another connection holds the write lock, so the batch is rolled back
+        FSQLiteDatabase Blocker;
+        TestTrue(TEXT("Blocker opens"), Blocker.Open(*Path, ESQLiteDatabaseOpenMode::ReadWrite));
+        TestTrue(TEXT("Write lock taken"), Blocker.Execute(TEXT("BEGIN IMMEDIATE;")));
+
+        Database.PutRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), 1250);
+        Database.FlushBlocking();
+        TestTrue(TEXT("Batch waits for a retry"), Database.HasFailedWrites());
+
+        int32 Score = 0;
+        TestTrue(TEXT("Row stays readable"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), Score) && Score == 1250);
+
+        // The retry goes ahead of newer writes, which still win
+        Blocker.Execute(TEXT("ROLLBACK;"));
+        Blocker.Close();
+        Database.PutRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), 1300);
+        Database.PutRow(ESEWorldTable::WarScores, TEXT("Timeline_1"), 900);
+        Database.FlushBlocking();
+        TestFalse(TEXT("Retry committed"), Database.HasFailedWrites());
+        Database.Close();
+    }
+
+    {
+        FSEWorldDatabase Database(Path, 16);
+        TestTrue(TEXT("Reopens"), Database.Open());
+
+        int32 Score = 0;
+        TestTrue(TEXT("Newest write on disk"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_0"), Score) && Score == 1300);
+        TestTrue(TEXT("Later batch on disk"), Database.GetRow(ESEWorldTable::WarScores, TEXT("Timeline_1"), Score) && Score == 900);
+        Database.Close();
+    }
+
+    FSEWorldDatabase::DeleteFiles(Path);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWorldDatabaseMigrationTest, "ShadowEchoes.SaveGame.WorldDatabaseMigration", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEWorldDatabaseMigrationTest::RunTest(const FString& Parameters)
+{
+    const FString Path = SEWorldDatabaseTests::GetTestPath(TEXT("WorldDatabaseMigrationTest.db"));
+    FSEWorldDatabase::DeleteFiles(Path);
+
+    // A schema 2 database holding a rating row from before rows were versioned
+    {
+        FSQLiteDatabase Old;
+        if (!TestTrue(TEXT("Old database created"), Old.Open(*Path, ESQLiteDatabaseOpenMode::ReadWriteCreate)))
+        {
+            return false;
+        }
+        for (const TCHAR* Table : { TEXT("guilds"), TEXT("guild_halls"), TEXT("guild_members"), TEXT("pvp_ratings"), TEXT("war_scores") })
+        {
+            Old.Execute(*FString::Printf(TEXT("CREATE TABLE %s (k TEXT PRIMARY KEY NOT NULL, v BLOB NOT NULL) WITHOUT ROWID;"), Table));
+        }
+        Old.SetUserVersion(2);
+
+        const double Legacy[3] = { 1720.0, 80.0, 0.05 };
+        FSQLitePreparedStatement Insert = Old.PrepareStatement(TEXT("INSERT INTO pvp_ratings (k, v) VALUES (?1, ?2);"));
+        Insert.SetBindingValueByIndex(1, FString(TEXT("Player_Old")));
+        Insert.SetBindingValueByIndex(2, TArrayView<const uint8>(reinterpret_cast<const uint8*>(Legacy), sizeof(Legacy)), false);
+        TestTrue(TEXT("Legacy row written"), Insert.Execute());
+        Insert.Destroy();
+        Old.Close();
+    }
+
+    {
+        FSEWorldDatabase Database(Path, 16);
+        if (!TestTrue(TEXT("Old database opens"), Database.Open()))
+        {
+            return false;
+        }
+        TestEqual(TEXT("Migrated to current schema"), Database.GetSchemaVersionOnDisk(), FSEWorldDatabase::SchemaVersion);
+
+        FSEGlickoRating Rating;
+        Rating.Period = 7;
+        TestTrue(TEXT("Legacy rating readable"), Database.GetRow(ESEWorldTable::PvPRatings, TEXT("Player_Old"), Rating));
+        TestEqual(TEXT("Rating kept"), Rating.Rating, 1720.0);
+        TestEqual(TEXT("Volatility kept"), Rating.Volatility, 0.05);
+        TestEqual(TEXT("Unversioned row keeps the default period"), Rating.Period, 7);
+        Database.Close();
+    }
+
+    FSEWorldDatabase::DeleteFiles(Path);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWorldDatabaseBenchmark, "ShadowEchoes.SaveGame.WorldDatabaseBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FSEWorldDatabaseBenchmark::RunTest(const FString& Parameters)
+{
+    // 1M rating rows written in server-sized batches, then loaded cold
+    const int32 NumRows = 1000000;
+    const int32 BatchSize = 10000;
+    const int32 NumReads = 100000;
+    const FString Path = SEWorldDatabaseTests::GetTestPath(TEXT("WorldDatabaseBenchmark.db"));
+    FSEWorldDatabase::DeleteFiles(Path);
+
+    TArray<FString> Keys;
+    Keys.Reserve(NumRows);
+    for (int32 Index = 0; Index < NumRows; ++Index)
+    {
+        Keys.Add(FString::Printf(TEXT("Bench_Player_%07d"), Index));
+    }
+
+    double WriteSeconds = 0.0;
+    double GameThreadSeconds = 0.0;
+    {
+        FSEWorldDatabase Database(Path);
+        if (!TestTrue(TEXT("Opens"), Database.Open()))
+        {
+            return false;
+        }
+
+        // Game-thread cost is queuing; the writer commits each batch in one transaction
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumRows; ++Index)
+        {
+            const double QueueStart = FPlatformTime::Seconds();
+            FSEGlickoRating Rating;
+            Rating.Rating = 1000.0 + Index % 2000;
+            Database.PutRow(ESEWorldTable::PvPRatings, Keys[Index], Rating);
+            if ((Index + 1) % BatchSize == 0)
+            {
+                Database.Flush();
+            }
+            GameThreadSeconds += FPlatformTime::Seconds() - QueueStart;
+        }
+        Database.FlushBlocking();
+        WriteSeconds = FPlatformTime::Seconds() - Start;
+        Database.Close();
+    }
+
+    double LoadSeconds = 0.0;
+    double ReadSeconds = 0.0;
+    int32 NumLoaded = 0;
+    double RatingSum = 0.0;
+    {
+        const double Start = FPlatformTime::Seconds();
+        FSEWorldDatabase Database(Path);
+        TestTrue(TEXT("Reopens"), Database.Open());
+        NumLoaded = Database.LoadAll(ESEWorldTable::PvPRatings, [&RatingSum](const FString&, const TArray<uint8>& Value)
+        {
+            FSEGlickoRating Rating;
+            FMemoryReader Reader(Value);
+            Reader << Rating;
+            RatingSum += Rating.Rating;
+        });
+        LoadSeconds = FPlatformTime::Seconds() - Start;
+
+        // Point reads with a skewed pattern, so the hot set stays cached
+        FRandomStream Random(43);
+        const double ReadStart = FPlatformTime::Seconds();
+        for (int32 Read = 0; Read < NumReads; ++Read)
+        {
+            const int32 Index = Random.RandHelper(8) == 0 ? Random.RandHelper(NumRows) : Random.RandHelper(2048);
+            FSEGlickoRating Rating;
+            Database.GetRow(ESEWorldTable::PvPRatings, Keys[Index], Rating);
+        }
+        ReadSeconds = FPlatformTime::Seconds() - ReadStart;
+
+        AddInfo(FString::Printf(TEXT("%d point reads: %.1f ms, %lld cache hits, %lld misses"),
+            NumReads, ReadSeconds * 1000.0, Database.GetCacheHits(), Database.GetCacheMisses()));
+        Database.Close();
+    }
+
+    TestEqual(TEXT("Every row loaded"), NumLoaded, NumRows);
+
+    AddInfo(FString::Printf(TEXT("%d rows in batches of %d: %.1f ms (%.0f rows/s), game thread %.1f ms"),
+        NumRows, BatchSize, WriteSeconds * 1000.0, NumRows / FMath::Max(WriteSeconds, 1e-9), GameThreadSeconds * 1000.0));
+    AddInfo(FString::Printf(TEXT("Cold start open + load of %d rows: %.1f ms (mean rating %.1f)"),
+        NumLoaded, LoadSeconds * 1000.0, RatingSum / FMath::Max(NumLoaded, 1)));
+
+    FSEWorldDatabase::DeleteFiles(Path);
+    return true;
+}
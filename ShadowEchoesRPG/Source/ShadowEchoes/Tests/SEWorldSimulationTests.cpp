@@ -0,0 +1,51 @@
+#include "World/SEWorldSimulation.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSEWorldSimulationTest, "ShadowEchoes.World.Simulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FSEWorldSimulationTest::RunTest(const FString& Parameters)
+{
+    FSEWorldSimulation Simulation;
+
+    // Three-area loop at 10 s per area, regaining 1% health per second
+    FSEAbstractBoss& Roamer = Simulation.AddBoss(TEXT("Test_Roamer"), { 4, 5, 6 }, 10.0f, 0.01f);
+    Roamer.HealthFraction = 0.5f;
+    Simulation.AddBoss(TEXT("Test_Promoted"), { 7 }, 10.0f, 0.01f).Tier = ESESimulationTier::Full;
+    Simulation.AddEvent(TEXT("Test_Event"), 4, 30.0f);
+
+    // 25 s is two and a half areas along the loop
+    Simulation.Advance(25.0f);
+    Simulation.Flush();
+
+    const FSEAbstractBoss* Stepped = Simulation.FindBoss(TEXT("Test_Roamer"));
+    TestEqual(TEXT("Advanced along route"), Stepped->GetArea(), 6);
+    TestEqual(TEXT("Partial progress kept"), Stepped->StepProgress, 0.5f, 0.001f);
+    TestEqual(TEXT("Health regenerated"), Stepped->HealthFraction, 0.75f, 0.001f);
+    TestEqual(TEXT("Full tier untouched"), Simulation.FindBoss(TEXT("Test_Promoted"))->HealthFraction, 1.0f);
+    TestEqual(TEXT("Event timer advanced"), Simulation.FindEvent(TEXT("Test_Event"))->RemainingTime, 5.0f, 0.001f);
+
+    // Changes made while a step is in flight win over the worker result
+    Simulation.Advance(10.0f);
+    FSEAbstractBoss* Live = Simulation.FindBoss(TEXT("Test_Roamer"));
+    Live->HealthFraction = 0.1f;
+    Simulation.Touch(*Live);
+    Simulation.Flush();
+    TestEqual(TEXT("Stale result dropped"), Simulation.FindBoss(TEXT("Test_Roamer"))->HealthFraction, 0.1f);
+
+    // The dropped step's 10 s is simulated with the next one instead of being lost
+    Simulation.Advance(5.0f);
+    Simulation.Flush();
+    Stepped = Simulation.FindBoss(TEXT("Test_Roamer"));
+    TestEqual(TEXT("Carried time regenerates"), Stepped->HealthFraction, 0.25f, 0.001f);
+    TestEqual(TEXT("Carried time roams"), Stepped->GetArea(), 5);
+    TestEqual(TEXT("Carried time used up"), Stepped->CarriedTime, 0.0f);
+
+    // Removal keeps the ID index consistent with the swapped records
+    Simulation.AddEvent(TEXT("Test_Event2"), 5, 60.0f);
+    Simulation.RemoveBoss(TEXT("Test_Roamer"));
+    TestNull(TEXT("Removed boss gone"), Simulation.FindBoss(TEXT("Test_Roamer")));
+    TestEqual(TEXT("Swapped boss still found"), Simulation.FindBoss(TEXT("Test_Promoted"))->BossID, FName(TEXT("Test_Promoted")));
+    Simulation.RemoveEvent(TEXT("Test_Event"));
+    TestEqual(TEXT("Swapped event still found"), Simulation.FindEvent(TEXT("Test_Event2"))->AreaIndex, 5);
+
+    return true;
+}
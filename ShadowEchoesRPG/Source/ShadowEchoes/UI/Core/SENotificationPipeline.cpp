@@ -0,0 +1,176 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "UI/Core/SENotificationPipeline.h"
+
+FText FSEPendingNotification::GetDisplayText() const
+{
+    if (!Notification.ItemID.IsEmpty())
+    {
+        return FText::FromString(FString::Printf(TEXT("%s: %s x%d"), *Notification.Message, *Notification.ItemID, Notification.Quantity));
+    }
+    if (Count > 1)
+    {
+        return FText::FromString(FString::Printf(TEXT("%s x%d"), *Notification.Message, Count));
+    }
+    return FText::FromString(Notification.Message);
+}
+
+FSENotificationPipeline& FSENotificationPipeline::Get()
+{
+    static FSENotificationPipeline Instance;
+    return Instance;
+}
+
+FSENotificationPipeline::FSENotificationPipeline()
+    : MaxPerSecond(2.0f)
+    , BudgetTokens(2.0f)
+    , LastRefillTime(0.0)
+    , NumMerged(0)
+    , NumDropped(0)
+{
+    // Default priorities, higher shows first
+    TypePriorities[static_cast<int32>(ENotificationType::Default)] = 0;
+    TypePriorities[static_cast<int32>(ENotificationType::Combat)] = 1;
+    TypePriorities[static_cast<int32>(ENotificationType::Timeline)] = 2;
+    TypePriorities[static_cast<int32>(ENotificationType::Quest)] = 3;
+    TypePriorities[static_cast<int32>(ENotificationType::Achievement)] = 4;
+}
+
+void FSENotificationPipeline::Post(FSENotificationMessage&& Message)
+{
+    Get().Push(MoveTemp(Message));
+}
+
+void FSENotificationPipeline::Post(const FString& Message, ENotificationType Type, float Duration)
+{
+    FSENotificationMessage NewMessage;
+    NewMessage.Message = Message;
+    NewMessage.Type = Type;
+    NewMessage.Duration = Duration;
+    Post(MoveTemp(NewMessage));
+}
+
+void FSENotificationPipeline::PostItem(const FString& Message, const FString& ItemID, int32 Quantity, ENotificationType Type)
+{
+    FSENotificationMessage NewMessage;
+    NewMessage.Message = Message;
+    NewMessage.Type = Type;
+    NewMessage.ItemID = ItemID;
+    NewMessage.Quantity = Quantity;
+    Post(MoveTemp(NewMessage));
+}
+
+void FSENotificationPipeline::Drain()
+{
+    check(IsInGameThread());
+
+    FSENotificationMessage Message;
+    while (Inbox.Dequeue(Message))
+    {
+        Enqueue(MoveTemp(Message));
+    }
+}
+
+void FSENotificationPipeline::Enqueue(FSENotificationMessage&& Message)
+{
+    const int32 TypeIndex = FMath::Clamp(static_cast<int32>(Message.Type), 0, NumTypes - 1);
+    FRing& Ring = Rings[TypeIndex];
+    const uint32 Hash = HashCombineFast(GetTypeHash(Message.Message), GetTypeHash(Message.ItemID));
+
+    // Merge with an identical pending message of the same type and item
+    for (int32 Index = 0; Index < Ring.Num; ++Index)
+    {
+        FSEPendingNotification& Pending = Ring.At(Index);
+        if (Pending.MessageHash == Hash
+            && Pending.Notification.Message.Equals(Message.Message, ESearchCase::CaseSensitive)
+            && Pending.Notification.ItemID.Equals(Message.ItemID, ESearchCase::CaseSensitive))
+        {
+            ++Pending.Count;
+            Pending.Notification.Quantity += Message.Quantity;
+            Pending.Notification.Duration = FMath::Max(Pending.Notification.Duration, Message.Duration);
+            ++NumMerged;
+            return;
+        }
+    }
+
+    // Full ring: evict the oldest entry of this type
+    if (Ring.Num == RingCapacity)
+    {
+        Ring.Head = (Ring.Head + 1) & (RingCapacity - 1);
+        --Ring.Num;
+        ++NumDropped;
+    }
+
+    FSEPendingNotification& Slot = Ring.At(Ring.Num);
+    Slot.Notification = MoveTemp(Message);
+    Slot.MessageHash = Hash;
+    Slot.Count = 1;
+    ++Ring.Num;
+}
+
+bool FSENotificationPipeline::Pop(double CurrentTime, FSEPendingNotification& OutNotification)
+{
+    check(IsInGameThread());
+
+    // Refill the per-second budget
+    const float Elapsed = static_cast<float>(FMath::Max(0.0, CurrentTime - LastRefillTime));
+    LastRefillTime = CurrentTime;
+    BudgetTokens = FMath::Min(MaxPerSecond, BudgetTokens + Elapsed * MaxPerSecond);
+    if (BudgetTokens < 1.0f)
+    {
+        return false;
+    }
+
+    // Highest priority non-empty ring
+    int32 BestType = INDEX_NONE;
+    for (int32 TypeIndex = 0; TypeIndex < NumTypes; ++TypeIndex)
+    {
+        if (Rings[TypeIndex].Num > 0 && (BestType == INDEX_NONE || TypePriorities[TypeIndex] > TypePriorities[BestType]))
+        {
+            BestType = TypeIndex;
+        }
+    }
+
+    if (BestType == INDEX_NONE)
+    {
+        return false;
+    }
+
+    FRing& Ring = Rings[BestType];
+    OutNotification = MoveTemp(Ring.At(0));
+    Ring.Head = (Ring.Head + 1) & (RingCapacity - 1);
+    --Ring.Num;
+
+    BudgetTokens -= 1.0f;
+    return true;
+}
+
+void FSENotificationPipeline::Reset()
+{
+    Drain();
+
+    for (FRing& Ring : Rings)
+    {
+        Ring.Head = 0;
+        Ring.Num = 0;
+    }
+}
+
+void FSENotificationPipeline::SetTypePriority(ENotificationType Type, int32 Priority)
+{
+    const int32 TypeIndex = static_cast<int32>(Type);
+    if (TypeIndex >= 0 && TypeIndex < NumTypes)
+    {
+        TypePriorities[TypeIndex] = Priority;
+    }
+}
+
+int32 FSENotificationPipeline::GetNumPending() const
+{
+    int32 Total = 0;
+    for (const FRing& Ring : Rings)
+    {
+        Total += Ring.Num;
+    }
+    return Total;
+}
@@ -0,0 +1,113 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "UI/Widgets/NotificationWidget.h"
+
+/**
+ * Notification posted by a gameplay system. Plain data only so that it can be
+ * created on any thread without touching UObjects.
+ */
+struct SHADOWECHOES_API FSENotificationMessage
+{
+    FString Message;
+    ENotificationType Type = ENotificationType::Default;
+    float Duration = 3.0f;
+
+    /** Item the message is about, if any; identical item messages merge by summing Quantity */
+    FString ItemID;
+    int32 Quantity = 0;
+
+    /** Optional sound override; only honoured for game-thread posts */
+    TWeakObjectPtr<USoundBase> Sound;
+};
+
+/**
+ * Pending notification after coalescing. Count > 1 means identical messages were merged.
+ */
+struct SHADOWECHOES_API FSEPendingNotification
+{
+    FSENotificationMessage Notification;
+    uint32 MessageHash = 0;
+    int32 Count = 0;
+
+    /** Message text with merge suffix applied, e.g. "Item sold x5" or "Trade completed: Iron_Ore x12" */
+    FText GetDisplayText() const;
+};
+
+/**
+ * Coalescing, rate-limited notification pipeline
+ *
+ * Producers call Post() from any thread; messages go through a lock-free MPSC queue.
+ * The consumer (UNotificationWidget) drains it on the game thread into fixed-size
+ * per-type ring buffers, merging identical pending messages, and pops entries in
+ * priority order subject to a per-second budget.
+ */
+class SHADOWECHOES_API FSENotificationPipeline
+{
+public:
+    /** Get the pipeline instance */
+    static FSENotificationPipeline& Get();
+
+    FSENotificationPipeline();
+
+    /** Post a notification; safe from any thread */
+    static void Post(FSENotificationMessage&& Message);
+    static void Post(const FString& Message, ENotificationType Type = ENotificationType::Default, float Duration = 3.0f);
+    static void PostItem(const FString& Message, const FString& ItemID, int32 Quantity, ENotificationType Type = ENotificationType::Default);
+
+    /** Post into this pipeline's inbox; safe from any thread */
+    void Push(FSENotificationMessage&& Message) { Inbox.Enqueue(MoveTemp(Message)); }
+
+    /** Game thread: move posted messages into the ring buffers */
+    void Drain();
+
+    /** Game thread: pop the highest priority pending notification if the budget allows */
+    bool Pop(double CurrentTime, FSEPendingNotification& OutNotification);
+
+    /** Game thread: drop all pending notifications */
+    void Reset();
+
+    /** Configuration */
+    void SetTypePriority(ENotificationType Type, int32 Priority);
+    void SetMaxPerSecond(float InMaxPerSecond) { MaxPerSecond = FMath::Max(0.1f, InMaxPerSecond); }
+
+    /** Stats */
+    int32 GetNumPending() const;
+    int32 GetNumMerged() const { return NumMerged; }
+    int32 GetNumDropped() const { return NumDropped; }
+
+private:
+    /** Ring capacity per type; power of two */
+    static constexpr int32 RingCapacity = 32;
+    static constexpr int32 NumTypes = static_cast<int32>(ENotificationType::Achievement) + 1;
+
+    /** Fixed-size ring buffer of pending notifications for one type */
+    struct FRing
+    {
+        FSEPendingNotification Slots[RingCapacity];
+        int32 Head = 0;
+        int32 Num = 0;
+
+        FSEPendingNotification& At(int32 Index) { return Slots[(Head + Index) & (RingCapacity - 1)]; }
+    };
+
+    /** Merge into an existing pending entry or append, evicting the oldest when full */
+    void Enqueue(FSENotificationMessage&& Message);
+
+    /** Multi-producer single-consumer inbox */
+    TQueue<FSENotificationMessage, EQueueMode::Mpsc> Inbox;
+
+    FRing Rings[NumTypes];
+    int32 TypePriorities[NumTypes];
+
+    /** Token bucket for the per-second budget */
+    float MaxPerSecond;
+    float BudgetTokens;
+    double LastRefillTime;
+
+    int32 NumMerged;
+    int32 NumDropped;
+};
@@ -8,6 +8,8 @@
 #include "UI/Widgets/DamageNumberWidget.h"
 #include "Blueprint/UserWidget.h"
 #include "Core/SEGameInstance.h"
+#include "Combat/AbilityComponent.h"
+#include "GameFramework/PlayerController.h"
 
 ASEGameHUD::ASEGameHUD()
 {
@@ -63,6 +65,12 @@ void ASEGameHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
     }
     DamageNumberPool.Empty();
 
+    if (APlayerController* PlayerController = GetOwningPlayerController())
+    {
+        PlayerController->OnPossessedPawnChanged.RemoveDynamic(this, &ASEGameHUD::HandlePossessedPawnChanged);
+        HandlePossessedPawnChanged(PlayerController->GetPawn(), nullptr);
+    }
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -108,6 +116,14 @@ void ASEGameHUD::UpdateAbilities(const TArray<FAbilityInfo>& Abilities)
     }
 }
 
+void ASEGameHUD::OnAbilityCooldownStarted(const FName& AbilityName, float StartTime, float Duration)
+{
+    if (CombatWidget)
+    {
+        CombatWidget->StartAbilityCooldown(AbilityName, StartTime, Duration);
+    }
+}
+
 void ASEGameHUD::ShowQuestLog()
 {
     if (QuestLogWidget)
@@ -240,6 +256,26 @@ void ASEGameHUD::SetupCallbacks()
     {
         GameInstance->OnTimelineStateChanged.AddDynamic(this, &ASEGameHUD::OnTimelineStateChanged);
     }
+
+    // Register for ability cooldowns of whichever pawn the player controls
+    if (APlayerController* PlayerController = GetOwningPlayerController())
+    {
+        PlayerController->OnPossessedPawnChanged.AddDynamic(this, &ASEGameHUD::HandlePossessedPawnChanged);
+        HandlePossessedPawnChanged(nullptr, PlayerController->GetPawn());
+    }
+}
+
+void ASEGameHUD::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+    if (UAbilityComponent* OldAbilities = OldPawn ? OldPawn->FindComponentByClass<UAbilityComponent>() : nullptr)
+    {
+        OldAbilities->OnCooldownStarted.RemoveDynamic(this, &ASEGameHUD::OnAbilityCooldownStarted);
+    }
+
+    if (UAbilityComponent* NewAbilities = NewPawn ? NewPawn->FindComponentByClass<UAbilityComponent>() : nullptr)
+    {
+        NewAbilities->OnCooldownStarted.AddUniqueDynamic(this, &ASEGameHUD::OnAbilityCooldownStarted);
+    }
 }
 
 void ASEGameHUD::AddWidgetToViewport(UUserWidget* Widget, int32 ZOrder)
@@ -58,6 +58,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Combat")
     void UpdateAbilities(const TArray<FAbilityInfo>& Abilities);
 
+    /** Bound to the possessed pawn's UAbilityComponent::OnCooldownStarted */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Combat")
+    void OnAbilityCooldownStarted(const FName& AbilityName, float StartTime, float Duration);
+
     /** Quest UI */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Quests")
     void ShowQuestLog();
@@ -125,6 +129,10 @@ private:
     void CreateWidgets();
     void SetupCallbacks();
 
+    /** Follow the owning player's pawn so its ability cooldowns reach the hotbar */
+    UFUNCTION()
+    void HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
     /** Widget management */
     void AddWidgetToViewport(class UUserWidget* Widget, int32 ZOrder = 0);
     void RemoveWidgetFromViewport(class UUserWidget* Widget);
@@ -7,11 +7,51 @@
 #include "Components/Button.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/GameplayStatics.h"
+#include "Animation/WidgetAnimation.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+namespace
+{
+    /** Clock seen by the Time node of UI-domain materials */
+    float GetUIMaterialTime()
+    {
+        return static_cast<float>(FApp::GetCurrentTime() - GStartTime);
+    }
+}
+
+void FSECooldownSweepClock::Rebase(float UITime, float WorldTime, float NewRate)
+{
+    AnchorUITime = UITime;
+    AnchorWorldTime = WorldTime;
+    Rate = NewRate;
+}
+
+float FSECooldownSweepClock::GetRemaining(float UITime, float StartTime, float Duration) const
+{
+    if (Duration <= 0.0f)
+    {
+        return 0.0f;
+    }
+    return 1.0f - FMath::Clamp((GetWorldTime(UITime) - StartTime) / Duration, 0.0f, 1.0f);
+}
+
+float FSECooldownSweepClock::GetWorldRate(const UWorld* World)
+{
+    if (!World || World->IsPaused())
+    {
+        return 0.0f;
+    }
+
+    const AWorldSettings* WorldSettings = World->GetWorldSettings();
+    return WorldSettings ? WorldSettings->GetEffectiveTimeDilation() : 1.0f;
+}
 
 UAbilitySlotWidget::UAbilitySlotWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
     , CooldownDuration(0.0f)
-    , CurrentCooldown(0.0f)
+    , CooldownEndTime(0.0f)
     , EnergyCost(0.0f)
     , RequiredTimeline(ETimelineState::Any)
     , bIsOnCooldown(false)
@@ -19,8 +59,7 @@ UAbilitySlotWidget::UAbilitySlotWidget(const FObjectInitializer& ObjectInitializ
     , UnavailableColor(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
     , CooldownColor(FLinearColor(0.2f, 0.2f, 0.2f, 0.8f))
 {
-    // Enable tick for cooldown updates
-    PrimaryComponentTick.bCanEverTick = true;
+    // No tick: the cooldown sweep is animated on the GPU and expiry is a single timer
 }
 
 void UAbilitySlotWidget::NativeConstruct()
@@ -31,22 +70,14 @@ void UAbilitySlotWidget::NativeConstruct()
     CreateMaterialInstance();
 }
 
-void UAbilitySlotWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UAbilitySlotWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
-
-    if (bIsOnCooldown)
+    if (UWorld* World = GetWorld())
     {
-        // Update cooldown
-        CurrentCooldown -= InDeltaTime;
-        UpdateCooldownDisplay();
-
-        // Check for completion
-        if (CurrentCooldown <= 0.0f)
-        {
-            CompleteCooldown();
-        }
+        World->GetTimerManager().ClearTimer(CooldownTimerHandle);
     }
+
+    Super::NativeDestruct();
 }
 
 void UAbilitySlotWidget::SetAbility(const FAbilityInfo& Ability)
@@ -72,8 +103,12 @@ void UAbilitySlotWidget::SetAbility(const FAbilityInfo& Ability)
     UpdateTimelineIcon();
 
     // Reset cooldown
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(CooldownTimerHandle);
+    }
     bIsOnCooldown = false;
-    CurrentCooldown = 0.0f;
+    CooldownEndTime = 0.0f;
     UpdateCooldownDisplay();
 
     // Enable button
@@ -91,11 +126,16 @@ void UAbilitySlotWidget::ClearAbility()
     // Clear data
     AbilityID = NAME_None;
     CooldownDuration = 0.0f;
-    CurrentCooldown = 0.0f;
+    CooldownEndTime = 0.0f;
     EnergyCost = 0.0f;
     RequiredTimeline = ETimelineState::Any;
     bIsOnCooldown = false;
 
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(CooldownTimerHandle);
+    }
+
     // Clear visuals
     if (AbilityIcon)
     {
@@ -124,15 +164,65 @@ void UAbilitySlotWidget::ClearAbility()
 
 void UAbilitySlotWidget::StartCooldown()
 {
-    if (!bIsOnCooldown && CooldownDuration > 0.0f)
+    UWorld* World = GetWorld();
+    if (World && !bIsOnCooldown && CooldownDuration > 0.0f)
     {
-        bIsOnCooldown = true;
-        CurrentCooldown = CooldownDuration;
-        UpdateCooldownDisplay();
+        StartCooldownAt(World->GetTimeSeconds(), CooldownDuration);
+    }
+}
 
-        // Notify blueprint
-        BP_OnCooldownStarted();
+void UAbilitySlotWidget::StartCooldownAt(float StartTime, float Duration)
+{
+    UWorld* World = GetWorld();
+    if (!World || Duration <= 0.0f)
+    {
+        return;
+    }
+
+    const float Now = World->GetTimeSeconds();
+    const float Elapsed = FMath::Max(0.0f, Now - StartTime);
+    const float Remaining = Duration - Elapsed;
+    if (Remaining <= 0.0f)
+    {
+        if (bIsOnCooldown)
+        {
+            CompleteCooldown();
+        }
+        return;
+    }
+
+    bIsOnCooldown = true;
+    CooldownDuration = Duration;
+    CooldownEndTime = Now + Remaining;
+
+    // The material derives the remaining fraction from its own Time node mapped onto world time
+    SweepClock.Rebase(GetUIMaterialTime(), Now, FSECooldownSweepClock::GetWorldRate(World));
+    SetSweepParameters(Now - Elapsed, Duration);
+
+    if (CooldownBar)
+    {
+        CooldownBar->SetPercent(Elapsed / Duration);
     }
+
+    UpdateAvailability(false);
+
+    // Single expiry timer on the world clock; it is authoritative for readiness
+    World->GetTimerManager().SetTimer(CooldownTimerHandle, this, &UAbilitySlotWidget::CompleteCooldown, Remaining, false);
+
+    // Notify blueprint
+    BP_OnCooldownStarted();
+}
+
+void UAbilitySlotWidget::SyncSweepClock(float WorldRate)
+{
+    UWorld* World = GetWorld();
+    if (!World || !bIsOnCooldown || WorldRate == SweepClock.Rate)
+    {
+        return;
+    }
+
+    SweepClock.Rebase(GetUIMaterialTime(), World->GetTimeSeconds(), WorldRate);
+    SetSweepClockParameters();
 }
 
 void UAbilitySlotWidget::UpdateEnergyCost(float CurrentEnergy)
@@ -155,11 +245,14 @@ void UAbilitySlotWidget::OnTimelineStateChanged(ETimelineState NewState)
 
 float UAbilitySlotWidget::GetCooldownProgress() const
 {
-    if (!bIsOnCooldown || CooldownDuration <= 0.0f)
+    const UWorld* World = GetWorld();
+    if (!bIsOnCooldown || CooldownDuration <= 0.0f || !World)
     {
         return 1.0f;
     }
-    return 1.0f - (CurrentCooldown / CooldownDuration);
+
+    const float Remaining = CooldownEndTime - World->GetTimeSeconds();
+    return FMath::Clamp(1.0f - (Remaining / CooldownDuration), 0.0f, 1.0f);
 }
 
 bool UAbilitySlotWidget::CanActivate() const
@@ -258,7 +351,7 @@ void UAbilitySlotWidget::UpdateTimelineIcon()
 
 void UAbilitySlotWidget::UpdateCooldownDisplay()
 {
-    // Update cooldown progress
+    // Snapshot only; the sweep itself animates without CPU updates
     float Progress = GetCooldownProgress();
 
     if (CooldownBar)
@@ -266,9 +359,30 @@ void UAbilitySlotWidget::UpdateCooldownDisplay()
         CooldownBar->SetPercent(Progress);
     }
 
+    if (!bIsOnCooldown)
+    {
+        // A zero duration makes the material treat the sweep as finished
+        SetSweepParameters(0.0f, 0.0f);
+    }
+}
+
+void UAbilitySlotWidget::SetSweepParameters(float StartTime, float Duration)
+{
     if (CooldownMID)
     {
-        CooldownMID->SetScalarParameterValue(TEXT("Progress"), Progress);
+        CooldownMID->SetScalarParameterValue(TEXT("CooldownStartTime"), StartTime);
+        CooldownMID->SetScalarParameterValue(TEXT("CooldownDuration"), Duration);
+        SetSweepClockParameters();
+    }
+}
+
+void UAbilitySlotWidget::SetSweepClockParameters()
+{
+    if (CooldownMID)
+    {
+        CooldownMID->SetScalarParameterValue(TEXT("SweepAnchorUITime"), SweepClock.AnchorUITime);
+        CooldownMID->SetScalarParameterValue(TEXT("SweepAnchorWorldTime"), SweepClock.AnchorWorldTime);
+        CooldownMID->SetScalarParameterValue(TEXT("SweepTimeRate"), SweepClock.Rate);
     }
 }
 
@@ -330,12 +444,23 @@ void UAbilitySlotWidget::OnActivateButtonClicked()
 void UAbilitySlotWidget::CompleteCooldown()
 {
     bIsOnCooldown = false;
-    CurrentCooldown = 0.0f;
+    CooldownEndTime = 0.0f;
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(CooldownTimerHandle);
+    }
 
     // Update visuals
     UpdateCooldownDisplay();
     UpdateAvailability(CanActivate());
 
+    // Ready flash
+    if (ReadyFlashAnim)
+    {
+        PlayAnimation(ReadyFlashAnim);
+    }
+
     // Play sound
     if (CooldownCompleteSound)
     {
@@ -16,6 +16,31 @@ class UMaterialInstanceDynamic;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAbilityActivated, const FName&, AbilityID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCooldownComplete, const FName&, AbilityID);
 
+/**
+ * Maps the UI material clock onto world time for the cooldown sweep
+ *
+ * UI materials only see the UI clock, which keeps running through pause and time dilation.
+ * The sweep gets an anchor pair and the world clock's rate instead, and is re-anchored when
+ * that rate changes, so it follows world time without per-frame updates.
+ */
+struct SHADOWECHOES_API FSECooldownSweepClock
+{
+    float AnchorUITime = 0.0f;
+    float AnchorWorldTime = 0.0f;
+    float Rate = 1.0f;
+
+    /** Re-anchor at the current times; WorldTime is authoritative, so drift never accumulates */
+    void Rebase(float UITime, float WorldTime, float NewRate);
+
+    float GetWorldTime(float UITime) const { return AnchorWorldTime + (UITime - AnchorUITime) * Rate; }
+
+    /** Remaining fraction of a cooldown as the sweep material computes it */
+    float GetRemaining(float UITime, float StartTime, float Duration) const;
+
+    /** World seconds per UI second: 0 while paused, the effective time dilation otherwise */
+    static float GetWorldRate(const UWorld* World);
+};
+
 /**
  * Widget for displaying and managing individual ability slots
  */
@@ -28,7 +53,7 @@ public:
     UAbilitySlotWidget(const FObjectInitializer& ObjectInitializer);
 
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
 
     /** Ability setup */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Abilities")
@@ -41,6 +66,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Abilities")
     void StartCooldown();
 
+    /** Start a cooldown that began at StartTime (world seconds); the sweep is animated by CooldownMaterial */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Abilities")
+    void StartCooldownAt(float StartTime, float Duration);
+
+    /** Re-anchor a running sweep after pause or time dilation changed the world clock's rate */
+    void SyncSweepClock(float WorldRate);
+
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Abilities")
     void UpdateEnergyCost(float CurrentEnergy);
 
@@ -48,6 +80,9 @@ public:
     virtual void OnTimelineStateChanged(ETimelineState NewState) override;
 
     /** Getters */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|UI|Abilities")
+    FName GetAbilityID() const { return AbilityID; }
+
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|UI|Abilities")
     bool HasAbility() const { return !AbilityID.IsNone(); }
 
@@ -87,7 +122,12 @@ protected:
     UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
     UImage* TimelineIcon;
 
+    /** Animations */
+    UPROPERTY(Transient, meta = (BindWidgetAnimOptional))
+    UWidgetAnimation* ReadyFlashAnim;
+
     /** Visual settings */
+    /** Radial sweep material; reads CooldownStartTime/CooldownDuration and the sweep clock against the material Time node */
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|UI|Style")
     UMaterialInterface* CooldownMaterial;
 
@@ -120,11 +160,16 @@ private:
     /** Ability data */
     FName AbilityID;
     float CooldownDuration;
-    float CurrentCooldown;
+    float CooldownEndTime;
     float EnergyCost;
     ETimelineState RequiredTimeline;
     bool bIsOnCooldown;
 
+    /** Fires once when the current cooldown expires */
+    FTimerHandle CooldownTimerHandle;
+
+    FSECooldownSweepClock SweepClock;
+
     /** Material instance */
     UPROPERTY()
     UMaterialInstanceDynamic* CooldownMID;
@@ -137,6 +182,8 @@ private:
     void UpdateVisuals();
     void UpdateTimelineIcon();
     void UpdateCooldownDisplay();
+    void SetSweepParameters(float StartTime, float Duration);
+    void SetSweepClockParameters();
     void UpdateEnergyDisplay(float CurrentEnergy);
     void UpdateAvailability(bool bCanActivate);
 
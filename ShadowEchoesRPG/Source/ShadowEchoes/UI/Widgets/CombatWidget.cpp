@@ -15,6 +15,7 @@ UCombatWidget::UCombatWidget(const FObjectInitializer& ObjectInitializer)
     , CurrentEnergyPercent(1.0f)
     , bIsLowHealth(false)
     , bIsLowEnergy(false)
+    , SweepClockRate(1.0f)
     , HealthBarColor(FLinearColor(0.0f, 1.0f, 0.0f, 1.0f))
     , LowHealthColor(FLinearColor(1.0f, 0.0f, 0.0f, 1.0f))
     , EnergyBarColor(FLinearColor(0.0f, 0.8f, 1.0f, 1.0f))
@@ -30,6 +31,26 @@ void UCombatWidget::NativeConstruct()
     CreateMaterialInstances();
 }
 
+void UCombatWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    // Cooldown sweeps follow world time on their own; they only need re-anchoring when
+    // pause or time dilation changes the world clock's rate
+    const float WorldRate = FSECooldownSweepClock::GetWorldRate(GetWorld());
+    if (WorldRate != SweepClockRate)
+    {
+        SweepClockRate = WorldRate;
+        for (UAbilitySlotWidget* Slot : AbilitySlots)
+        {
+            if (Slot)
+            {
+                Slot->SyncSweepClock(WorldRate);
+            }
+        }
+    }
+}
+
 void UCombatWidget::UpdateHealth(float CurrentHealth, float MaxHealth)
 {
     // Calculate percentage
@@ -122,6 +143,17 @@ void UCombatWidget::ClearAbilities()
     AbilitySlots.Empty();
 }
 
+void UCombatWidget::StartAbilityCooldown(const FName& AbilityID, float StartTime, float Duration)
+{
+    for (UAbilitySlotWidget* Slot : AbilitySlots)
+    {
+        if (Slot && Slot->GetAbilityID() == AbilityID)
+        {
+            Slot->StartCooldownAt(StartTime, Duration);
+        }
+    }
+}
+
 void UCombatWidget::ShowWidget()
 {
     SetVisibility(ESlateVisibility::Visible);
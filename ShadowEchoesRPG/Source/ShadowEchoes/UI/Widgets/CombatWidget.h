@@ -26,6 +26,7 @@ public:
     UCombatWidget(const FObjectInitializer& ObjectInitializer);
 
     virtual void NativeConstruct() override;
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
     /** Health management */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Combat")
@@ -42,6 +43,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Combat")
     void ClearAbilities();
 
+    /** Route a cooldown start (world seconds) to the matching ability slot */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Combat")
+    void StartAbilityCooldown(const FName& AbilityID, float StartTime, float Duration);
+
     /** Combat state */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|UI|Combat")
     void ShowWidget();
@@ -126,6 +131,9 @@ private:
     bool bIsLowHealth;
     bool bIsLowEnergy;
 
+    /** World clock rate the cooldown sweeps were last anchored to */
+    float SweepClockRate;
+
     /** Initialize UI */
     void InitializeWidgets();
     void CreateMaterialInstances();
@@ -5,6 +5,7 @@
 #include "Components/Image.h"
 #include "Animation/WidgetAnimation.h"
 #include "Kismet/GameplayStatics.h"
+#include "UI/Core/SENotificationPipeline.h"
 
 UNotificationWidget::UNotificationWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -15,8 +16,9 @@ UNotificationWidget::UNotificationWidget(const FObjectInitializer& ObjectInitial
     , TimelineColor(FLinearColor(1.0f, 0.8f, 0.0f, 1.0f))
     , CombatColor(FLinearColor(1.0f, 0.2f, 0.2f, 1.0f))
     , AchievementColor(FLinearColor(0.8f, 0.4f, 1.0f, 1.0f))
+    , MaxNotificationsPerSecond(2.0f)
 {
-    // Enable tick for notification timing
+    // Enable tick for notification timing and pipeline draining
     PrimaryComponentTick.bCanEverTick = true;
 }
 
@@ -26,6 +28,8 @@ void UNotificationWidget::NativeConstruct()
 
     InitializeWidgets();
 
+    FSENotificationPipeline::Get().SetMaxPerSecond(MaxNotificationsPerSecond);
+
     // Bind animation finished events
     if (ShowAnimation)
     {
@@ -49,6 +53,11 @@ void UNotificationWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaT
             CompleteCurrentNotification();
         }
     }
+    else
+    {
+        // Pick up messages posted by gameplay systems (possibly off the game thread)
+        ProcessNotificationQueue();
+    }
 }
 
 void UNotificationWidget::ShowNotification(const FText& Message, float Duration)
@@ -61,8 +70,15 @@ void UNotificationWidget::ShowNotification(const FText& Message, float Duration)
 
 void UNotificationWidget::ShowNotificationWithType(const FNotificationInfo& Notification)
 {
-    // Add to queue
-    NotificationQueue.Add(Notification);
+    // Route through the pipeline so bursts are merged and rate-limited
+    FSENotificationMessage Message;
+    Message.Message = Notification.Message.ToString();
+    Message.Type = Notification.Type;
+    Message.Duration = Notification.Duration;
+    Message.Sound = Notification.Sound;
+    Message.ItemID = Notification.ItemID;
+    Message.Quantity = Notification.Quantity;
+    FSENotificationPipeline::Post(MoveTemp(Message));
 
     // Process queue if not currently showing a notification
     if (!bIsShowingNotification)
@@ -74,7 +90,7 @@ void UNotificationWidget::ShowNotificationWithType(const FNotificationInfo& Noti
 void UNotificationWidget::ClearNotifications()
 {
     // Clear queue
-    NotificationQueue.Empty();
+    FSENotificationPipeline::Get().Reset();
 
     // Hide current notification if showing
     if (bIsShowingNotification)
@@ -98,7 +114,7 @@ void UNotificationWidget::OnTimelineStateChanged(ETimelineState NewState)
     // Update visuals for current notification if showing
     if (bIsShowingNotification)
     {
-        UpdateNotificationStyle(NotificationQueue[0].Type);
+        UpdateNotificationStyle(CurrentNotification.Type);
     }
 
     // Notify blueprint
@@ -119,21 +135,29 @@ void UNotificationWidget::InitializeWidgets()
 
 void UNotificationWidget::ProcessNotificationQueue()
 {
-    if (NotificationQueue.Num() > 0 && !bIsShowingNotification)
+    if (!bIsShowingNotification)
     {
+        FSENotificationPipeline::Get().Drain();
         ShowNextNotification();
     }
 }
 
 void UNotificationWidget::ShowNextNotification()
 {
-    if (NotificationQueue.Num() == 0)
+    FSEPendingNotification Pending;
+    if (!FSENotificationPipeline::Get().Pop(FPlatformTime::Seconds(), Pending))
     {
         return;
     }
 
     // Get next notification
-    const FNotificationInfo& Notification = NotificationQueue[0];
+    CurrentNotification.Message = Pending.GetDisplayText();
+    CurrentNotification.Type = Pending.Notification.Type;
+    CurrentNotification.Duration = Pending.Notification.Duration;
+    CurrentNotification.Sound = Pending.Notification.Sound.Get();
+    CurrentNotification.ItemID = Pending.Notification.ItemID;
+    CurrentNotification.Quantity = Pending.Notification.Quantity;
+    const FNotificationInfo& Notification = CurrentNotification;
 
     // Set notification text
     if (NotificationText)
@@ -271,12 +295,6 @@ void UNotificationWidget::OnHideAnimationFinished()
     SetVisibility(ESlateVisibility::Hidden);
     bIsShowingNotification = false;
 
-    // Remove completed notification
-    if (NotificationQueue.Num() > 0)
-    {
-        NotificationQueue.RemoveAt(0);
-    }
-
     // Notify blueprint
     BP_OnNotificationHidden();
 
@@ -39,16 +39,25 @@ struct FNotificationInfo
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Notification")
     USoundBase* Sound;
 
+    /** Item the notification is about, empty if none; Quantity is summed over merged messages */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Notification")
+    FString ItemID;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Notification")
+    int32 Quantity;
+
     FNotificationInfo()
         : Type(ENotificationType::Default)
         , Duration(3.0f)
         , Sound(nullptr)
+        , Quantity(0)
     {
     }
 };
 
 /**
  * Widget for displaying game notifications and messages
+ * Consumes FSENotificationPipeline, which coalesces and rate-limits incoming messages
  */
 UCLASS()
 class SHADOWECHOES_API UNotificationWidget : public USEBaseWidget
@@ -141,9 +150,13 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|UI|Audio")
     USoundBase* AchievementSound;
 
+    /** Pipeline settings */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|UI|Notifications")
+    float MaxNotificationsPerSecond;
+
 private:
-    /** Notification queue */
-    TArray<FNotificationInfo> NotificationQueue;
+    /** Notification currently on screen */
+    FNotificationInfo CurrentNotification;
     float CurrentNotificationTime;
     bool bIsShowingNotification;
 
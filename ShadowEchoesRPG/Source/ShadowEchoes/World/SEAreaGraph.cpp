@@ -0,0 +1,228 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "World/SEAreaGraph.h"
+#include "World/SEWorldManager.h"
+#include "Core/SEProgression.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+
+FSEAreaGraph::FSEAreaGraph()
+    : StartArea(INDEX_NONE)
+{
+}
+
+void FSEAreaGraph::Build(const TMap<FName, FWorldArea>& Areas)
+{
+    FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+
+    // Every area and every connection target needs an index before the arrays are sized
+    TArray<TPair<int32, int32>> Edges;
+    for (const auto& Pair : Areas)
+    {
+        const int32 From = Registry.FindOrAdd(ESEProgressionDomain::Area, Pair.Key);
+        for (const FName& ConnectedArea : Pair.Value.ConnectedAreas)
+        {
+            const int32 To = Registry.FindOrAdd(ESEProgressionDomain::Area, ConnectedArea);
+            if (From != INDEX_NONE && To != INDEX_NONE && From != To)
+            {
+                Edges.Emplace(From, To);
+            }
+        }
+    }
+
+    Edges.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+    {
+        return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+    });
+
+    // Compressed sparse rows
+    const int32 NumNodes = Registry.Num(ESEProgressionDomain::Area);
+    Offsets.Reset(NumNodes + 1);
+    Offsets.AddZeroed(NumNodes + 1);
+    Neighbors.Reset(Edges.Num());
+
+    for (int32 Index = 0; Index < Edges.Num(); ++Index)
+    {
+        // Duplicate connections in the data collapse to one edge
+        if (Index > 0 && Edges[Index] == Edges[Index - 1])
+        {
+            continue;
+        }
+        Neighbors.Add(Edges[Index].Value);
+        ++Offsets[Edges[Index].Key + 1];
+    }
+
+    for (int32 Node = 0; Node < NumNodes; ++Node)
+    {
+        Offsets[Node + 1] += Offsets[Node];
+    }
+
+    Reachable.Init(false, NumNodes);
+    Frontier.Init(false, NumNodes);
+    RouteCache.Reset();
+}
+
+TArrayView<const int32> FSEAreaGraph::GetNeighbors(int32 Area) const
+{
+    if (Area < 0 || Area >= NumAreas())
+    {
+        return TArrayView<const int32>();
+    }
+    return TArrayView<const int32>(Neighbors.GetData() + Offsets[Area], Offsets[Area + 1] - Offsets[Area]);
+}
+
+bool FSEAreaGraph::HasEdge(int32 From, int32 To) const
+{
+    return Algo::BinarySearch(GetNeighbors(From), To) != INDEX_NONE;
+}
+
+bool FSEAreaGraph::HasNeighborIn(int32 Area, const TBitArray<>& Bits) const
+{
+    for (const int32 Neighbor : GetNeighbors(Area))
+    {
+        if (IsSet(Bits, Neighbor))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FSEAreaGraph::ResetReachability(int32 InStartArea, const TBitArray<>& UnlockedAreas)
+{
+    StartArea = InStartArea;
+    Reachable.Init(false, NumAreas());
+    Frontier.Init(false, NumAreas());
+    RouteCache.Reset();
+
+    if (StartArea >= 0 && StartArea < NumAreas() && IsSet(UnlockedAreas, StartArea))
+    {
+        TArray<int32> Seeds = { StartArea };
+        Reachable[StartArea] = true;
+        ExpandReachable(Seeds, UnlockedAreas);
+    }
+}
+
+void FSEAreaGraph::OnAreaUnlocked(int32 Area, const TBitArray<>& UnlockedAreas)
+{
+    RouteCache.Reset();
+
+    if (Area < 0 || Area >= NumAreas() || Reachable[Area])
+    {
+        return;
+    }
+
+    // Joins the reachable region if it is the start or touches it
+    bool bConnected = Area == StartArea;
+    for (const int32 Neighbor : GetNeighbors(Area))
+    {
+        bConnected |= Reachable[Neighbor];
+    }
+    bConnected |= Frontier[Area];
+
+    if (!bConnected)
+    {
+        return;
+    }
+
+    TArray<int32> Seeds = { Area };
+    Reachable[Area] = true;
+    Frontier[Area] = false;
+    ExpandReachable(Seeds, UnlockedAreas);
+}
+
+void FSEAreaGraph::ExpandReachable(TArray<int32>& Seeds, const TBitArray<>& UnlockedAreas)
+{
+    // Seeds are already marked; only newly reached areas are visited
+    for (int32 Head = 0; Head < Seeds.Num(); ++Head)
+    {
+        for (const int32 Neighbor : GetNeighbors(Seeds[Head]))
+        {
+            if (Reachable[Neighbor])
+            {
+                continue;
+            }
+
+            if (IsSet(UnlockedAreas, Neighbor))
+            {
+                Reachable[Neighbor] = true;
+                Frontier[Neighbor] = false;
+                Seeds.Add(Neighbor);
+            }
+            else
+            {
+                Frontier[Neighbor] = true;
+            }
+        }
+    }
+}
+
+const FSEAreaGraph::FRouteTree& FSEAreaGraph::GetRouteTree(int32 From, const TBitArray<>& UnlockedAreas)
+{
+    if (const FRouteTree* Cached = RouteCache.Find(From))
+    {
+        return *Cached;
+    }
+
+    FRouteTree& Tree = RouteCache.Add(From);
+    Tree.Parents.Init(INDEX_NONE, NumAreas());
+    Tree.Distances.Init(INDEX_NONE, NumAreas());
+    Tree.Parents[From] = From;
+    Tree.Distances[From] = 0;
+
+    TArray<int32> Queue = { From };
+    for (int32 Head = 0; Head < Queue.Num(); ++Head)
+    {
+        const int32 Current = Queue[Head];
+
+        // Locked areas can be arrived at but not travelled through
+        if (Current != From && !IsSet(UnlockedAreas, Current))
+        {
+            continue;
+        }
+
+        for (const int32 Neighbor : GetNeighbors(Current))
+        {
+            if (Tree.Parents[Neighbor] == INDEX_NONE)
+            {
+                Tree.Parents[Neighbor] = Current;
+                Tree.Distances[Neighbor] = Tree.Distances[Current] + 1;
+                Queue.Add(Neighbor);
+            }
+        }
+    }
+
+    return Tree;
+}
+
+bool FSEAreaGraph::FindRoute(int32 From, int32 To, const TBitArray<>& UnlockedAreas, TArray<int32>& OutRoute)
+{
+    OutRoute.Reset();
+    if (From < 0 || From >= NumAreas() || To < 0 || To >= NumAreas())
+    {
+        return false;
+    }
+
+    const FRouteTree& Tree = GetRouteTree(From, UnlockedAreas);
+    if (Tree.Parents[To] == INDEX_NONE)
+    {
+        return false;
+    }
+
+    for (int32 Node = To; Node != From; Node = Tree.Parents[Node])
+    {
+        OutRoute.Add(Node);
+    }
+    OutRoute.Add(From);
+    Algo::Reverse(OutRoute);
+    return true;
+}
+
+int32 FSEAreaGraph::GetHopDistance(int32 From, int32 To, const TBitArray<>& UnlockedAreas)
+{
+    if (From < 0 || From >= NumAreas() || To < 0 || To >= NumAreas())
+    {
+        return INDEX_NONE;
+    }
+    return GetRouteTree(From, UnlockedAreas).Distances[To];
+}
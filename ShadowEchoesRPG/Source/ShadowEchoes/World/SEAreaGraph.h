@@ -0,0 +1,86 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FWorldArea;
+
+/**
+ * Compiled connectivity of the world areas
+ *
+ * Built once from DT_WorldAreas into CSR adjacency (one offset per area, neighbor indices
+ * sorted per area) using the area indices of FSEProgressionRegistry, so node bits line up
+ * with the unlocked-area bitset. Reachability from the starting area through unlocked
+ * areas is kept as a bitset and grown incrementally on unlock, together with the frontier
+ * of locked areas next to it. Routes come from per-source BFS trees that are cached until
+ * the next unlock.
+ */
+class SHADOWECHOES_API FSEAreaGraph
+{
+public:
+    FSEAreaGraph();
+
+    /** Compile adjacency from area data */
+    void Build(const TMap<FName, FWorldArea>& Areas);
+
+    /** Recompute reachability from scratch for the given unlocked-area bits */
+    void ResetReachability(int32 StartArea, const TBitArray<>& UnlockedAreas);
+
+    /** Grow reachability after an area was unlocked; clears the route cache */
+    void OnAreaUnlocked(int32 Area, const TBitArray<>& UnlockedAreas);
+
+    int32 NumAreas() const { return Offsets.Num() > 0 ? Offsets.Num() - 1 : 0; }
+
+    /** Neighbors of an area as authored in its ConnectedAreas */
+    TArrayView<const int32> GetNeighbors(int32 Area) const;
+
+    /** Whether From lists To as connected; O(log degree) */
+    bool HasEdge(int32 From, int32 To) const;
+
+    /** Whether any neighbor of an area is set in the given bits */
+    bool HasNeighborIn(int32 Area, const TBitArray<>& Bits) const;
+
+    /** Reachable from the starting area through unlocked areas */
+    bool IsReachable(int32 Area) const { return Reachable.IsValidIndex(Area) && Reachable[Area]; }
+    const TBitArray<>& GetReachable() const { return Reachable; }
+
+    /** Locked areas next to a reachable one, shown on the map */
+    bool IsFrontier(int32 Area) const { return Frontier.IsValidIndex(Area) && Frontier[Area]; }
+    const TBitArray<>& GetFrontier() const { return Frontier; }
+
+    /**
+     * Shortest route through unlocked areas, including both ends; the destination itself may
+     * be locked. Returns false if there is none.
+     */
+    bool FindRoute(int32 From, int32 To, const TBitArray<>& UnlockedAreas, TArray<int32>& OutRoute);
+
+    /** Hops of the shortest route, or INDEX_NONE */
+    int32 GetHopDistance(int32 From, int32 To, const TBitArray<>& UnlockedAreas);
+
+private:
+    struct FRouteTree
+    {
+        /** BFS parent per area; INDEX_NONE if unvisited, the source points to itself */
+        TArray<int32> Parents;
+        TArray<int32> Distances;
+    };
+
+    const FRouteTree& GetRouteTree(int32 From, const TBitArray<>& UnlockedAreas);
+
+    /** BFS through unlocked areas from Seeds, marking Reachable and Frontier */
+    void ExpandReachable(TArray<int32>& Seeds, const TBitArray<>& UnlockedAreas);
+
+    static bool IsSet(const TBitArray<>& Bits, int32 Index) { return Index >= 0 && Index < Bits.Num() && Bits[Index]; }
+
+    /** CSR adjacency */
+    TArray<int32> Offsets;
+    TArray<int32> Neighbors;
+
+    int32 StartArea;
+    TBitArray<> Reachable;
+    TBitArray<> Frontier;
+
+    /** Cached BFS trees by source area */
+    TMap<int32, FRouteTree> RouteCache;
+};
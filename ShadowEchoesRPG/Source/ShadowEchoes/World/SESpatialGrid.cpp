@@ -0,0 +1,212 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "World/SESpatialGrid.h"
+#include "Combat/CombatComponent.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+FSESpatialHashGrid::FSESpatialHashGrid(float InCellSize)
+    : CellSize(FMath::Max(InCellSize, 1.0f))
+    , InvCellSize(1.0f / FMath::Max(InCellSize, 1.0f))
+{
+}
+
+FIntPoint FSESpatialHashGrid::ToCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X * InvCellSize), FMath::FloorToInt(Location.Y * InvCellSize));
+}
+
+int32 FSESpatialHashGrid::Add(const FVector& Location)
+{
+    const int32 Handle = FreeHandles.Num() > 0 ? FreeHandles.Pop(false) : Entries.AddUninitialized();
+
+    FEntry& Entry = Entries[Handle];
+    Entry.Location = Location;
+    LinkToCell(Handle, ToCell(Location));
+    return Handle;
+}
+
+void FSESpatialHashGrid::Remove(int32 Handle)
+{
+    if (!IsValidHandle(Handle))
+    {
+        return;
+    }
+
+    UnlinkFromCell(Handle);
+    FreeHandles.Add(Handle);
+}
+
+bool FSESpatialHashGrid::Update(int32 Handle, const FVector& Location)
+{
+    if (!IsValidHandle(Handle))
+    {
+        return false;
+    }
+
+    Entries[Handle].Location = Location;
+
+    const FIntPoint NewCell = ToCell(Location);
+    if (NewCell == Entries[Handle].Cell)
+    {
+        return false;
+    }
+
+    UnlinkFromCell(Handle);
+    LinkToCell(Handle, NewCell);
+    return true;
+}
+
+void FSESpatialHashGrid::LinkToCell(int32 Handle, const FIntPoint& Cell)
+{
+    TArray<int32>& CellHandles = Cells.FindOrAdd(Cell);
+    Entries[Handle].Cell = Cell;
+    Entries[Handle].SlotInCell = CellHandles.Add(Handle);
+}
+
+void FSESpatialHashGrid::UnlinkFromCell(int32 Handle)
+{
+    FEntry& Entry = Entries[Handle];
+    TArray<int32>* CellHandles = Cells.Find(Entry.Cell);
+    check(CellHandles && CellHandles->IsValidIndex(Entry.SlotInCell));
+
+    // Swap-remove and fix up the entry that took the slot
+    const int32 Slot = Entry.SlotInCell;
+    CellHandles->RemoveAtSwap(Slot, 1, false);
+    if (Slot < CellHandles->Num())
+    {
+        Entries[(*CellHandles)[Slot]].SlotInCell = Slot;
+    }
+
+    // Empty cells are dropped so sparse worlds do not accumulate them
+    if (CellHandles->Num() == 0)
+    {
+        Cells.Remove(Entry.Cell);
+    }
+
+    Entry.SlotInCell = INDEX_NONE;
+}
+
+void FSESpatialHashGrid::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutHandles) const
+{
+    OutHandles.Reset();
+    if (Radius < 0.0f || Cells.Num() == 0)
+    {
+        return;
+    }
+
+    const FIntPoint MinCell = ToCell(Center - FVector(Radius, Radius, 0.0f));
+    const FIntPoint MaxCell = ToCell(Center + FVector(Radius, Radius, 0.0f));
+    const float RadiusSquared = Radius * Radius;
+
+    for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+    {
+        for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+        {
+            const TArray<int32>* CellHandles = Cells.Find(FIntPoint(CellX, CellY));
+            if (!CellHandles)
+            {
+                continue;
+            }
+
+            for (const int32 Handle : *CellHandles)
+            {
+                if (FVector::DistSquared(Entries[Handle].Location, Center) <= RadiusSquared)
+                {
+                    OutHandles.Add(Handle);
+                }
+            }
+        }
+    }
+}
+
+void FSESpatialHashGrid::Reset()
+{
+    Entries.Reset();
+    FreeHandles.Reset();
+    Cells.Reset();
+}
+
+USESpatialGridSubsystem::USESpatialGridSubsystem()
+    : Grid(DefaultCellSize)
+{
+}
+
+USESpatialGridSubsystem* USESpatialGridSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USESpatialGridSubsystem>() : nullptr;
+}
+
+void USESpatialGridSubsystem::Deinitialize()
+{
+    Grid.Reset();
+    Components.Reset();
+    Handles.Reset();
+    Super::Deinitialize();
+}
+
+void USESpatialGridSubsystem::Register(UCombatComponent* Component)
+{
+    if (!Component || !Component->GetOwner() || Handles.Contains(Component))
+    {
+        return;
+    }
+
+    const int32 Handle = Grid.Add(Component->GetOwner()->GetActorLocation());
+    if (Handle >= Components.Num())
+    {
+        Components.SetNum(Handle + 1);
+    }
+    Components[Handle] = Component;
+    Handles.Add(Component, Handle);
+}
+
+void USESpatialGridSubsystem::Unregister(UCombatComponent* Component)
+{
+    int32 Handle = INDEX_NONE;
+    if (Handles.RemoveAndCopyValue(Component, Handle))
+    {
+        Grid.Remove(Handle);
+        Components[Handle].Reset();
+    }
+}
+
+void USESpatialGridSubsystem::UpdateLocation(UCombatComponent* Component)
+{
+    if (const int32* Handle = Handles.Find(Component))
+    {
+        Grid.Update(*Handle, Component->GetOwner()->GetActorLocation());
+    }
+}
+
+void USESpatialGridSubsystem::QueryComponentsInRadius(const FVector& Center, float Radius, TArray<UCombatComponent*>& OutComponents, const AActor* IgnoreActor) const
+{
+    OutComponents.Reset();
+    Grid.QueryRadius(Center, Radius, QueryScratch);
+
+    for (const int32 Handle : QueryScratch)
+    {
+        UCombatComponent* Component = Components[Handle].Get();
+        if (Component && Component->GetOwner() != IgnoreActor)
+        {
+            OutComponents.Add(Component);
+        }
+    }
+}
+
+void USESpatialGridSubsystem::QueryActorsInRadius(const FVector& Center, float Radius, TArray<AActor*>& OutActors, const AActor* IgnoreActor) const
+{
+    OutActors.Reset();
+    Grid.QueryRadius(Center, Radius, QueryScratch);
+
+    for (const int32 Handle : QueryScratch)
+    {
+        const UCombatComponent* Component = Components[Handle].Get();
+        AActor* Owner = Component ? Component->GetOwner() : nullptr;
+        if (Owner && Owner != IgnoreActor)
+        {
+            OutActors.Add(Owner);
+        }
+    }
+}
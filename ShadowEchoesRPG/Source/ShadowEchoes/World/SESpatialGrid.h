@@ -0,0 +1,113 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SESpatialGrid.generated.h"
+
+class UCombatComponent;
+
+/**
+ * Uniform hash grid over the XY plane
+ *
+ * Entries are dense handles with a cached location and cell. Moving an entry only touches
+ * the cell lists when it crosses a cell boundary, and cells swap-remove so both updates and
+ * removals are O(1). Radius queries visit the cells overlapping the query circle and test
+ * the full 3D distance, so their cost follows local density rather than world population.
+ */
+class SHADOWECHOES_API FSESpatialHashGrid
+{
+public:
+    explicit FSESpatialHashGrid(float InCellSize = 1000.0f);
+
+    /** Insert an entry and return its handle */
+    int32 Add(const FVector& Location);
+
+    /** Remove an entry; its handle may be reused */
+    void Remove(int32 Handle);
+
+    /** Move an entry; returns true if it changed cell */
+    bool Update(int32 Handle, const FVector& Location);
+
+    /** Handles within Radius of Center, unordered */
+    void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutHandles) const;
+
+    bool IsValidHandle(int32 Handle) const { return Entries.IsValidIndex(Handle) && Entries[Handle].SlotInCell != INDEX_NONE; }
+    const FVector& GetLocation(int32 Handle) const { return Entries[Handle].Location; }
+
+    int32 Num() const { return Entries.Num() - FreeHandles.Num(); }
+    int32 NumCells() const { return Cells.Num(); }
+    float GetCellSize() const { return CellSize; }
+
+    void Reset();
+
+private:
+    struct FEntry
+    {
+        FVector Location;
+        FIntPoint Cell;
+
+        /** Position in the cell list; INDEX_NONE for free handles */
+        int32 SlotInCell;
+    };
+
+    FIntPoint ToCell(const FVector& Location) const;
+    void LinkToCell(int32 Handle, const FIntPoint& Cell);
+    void UnlinkFromCell(int32 Handle);
+
+    float CellSize;
+    float InvCellSize;
+
+    TArray<FEntry> Entries;
+    TArray<int32> FreeHandles;
+    TMap<FIntPoint, TArray<int32>> Cells;
+};
+
+/**
+ * Gameplay spatial index of actors with combat components
+ *
+ * Combat components register on BeginPlay and keep their cell current as their owner moves, so
+ * hazards, area attacks and class abilities can find damageable actors near a point
+ * without scanning the world.
+ */
+UCLASS()
+class SHADOWECHOES_API USESpatialGridSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    USESpatialGridSubsystem();
+
+    static USESpatialGridSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Deinitialize() override;
+
+    /** Combat component lifetime */
+    void Register(UCombatComponent* Component);
+    void Unregister(UCombatComponent* Component);
+    void UpdateLocation(UCombatComponent* Component);
+
+    /** Registered actors within Radius of Center */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
+    void QueryActorsInRadius(const FVector& Center, float Radius, TArray<AActor*>& OutActors, const AActor* IgnoreActor = nullptr) const;
+
+    void QueryComponentsInRadius(const FVector& Center, float Radius, TArray<UCombatComponent*>& OutComponents, const AActor* IgnoreActor = nullptr) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|World")
+    int32 GetNumRegistered() const { return Grid.Num(); }
+
+    /** Cell edge in world units; about the radius of a typical hazard */
+    static constexpr float DefaultCellSize = 1000.0f;
+
+private:
+    FSESpatialHashGrid Grid;
+
+    /** Component per grid handle */
+    TArray<TWeakObjectPtr<UCombatComponent>> Components;
+
+    TMap<TWeakObjectPtr<UCombatComponent>, int32> Handles;
+
+    /** Reused by queries */
+    mutable TArray<int32> QueryScratch;
+};
@@ -2,8 +2,10 @@
 
 #include "World/SEWeatherManager.h"
 #include "Core/SEGameInstance.h"
+#include "Systems/SEJobScheduler.h"
 #include "Systems/TimelineManager.h"
-#include "Engine/DataTable.h"
+#include "World/SESpatialGrid.h"
+#include "World/SEWeatherSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 USEWeatherManager::USEWeatherManager()
@@ -12,8 +14,8 @@ USEWeatherManager::USEWeatherManager()
     , DayLength(1440.0f) // 24 minutes real time = 24 hours game time
     , CurrentWeather(EWeatherType::Clear)
     , CurrentWeatherIntensity(1.0f)
-    , CurrentTime(720.0f) // Start at noon
     , CurrentSeason(0)
+    , HazardPassCursor(INDEX_NONE)
 {
 }
 
@@ -25,84 +27,87 @@ void USEWeatherManager::Initialize(USEGameInstance* InGameInstance)
         TimelineManager = GameInstance->GetTimelineManager();
     }
 
-    // Start weather update loop
-    FTimerHandle UpdateTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        UpdateTimer,
-        this,
-        &USEWeatherManager::UpdateWeatherEffects,
-        WeatherUpdateInterval,
-        true
-    );
+    // Blending and the clock run in the weather subsystem's tick; gameplay only hears thresholds
+    if (USEWeatherSubsystem* Weather = GetWeatherSubsystem())
+    {
+        Weather->SetTimeRate(TimeScale * USEWeatherSubsystem::MinutesPerDay / DayLength);
+        Weather->OnWeatherThreshold.AddUObject(this, &USEWeatherManager::HandleWeatherThreshold);
+        Weather->OnDayNightChanged.AddUObject(this, &USEWeatherManager::HandleDayNightChanged);
+        Weather->SetWeather(CurrentWeather, CurrentWeatherIntensity);
+    }
 
-    // Start time of day update
-    FTimerHandle TimeTimer;
-    GetWorld()->GetTimerManager().SetTimer(
-        TimeTimer,
-        this,
-        &USEWeatherManager::UpdateTimeOfDay,
-        1.0f,
-        true
-    );
+    // Start weather update loop; hazard damage keeps its cadence ahead of market and world scans
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        Scheduler->AddJob(TEXT("Weather.Effects"), WeatherUpdateInterval, ESEJobPriority::High,
+            [this](const FSEJobBudget& Budget) { return StepWeatherEffects(Budget); }, this);
+    }
+}
+
+USEWeatherSubsystem* USEWeatherManager::GetWeatherSubsystem() const
+{
+    UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<USEWeatherSubsystem>() : nullptr;
+}
+
+const FWeatherEffect* USEWeatherManager::FindWeatherEffect(EWeatherType Weather) const
+{
+    USEWeatherSubsystem* WeatherSubsystem = GetWeatherSubsystem();
+    return WeatherSubsystem ? WeatherSubsystem->FindWeatherEffect(Weather) : nullptr;
+}
+
+float USEWeatherManager::GetCurrentWeatherIntensity() const
+{
+    USEWeatherSubsystem* Weather = GetWeatherSubsystem();
+    return Weather ? Weather->GetCurrentIntensity() : CurrentWeatherIntensity;
 }
 
 void USEWeatherManager::SetWeather(EWeatherType NewWeather, float Intensity)
 {
-    if (NewWeather == CurrentWeather && FMath::IsNearlyEqual(Intensity, CurrentWeatherIntensity))
+    USEWeatherSubsystem* Weather = GetWeatherSubsystem();
+    if (NewWeather == CurrentWeather && FMath::IsNearlyEqual(Intensity, GetCurrentWeatherIntensity()) && !(Weather && Weather->IsTransitioning()))
     {
         return;
     }
 
+    // The subsystem reports back through HandleWeatherThreshold
+    if (Weather)
+    {
+        Weather->SetWeather(NewWeather, Intensity);
+    }
+    else
+    {
+        HandleWeatherThreshold(NewWeather, FMath::Clamp(Intensity, 0.0f, 1.0f));
+    }
+}
+
+void USEWeatherManager::HandleWeatherThreshold(EWeatherType DominantWeather, float Intensity)
+{
     // FromSoftware-style: Weather changes affect gameplay significantly
-    CurrentWeather = NewWeather;
-    CurrentWeatherIntensity = FMath::Clamp(Intensity, 0.0f, 1.0f);
+    CurrentWeather = DominantWeather;
+    CurrentWeatherIntensity = Intensity;
 
-    // Load weather effect data
-    UDataTable* WeatherTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_WeatherEffects")));
-    if (WeatherTable)
+    if (const FWeatherEffect* Effect = FindWeatherEffect(DominantWeather))
     {
-        FWeatherEffect* Effect = WeatherTable->FindRow<FWeatherEffect>(*UEnum::GetValueAsString(NewWeather), "");
-        if (Effect)
-        {
-            ApplyWeatherEffects(*Effect);
-        }
+        ApplyWeatherEffects(*Effect);
     }
 
     // Notify weather change
-    OnWeatherChanged.Broadcast(NewWeather, CurrentWeatherIntensity);
-    BP_OnWeatherChanged(NewWeather, CurrentWeatherIntensity);
+    OnWeatherChanged.Broadcast(CurrentWeather, CurrentWeatherIntensity);
+    BP_OnWeatherChanged(CurrentWeather, CurrentWeatherIntensity);
 }
 
 void USEWeatherManager::TransitionWeather(EWeatherType TargetWeather, float TransitionTime)
 {
     // FromSoftware-style: Weather transitions are dramatic and affect visibility
-    FTimerHandle TransitionTimer;
-    float StartIntensity = CurrentWeatherIntensity;
-    float ElapsedTime = 0.0f;
-
-    auto TransitionUpdate = [this, TargetWeather, TransitionTime, StartIntensity, &ElapsedTime]()
+    if (USEWeatherSubsystem* Weather = GetWeatherSubsystem())
     {
-        ElapsedTime += WeatherUpdateInterval;
-        float Alpha = FMath::Clamp(ElapsedTime / TransitionTime, 0.0f, 1.0f);
-        float NewIntensity = FMath::Lerp(StartIntensity, 1.0f, Alpha);
-
-        if (Alpha >= 1.0f)
-        {
-            SetWeather(TargetWeather, 1.0f);
-            GetWorld()->GetTimerManager().ClearTimer(TransitionTimer);
-        }
-        else
-        {
-            SetWeather(CurrentWeather, NewIntensity);
-        }
-    };
-
-    GetWorld()->GetTimerManager().SetTimer(
-        TransitionTimer,
-        TransitionUpdate,
-        WeatherUpdateInterval,
-        true
-    );
+        Weather->TransitionTo(TargetWeather, 1.0f, TransitionTime);
+    }
+    else
+    {
+        SetWeather(TargetWeather, 1.0f);
+    }
 }
 
 void USEWeatherManager::SpawnEnvironmentalHazard(const FEnvironmentalHazard& Hazard, const FVector& Location)
@@ -114,23 +119,10 @@ void USEWeatherManager::SpawnEnvironmentalHazard(const FEnvironmentalHazard& Haz
 
     // FromSoftware-style: Environmental hazards are deadly and require strategy
     ActiveHazards.Add(Hazard.HazardID, Hazard);
+    HazardLocations.Add(Hazard.HazardID, Location);
 
-    // Apply immediate effects
-    TArray<AActor*> OverlappingActors;
-    UGameplayStatics::GetAllActorsInRadius(GetWorld(), Location, Hazard.Radius, OverlappingActors);
-
-    for (AActor* Actor : OverlappingActors)
-    {
-        // Apply damage and status effects
-        float DamageAmount = CalculateHazardDamage(Hazard);
-        UGameplayStatics::ApplyDamage(Actor, DamageAmount, nullptr, nullptr, nullptr);
-
-        // Apply status effects
-        for (const FName& StatusEffect : Hazard.StatusEffects)
-        {
-            // Apply status effect to actor
-        }
-    }
+    // Damage accrues from now; the weather pass applies it
+    HazardApplyTimes.Add(Hazard.HazardID, GetWorld()->GetTimeSeconds());
 
     // Set up hazard persistence
     FTimerHandle HazardTimer;
@@ -151,22 +143,47 @@ void USEWeatherManager::SpawnEnvironmentalHazard(const FEnvironmentalHazard& Haz
 
 void USEWeatherManager::RemoveEnvironmentalHazard(const FName& HazardID)
 {
+    // Settle the damage owed since the last pass, so the total matches the hazard's lifetime
+    const FEnvironmentalHazard* Hazard = ActiveHazards.Find(HazardID);
+    const FVector* Location = HazardLocations.Find(HazardID);
+    const float* LastApplied = HazardApplyTimes.Find(HazardID);
+    if (Hazard && Location && LastApplied)
+    {
+        ApplyHazardToActorsInRange(*Hazard, *Location, FMath::Max(GetWorld()->GetTimeSeconds() - *LastApplied, 0.0f));
+    }
+
     ActiveHazards.Remove(HazardID);
+    HazardLocations.Remove(HazardID);
+    HazardApplyTimes.Remove(HazardID);
 }
 
 void USEWeatherManager::SetTimeOfDay(float NewTime)
 {
-    CurrentTime = FMath::Fmod(NewTime, DayLength);
-    bool bIsNight = IsNightTime();
+    USEWeatherSubsystem* Weather = GetWeatherSubsystem();
+    if (!Weather)
+    {
+        return;
+    }
 
-    // FromSoftware-style: Time of day affects enemy behavior and difficulty
-    OnTimeOfDayChanged.Broadcast(CurrentTime, bIsNight);
-    BP_OnTimeOfDayChanged(CurrentTime, bIsNight);
+    const bool bWasNight = IsNightTime();
+    Weather->SetTimeOfDay(NewTime);
+
+    // A day/night crossing has already been reported by the subsystem
+    if (bWasNight == IsNightTime())
+    {
+        HandleDayNightChanged(Weather->GetTimeOfDay(), bWasNight);
+    }
+}
+
+float USEWeatherManager::GetTimeOfDay() const
+{
+    USEWeatherSubsystem* Weather = GetWeatherSubsystem();
+    return Weather ? Weather->GetTimeOfDay() : 720.0f;
 }
 
 bool USEWeatherManager::IsNightTime() const
 {
-    return (CurrentTime < 360.0f || CurrentTime > 1080.0f); // Night between 6 PM and 6 AM
+    return USEWeatherSubsystem::IsNight(GetTimeOfDay()); // Night between 6 PM and 6 AM
 }
 
 void USEWeatherManager::AdvanceSeason()
@@ -187,58 +204,94 @@ void USEWeatherManager::OnTimelineStateChanged(ETimelineState NewState)
     BP_OnTimelineStateChanged(NewState);
 }
 
-void USEWeatherManager::UpdateWeatherEffects()
+bool USEWeatherManager::StepWeatherEffects(const FSEJobBudget& Budget)
 {
-    // Update active weather effects
-    if (CurrentWeather != EWeatherType::Clear)
+    if (HazardPassCursor == INDEX_NONE)
     {
-        UDataTable* WeatherTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_WeatherEffects")));
-        if (WeatherTable)
+        // Update active weather effects
+        if (CurrentWeather != EWeatherType::Clear)
         {
-            FWeatherEffect* Effect = WeatherTable->FindRow<FWeatherEffect>(*UEnum::GetValueAsString(CurrentWeather), "");
-            if (Effect)
+            if (const FWeatherEffect* Effect = FindWeatherEffect(CurrentWeather))
             {
                 ApplyWeatherEffects(*Effect);
             }
         }
+
+        ActiveHazards.GetKeys(HazardPassIDs);
+        HazardPassCursor = 0;
     }
 
     // Process environmental hazards
-    ProcessEnvironmentalHazards();
+    if (!StepEnvironmentalHazards(Budget))
+    {
+        return false;
+    }
+
+    HazardPassIDs.Reset();
+    HazardPassCursor = INDEX_NONE;
 
     // Check for weather transitions
     CheckWeatherTransitions();
+    return true;
 }
 
-void USEWeatherManager::ProcessEnvironmentalHazards()
+bool USEWeatherManager::StepEnvironmentalHazards(const FSEJobBudget& Budget)
 {
     // FromSoftware-style: Environmental hazards require constant attention
-    for (auto& Pair : ActiveHazards)
+    const float Now = GetWorld()->GetTimeSeconds();
+    while (HazardPassCursor < HazardPassIDs.Num())
     {
-        const FEnvironmentalHazard& Hazard = Pair.Value;
-        float DamageAmount = CalculateHazardDamage(Hazard);
+        const FName HazardID = HazardPassIDs[HazardPassCursor++];
+        const FEnvironmentalHazard* Hazard = ActiveHazards.Find(HazardID);
+        const FVector* Location = HazardLocations.Find(HazardID);
+        float* LastApplied = HazardApplyTimes.Find(HazardID);
+        if (Hazard && Location && LastApplied)
+        {
+            // Damage for the time since this hazard was last applied, however late the pass runs
+            const float Elapsed = FMath::Max(Now - *LastApplied, 0.0f);
+            *LastApplied = Now;
+            ApplyHazardToActorsInRange(*Hazard, *Location, Elapsed);
+        }
 
-        // Apply periodic damage and effects
-        // This would be handled by the gameplay effect system
+        if (HazardPassCursor < HazardPassIDs.Num() && !Budget.HasTimeLeft())
+        {
+            return false;
+        }
     }
+    return true;
 }
 
-void USEWeatherManager::UpdateTimeOfDay()
+void USEWeatherManager::ApplyHazardToActorsInRange(const FEnvironmentalHazard& Hazard, const FVector& Location, float DeltaSeconds)
 {
-    float PreviousTime = CurrentTime;
-    CurrentTime = FMath::Fmod(CurrentTime + (TimeScale / DayLength), DayLength);
+    // Only actors with combat components are indexed, so everything found can take damage
+    USESpatialGridSubsystem* SpatialGrid = USESpatialGridSubsystem::Get(GetWorld());
+    if (!SpatialGrid)
+    {
+        return;
+    }
 
-    bool bWasNight = (PreviousTime < 360.0f || PreviousTime > 1080.0f);
-    bool bIsNight = IsNightTime();
+    TArray<AActor*> ActorsInRange;
+    SpatialGrid->QueryActorsInRadius(Location, Hazard.Radius, ActorsInRange);
 
-    // FromSoftware-style: Day/night transitions affect enemy spawns and behavior
-    if (bWasNight != bIsNight)
+    const float DamageAmount = CalculateHazardDamage(Hazard, DeltaSeconds);
+    if (DamageAmount <= 0.0f)
+    {
+        return;
+    }
+
+    for (AActor* Actor : ActorsInRange)
     {
-        OnTimeOfDayChanged.Broadcast(CurrentTime, bIsNight);
-        BP_OnTimeOfDayChanged(CurrentTime, bIsNight);
+        UGameplayStatics::ApplyDamage(Actor, DamageAmount, nullptr, nullptr, nullptr);
     }
 }
 
+void USEWeatherManager::HandleDayNightChanged(float TimeOfDay, bool bIsNight)
+{
+    // FromSoftware-style: Day/night transitions affect enemy spawns and behavior
+    OnTimeOfDayChanged.Broadcast(TimeOfDay, bIsNight);
+    BP_OnTimeOfDayChanged(TimeOfDay, bIsNight);
+}
+
 void USEWeatherManager::CheckWeatherTransitions()
 {
     // FromSoftware-style: Weather changes are meaningful and strategic
@@ -261,16 +314,17 @@ void USEWeatherManager::CheckWeatherTransitions()
 void USEWeatherManager::ApplyWeatherEffects(const FWeatherEffect& Effect)
 {
     // FromSoftware-style: Weather affects gameplay mechanics
+    const float Intensity = GetCurrentWeatherIntensity();
     for (const auto& GameplayEffect : Effect.GameplayEffects)
     {
         // Apply effect based on intensity
-        float EffectValue = GameplayEffect.Value * CurrentWeatherIntensity;
+        float EffectValue = GameplayEffect.Value * Intensity;
 
         // Apply to relevant systems (movement, combat, visibility, etc.)
     }
 
     // Spawn weather-specific encounters
-    if (FMath::FRand() < CurrentWeatherIntensity)
+    if (FMath::FRand() < Intensity)
     {
         for (const FName& EncounterID : Effect.SpecialEncounters)
         {
@@ -303,10 +357,10 @@ void USEWeatherManager::SpawnTimelineSpecificEffects(ETimelineState State)
     }
 }
 
-float USEWeatherManager::CalculateHazardDamage(const FEnvironmentalHazard& Hazard) const
+float USEWeatherManager::CalculateHazardDamage(const FEnvironmentalHazard& Hazard, float DeltaSeconds) const
 {
     // FromSoftware-style: Environmental damage is significant and requires preparation
-    float BaseDamage = Hazard.DamagePerSecond * WeatherUpdateInterval;
+    float BaseDamage = Hazard.DamagePerSecond * DeltaSeconds;
 
     // Apply modifiers based on:
     // - Current weather
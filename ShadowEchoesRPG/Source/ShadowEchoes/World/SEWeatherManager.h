@@ -8,6 +8,8 @@
 
 class USEGameInstance;
 class UTimelineManager;
+class USEWeatherSubsystem;
+struct FSEJobBudget;
 
 UENUM(BlueprintType)
 enum class EWeatherType : uint8
@@ -21,6 +23,51 @@ enum class EWeatherType : uint8
     RealityStorm    UMETA(DisplayName = "Reality Storm")
 };
 
+/** Blendable weather parameters, written to MPC_Weather */
+USTRUCT(BlueprintType)
+struct FSEWeatherParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weather")
+    float Intensity;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weather")
+    float FogDensity;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weather")
+    float WindStrength;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weather")
+    float Precipitation;
+
+    FSEWeatherParams()
+        : Intensity(0.0f)
+        , FogDensity(0.0f)
+        , WindStrength(0.0f)
+        , Precipitation(0.0f)
+    {
+    }
+
+    static FSEWeatherParams Lerp(const FSEWeatherParams& A, const FSEWeatherParams& B, float Alpha)
+    {
+        FSEWeatherParams Result;
+        Result.Intensity = FMath::Lerp(A.Intensity, B.Intensity, Alpha);
+        Result.FogDensity = FMath::Lerp(A.FogDensity, B.FogDensity, Alpha);
+        Result.WindStrength = FMath::Lerp(A.WindStrength, B.WindStrength, Alpha);
+        Result.Precipitation = FMath::Lerp(A.Precipitation, B.Precipitation, Alpha);
+        return Result;
+    }
+
+    bool Equals(const FSEWeatherParams& Other, float Tolerance = KINDA_SMALL_NUMBER) const
+    {
+        return FMath::IsNearlyEqual(Intensity, Other.Intensity, Tolerance)
+            && FMath::IsNearlyEqual(FogDensity, Other.FogDensity, Tolerance)
+            && FMath::IsNearlyEqual(WindStrength, Other.WindStrength, Tolerance)
+            && FMath::IsNearlyEqual(Precipitation, Other.Precipitation, Tolerance);
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FWeatherEffect
 {
@@ -32,6 +79,10 @@ struct FWeatherEffect
     UPROPERTY(EditDefaultsOnly, Category = "Weather")
     float Intensity;
 
+    /** Look of this weather at full intensity */
+    UPROPERTY(EditDefaultsOnly, Category = "Weather")
+    FSEWeatherParams Parameters;
+
     UPROPERTY(EditDefaultsOnly, Category = "Weather")
     float Duration;
 
@@ -100,6 +151,10 @@ public:
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Weather")
     EWeatherType GetCurrentWeather() const { return CurrentWeather; }
 
+    /** Live intensity, including mid-blend; not just the value at the last threshold */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Weather")
+    float GetCurrentWeatherIntensity() const;
+
     /** Environmental hazards */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|Weather")
     void SpawnEnvironmentalHazard(const FEnvironmentalHazard& Hazard, const FVector& Location);
@@ -112,7 +167,7 @@ public:
     void SetTimeOfDay(float NewTime);
 
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Weather")
-    float GetTimeOfDay() const { return CurrentTime; }
+    float GetTimeOfDay() const;
 
     UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Weather")
     bool IsNightTime() const;
@@ -151,18 +206,27 @@ private:
     UPROPERTY()
     EWeatherType CurrentWeather;
 
+    /** Intensity at the last threshold; the subsystem holds the live value */
     UPROPERTY()
     float CurrentWeatherIntensity;
 
-    UPROPERTY()
-    float CurrentTime;
-
     UPROPERTY()
     int32 CurrentSeason;
 
     UPROPERTY()
     TMap<FName, FEnvironmentalHazard> ActiveHazards;
 
+    /** Where each active hazard was spawned */
+    UPROPERTY()
+    TMap<FName, FVector> HazardLocations;
+
+    /** World time each active hazard last dealt damage */
+    TMap<FName, float> HazardApplyTimes;
+
+    /** Hazards still to apply in the weather pass in progress; INDEX_NONE between passes */
+    TArray<FName> HazardPassIDs;
+    int32 HazardPassCursor;
+
     /** Game instance reference */
     UPROPERTY()
     USEGameInstance* GameInstance;
@@ -171,13 +235,19 @@ private:
     UTimelineManager* TimelineManager;
 
     /** Internal functionality */
-    void UpdateWeatherEffects();
-    void ProcessEnvironmentalHazards();
-    void UpdateTimeOfDay();
+    bool StepWeatherEffects(const FSEJobBudget& Budget);
+    bool StepEnvironmentalHazards(const FSEJobBudget& Budget);
+    void ApplyHazardToActorsInRange(const FEnvironmentalHazard& Hazard, const FVector& Location, float DeltaSeconds);
+    USEWeatherSubsystem* GetWeatherSubsystem() const;
+    const FWeatherEffect* FindWeatherEffect(EWeatherType Weather) const;
+
+    /** Subsystem notifications */
+    void HandleWeatherThreshold(EWeatherType DominantWeather, float Intensity);
+    void HandleDayNightChanged(float TimeOfDay, bool bIsNight);
     void CheckWeatherTransitions();
     void ApplyWeatherEffects(const FWeatherEffect& Effect);
     void SpawnTimelineSpecificEffects(ETimelineState State);
-    float CalculateHazardDamage(const FEnvironmentalHazard& Hazard) const;
+    float CalculateHazardDamage(const FEnvironmentalHazard& Hazard, float DeltaSeconds) const;
     bool ShouldSpawnHazard(const FEnvironmentalHazard& Hazard) const;
 
 protected:
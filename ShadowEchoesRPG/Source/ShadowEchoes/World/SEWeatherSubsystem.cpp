@@ -0,0 +1,237 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "World/SEWeatherSubsystem.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "ShadowEchoes.h"
+
+namespace SEWeatherParams
+{
+    static const FName Intensity(TEXT("WeatherIntensity"));
+    static const FName FogDensity(TEXT("FogDensity"));
+    static const FName WindStrength(TEXT("WindStrength"));
+    static const FName Precipitation(TEXT("Precipitation"));
+    static const FName TimeOfDay(TEXT("TimeOfDay"));
+}
+
+void FSEWeatherBlend::Snap(EWeatherType Weather, const FSEWeatherParams& Params)
+{
+    CurrentParams = Params;
+    SourceWeather = Weather;
+    TargetWeather = Weather;
+    Elapsed = 0.0f;
+    Duration = 0.0f;
+}
+
+void FSEWeatherBlend::Begin(EWeatherType Weather, const FSEWeatherParams& Params, float InDuration)
+{
+    if (InDuration <= 0.0f)
+    {
+        Snap(Weather, Params);
+        return;
+    }
+
+    // Start from wherever the previous blend got to
+    StartParams = CurrentParams;
+    TargetParams = Params;
+    SourceWeather = DominantWeather;
+    TargetWeather = Weather;
+    Elapsed = 0.0f;
+    Duration = InDuration;
+}
+
+void FSEWeatherBlend::Advance(float DeltaTime, const UCurveFloat* Curve)
+{
+    if (!IsTransitioning())
+    {
+        return;
+    }
+
+    Elapsed += DeltaTime;
+    const float Progress = FMath::Clamp(Elapsed / Duration, 0.0f, 1.0f);
+    const float Alpha = Curve ? Curve->GetFloatValue(Progress) : FMath::SmoothStep(0.0f, 1.0f, Progress);
+
+    CurrentParams = FSEWeatherParams::Lerp(StartParams, TargetParams, Alpha);
+
+    if (Progress >= 1.0f)
+    {
+        CurrentParams = TargetParams;
+        SourceWeather = TargetWeather;
+        Duration = 0.0f;
+    }
+}
+
+bool FSEWeatherBlend::UpdateThreshold()
+{
+    // The target takes over halfway through the blend
+    const bool bPastMidpoint = !IsTransitioning() || Elapsed * 2.0f >= Duration;
+    const EWeatherType Dominant = bPastMidpoint ? TargetWeather : SourceWeather;
+    const int32 Band = GetIntensityBand(CurrentParams.Intensity);
+
+    if (Dominant == DominantWeather && Band == NotifiedBand)
+    {
+        return false;
+    }
+
+    DominantWeather = Dominant;
+    NotifiedBand = Band;
+    return true;
+}
+
+USEWeatherSubsystem::USEWeatherSubsystem()
+    : WeatherParameters(nullptr)
+    , WeatherParametersInstance(nullptr)
+    , BlendCurve(nullptr)
+    , WrittenTimeOfDay(-1.0f)
+    , TimeOfDay(720.0f) // Start at noon
+    , TimeRate(1.0f)
+{
+}
+
+void USEWeatherSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Weather rows are resolved once instead of per weather change
+    UDataTable* WeatherTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, TEXT("/Game/Data/DT_WeatherEffects")));
+    if (WeatherTable)
+    {
+        const UEnum* WeatherEnum = StaticEnum<EWeatherType>();
+        for (int32 Index = 0; Index < WeatherEnum->NumEnums() - 1; ++Index)
+        {
+            const EWeatherType Weather = static_cast<EWeatherType>(WeatherEnum->GetValueByIndex(Index));
+            if (const FWeatherEffect* Effect = WeatherTable->FindRow<FWeatherEffect>(*WeatherEnum->GetNameStringByIndex(Index), "", false))
+            {
+                WeatherEffects.Add(Weather, *Effect);
+            }
+        }
+    }
+
+    WeatherParameters = Cast<UMaterialParameterCollection>(StaticLoadObject(
+        UMaterialParameterCollection::StaticClass(),
+        nullptr,
+        TEXT("/Game/Materials/MPC_Weather")
+    ));
+
+    BlendCurve = Cast<UCurveFloat>(StaticLoadObject(UCurveFloat::StaticClass(), nullptr, TEXT("/Game/Data/Curves/C_WeatherBlend")));
+
+    // Both are optional: gameplay thresholds and the live intensity work without them
+    if (!WeatherParameters)
+    {
+        SE_LOG_WARNING(TEXT("MPC_Weather not found; weather parameters will not reach materials"));
+    }
+    if (!BlendCurve)
+    {
+        SE_LOG(Log, TEXT("C_WeatherBlend not found; weather blends use smoothstep"));
+    }
+}
+
+TStatId USEWeatherSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USEWeatherSubsystem, STATGROUP_Tickables);
+}
+
+void USEWeatherSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UpdateClock(DeltaTime);
+    Blend.Advance(DeltaTime, BlendCurve);
+    CheckThresholds();
+    WriteParameterCollection();
+}
+
+const FWeatherEffect* USEWeatherSubsystem::FindWeatherEffect(EWeatherType Weather) const
+{
+    return WeatherEffects.Find(Weather);
+}
+
+FSEWeatherParams USEWeatherSubsystem::GetTargetParams(EWeatherType Weather, float Intensity) const
+{
+    const float Scale = FMath::Clamp(Intensity, 0.0f, 1.0f);
+
+    FSEWeatherParams Target;
+    if (const FWeatherEffect* Effect = FindWeatherEffect(Weather))
+    {
+        Target = FSEWeatherParams::Lerp(FSEWeatherParams(), Effect->Parameters, Scale);
+    }
+    Target.Intensity = Scale;
+    return Target;
+}
+
+void USEWeatherSubsystem::SetWeather(EWeatherType Weather, float Intensity)
+{
+    Blend.Snap(Weather, GetTargetParams(Weather, Intensity));
+    CheckThresholds();
+}
+
+void USEWeatherSubsystem::TransitionTo(EWeatherType Weather, float Intensity, float Duration)
+{
+    if (Duration <= 0.0f)
+    {
+        SetWeather(Weather, Intensity);
+        return;
+    }
+
+    Blend.Begin(Weather, GetTargetParams(Weather, Intensity), Duration);
+}
+
+void USEWeatherSubsystem::SetTimeOfDay(float Minutes)
+{
+    const bool bWasNight = IsNight(TimeOfDay);
+    TimeOfDay = FMath::Fmod(FMath::Fmod(Minutes, MinutesPerDay) + MinutesPerDay, MinutesPerDay);
+
+    if (bWasNight != IsNight(TimeOfDay))
+    {
+        OnDayNightChanged.Broadcast(TimeOfDay, IsNight(TimeOfDay));
+    }
+}
+
+void USEWeatherSubsystem::UpdateClock(float DeltaTime)
+{
+    SetTimeOfDay(TimeOfDay + DeltaTime * TimeRate);
+}
+
+void USEWeatherSubsystem::CheckThresholds()
+{
+    if (Blend.UpdateThreshold())
+    {
+        OnWeatherThreshold.Broadcast(Blend.DominantWeather, Blend.CurrentParams.Intensity);
+    }
+}
+
+void USEWeatherSubsystem::WriteParameterCollection()
+{
+    if (!WeatherParameters)
+    {
+        return;
+    }
+
+    if (!WeatherParametersInstance)
+    {
+        WeatherParametersInstance = GetWorld()->GetParameterCollectionInstance(WeatherParameters);
+        if (!WeatherParametersInstance)
+        {
+            return;
+        }
+    }
+
+    const FSEWeatherParams& CurrentParams = Blend.CurrentParams;
+    if (!CurrentParams.Equals(WrittenParams) || WrittenTimeOfDay < 0.0f)
+    {
+        WeatherParametersInstance->SetScalarParameterValue(SEWeatherParams::Intensity, CurrentParams.Intensity);
+        WeatherParametersInstance->SetScalarParameterValue(SEWeatherParams::FogDensity, CurrentParams.FogDensity);
+        WeatherParametersInstance->SetScalarParameterValue(SEWeatherParams::WindStrength, CurrentParams.WindStrength);
+        WeatherParametersInstance->SetScalarParameterValue(SEWeatherParams::Precipitation, CurrentParams.Precipitation);
+        WrittenParams = CurrentParams;
+    }
+
+    if (TimeOfDay != WrittenTimeOfDay)
+    {
+        WeatherParametersInstance->SetScalarParameterValue(SEWeatherParams::TimeOfDay, TimeOfDay / MinutesPerDay);
+        WrittenTimeOfDay = TimeOfDay;
+    }
+}
@@ -0,0 +1,137 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "World/SEWeatherManager.h"
+#include "SEWeatherSubsystem.generated.h"
+
+class UCurveFloat;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FSEOnWeatherThreshold, EWeatherType /*DominantWeather*/, float /*Intensity*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FSEOnDayNightChanged, float /*TimeOfDay*/, bool /*bIsNight*/);
+
+/**
+ * Blend between two weathers and the threshold state gameplay was last told about
+ * Kept apart from the subsystem so the blend can be stepped without a world.
+ */
+struct SHADOWECHOES_API FSEWeatherBlend
+{
+    FSEWeatherParams CurrentParams;
+    FSEWeatherParams StartParams;
+    FSEWeatherParams TargetParams;
+    EWeatherType SourceWeather = EWeatherType::Clear;
+    EWeatherType TargetWeather = EWeatherType::Clear;
+    float Elapsed = 0.0f;
+    float Duration = 0.0f;
+
+    /** Last notified state */
+    EWeatherType DominantWeather = EWeatherType::Clear;
+    int32 NotifiedBand = INDEX_NONE;
+
+    /** Intensity bands that gameplay distinguishes */
+    static constexpr float IntensityBandSize = 0.25f;
+
+    /** Jump straight to Params */
+    void Snap(EWeatherType Weather, const FSEWeatherParams& Params);
+
+    /** Blend from wherever the previous blend got to towards Params over InDuration seconds */
+    void Begin(EWeatherType Weather, const FSEWeatherParams& Params, float InDuration);
+
+    /** Advance the blend; Curve shapes it, smoothstep when null */
+    void Advance(float DeltaTime, const UCurveFloat* Curve = nullptr);
+
+    /** True when the dominant weather or intensity band changed since the last call */
+    bool UpdateThreshold();
+
+    bool IsTransitioning() const { return Duration > 0.0f; }
+
+    static int32 GetIntensityBand(float Intensity) { return FMath::FloorToInt(FMath::Clamp(Intensity, 0.0f, 1.0f) / IntensityBandSize); }
+};
+
+/**
+ * Weather and time-of-day simulation
+ *
+ * Weather is a blendable parameter vector interpolated along a curve, advanced together with
+ * the clock in a single tick and written to MPC_Weather for materials and the sky. Weather
+ * rows are loaded once. Gameplay hears about it only when the dominant weather flips, the
+ * intensity crosses into another band, or day turns to night; the live intensity can be read
+ * at any time. Without MPC_Weather nothing is written, and without C_WeatherBlend blends
+ * use smoothstep.
+ */
+UCLASS()
+class SHADOWECHOES_API USEWeatherSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    USEWeatherSubsystem();
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Snap to a weather without blending */
+    void SetWeather(EWeatherType Weather, float Intensity);
+
+    /** Blend from the current parameters to the target over Duration seconds */
+    void TransitionTo(EWeatherType Weather, float Intensity, float Duration);
+
+    /** Data row of a weather type, or null */
+    const FWeatherEffect* FindWeatherEffect(EWeatherType Weather) const;
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Weather")
+    const FSEWeatherParams& GetCurrentParams() const { return Blend.CurrentParams; }
+
+    /** Intensity right now, including mid-blend */
+    float GetCurrentIntensity() const { return Blend.CurrentParams.Intensity; }
+
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|Weather")
+    bool IsTransitioning() const { return Blend.IsTransitioning(); }
+
+    EWeatherType GetDominantWeather() const { return Blend.DominantWeather; }
+
+    /** Clock in game minutes, [0, MinutesPerDay) */
+    void SetTimeOfDay(float Minutes);
+    float GetTimeOfDay() const { return TimeOfDay; }
+    void SetTimeRate(float GameMinutesPerSecond) { TimeRate = GameMinutesPerSecond; }
+
+    static bool IsNight(float Minutes) { return Minutes < 360.0f || Minutes > 1080.0f; }
+
+    static constexpr float MinutesPerDay = 1440.0f;
+
+    /** Gameplay notifications */
+    FSEOnWeatherThreshold OnWeatherThreshold;
+    FSEOnDayNightChanged OnDayNightChanged;
+
+private:
+    FSEWeatherParams GetTargetParams(EWeatherType Weather, float Intensity) const;
+    void UpdateClock(float DeltaTime);
+    void CheckThresholds();
+    void WriteParameterCollection();
+
+    /** Weather rows by type, loaded once */
+    TMap<EWeatherType, FWeatherEffect> WeatherEffects;
+
+    UPROPERTY()
+    UMaterialParameterCollection* WeatherParameters;
+
+    UPROPERTY()
+    UMaterialParameterCollectionInstance* WeatherParametersInstance;
+
+    /** Blend shape; smoothstep when absent */
+    UPROPERTY()
+    UCurveFloat* BlendCurve;
+
+    FSEWeatherBlend Blend;
+
+    /** Last values written to the MPC */
+    FSEWeatherParams WrittenParams;
+    float WrittenTimeOfDay;
+
+    float TimeOfDay;
+    float TimeRate;
+};
@@ -2,6 +2,8 @@
 
 #include "World/SEWorldManager.h"
 #include "Core/SEGameInstance.h"
+#include "Core/SEProgression.h"
+#include "Systems/SEJobScheduler.h"
 #include "Systems/TimelineManager.h"
 #include "Engine/DataTable.h"
 #include "Kismet/GameplayStatics.h"
@@ -10,6 +12,12 @@ USEWorldManager::USEWorldManager()
     : EventCheckInterval(30.0f)
     , BossRespawnMultiplier(1.5f)
     , MaxActiveEvents(3)
+    , SimulationInterval(2.0f)
+    , PromoteDistance(0)
+    , DemoteDistance(1)
+    , RoamSecondsPerArea(90.0f)
+    , AbstractBossRegen(0.002f)
+    , WorldStatePhase(0)
 {
 }
 
@@ -21,15 +29,23 @@ void USEWorldManager::Initialize(USEGameInstance* InGameInstance)
         TimelineManager = GameInstance->GetTimelineManager();
     }
 
+    FSEProgressionRegistry::Get().LoadFromData();
     LoadWorldData();
 
-    // Start world state update loop
-    FTimerHandle UpdateTimer;
+    // World state scans run under the shared frame budget
+    if (USEJobSchedulerSubsystem* Scheduler = USEJobSchedulerSubsystem::Get(GetWorld()))
+    {
+        Scheduler->AddJob(TEXT("World.State"), EventCheckInterval, ESEJobPriority::Normal,
+            [this](const FSEJobBudget& Budget) { return StepWorldState(Budget); }, this);
+    }
+
+    // Abstract simulation of distant bosses and events
+    FTimerHandle SimulationTimer;
     GetWorld()->GetTimerManager().SetTimer(
-        UpdateTimer,
+        SimulationTimer,
         this,
-        &USEWorldManager::UpdateWorldState,
-        EventCheckInterval,
+        &USEWorldManager::SimulateWorld,
+        SimulationInterval,
         true
     );
 }
@@ -65,26 +81,51 @@ void USEWorldManager::LoadWorldData()
         // Initialize world bosses (not spawned by default)
     }
 
+    // Compile connectivity, then restore reachability from saved unlocks
+    AreaGraph.Build(Areas);
+    const FName StartingArea("StartingArea");
+    AreaGraph.ResetReachability(FSEProgressionRegistry::Get().Find(ESEProgressionDomain::Area, StartingArea), GetUnlockedAreaBits());
+
     // Unlock starting area
-    UnlockArea(FName("StartingArea"));
+    UnlockArea(StartingArea);
+    CurrentAreaID = StartingArea;
 }
 
-void USEWorldManager::UpdateWorldState()
+bool USEWorldManager::StepWorldState(const FSEJobBudget& Budget)
 {
-    // Update active events
-    ProcessEventCooldowns();
-
-    // Update world bosses
-    ManageWorldBosses();
+    while (WorldStatePhase < 3)
+    {
+        switch (WorldStatePhase++)
+        {
+            case 0:
+                // Update active events
+                ProcessEventCooldowns();
+                break;
+
+            case 1:
+                // Update world bosses
+                ManageWorldBosses();
+                break;
+
+            default:
+                // Update area difficulty based on player level and timeline
+                UpdateAreaDifficulty();
+                break;
+        }
 
-    // Update area difficulty based on player level and timeline
-    UpdateAreaDifficulty();
+        if (WorldStatePhase < 3 && !Budget.HasTimeLeft())
+        {
+            return false;
+        }
+    }
+    WorldStatePhase = 0;
 
     // Check for potential new events
     if (ActiveEvents.Num() < MaxActiveEvents)
     {
         // Randomly trigger new events based on area and timeline state
     }
+    return true;
 }
 
 const FWorldArea* USEWorldManager::GetAreaInfo(const FName& AreaID) const
@@ -107,33 +148,87 @@ void USEWorldManager::UnlockArea(const FName& AreaID)
     }
 
     // Check if area is connected to already unlocked areas
-    bool bHasValidConnection = false;
-    for (const FName& ConnectedArea : Area->ConnectedAreas)
+    const int32 AreaIndex = FSEProgressionRegistry::Get().Find(ESEProgressionDomain::Area, AreaID);
+    const bool bHasValidConnection = AreaGraph.HasNeighborIn(AreaIndex, GetUnlockedAreaBits());
+
+    if ((!bHasValidConnection && AreaID != FName("StartingArea")) || !GameInstance)
     {
-        if (IsAreaUnlocked(ConnectedArea))
-        {
-            bHasValidConnection = true;
-            break;
-        }
+        return;
     }
 
-    if (!bHasValidConnection && AreaID != FName("StartingArea"))
+    if (GameInstance->SetProgressionFlag(ESEProgressionDomain::Area, AreaIndex))
     {
-        return;
+        // FromSoftware-style: Reveal connected areas but keep them locked
+        AreaGraph.OnAreaUnlocked(AreaIndex, GetUnlockedAreaBits());
     }
+}
+
+bool USEWorldManager::IsAreaUnlocked(const FName& AreaID) const
+{
+    return GameInstance && GameInstance->GetProgression().TestID(ESEProgressionDomain::Area, AreaID);
+}
 
-    UnlockedAreas.Add(AreaID);
+const TBitArray<>& USEWorldManager::GetUnlockedAreaBits() const
+{
+    static const TBitArray<> Empty;
+    return GameInstance ? GameInstance->GetProgression().GetBits(ESEProgressionDomain::Area) : Empty;
+}
 
-    // FromSoftware-style: Reveal connected areas but keep them locked
-    for (const FName& ConnectedArea : Area->ConnectedAreas)
+void USEWorldManager::SetCurrentArea(const FName& AreaID)
+{
+    if (IsAreaUnlocked(AreaID) && AreaID != CurrentAreaID)
     {
-        // Show area on map but keep locked until requirements are met
+        CurrentAreaID = AreaID;
+
+        // Promote whatever the player just walked into range of
+        UpdateSimulationTiers();
     }
 }
 
-bool USEWorldManager::IsAreaUnlocked(const FName& AreaID) const
+bool USEWorldManager::IsAreaReachable(const FName& AreaID) const
+{
+    return AreaGraph.IsReachable(FSEProgressionRegistry::Get().Find(ESEProgressionDomain::Area, AreaID));
+}
+
+TArray<FName> USEWorldManager::GetReachableAreas() const
 {
-    return UnlockedAreas.Contains(AreaID);
+    return AreaBitsToNames(AreaGraph.GetReachable());
+}
+
+TArray<FName> USEWorldManager::GetRevealedAreas() const
+{
+    return AreaBitsToNames(AreaGraph.GetFrontier());
+}
+
+TArray<FName> USEWorldManager::AreaBitsToNames(const TBitArray<>& Bits) const
+{
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+
+    TArray<FName> AreaIDs;
+    for (TConstSetBitIterator<> It(Bits); It; ++It)
+    {
+        AreaIDs.Add(Registry.GetID(ESEProgressionDomain::Area, It.GetIndex()));
+    }
+    return AreaIDs;
+}
+
+bool USEWorldManager::FindAreaRoute(const FName& FromArea, const FName& ToArea, TArray<FName>& OutRoute)
+{
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+
+    TArray<int32> Route;
+    OutRoute.Reset();
+    if (!AreaGraph.FindRoute(Registry.Find(ESEProgressionDomain::Area, FromArea), Registry.Find(ESEProgressionDomain::Area, ToArea),
+        GetUnlockedAreaBits(), Route))
+    {
+        return false;
+    }
+
+    for (const int32 AreaIndex : Route)
+    {
+        OutRoute.Add(Registry.GetID(ESEProgressionDomain::Area, AreaIndex));
+    }
+    return true;
 }
 
 void USEWorldManager::TriggerWorldEvent(const FName& EventID)
@@ -166,6 +261,7 @@ void USEWorldManager::TriggerWorldEvent(const FName& EventID)
 
     // Start event
     ActiveEvents.Add(EventID, *Event);
+    WorldSimulation.AddEvent(EventID, FSEProgressionRegistry::Get().Find(ESEProgressionDomain::Area, CurrentAreaID), Event->Duration);
 
     // Spawn event-specific content
     for (const FName& BossID : Event->SpawnableBosses)
@@ -193,6 +289,7 @@ void USEWorldManager::EndWorldEvent(const FName& EventID)
     }
 
     ActiveEvents.Remove(EventID);
+    WorldSimulation.RemoveEvent(EventID);
 }
 
 bool USEWorldManager::IsEventActive(const FName& EventID) const
@@ -221,13 +318,26 @@ void USEWorldManager::SpawnWorldBoss(const FName& BossID)
     }
 
     // FromSoftware-style: Choose spawn location based on player position and area state
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+    const TBitArray<>& UnlockedBits = GetUnlockedAreaBits();
+    const int32 CurrentArea = Registry.Find(ESEProgressionDomain::Area, CurrentAreaID);
+
     FName SpawnArea;
+    int32 BestDistance = MAX_int32;
     for (const FName& PossibleArea : Boss->PossibleSpawnAreas)
     {
-        if (IsAreaUnlocked(PossibleArea))
+        if (!IsAreaUnlocked(PossibleArea))
+        {
+            continue;
+        }
+
+        // Nearest unlocked spawn area by route length; unreachable ones only as a last resort
+        const int32 Distance = AreaGraph.GetHopDistance(CurrentArea, Registry.Find(ESEProgressionDomain::Area, PossibleArea), UnlockedBits);
+        const int32 SortDistance = Distance == INDEX_NONE ? MAX_int32 - 1 : Distance;
+        if (SortDistance < BestDistance)
         {
+            BestDistance = SortDistance;
             SpawnArea = PossibleArea;
-            break;
         }
     }
 
@@ -236,12 +346,56 @@ void USEWorldManager::SpawnWorldBoss(const FName& BossID)
         return;
     }
 
-    // Spawn boss
+    // Spawn boss abstractly; it becomes an actor once the player is in range
     ActiveBosses.Add(BossID, *Boss);
+    WorldSimulation.AddBoss(BossID, BuildRoamingRoute(*Boss, SpawnArea), RoamSecondsPerArea, AbstractBossRegen);
 
     // Notify boss spawn
     OnWorldBossSpawned.Broadcast(*Boss);
     BP_OnWorldBossSpawned(*Boss);
+
+    UpdateSimulationTiers();
+}
+
+TArray<int32> USEWorldManager::BuildRoamingRoute(const FWorldBoss& Boss, const FName& SpawnArea)
+{
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+    const TBitArray<>& UnlockedBits = GetUnlockedAreaBits();
+
+    const int32 Start = Registry.Find(ESEProgressionDomain::Area, SpawnArea);
+    TArray<int32> Route = { Start };
+    if (!Boss.bIsRoaming)
+    {
+        return Route;
+    }
+
+    // Loop through every unlocked spawn area and back, following area connections
+    TArray<int32> Stops;
+    for (const FName& PossibleArea : Boss.PossibleSpawnAreas)
+    {
+        const int32 Stop = Registry.Find(ESEProgressionDomain::Area, PossibleArea);
+        if (Stop != Start && IsAreaUnlocked(PossibleArea))
+        {
+            Stops.Add(Stop);
+        }
+    }
+    Stops.Add(Start);
+
+    TArray<int32> Segment;
+    for (const int32 Stop : Stops)
+    {
+        if (AreaGraph.FindRoute(Route.Last(), Stop, UnlockedBits, Segment) && Segment.Num() > 1)
+        {
+            Route.Append(Segment.GetData() + 1, Segment.Num() - 1);
+        }
+    }
+
+    // The loop closes on the start, which is already the first entry
+    if (Route.Num() > 1)
+    {
+        Route.Pop();
+    }
+    return Route;
 }
 
 void USEWorldManager::DespawnWorldBoss(const FName& BossID)
@@ -252,6 +406,109 @@ void USEWorldManager::DespawnWorldBoss(const FName& BossID)
     }
 
     ActiveBosses.Remove(BossID);
+    WorldSimulation.RemoveBoss(BossID);
+}
+
+ESESimulationTier USEWorldManager::GetWorldBossTier(const FName& BossID)
+{
+    const FSEAbstractBoss* Boss = WorldSimulation.FindBoss(BossID);
+    return Boss ? Boss->Tier : ESESimulationTier::Abstract;
+}
+
+void USEWorldManager::SyncWorldBossState(const FName& BossID, const FName& AreaID, float HealthFraction)
+{
+    FSEAbstractBoss* Boss = WorldSimulation.FindBoss(BossID);
+    if (!Boss || Boss->Tier != ESESimulationTier::Full)
+    {
+        return;
+    }
+
+    Boss->HealthFraction = FMath::Clamp(HealthFraction, 0.0f, 1.0f);
+
+    // Resume the route from wherever the actor wandered to
+    const int32 RouteStep = Boss->Route.Find(FSEProgressionRegistry::Get().Find(ESEProgressionDomain::Area, AreaID));
+    if (RouteStep != INDEX_NONE)
+    {
+        Boss->RouteStep = RouteStep;
+        Boss->StepProgress = 0.0f;
+    }
+    WorldSimulation.Touch(*Boss);
+}
+
+FSEWorldBossSimState USEWorldManager::MakeBossSimState(const FSEAbstractBoss& Boss) const
+{
+    FSEWorldBossSimState State;
+    State.BossID = Boss.BossID;
+    State.AreaID = FSEProgressionRegistry::Get().GetID(ESEProgressionDomain::Area, Boss.GetArea());
+    State.HealthFraction = Boss.HealthFraction;
+    State.RouteProgress = Boss.StepProgress;
+    return State;
+}
+
+void USEWorldManager::SimulateWorld()
+{
+    WorldSimulation.Advance(SimulationInterval);
+    UpdateSimulationTiers();
+}
+
+bool USEWorldManager::IsWithinDistance(int32 AreaIndex, int32 MaxHops)
+{
+    const int32 CurrentArea = FSEProgressionRegistry::Get().Find(ESEProgressionDomain::Area, CurrentAreaID);
+    const int32 Distance = AreaGraph.GetHopDistance(CurrentArea, AreaIndex, GetUnlockedAreaBits());
+    return Distance != INDEX_NONE && Distance <= MaxHops;
+}
+
+void USEWorldManager::UpdateSimulationTiers()
+{
+    // Route trees from the current area are cached, so this is a lookup per record.
+    // Indexed loops because blueprint handlers may spawn or despawn content.
+    TArray<FSEAbstractBoss>& Bosses = WorldSimulation.GetBosses();
+    for (int32 Index = 0; Index < Bosses.Num(); ++Index)
+    {
+        FSEAbstractBoss& Boss = Bosses[Index];
+        const FWorldBoss* BossData = ActiveBosses.Find(Boss.BossID);
+        if (!BossData)
+        {
+            continue;
+        }
+
+        if (Boss.Tier == ESESimulationTier::Abstract && IsWithinDistance(Boss.GetArea(), PromoteDistance))
+        {
+            Boss.Tier = ESESimulationTier::Full;
+            WorldSimulation.Touch(Boss);
+            BP_OnWorldBossPromoted(*BossData, MakeBossSimState(Boss));
+        }
+        else if (Boss.Tier == ESESimulationTier::Full && !IsWithinDistance(Boss.GetArea(), DemoteDistance))
+        {
+            Boss.Tier = ESESimulationTier::Abstract;
+            WorldSimulation.Touch(Boss);
+            BP_OnWorldBossDemoted(Boss.BossID);
+        }
+    }
+
+    TArray<FSEAbstractEvent>& Events = WorldSimulation.GetEvents();
+    for (int32 Index = 0; Index < Events.Num(); ++Index)
+    {
+        FSEAbstractEvent& Event = Events[Index];
+        const FWorldEvent* EventData = ActiveEvents.Find(Event.EventID);
+        if (!EventData)
+        {
+            continue;
+        }
+
+        if (Event.Tier == ESESimulationTier::Abstract && IsWithinDistance(Event.AreaIndex, PromoteDistance))
+        {
+            Event.Tier = ESESimulationTier::Full;
+            WorldSimulation.Touch(Event);
+            BP_OnWorldEventPromoted(*EventData, Event.RemainingTime);
+        }
+        else if (Event.Tier == ESESimulationTier::Full && !IsWithinDistance(Event.AreaIndex, DemoteDistance))
+        {
+            Event.Tier = ESESimulationTier::Abstract;
+            WorldSimulation.Touch(Event);
+            BP_OnWorldEventDemoted(Event.EventID);
+        }
+    }
 }
 
 bool USEWorldManager::IsWorldBossActive(const FName& BossID) const
@@ -261,21 +518,19 @@ bool USEWorldManager::IsWorldBossActive(const FName& BossID) const
 
 void USEWorldManager::DiscoverSecret(const FName& AreaID, const FName& SecretID)
 {
-    const FWorldArea* Area = GetAreaInfo(AreaID);
-    if (!Area || !Area->HiddenSecrets.Contains(SecretID))
+    // Only secrets listed in the area data are registered
+    const int32 SecretIndex = FSEProgressionRegistry::Get().FindSecret(AreaID, SecretID);
+    if (SecretIndex == INDEX_NONE || !GameInstance)
     {
         return;
     }
 
-    FName CombinedID = *FString::Printf(TEXT("%s_%s"), *AreaID.ToString(), *SecretID.ToString());
-    if (DiscoveredSecrets.Contains(CombinedID))
+    // FromSoftware-style: Secrets have meaningful impact
+    if (!GameInstance->SetProgressionFlag(ESEProgressionDomain::Secret, SecretIndex))
     {
         return;
     }
 
-    // FromSoftware-style: Secrets have meaningful impact
-    DiscoveredSecrets.Add(CombinedID);
-
     // Notify secret discovery
     OnSecretDiscovered.Broadcast(AreaID, SecretID);
     BP_OnSecretDiscovered(AreaID, SecretID);
@@ -283,8 +538,8 @@ void USEWorldManager::DiscoverSecret(const FName& AreaID, const FName& SecretID)
 
 bool USEWorldManager::IsSecretDiscovered(const FName& AreaID, const FName& SecretID) const
 {
-    FName CombinedID = *FString::Printf(TEXT("%s_%s"), *AreaID.ToString(), *SecretID.ToString());
-    return DiscoveredSecrets.Contains(CombinedID);
+    return GameInstance && GameInstance->GetProgression().Test(ESEProgressionDomain::Secret,
+        FSEProgressionRegistry::Get().FindSecret(AreaID, SecretID));
 }
 
 void USEWorldManager::OnTimelineStateChanged(ETimelineState NewState)
@@ -303,7 +558,8 @@ void USEWorldManager::ProcessEventCooldowns()
     for (const auto& Pair : ActiveEvents)
     {
         // Check event duration and cooldown
-        if (/* Event duration expired */)
+        const FSEAbstractEvent* Event = WorldSimulation.FindEvent(Pair.Key);
+        if (Event && Event->RemainingTime <= 0.0f)
         {
             ExpiredEvents.Add(Pair.Key);
         }
@@ -318,20 +574,14 @@ void USEWorldManager::ProcessEventCooldowns()
 void USEWorldManager::ManageWorldBosses()
 {
     // FromSoftware-style: World bosses have complex behaviors
-    for (const auto& Pair : ActiveBosses)
-    {
-        const FWorldBoss& Boss = Pair.Value;
-        if (Boss.bIsRoaming)
-        {
-            // Update roaming behavior
-        }
-    }
+    // Roaming is advanced by the abstract simulation; make sure tiers match the player's position
+    UpdateSimulationTiers();
 }
 
 bool USEWorldManager::ValidateAreaConnection(const FName& FromArea, const FName& ToArea) const
 {
-    const FWorldArea* Area = GetAreaInfo(FromArea);
-    return Area && Area->ConnectedAreas.Contains(ToArea);
+    const FSEProgressionRegistry& Registry = FSEProgressionRegistry::Get();
+    return AreaGraph.HasEdge(Registry.Find(ESEProgressionDomain::Area, FromArea), Registry.Find(ESEProgressionDomain::Area, ToArea));
 }
 
 void USEWorldManager::CheckTimelineSpecificContent(ETimelineState NewState)
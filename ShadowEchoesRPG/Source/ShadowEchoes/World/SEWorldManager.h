@@ -5,10 +5,13 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "GameFramework/Actor.h"
+#include "World/SEAreaGraph.h"
+#include "World/SEWorldSimulation.h"
 #include "SEWorldManager.generated.h"
 
 class USEGameInstance;
 class UTimelineManager;
+struct FSEJobBudget;
 
 USTRUCT(BlueprintType)
 struct FWorldArea
@@ -125,6 +128,25 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
     bool IsAreaUnlocked(const FName& AreaID) const;
 
+    /** Area navigation */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
+    void SetCurrentArea(const FName& AreaID);
+
+    /** Reachable from the starting area through unlocked areas */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|World")
+    bool IsAreaReachable(const FName& AreaID) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
+    TArray<FName> GetReachableAreas() const;
+
+    /** Locked areas next to reachable ones, shown on the map but not yet enterable */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
+    TArray<FName> GetRevealedAreas() const;
+
+    /** Shortest route through unlocked areas; the destination may be locked */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
+    bool FindAreaRoute(const FName& FromArea, const FName& ToArea, TArray<FName>& OutRoute);
+
     /** Event system */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
     void TriggerWorldEvent(const FName& EventID);
@@ -145,6 +167,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
     bool IsWorldBossActive(const FName& BossID) const;
 
+    /** Whether a boss is currently a full actor rather than abstractly simulated */
+    UFUNCTION(BlueprintPure, Category = "Shadow Echoes|World")
+    ESESimulationTier GetWorldBossTier(const FName& BossID);
+
+    /** Full actors report their state so it survives demotion */
+    UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
+    void SyncWorldBossState(const FName& BossID, const FName& AreaID, float HealthFraction);
+
     /** Secret discovery */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
     void DiscoverSecret(const FName& AreaID, const FName& SecretID);
@@ -152,6 +182,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
     bool IsSecretDiscovered(const FName& AreaID, const FName& SecretID) const;
 
+    /** Unlocked areas indexed by FSEProgressionRegistry, for map rendering */
+    const TBitArray<>& GetUnlockedAreaBits() const;
+
     /** Timeline integration */
     UFUNCTION(BlueprintCallable, Category = "Shadow Echoes|World")
     void OnTimelineStateChanged(ETimelineState NewState);
@@ -177,6 +210,25 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|World")
     int32 MaxActiveEvents;
 
+    /** Simulation LOD */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|World|Simulation")
+    float SimulationInterval;
+
+    /** Area hops from the player at which content becomes a full actor */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|World|Simulation")
+    int32 PromoteDistance;
+
+    /** Area hops beyond which full content returns to the abstract tier; above PromoteDistance to avoid flapping */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|World|Simulation")
+    int32 DemoteDistance;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|World|Simulation")
+    float RoamSecondsPerArea;
+
+    /** Fraction of maximum health regained per second while abstract */
+    UPROPERTY(EditDefaultsOnly, Category = "Shadow Echoes|World|Simulation")
+    float AbstractBossRegen;
+
 private:
     /** Current state */
     UPROPERTY()
@@ -188,11 +240,17 @@ private:
     UPROPERTY()
     TMap<FName, FWorldBoss> ActiveBosses;
 
-    UPROPERTY()
-    TSet<FName> UnlockedAreas;
+    /** Compiled area connectivity, reachability and route cache */
+    FSEAreaGraph AreaGraph;
+
+    /** Abstract tier of bosses and events */
+    FSEWorldSimulation WorldSimulation;
+
+    /** Next scan of the world state pass; the scheduler may split the pass between them */
+    int32 WorldStatePhase;
 
     UPROPERTY()
-    TSet<FName> DiscoveredSecrets;
+    FName CurrentAreaID;
 
     /** Game instance reference */
     UPROPERTY()
@@ -203,10 +261,16 @@ private:
 
     /** Internal functionality */
     void LoadWorldData();
-    void UpdateWorldState();
+    bool StepWorldState(const FSEJobBudget& Budget);
     void ProcessEventCooldowns();
     void ManageWorldBosses();
+    void SimulateWorld();
+    void UpdateSimulationTiers();
+    bool IsWithinDistance(int32 AreaIndex, int32 MaxHops);
+    TArray<int32> BuildRoamingRoute(const FWorldBoss& Boss, const FName& SpawnArea);
+    FSEWorldBossSimState MakeBossSimState(const FSEAbstractBoss& Boss) const;
     bool ValidateAreaConnection(const FName& FromArea, const FName& ToArea) const;
+    TArray<FName> AreaBitsToNames(const TBitArray<>& Bits) const;
     void CheckTimelineSpecificContent(ETimelineState NewState);
     void UpdateAreaDifficulty();
 
@@ -218,6 +282,20 @@ protected:
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|World|Events")
     void BP_OnWorldBossSpawned(const FWorldBoss& Boss);
 
+    /** Spawn the boss actor from its abstract state */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|World|Events")
+    void BP_OnWorldBossPromoted(const FWorldBoss& Boss, const FSEWorldBossSimState& State);
+
+    /** Remove the boss actor; its last synced state carries on abstractly */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|World|Events")
+    void BP_OnWorldBossDemoted(const FName& BossID);
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|World|Events")
+    void BP_OnWorldEventPromoted(const FWorldEvent& Event, float RemainingTime);
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|World|Events")
+    void BP_OnWorldEventDemoted(const FName& EventID);
+
     UFUNCTION(BlueprintImplementableEvent, Category = "Shadow Echoes|World|Events")
     void BP_OnSecretDiscovered(const FName& AreaID, const FName& SecretID);
 
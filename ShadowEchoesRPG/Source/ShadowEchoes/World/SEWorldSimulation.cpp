@@ -0,0 +1,221 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#include "World/SEWorldSimulation.h"
+
+FSEWorldSimulation::FSEWorldSimulation()
+    : bStepInFlight(false)
+    , UnsimulatedTime(0.0f)
+    , NextSerial(1)
+{
+}
+
+namespace SEWorldSimulation
+{
+    /** Remove by swapping the last record into the hole, keeping the index map in step */
+    template <typename RecordType, typename IDGetter>
+    static void RemoveIndexed(TArray<RecordType>& Records, TMap<FName, int32>& Indices, FName ID, IDGetter GetID)
+    {
+        int32 Index = INDEX_NONE;
+        if (!Indices.RemoveAndCopyValue(ID, Index))
+        {
+            return;
+        }
+
+        Records.RemoveAtSwap(Index, 1, false);
+        if (Records.IsValidIndex(Index))
+        {
+            Indices.Add(GetID(Records[Index]), Index);
+        }
+    }
+}
+
+FSEAbstractBoss& FSEWorldSimulation::AddBoss(FName BossID, TArray<int32> Route, float SecondsPerArea, float RegenPerSecond)
+{
+    RemoveBoss(BossID);
+
+    BossIndices.Add(BossID, Bosses.Num());
+    FSEAbstractBoss& Boss = Bosses.AddDefaulted_GetRef();
+    Boss.BossID = BossID;
+    Boss.Route = MoveTemp(Route);
+    Boss.SecondsPerArea = FMath::Max(SecondsPerArea, 1.0f);
+    Boss.RegenPerSecond = RegenPerSecond;
+    Touch(Boss);
+    Boss.CreatedSerial = Boss.Serial;
+    return Boss;
+}
+
+void FSEWorldSimulation::RemoveBoss(FName BossID)
+{
+    SEWorldSimulation::RemoveIndexed(Bosses, BossIndices, BossID, [](const FSEAbstractBoss& Boss) { return Boss.BossID; });
+}
+
+FSEAbstractBoss* FSEWorldSimulation::FindBoss(FName BossID)
+{
+    const int32* Index = BossIndices.Find(BossID);
+    return Index ? &Bosses[*Index] : nullptr;
+}
+
+FSEAbstractEvent& FSEWorldSimulation::AddEvent(FName EventID, int32 AreaIndex, float Duration)
+{
+    RemoveEvent(EventID);
+
+    EventIndices.Add(EventID, Events.Num());
+    FSEAbstractEvent& Event = Events.AddDefaulted_GetRef();
+    Event.EventID = EventID;
+    Event.AreaIndex = AreaIndex;
+    Event.RemainingTime = Duration;
+    Touch(Event);
+    Event.CreatedSerial = Event.Serial;
+    return Event;
+}
+
+void FSEWorldSimulation::RemoveEvent(FName EventID)
+{
+    SEWorldSimulation::RemoveIndexed(Events, EventIndices, EventID, [](const FSEAbstractEvent& Event) { return Event.EventID; });
+}
+
+FSEAbstractEvent* FSEWorldSimulation::FindEvent(FName EventID)
+{
+    const int32* Index = EventIndices.Find(EventID);
+    return Index ? &Events[*Index] : nullptr;
+}
+
+void FSEWorldSimulation::Advance(float DeltaSeconds)
+{
+    UnsimulatedTime += DeltaSeconds;
+
+    // Promoted events keep their clock on the game thread
+    for (FSEAbstractEvent& Event : Events)
+    {
+        if (Event.Tier == ESESimulationTier::Full)
+        {
+            Event.RemainingTime -= DeltaSeconds;
+        }
+    }
+
+    if (bStepInFlight)
+    {
+        // A slow worker only delays results; the time is simulated with the next batch
+        if (!PendingStep.IsCompleted())
+        {
+            return;
+        }
+        Flush();
+    }
+
+    // Only abstract records go to the worker
+    FStepBatch Batch;
+    for (const FSEAbstractBoss& Boss : Bosses)
+    {
+        if (Boss.Tier == ESESimulationTier::Abstract)
+        {
+            Batch.Bosses.Add(Boss);
+        }
+    }
+    for (const FSEAbstractEvent& Event : Events)
+    {
+        if (Event.Tier == ESESimulationTier::Abstract)
+        {
+            Batch.Events.Add(Event);
+        }
+    }
+
+    if (Batch.Bosses.Num() == 0 && Batch.Events.Num() == 0)
+    {
+        UnsimulatedTime = 0.0f;
+        return;
+    }
+
+    Batch.StepTime = UnsimulatedTime;
+    UnsimulatedTime = 0.0f;
+
+    PendingStep = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Batch = MoveTemp(Batch)]() mutable
+    {
+        StepBosses(Batch.Bosses, Batch.StepTime);
+        StepEvents(Batch.Events, Batch.StepTime);
+        return MoveTemp(Batch);
+    });
+    bStepInFlight = true;
+}
+
+void FSEWorldSimulation::Flush()
+{
+    if (!bStepInFlight)
+    {
+        return;
+    }
+
+    bStepInFlight = false;
+    FStepBatch& Batch = PendingStep.GetResult();
+    MergeStep(Batch);
+    PendingStep = UE::Tasks::TTask<FStepBatch>();
+}
+
+void FSEWorldSimulation::MergeStep(FStepBatch& Batch)
+{
+    // A record touched during the step keeps the game thread's state and still owes the step's
+    // time; its own CarriedTime was part of the dropped step too, so only StepTime is added
+    for (FSEAbstractBoss& Stepped : Batch.Bosses)
+    {
+        FSEAbstractBoss* Live = FindBoss(Stepped.BossID);
+        if (!Live || Live->CreatedSerial != Stepped.CreatedSerial)
+        {
+            continue;
+        }
+
+        if (Live->Serial == Stepped.Serial)
+        {
+            *Live = MoveTemp(Stepped);
+        }
+        else if (Live->Tier == ESESimulationTier::Abstract)
+        {
+            Live->CarriedTime += Batch.StepTime;
+        }
+    }
+
+    for (FSEAbstractEvent& Stepped : Batch.Events)
+    {
+        FSEAbstractEvent* Live = FindEvent(Stepped.EventID);
+        if (!Live || Live->CreatedSerial != Stepped.CreatedSerial)
+        {
+            continue;
+        }
+
+        if (Live->Serial == Stepped.Serial)
+        {
+            *Live = Stepped;
+        }
+        else if (Live->Tier == ESESimulationTier::Abstract)
+        {
+            Live->CarriedTime += Batch.StepTime;
+        }
+    }
+}
+
+void FSEWorldSimulation::StepBosses(TArrayView<FSEAbstractBoss> Batch, float DeltaSeconds)
+{
+    for (FSEAbstractBoss& Boss : Batch)
+    {
+        const float BossDelta = DeltaSeconds + Boss.CarriedTime;
+        Boss.CarriedTime = 0.0f;
+        Boss.HealthFraction = FMath::Min(1.0f, Boss.HealthFraction + Boss.RegenPerSecond * BossDelta);
+
+        if (Boss.Route.Num() > 1)
+        {
+            // Whole areas crossed this step, wrapping around the loop
+            Boss.StepProgress += BossDelta / Boss.SecondsPerArea;
+            const int32 AreasCrossed = FMath::FloorToInt(Boss.StepProgress);
+            Boss.StepProgress -= AreasCrossed;
+            Boss.RouteStep = (Boss.RouteStep + AreasCrossed) % Boss.Route.Num();
+        }
+    }
+}
+
+void FSEWorldSimulation::StepEvents(TArrayView<FSEAbstractEvent> Batch, float DeltaSeconds)
+{
+    for (FSEAbstractEvent& Event : Batch)
+    {
+        Event.RemainingTime -= DeltaSeconds + Event.CarriedTime;
+        Event.CarriedTime = 0.0f;
+    }
+}
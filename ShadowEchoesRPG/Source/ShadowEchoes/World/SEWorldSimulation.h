@@ -0,0 +1,147 @@
+// Copyright Shadow Echoes RPG. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "SEWorldSimulation.generated.h"
+
+/** How a world boss or event is currently simulated */
+UENUM(BlueprintType)
+enum class ESESimulationTier : uint8
+{
+    Abstract    UMETA(DisplayName = "Abstract"),
+    Full        UMETA(DisplayName = "Full")
+};
+
+/** Abstract state handed to blueprints when a boss is promoted to a full actor */
+USTRUCT(BlueprintType)
+struct FSEWorldBossSimState
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "World")
+    FName BossID;
+
+    UPROPERTY(BlueprintReadOnly, Category = "World")
+    FName AreaID;
+
+    /** 0-1 of maximum health */
+    UPROPERTY(BlueprintReadOnly, Category = "World")
+    float HealthFraction;
+
+    /** 0-1 between the current area and the next on the roaming route */
+    UPROPERTY(BlueprintReadOnly, Category = "World")
+    float RouteProgress;
+
+    FSEWorldBossSimState()
+        : HealthFraction(1.0f)
+        , RouteProgress(0.0f)
+    {
+    }
+};
+
+/** Coarse state of a world boss; areas are FSEProgressionRegistry area indices */
+struct FSEAbstractBoss
+{
+    FName BossID;
+
+    /** Bumped on every game-thread change so stale worker results are dropped */
+    uint32 Serial = 0;
+
+    /** Serial at creation; tells a re-added record from the one a worker stepped */
+    uint32 CreatedSerial = 0;
+
+    /** Time from dropped worker results, simulated with the next step */
+    float CarriedTime = 0.0f;
+
+    ESESimulationTier Tier = ESESimulationTier::Abstract;
+
+    /** Roaming loop; a single area for stationary bosses */
+    TArray<int32> Route;
+    int32 RouteStep = 0;
+    float StepProgress = 0.0f;
+    float SecondsPerArea = 60.0f;
+
+    float HealthFraction = 1.0f;
+    float RegenPerSecond = 0.0f;
+
+    int32 GetArea() const { return Route.IsValidIndex(RouteStep) ? Route[RouteStep] : INDEX_NONE; }
+};
+
+/** Coarse state of a world event */
+struct FSEAbstractEvent
+{
+    FName EventID;
+    uint32 Serial = 0;
+    uint32 CreatedSerial = 0;
+    float CarriedTime = 0.0f;
+    ESESimulationTier Tier = ESESimulationTier::Abstract;
+    int32 AreaIndex = INDEX_NONE;
+    float RemainingTime = 0.0f;
+};
+
+/**
+ * Abstract simulation tier for world bosses and events
+ *
+ * Records in the abstract tier advance in batches on a worker: route position, health regen
+ * and event timers. Advance copies them into a batch, and the stepped batch is merged back on
+ * the next call once the task has finished, skipping records the game thread touched in the
+ * meantime; those keep the step's time and simulate it with the next batch. Records are
+ * indexed by ID. Records promoted to full actors are left alone until they are demoted again.
+ */
+class SHADOWECHOES_API FSEWorldSimulation
+{
+public:
+    FSEWorldSimulation();
+
+    FSEAbstractBoss& AddBoss(FName BossID, TArray<int32> Route, float SecondsPerArea, float RegenPerSecond);
+    void RemoveBoss(FName BossID);
+    FSEAbstractBoss* FindBoss(FName BossID);
+
+    FSEAbstractEvent& AddEvent(FName EventID, int32 AreaIndex, float Duration);
+    void RemoveEvent(FName EventID);
+    FSEAbstractEvent* FindEvent(FName EventID);
+
+    /** Mark a record changed on the game thread */
+    void Touch(FSEAbstractBoss& Boss) { Boss.Serial = NextSerial++; }
+    void Touch(FSEAbstractEvent& Event) { Event.Serial = NextSerial++; }
+
+    /** Merge a finished step, then launch the next one with all time elapsed since */
+    void Advance(float DeltaSeconds);
+
+    /** Wait for the step in flight and merge it */
+    void Flush();
+
+    TArray<FSEAbstractBoss>& GetBosses() { return Bosses; }
+    TArray<FSEAbstractEvent>& GetEvents() { return Events; }
+
+    /** Worker-side stepping, also used directly by tests; each record also uses up its CarriedTime */
+    static void StepBosses(TArrayView<FSEAbstractBoss> Batch, float DeltaSeconds);
+    static void StepEvents(TArrayView<FSEAbstractEvent> Batch, float DeltaSeconds);
+
+private:
+    struct FStepBatch
+    {
+        TArray<FSEAbstractBoss> Bosses;
+        TArray<FSEAbstractEvent> Events;
+        float StepTime = 0.0f;
+    };
+
+    void MergeStep(FStepBatch& Batch);
+
+    TArray<FSEAbstractBoss> Bosses;
+    TArray<FSEAbstractEvent> Events;
+
+    /** Position of each record in Bosses and Events */
+    TMap<FName, int32> BossIndices;
+    TMap<FName, int32> EventIndices;
+
+    UE::Tasks::TTask<FStepBatch> PendingStep;
+    bool bStepInFlight;
+
+    /** Time not yet handed to a worker */
+    float UnsimulatedTime;
+
+    uint32 NextSerial;
+};